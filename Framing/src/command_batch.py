@@ -0,0 +1,180 @@
+"""Command batch packets for ProvesRouter."""
+
+import argparse
+import os
+import re
+import sys
+from typing import List, Optional, Tuple
+
+# ComCfg.Apid.PROVES_COMMAND_BATCH
+COMMAND_BATCH_APID = 0x0080
+
+# Flight software models the batch limits are read from, relative to the repository
+FP_CONSTANTS_FPP = "PROVESFlightControllerReference/project/config/FpConstants.fpp"
+PROVES_ROUTER_FPP = (
+    "PROVESFlightControllerReference/Components/ProvesRouter/ProvesRouter.fpp"
+)
+
+# ProvesRouter ROUTER_MAX_BATCH_COMMANDS and FW_COM_BUFFER_MAX_SIZE, used when the
+# models are not found
+DEFAULT_MAX_BATCH_COMMANDS = 8
+DEFAULT_MAX_COMMAND_SIZE = 227
+
+# Packet descriptor and opcode
+MIN_COMMAND_SIZE = 6
+
+
+def read_fpp_constant(path: str, name: str) -> int:
+    """
+    Read an integer constant from an FPP model.
+
+    Args:
+        path: FPP file defining the constant
+        name: Constant name, e.g. FW_COM_BUFFER_MAX_SIZE
+
+    Returns:
+        The constant value
+
+    Raises:
+        FileNotFoundError: If the FPP file is not found
+        ValueError: If the file does not define the constant as an integer literal
+    """
+    if not os.path.exists(path):
+        raise FileNotFoundError(
+            f"{os.path.basename(path)} not found at {path}. "
+            "Command batches are checked against the flight software limits it defines."
+        )
+
+    pattern = re.compile(rf"^\s*constant\s+{name}\s*=\s*(0x[0-9A-Fa-f]+|\d+)\s*$")
+    with open(path, "r") as f:
+        for line in f:
+            match = pattern.match(line)
+            if match:
+                return int(match.group(1), 0)
+
+    raise ValueError(
+        f"No integer constant {name} found in {path}. "
+        f"It must contain a line with: constant {name} = <value>"
+    )
+
+
+def read_batch_limits(repository: str = ".") -> Tuple[int, int]:
+    """
+    Read the batch limits from the flight software models in a repository checkout.
+
+    Falls back to DEFAULT_MAX_BATCH_COMMANDS and DEFAULT_MAX_COMMAND_SIZE, with a
+    warning, when the models are not found, e.g. when run outside the repository.
+
+    Args:
+        repository: Root of the repository, the current directory by default
+
+    Returns:
+        The most commands in one batch and the largest command packet in bytes
+
+    Raises:
+        ValueError: If a model is found but does not define its constant
+    """
+    try:
+        return (
+            read_fpp_constant(
+                os.path.join(repository, PROVES_ROUTER_FPP),
+                "ROUTER_MAX_BATCH_COMMANDS",
+            ),
+            read_fpp_constant(
+                os.path.join(repository, FP_CONSTANTS_FPP), "FW_COM_BUFFER_MAX_SIZE"
+            ),
+        )
+    except FileNotFoundError as e:
+        print(f"Warning: {e} Using the default limits.", file=sys.stderr)
+        return DEFAULT_MAX_BATCH_COMMANDS, DEFAULT_MAX_COMMAND_SIZE
+
+
+def encode_command_batch(
+    commands: List[bytes],
+    max_batch_commands: int = DEFAULT_MAX_BATCH_COMMANDS,
+    max_command_size: int = DEFAULT_MAX_COMMAND_SIZE,
+) -> bytes:
+    """
+    Pack serialized command packets into one command batch packet.
+
+    Each command is the packet a single command frame would carry: packet descriptor,
+    opcode and arguments. The batch is authenticated as one frame and consumes one
+    sequence number; ProvesRouter dispatches the commands in order and reports each
+    response with a BatchCommandResponse event.
+
+    Args:
+        commands: Serialized command packets, in dispatch order
+        max_batch_commands: ProvesRouter ROUTER_MAX_BATCH_COMMANDS
+        max_command_size: FW_COM_BUFFER_MAX_SIZE
+
+    Returns:
+        The batch packet, starting with the COMMAND_BATCH_APID packet descriptor
+
+    Raises:
+        ValueError: If the batch would be rejected by ProvesRouter
+    """
+    if not commands:
+        raise ValueError("A command batch needs at least one command")
+    if len(commands) > max_batch_commands:
+        raise ValueError(
+            f"A command batch carries at most {max_batch_commands} commands, "
+            f"got {len(commands)}"
+        )
+
+    batch = COMMAND_BATCH_APID.to_bytes(2, byteorder="big", signed=False)
+    for command in commands:
+        if not MIN_COMMAND_SIZE <= len(command) <= max_command_size:
+            raise ValueError(
+                f"Command packets must be {MIN_COMMAND_SIZE} to {max_command_size} "
+                f"bytes, got {len(command)}"
+            )
+        batch += len(command).to_bytes(2, byteorder="big", signed=False)
+        batch += command
+    return batch
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    """
+    Encode command packets given as hex strings into a command batch packet.
+
+    The batch is written as hex to stdout, or as raw bytes to --output, ready to be
+    framed by the authenticate-space-data-link framer in place of a single command
+    packet.
+    """
+    parser = argparse.ArgumentParser(description=main.__doc__.strip().splitlines()[0])
+    parser.add_argument(
+        "commands",
+        nargs="+",
+        help="Serialized command packets as hex strings, in dispatch order",
+    )
+    parser.add_argument(
+        "--output", help="Write the batch packet to this file instead of stdout"
+    )
+    parser.add_argument(
+        "--repository",
+        default=".",
+        help="Repository checkout to read the batch limits from, the current "
+        "directory by default",
+    )
+    args = parser.parse_args(argv)
+
+    try:
+        max_batch_commands, max_command_size = read_batch_limits(args.repository)
+        batch = encode_command_batch(
+            [bytes.fromhex(command) for command in args.commands],
+            max_batch_commands,
+            max_command_size,
+        )
+    except ValueError as e:
+        parser.error(str(e))
+
+    if args.output is None:
+        print(batch.hex())
+    else:
+        with open(args.output, "wb") as f:
+            f.write(batch)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,111 @@
+"""SBand modulation change announcements for link-margin adaptive modulation."""
+
+from dataclasses import dataclass
+from typing import Optional
+
+# LinkAdaptation kAnnouncementSize and header
+ANNOUNCEMENT_SIZE = 9
+ANNOUNCEMENT_MAGIC = b"SBMC"
+
+# LinkAdaptation kAcknowledgementSize and header
+ACKNOWLEDGEMENT_SIZE = 5
+ACKNOWLEDGEMENT_MAGIC = b"SBMA"
+
+# SBand ADAPT_IDLE_TICKS at the 10 Hz rate group; both ends return to the home rung
+# after this long without hearing the other
+IDLE_RESET_SECONDS = 300
+
+# LinkAdaptation kLadder, fastest first: (spreading factor, bandwidth in kHz)
+LADDER = (
+    (5, 1625.0),
+    (6, 1625.0),
+    (7, 1625.0),
+    (7, 812.5),
+    (7, 406.25),
+    (8, 406.25),
+    (9, 406.25),
+    (10, 406.25),
+    (10, 203.125),
+    (11, 203.125),
+    (12, 203.125),
+)
+
+# SBandBandwidth values
+BANDWIDTH_KHZ = (203.125, 406.25, 812.5, 1625.0)
+
+
+@dataclass(frozen=True)
+class ModulationChange:
+    """A modulation the spacecraft is switching to."""
+
+    rung: int
+    spreading_factor: int
+    bandwidth_khz: float
+    coding_rate: int
+    remaining: int
+
+    @property
+    def takes_effect(self) -> bool:
+        """Whether the spacecraft switches as soon as this announcement is sent."""
+        return self.remaining == 0
+
+
+def decode_announcement(packet: bytes) -> Optional[ModulationChange]:
+    """
+    Decode an SBand modulation change announcement.
+
+    Announcements are bare radio packets, not CCSDS frames, so a received packet is
+    checked here before it goes to the deframer. The spacecraft sends one per rate
+    group tick in the old modulation and switches after the one with nothing
+    remaining; the ground station must retune the radio then and uplink the
+    encode_acknowledgement packet within 10 seconds, or the spacecraft reverts.
+
+    Args:
+        packet: A packet received from the SBand radio
+
+    Returns:
+        The announced change, or None when the packet is not an announcement
+
+    Raises:
+        ValueError: If the packet is an announcement with an invalid modulation
+    """
+    if len(packet) != ANNOUNCEMENT_SIZE or not packet.startswith(ANNOUNCEMENT_MAGIC):
+        return None
+
+    rung, spreading_factor, bandwidth, coding_rate, remaining = packet[4:]
+    if rung >= len(LADDER) or bandwidth >= len(BANDWIDTH_KHZ):
+        raise ValueError(f"Announcement names an unknown modulation rung {rung}")
+    if LADDER[rung] != (spreading_factor, BANDWIDTH_KHZ[bandwidth]):
+        raise ValueError(
+            f"Announcement rung {rung} does not match SF{spreading_factor} at "
+            f"{BANDWIDTH_KHZ[bandwidth]} kHz"
+        )
+    if not 5 <= coding_rate <= 8:
+        raise ValueError(f"Coding rate must be 4/5 to 4/8, got 4/{coding_rate}")
+    return ModulationChange(
+        rung, spreading_factor, BANDWIDTH_KHZ[bandwidth], coding_rate, remaining
+    )
+
+
+def encode_acknowledgement(change: ModulationChange) -> bytes:
+    """
+    Encode the acknowledgement of an SBand modulation change.
+
+    The ground station sends this bare radio packet, not a CCSDS frame, once it has
+    retuned to the announced modulation. Only an acknowledgement naming the announced
+    rung holds the change on the spacecraft.
+
+    Args:
+        change: The announcement with nothing remaining
+
+    Returns:
+        The acknowledgement packet to uplink in the new modulation
+
+    Raises:
+        ValueError: If the change names an unknown modulation rung
+    """
+    if not 0 <= change.rung < len(LADDER):
+        raise ValueError(
+            f"Acknowledgement names an unknown modulation rung {change.rung}"
+        )
+    return ACKNOWLEDGEMENT_MAGIC + bytes([change.rung])
@@ -5,7 +5,9 @@
 
 #include "BDot.hpp"
 
-#include <cmath>
+namespace {
+constexpr std::int64_t USECONDS_PER_SECOND = 1000000;
+}
 
 namespace Components {
 
@@ -13,88 +15,180 @@ namespace Components {
 // Component construction and destruction
 // ----------------------------------------------------------------------
 
-BDot ::BDot() {}
+template <std::size_t STENCIL_POINTS, typename Scalar>
+BasicBDot<STENCIL_POINTS, Scalar>::BasicBDot() {}
 
-BDot ::~BDot() {}
+template <std::size_t STENCIL_POINTS, typename Scalar>
+BasicBDot<STENCIL_POINTS, Scalar>::~BasicBDot() {}
 
 // ----------------------------------------------------------------------
 //  public helper methods
 // ----------------------------------------------------------------------
 
-std::array<double, 3> BDot ::getMagneticMoment() {
+template <std::size_t STENCIL_POINTS, typename Scalar>
+typename BasicBDot<STENCIL_POINTS, Scalar>::Vector BasicBDot<STENCIL_POINTS, Scalar>::getMagneticMoment() {
     // Compute BDot
-    std::array<double, 3> b_dot = this->computeBDot();
+    Vector b_dot = this->computeBDot();
 
     // Compute dipole moment components
-    double moment_x = -this->m_gain * b_dot[0];
-    double moment_y = -this->m_gain * b_dot[1];
-    double moment_z = -this->m_gain * b_dot[2];
+    Scalar moment_x = -this->m_gain * b_dot[0];
+    Scalar moment_y = -this->m_gain * b_dot[1];
+    Scalar moment_z = -this->m_gain * b_dot[2];
 
     // Return result
-    return std::array<double, 3>{moment_x, moment_y, moment_z};
+    return Vector{moment_x, moment_y, moment_z};
 }
 
-void BDot ::configure(double gain, std::chrono::microseconds magnetometer_sampling_period) {
+template <std::size_t STENCIL_POINTS, typename Scalar>
+void BasicBDot<STENCIL_POINTS, Scalar>::configure(Scalar gain, std::chrono::microseconds magnetometer_sampling_period) {
     this->m_gain = gain;
     this->m_magnetometer_sampling_period = magnetometer_sampling_period;
 }
 
-void BDot ::addSample(const std::array<double, 3>& magnetic_field, std::chrono::microseconds timestamp) {
-    // Add sample if there is space
-    if (this->m_sample_count >= SAMPLING_SET_SIZE) {
+template <std::size_t STENCIL_POINTS, typename Scalar>
+void BasicBDot<STENCIL_POINTS, Scalar>::setSamplingMode(SamplingMode mode) {
+    this->m_sampling_mode = mode;
+    this->emptySampleSet();
+}
+
+template <std::size_t STENCIL_POINTS, typename Scalar>
+void BasicBDot<STENCIL_POINTS, Scalar>::setDerivativeMethod(DerivativeMethod method) {
+    this->m_derivative_method = method;
+}
+
+template <std::size_t STENCIL_POINTS, typename Scalar>
+void BasicBDot<STENCIL_POINTS, Scalar>::addSample(const Vector& magnetic_field, std::chrono::microseconds timestamp) {
+    // In batch mode add sample only if there is space
+    if (this->m_sampling_mode == SamplingMode::BATCH && this->m_sample_count >= SAMPLING_SET_SIZE) {
         return;
     }
-    this->m_sampling_set[this->m_sample_count] = {magnetic_field, timestamp};
-    this->m_sample_count++;
+
+    // Write over the oldest sample in streaming mode
+    this->m_sampling_set[this->m_next_index] = {magnetic_field, timestamp};
+    this->m_next_index = (this->m_next_index + 1) % SAMPLING_SET_SIZE;
+    if (this->m_sample_count < SAMPLING_SET_SIZE) {
+        this->m_sample_count++;
+    }
 }
 
-bool BDot ::samplingComplete() const {
+template <std::size_t STENCIL_POINTS, typename Scalar>
+bool BasicBDot<STENCIL_POINTS, Scalar>::samplingComplete() const {
     return this->m_sample_count >= SAMPLING_SET_SIZE;
 }
 
-std::chrono::microseconds BDot ::getTimeBetweenSamples() const {
+template <std::size_t STENCIL_POINTS, typename Scalar>
+std::chrono::microseconds BasicBDot<STENCIL_POINTS, Scalar>::getTimeBetweenSamples() const {
     if (this->m_sample_count < 2) {
         return std::chrono::microseconds(0);
     }
 
-    std::chrono::microseconds first_timestamp = this->m_sampling_set[0].timestamp;
-    std::chrono::microseconds last_timestamp = this->m_sampling_set[this->m_sample_count - 1].timestamp;
+    std::chrono::microseconds first_timestamp = this->getSample(0).timestamp;
+    std::chrono::microseconds last_timestamp = this->getSample(this->m_sample_count - 1).timestamp;
 
     return last_timestamp - first_timestamp;
 }
 
-void BDot ::emptySampleSet() {
+template <std::size_t STENCIL_POINTS, typename Scalar>
+void BasicBDot<STENCIL_POINTS, Scalar>::emptySampleSet() {
     this->m_sample_count = 0;
+    this->m_next_index = 0;
 }
 
 // ----------------------------------------------------------------------
 //  Private helper methods
 // ----------------------------------------------------------------------
 
-std::array<double, 3> BDot ::computeBDot() const {
-    // Get time delta between samples in seconds
-    double dt_seconds = this->m_magnetometer_sampling_period.count() / 1e6;
-    if (dt_seconds <= 0.0) {
-        return std::array<double, 3>{0.0, 0.0, 0.0};
-    }
-
+template <std::size_t STENCIL_POINTS, typename Scalar>
+typename BasicBDot<STENCIL_POINTS, Scalar>::Vector BasicBDot<STENCIL_POINTS, Scalar>::computeBDot() const {
     // Ensure we have enough samples
     if (!this->samplingComplete()) {
-        return std::array<double, 3>{0.0, 0.0, 0.0};
+        return Vector{0, 0, 0};
+    }
+
+    if (this->m_derivative_method == DerivativeMethod::LEAST_SQUARES) {
+        return this->computeLeastSquaresBDot();
+    }
+
+    // Sample rate 1 / 𝚫t from the integer microsecond span, so no scalar division is needed
+    std::int64_t span_useconds = this->m_magnetometer_sampling_period.count();
+    std::int64_t intervals = 1;
+    if (this->m_sampling_mode == SamplingMode::STREAMING) {
+        span_useconds = this->getTimeBetweenSamples().count();
+        intervals = static_cast<std::int64_t>(SAMPLING_SET_SIZE - 1);
+    }
+    if (span_useconds <= 0) {
+        return Vector{0, 0, 0};
+    }
+    Scalar sample_rate = ScalarMath<Scalar>::ratio(intervals * USECONDS_PER_SECOND, span_useconds);
+
+    // Weighted sum of all samples, with the axes fused so the fixed size loops unroll into straight line code. The
+    // rate is folded into each weight first so fixed point rounding of the products is not amplified by it.
+    constexpr CentralDifferenceStencil<STENCIL_POINTS, Scalar> stencil;
+    Vector b_dot{0, 0, 0};
+    for (std::size_t i = 0; i < STENCIL_POINTS; i++) {
+        Scalar weight = stencil.weights[i] * sample_rate;
+        const Sample& sample = this->getSample(i);
+        for (std::size_t axis = 0; axis < 3; axis++) {
+            b_dot[axis] += weight * sample.magnetic_field[axis];
+        }
     }
 
-    // Compute BDot using 5-point Central Difference Formula
-    double x = (-1.0 * this->m_sampling_set[4].magnetic_field[0] + 8.0 * this->m_sampling_set[3].magnetic_field[0] +
-                -8.0 * this->m_sampling_set[1].magnetic_field[0] + 1.0 * this->m_sampling_set[0].magnetic_field[0]) /
-               (12.0 * dt_seconds);
-    double y = (-1.0 * this->m_sampling_set[4].magnetic_field[1] + 8.0 * this->m_sampling_set[3].magnetic_field[1] +
-                -8.0 * this->m_sampling_set[1].magnetic_field[1] + 1.0 * this->m_sampling_set[0].magnetic_field[1]) /
-               (12.0 * dt_seconds);
-    double z = (-1.0 * this->m_sampling_set[4].magnetic_field[2] + 8.0 * this->m_sampling_set[3].magnetic_field[2] +
-                -8.0 * this->m_sampling_set[1].magnetic_field[2] + 1.0 * this->m_sampling_set[0].magnetic_field[2]) /
-               (12.0 * dt_seconds);
-
-    return std::array<double, 3>{x, y, z};
+    return b_dot;
 }
 
+template <std::size_t STENCIL_POINTS, typename Scalar>
+typename BasicBDot<STENCIL_POINTS, Scalar>::Vector BasicBDot<STENCIL_POINTS, Scalar>::computeLeastSquaresBDot()
+    const {
+    // Sample times in microseconds relative to the oldest sample, scaled by N so centring stays exact in integers
+    constexpr std::int64_t POINTS = static_cast<std::int64_t>(STENCIL_POINTS);
+    std::chrono::microseconds origin = this->getSample(0).timestamp;
+    std::array<std::int64_t, STENCIL_POINTS> centred{};
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < STENCIL_POINTS; i++) {
+        centred[i] = (this->getSample(i).timestamp - origin).count();
+        sum += centred[i];
+    }
+
+    // N (t_i - t̄) and the normal equation denominator N² Σ (t_j - t̄)²
+    std::int64_t sum_squares = 0;
+    for (std::size_t i = 0; i < STENCIL_POINTS; i++) {
+        centred[i] = POINTS * centred[i] - sum;
+        sum_squares += centred[i] * centred[i];
+    }
+    if (sum_squares <= 0) {
+        return Vector{0, 0, 0};
+    }
+
+    // Centred weights sum to zero, so the mean field drops out and one fused pass gives the slope of each axis
+    Vector b_dot{0, 0, 0};
+    for (std::size_t i = 0; i < STENCIL_POINTS; i++) {
+        Scalar weight = ScalarMath<Scalar>::ratio(POINTS * centred[i] * USECONDS_PER_SECOND, sum_squares);
+        const Sample& sample = this->getSample(i);
+        for (std::size_t axis = 0; axis < 3; axis++) {
+            b_dot[axis] += weight * sample.magnetic_field[axis];
+        }
+    }
+
+    return b_dot;
+}
+
+template <std::size_t STENCIL_POINTS, typename Scalar>
+const typename BasicBDot<STENCIL_POINTS, Scalar>::Sample& BasicBDot<STENCIL_POINTS, Scalar>::getSample(
+    std::size_t index) const {
+    // The oldest sample sits just behind the write index once the ring has wrapped
+    std::size_t oldest = (this->m_next_index + SAMPLING_SET_SIZE - this->m_sample_count) % SAMPLING_SET_SIZE;
+    return this->m_sampling_set[(oldest + index) % SAMPLING_SET_SIZE];
+}
+
+// ----------------------------------------------------------------------
+//  Supported stencil sizes and scalar types
+// ----------------------------------------------------------------------
+
+template class BasicBDot<3>;
+template class BasicBDot<5>;
+template class BasicBDot<7>;
+template class BasicBDot<9>;
+template class BasicBDot<BDOT_STENCIL_POINTS, float>;
+template class BasicBDot<BDOT_STENCIL_POINTS, FixedPointQ16>;
+
 }  // namespace Components
@@ -9,25 +9,45 @@
 #include <chrono>
 #include <cstdint>
 
-using TimePoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono::microseconds>;
+#include "FiniteDifferenceStencil.hpp"
 
-namespace {
-constexpr std::size_t SAMPLING_SET_SIZE =
-    5;  //!< Number of samples, to change this you must also change the computeBDot method
-}
+using TimePoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono::microseconds>;
 
 namespace Components {
 
-class BDot {
+//! Number of samples in the derivative stencil used for detumbling, one of 3, 5, 7 or 9
+//!
+//! Wider stencils reject more magnetometer noise but hold each derivative for longer before it is actuated.
+constexpr std::size_t BDOT_STENCIL_POINTS = 5;
+
+//! B-Dot algorithm over a STENCIL_POINTS sample window, computing in Scalar (double, float or FixedPoint)
+template <std::size_t STENCIL_POINTS, typename Scalar = double>
+class BasicBDot {
   public:
+    static constexpr std::size_t SAMPLING_SET_SIZE = STENCIL_POINTS;  //!< Number of samples in the set
+
+    using Vector = std::array<Scalar, 3>;  //!< Three axis vector in the computation scalar
+
     // ----------------------------------------------------------------------
     //  Public types
     // ----------------------------------------------------------------------
 
     //! Sample structure for magnetic field samples
     struct Sample {
-        std::array<double, 3> magnetic_field;  //!< Magnetic field vector in gauss
-        std::chrono::microseconds timestamp;   //!< Timestamp of the sample
+        Vector magnetic_field;                //!< Magnetic field vector in gauss
+        std::chrono::microseconds timestamp;  //!< Timestamp of the sample
+    };
+
+    //! How new samples are added once the sample set is full
+    enum class SamplingMode {
+        BATCH,      //!< Samples are ignored once the set is full until it is emptied
+        STREAMING,  //!< Each sample replaces the oldest, so every sample yields a fresh derivative
+    };
+
+    //! How the time derivative is estimated from the sample set
+    enum class DerivativeMethod {
+        CENTRAL_DIFFERENCE,  //!< Stencil weights assuming the samples are evenly spaced
+        LEAST_SQUARES,       //!< Least-squares slope through the sample timestamps, tolerates jittered spacing
     };
 
   public:
@@ -36,10 +56,10 @@ class BDot {
     // ----------------------------------------------------------------------
 
     //! Construct BDot object
-    BDot();
+    BasicBDot();
 
     //! Destroy BDot object
-    ~BDot();
+    ~BasicBDot();
 
   public:
     // ----------------------------------------------------------------------
@@ -53,16 +73,26 @@ class BDot {
     // m is the magnetic moment in A⋅m²
     // k is a gain constant in A⋅m²⋅s/G
     // Ḃ is the time derivative of the magnetic field sample in gauss per second (G/s)
-    std::array<double, 3> getMagneticMoment();
+    Vector getMagneticMoment();
 
     //! Configure BDot parameters
-    void configure(double gain,                                            //!< Gain constant
+    void configure(Scalar gain,                                            //!< Gain constant
                    std::chrono::microseconds magnetometer_sampling_period  //!< Magnetometer sampling period
     );
 
+    //! Select how samples are added once the set is full, empties the sample set
+    void setSamplingMode(SamplingMode mode  //!< Sampling mode
+    );
+
+    //! Select how the time derivative is estimated, keeps the sample set
+    void setDerivativeMethod(DerivativeMethod method  //!< Derivative method
+    );
+
     //! Adds a magnetic field sample set
-    void addSample(const std::array<double, 3>& magnetic_field,  //!< Magnetic field vector in gauss
-                   std::chrono::microseconds timestamp           //!< Timestamp of the sample
+    //!
+    //! In STREAMING mode the oldest sample is overwritten when the set is full.
+    void addSample(const Vector& magnetic_field,        //!< Magnetic field vector in gauss
+                   std::chrono::microseconds timestamp  //!< Timestamp of the sample
     );
 
     //! Tells the caller if the sample set is full
@@ -81,26 +111,57 @@ class BDot {
 
     //! Compute BDot uses the central difference method to estimate the time derivative of the magnetic field.
     //!
-    //! Ḃ = (-1)B_4 + 8B_3 - 8B_1 + B_0) / (12 * 𝚫t)
+    //! Ḃ = (Σ w_i B_i) / 𝚫t
     //!
-    //! B_i is the magnetic field vector at sample i
+    //! B_i is the magnetic field vector at sample i, oldest first
+    //! w_i are the CentralDifferenceStencil weights, e.g. (1, -8, 0, 8, -1) / 12 for five points
     //! 𝚫t is the time delta between samples in seconds
-    //! Coefficients are (-1, 8, -8, 1) with divisor 12 * 𝚫t.
-    std::array<double, 3> computeBDot() const;
+    //!
+    //! In BATCH mode 𝚫t is the configured magnetometer sampling period. In STREAMING mode samples are spaced by
+    //! the control cycle rather than the magnetometer, so 𝚫t is the mean spacing of the sample timestamps.
+    //!
+    //! In LEAST_SQUARES mode the derivative comes from computeLeastSquaresBDot instead.
+    Vector computeBDot() const;
+
+    //! Estimate the time derivative of the magnetic field as the least-squares slope through the samples.
+    //!
+    //! Ḃ = Σ c_i B_i,  c_i = (t_i - t̄) / Σ (t_j - t̄)²
+    //!
+    //! t_i is the timestamp of sample i in seconds and t̄ the mean timestamp. The weights c_i solve the normal
+    //! equations of the line fit once per window and are shared by all three axes. The result is the slope at t̄
+    //! and is exact for linear fields however the samples are spaced. The centred times are kept in integer
+    //! microseconds so only the final weights are rounded to Scalar.
+    Vector computeLeastSquaresBDot() const;
+
+    //! Sample at the given position in the set, where 0 is the oldest
+    const Sample& getSample(std::size_t index) const;
 
     //! Compute the magnitude of the most recent magnetic field sample.
-    double getMagnitude() const;
+    Scalar getMagnitude() const;
 
   private:
     // ----------------------------------------------------------------------
     //  Private member variables
     // ----------------------------------------------------------------------
 
-    double m_gain;                                             //!< Gain constant
-    std::chrono::microseconds m_magnetometer_sampling_period;  //!< Magnetometer
+    Scalar m_gain{};                                             //!< Gain constant
+    std::chrono::microseconds m_magnetometer_sampling_period{};  //!< Magnetometer
 
-    std::array<Sample, SAMPLING_SET_SIZE> m_sampling_set{};  //!< Set of samples used to compute BDot
+    std::array<Sample, SAMPLING_SET_SIZE> m_sampling_set{};  //!< Ring of samples used to compute BDot
     std::size_t m_sample_count = 0;                          //!< Number of samples in the set
+    std::size_t m_next_index = 0;                            //!< Ring index the next sample is written to
+    SamplingMode m_sampling_mode = SamplingMode::BATCH;      //!< How samples are added once the set is full
+
+    DerivativeMethod m_derivative_method = DerivativeMethod::CENTRAL_DIFFERENCE;  //!< How the derivative is estimated
 };
 
+extern template class BasicBDot<3>;
+extern template class BasicBDot<5>;
+extern template class BasicBDot<7>;
+extern template class BasicBDot<9>;
+extern template class BasicBDot<BDOT_STENCIL_POINTS, float>;
+extern template class BasicBDot<BDOT_STENCIL_POINTS, FixedPointQ16>;
+
+using BDot = BasicBDot<BDOT_STENCIL_POINTS, DetumbleScalar>;  //!< B-Dot algorithm used by DetumbleManager
+
 }  // namespace Components
@@ -0,0 +1,302 @@
+// ======================================================================
+// \title  DetumbleController.cpp
+// \brief  cpp file for DetumbleController implementation class
+// ======================================================================
+
+#include "DetumbleController.hpp"
+
+namespace {
+//! Convert a parameter or sensor value to the scalar type of the detumble control path
+Components::DetumbleScalar toDetumbleScalar(double value) {
+    return Components::ScalarMath<Components::DetumbleScalar>::fromDouble(value);
+}
+}  // namespace
+
+namespace Components {
+// ----------------------------------------------------------------------
+// Component construction and destruction
+// ----------------------------------------------------------------------
+
+DetumbleController::DetumbleController() {}
+
+DetumbleController::~DetumbleController() {}
+
+// ----------------------------------------------------------------------
+//  Public helper methods
+// ----------------------------------------------------------------------
+
+void DetumbleController::run(Io& io) {
+    switch (this->m_state) {
+        case COOLDOWN:
+            this->stateCooldownActions(io);
+            return;
+        case SENSING_ANGULAR_VELOCITY:
+            this->stateSensingAngularVelocityActions(io);
+            return;
+        case SENSING_MAGNETIC_FIELD:
+            this->stateSensingMagneticFieldActions(io);
+            return;
+        case ACTUATING_BDOT:
+            this->stateActuatingBDotActions(io);
+            return;
+        case ACTUATING_HYSTERESIS:
+            this->stateActuatingHysteresisActions(io);
+            return;
+        case ACTUATING_BDOT_CONTINUOUS:
+            this->stateActuatingBDotContinuousActions(io);
+            return;
+    }
+}
+
+void DetumbleController::magneticFieldReady(Io& io) {
+    // Every conversion enters the sampling window, not only the newest one of each run
+    if (this->m_state == SENSING_MAGNETIC_FIELD) {
+        this->stateSensingMagneticFieldActions(io);
+    }
+}
+
+void DetumbleController::disable(Io& io) {
+    if (this->m_state == ACTUATING_BDOT_CONTINUOUS) {
+        this->stateExitActuatingBDotContinuousActions(io);
+    }
+    if (this->m_state != COOLDOWN) {
+        io.stopMagnetorquers();
+        this->m_state = COOLDOWN;  // Reset state to COOLDOWN when re-enabled
+    }
+}
+
+DetumbleController::State DetumbleController::getState() const {
+    return this->m_state;
+}
+
+StrategySelector::Strategy DetumbleController::getStrategy() const {
+    return this->m_strategy;
+}
+
+// ----------------------------------------------------------------------
+//  Private helper methods
+// ----------------------------------------------------------------------
+
+void DetumbleController::stateCooldownActions(Io& io) {
+    std::chrono::microseconds current_time = io.currentTime();
+
+    // On first call after state transition record the cooldown start time
+    if (this->m_cooldown_start_time.count() == 0) {
+        this->m_cooldown_start_time = current_time;
+    }
+
+    // Check if cooldown duration has elapsed and exit COOLDOWN state
+    if (current_time - this->m_cooldown_start_time > io.settings().cooldown_duration) {
+        this->m_cooldown_start_time = std::chrono::microseconds(0);
+        this->m_state = SENSING_ANGULAR_VELOCITY;
+    }
+}
+
+void DetumbleController::stateSensingAngularVelocityActions(Io& io) {
+    Settings settings = io.settings();
+
+    double angular_velocity_magnitude_deg_sec = 0.0;
+    if (!this->selectStrategy(io, settings, angular_velocity_magnitude_deg_sec)) {
+        return;
+    }
+
+    this->stateExitSensingAngularVelocityActions(io, settings, angular_velocity_magnitude_deg_sec);
+}
+
+bool DetumbleController::selectStrategy(Io& io, const Settings& settings, double& angular_velocity_magnitude_deg_sec) {
+    // Configure strategy selector with updated thresholds
+    this->m_strategy_selector.configure(toDetumbleScalar(settings.bdot_max_threshold),
+                                        toDetumbleScalar(settings.deadband_upper_threshold),
+                                        toDetumbleScalar(settings.deadband_lower_threshold));
+
+    if (!io.angularVelocityMagnitude(angular_velocity_magnitude_deg_sec)) {
+        return false;
+    }
+
+    this->m_strategy =
+        this->m_strategy_selector.fromAngularVelocityMagnitude(toDetumbleScalar(angular_velocity_magnitude_deg_sec));
+    return true;
+}
+
+void DetumbleController::stateExitSensingAngularVelocityActions(Io& io,
+                                                                const Settings& settings,
+                                                                double angular_velocity_magnitude_deg_sec) {
+    switch (this->m_strategy) {
+        case StrategySelector::IDLE:
+            // No detumbling required, remain in SENSING_ANGULAR_VELOCITY state
+            io.detumbleCompleted(angular_velocity_magnitude_deg_sec);
+            return;
+        case StrategySelector::BDOT:
+            if (settings.continuous) {
+                this->stateEnterActuatingBDotContinuousActions(io);
+                this->m_state = ACTUATING_BDOT_CONTINUOUS;
+            } else {
+                this->m_state = SENSING_MAGNETIC_FIELD;
+            }
+            break;
+        case StrategySelector::HYSTERESIS:
+            this->m_state = ACTUATING_HYSTERESIS;
+            break;
+    }
+
+    io.detumbleStarted(angular_velocity_magnitude_deg_sec);
+}
+
+bool DetumbleController::getMagneticField(Io& io, BDot::Vector& magnetic_field, std::chrono::microseconds& timestamp) {
+    Field field;
+    if (!io.magneticField(field, timestamp)) {
+        return false;
+    }
+    magnetic_field = {toDetumbleScalar(field[0]), toDetumbleScalar(field[1]), toDetumbleScalar(field[2])};
+    return true;
+}
+
+bool DetumbleController::configureBDot(Io& io, const Settings& settings) {
+    std::chrono::microseconds sampling_period;
+    if (!io.magneticFieldSamplingPeriod(sampling_period)) {
+        return false;
+    }
+    this->m_bdot.configure(toDetumbleScalar(settings.gain), sampling_period);
+    this->m_bdot.setDerivativeMethod(settings.derivative_method);
+    return true;
+}
+
+void DetumbleController::stateSensingMagneticFieldActions(Io& io) {
+    BDot::Vector magnetic_field;
+    std::chrono::microseconds timestamp;
+    if (!this->getMagneticField(io, magnetic_field, timestamp)) {
+        return;
+    }
+
+    this->m_bdot.addSample(magnetic_field, timestamp);
+
+    if (this->m_bdot.samplingComplete()) {
+        // Sampling complete, transition to ACTUATING_BDOT state
+        this->m_state = ACTUATING_BDOT;
+    }
+}
+
+void DetumbleController::stateActuatingBDotActions(Io& io) {
+    Settings settings = io.settings();
+
+    // On first call after state transition configure B-Dot and record the torque start time
+    if (this->m_torque_start_time.count() == 0 && this->configureBDot(io, settings)) {
+        this->m_torque_start_time = io.currentTime();
+    }
+
+    // Perform torqueing action
+    io.startMagnetorquers(this->m_bdot.getMagneticMoment());
+
+    // Remain in ACTUATING_BDOT state until the torque duration has elapsed
+    if (io.currentTime() - this->m_torque_start_time <= settings.torque_duration) {
+        return;
+    }
+
+    // Empty B-Dot sample set for next detumble cycle
+    this->m_bdot.emptySampleSet();
+
+    io.stopMagnetorquers();
+    this->m_torque_start_time = std::chrono::microseconds(0);
+    this->m_state = COOLDOWN;
+}
+
+void DetumbleController::stateActuatingHysteresisActions(Io& io) {
+    // Perform torqueing action
+    switch (io.settings().hysteresis_axis) {
+        case X_AXIS:
+            io.startMagnetorquers(DriveLevels{127, -127, 0, 0, 0});
+            break;
+        case Y_AXIS:
+            io.startMagnetorquers(DriveLevels{0, 0, 127, -127, 0});
+            break;
+        case Z_AXIS:
+            io.startMagnetorquers(DriveLevels{0, 0, 0, 0, -127});
+            break;
+    }
+
+    this->m_state = COOLDOWN;
+}
+
+void DetumbleController::stateActuatingBDotContinuousActions(Io& io) {
+    Settings settings = io.settings();
+    std::chrono::microseconds current_time = io.currentTime();
+
+    if (this->m_continuous_torquing) {
+        // Keep torquing until the torque duration has elapsed
+        if (current_time - this->m_torque_start_time <= settings.torque_duration) {
+            return;
+        }
+
+        // Open a measurement gap so the coil fields do not corrupt the next magnetic field sample
+        io.stopMagnetorquers();
+        this->m_continuous_torquing = false;
+        this->m_torque_start_time = std::chrono::microseconds(0);
+        this->m_cooldown_start_time = current_time;
+        return;
+    }
+
+    // Wait out the measurement gap
+    if (current_time - this->m_cooldown_start_time <= settings.cooldown_duration) {
+        return;
+    }
+
+    // Re-evaluate the strategy every gap so detumble completion or a spin-up is still detected
+    double angular_velocity_magnitude_deg_sec = 0.0;
+    if (!this->selectStrategy(io, settings, angular_velocity_magnitude_deg_sec)) {
+        return;
+    }
+    if (this->m_strategy != StrategySelector::BDOT) {
+        // Hand over to the regular strategy transitions from SENSING_ANGULAR_VELOCITY
+        this->stateExitActuatingBDotContinuousActions(io);
+        this->m_state = SENSING_ANGULAR_VELOCITY;
+        this->stateExitSensingAngularVelocityActions(io, settings, angular_velocity_magnitude_deg_sec);
+        return;
+    }
+
+    // Get magnetic field, waiting for a conversion taken after the coils were turned off
+    BDot::Vector magnetic_field;
+    std::chrono::microseconds timestamp;
+    if (!this->getMagneticField(io, magnetic_field, timestamp) || timestamp < this->m_cooldown_start_time) {
+        return;
+    }
+
+    // Refresh gain and sampling period so parameter updates apply without leaving the state
+    if (!this->configureBDot(io, settings)) {
+        return;
+    }
+
+    // Stream the sample into the B-Dot window, replacing the oldest sample
+    this->m_bdot.addSample(magnetic_field, timestamp);
+
+    // Torque with the updated dipole. Until the first window fills the coils stay off for the torque duration so
+    // that samples remain evenly spaced.
+    if (this->m_bdot.samplingComplete()) {
+        io.startMagnetorquers(this->m_bdot.getMagneticMoment());
+    }
+
+    this->m_continuous_torquing = true;
+    this->m_torque_start_time = current_time;
+    this->m_cooldown_start_time = std::chrono::microseconds(0);
+}
+
+void DetumbleController::stateEnterActuatingBDotContinuousActions(Io& io) {
+    // Start from an empty streaming window, coils are already off after SENSING_ANGULAR_VELOCITY
+    this->m_bdot.setSamplingMode(BDot::SamplingMode::STREAMING);
+    this->m_continuous_torquing = false;
+    this->m_torque_start_time = std::chrono::microseconds(0);
+    this->m_cooldown_start_time = io.currentTime();
+}
+
+void DetumbleController::stateExitActuatingBDotContinuousActions(Io& io) {
+    io.stopMagnetorquers();
+
+    // Return B-Dot to batch sampling for the SENSING_MAGNETIC_FIELD path
+    this->m_bdot.setSamplingMode(BDot::SamplingMode::BATCH);
+
+    // Reset timing so the next state starts fresh
+    this->m_continuous_torquing = false;
+    this->m_torque_start_time = std::chrono::microseconds(0);
+    this->m_cooldown_start_time = std::chrono::microseconds(0);
+}
+
+}  // namespace Components
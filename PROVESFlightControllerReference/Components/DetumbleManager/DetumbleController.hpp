@@ -0,0 +1,187 @@
+// ======================================================================
+// \title  DetumbleController.hpp
+// \brief  hpp file for DetumbleController implementation class
+// ======================================================================
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "BDot.hpp"
+#include "MagnetorquerArray.hpp"
+#include "StrategySelector.hpp"
+
+namespace Components {
+
+//! DetumbleManager AUTO mode state machine
+//!
+//! Time, parameters, sensors and coil drivers are reached through Io, so the same state machine runs in
+//! DetumbleManager and in the closed-loop simulator on the host.
+class DetumbleController {
+  public:
+    // ----------------------------------------------------------------------
+    //  Public types
+    // ----------------------------------------------------------------------
+
+    //! Detumble states, in DetumbleState order
+    enum State {
+        COOLDOWN = 0,                   //!< Waiting for the coil fields to decay
+        SENSING_ANGULAR_VELOCITY = 1,   //!< Selecting a strategy from the angular velocity
+        SENSING_MAGNETIC_FIELD = 2,     //!< Filling the B-Dot sample set
+        ACTUATING_BDOT = 3,             //!< Torquing with the B-Dot dipole
+        ACTUATING_HYSTERESIS = 4,       //!< Torquing one axis at full drive
+        ACTUATING_BDOT_CONTINUOUS = 5,  //!< Alternating B-Dot torque and measurement gaps
+    };
+
+    //! Axis driven by hysteresis detumbling, in HysteresisAxis order
+    enum HysteresisAxis {
+        X_AXIS = 0,
+        Y_AXIS = 1,
+        Z_AXIS = 2,
+    };
+
+    using DriveLevels = std::array<std::int8_t, MagnetorquerArray::COIL_COUNT>;  //!< Drive level per coil
+    using Field = std::array<double, 3>;                                         //!< Magnetic field vector in gauss
+
+    //! Parameter values the state machine reads
+    struct Settings {
+        double gain;                                  //!< B-Dot gain constant in A⋅m²⋅s/G
+        std::chrono::microseconds torque_duration;    //!< Time the coils are driven per actuation
+        std::chrono::microseconds cooldown_duration;  //!< Time the coils are off before sensing
+        double bdot_max_threshold;                    //!< B-Dot maximum rotational threshold in deg/s
+        double deadband_upper_threshold;              //!< Upper deadband rotational threshold in deg/s
+        double deadband_lower_threshold;              //!< Lower deadband rotational threshold in deg/s
+        bool continuous;                              //!< Whether B-Dot streams samples between torque pulses
+        BDot::DerivativeMethod derivative_method;     //!< How the field derivative is estimated
+        HysteresisAxis hysteresis_axis;               //!< Axis driven by hysteresis detumbling
+    };
+
+    //! Everything the state machine needs from the spacecraft
+    class Io {
+      public:
+        virtual ~Io() = default;
+
+        //! Current time, never zero
+        virtual std::chrono::microseconds currentTime() = 0;
+
+        //! Current parameter values
+        virtual Settings settings() = 0;
+
+        //! Angular velocity magnitude in deg/s, false when it could not be read
+        virtual bool angularVelocityMagnitude(double& angular_velocity_magnitude_deg_sec) = 0;
+
+        //! Next magnetic field sample and the time it was taken, false when none is available
+        virtual bool magneticField(Field& magnetic_field, std::chrono::microseconds& timestamp) = 0;
+
+        //! Magnetometer sampling period, false when it could not be read
+        virtual bool magneticFieldSamplingPeriod(std::chrono::microseconds& sampling_period) = 0;
+
+        //! Drive the coils to produce a magnetic moment in A·m²
+        virtual void startMagnetorquers(const BDot::Vector& magnetic_moment) = 0;
+
+        //! Drive the coils at fixed levels
+        virtual void startMagnetorquers(const DriveLevels& drive_levels) = 0;
+
+        //! Turn the coils off
+        virtual void stopMagnetorquers() = 0;
+
+        //! A detumble strategy was selected at the given angular velocity magnitude in deg/s
+        virtual void detumbleStarted(double angular_velocity_magnitude_deg_sec) = 0;
+
+        //! No detumbling is needed at the given angular velocity magnitude in deg/s
+        virtual void detumbleCompleted(double angular_velocity_magnitude_deg_sec) = 0;
+    };
+
+  public:
+    // ----------------------------------------------------------------------
+    // Component construction and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct DetumbleController object
+    DetumbleController();
+
+    //! Destroy DetumbleController object
+    ~DetumbleController();
+
+  public:
+    // ----------------------------------------------------------------------
+    //  Public helper methods
+    // ----------------------------------------------------------------------
+
+    //! Perform the actions of the current state once per rate group cycle
+    void run(Io& io);
+
+    //! Feed a newly converted magnetic field into the sample set while in SENSING_MAGNETIC_FIELD
+    void magneticFieldReady(Io& io);
+
+    //! Turn the coils off and return to COOLDOWN while detumbling is disabled
+    void disable(Io& io);
+
+    //! Current state
+    State getState() const;
+
+    //! Most recently selected strategy
+    StrategySelector::Strategy getStrategy() const;
+
+  private:
+    // ----------------------------------------------------------------------
+    //  Private helper methods
+    // ----------------------------------------------------------------------
+
+    //! Actions to perform in the COOLDOWN state
+    void stateCooldownActions(Io& io);
+
+    //! Actions to perform in the SENSING_ANGULAR_VELOCITY state
+    void stateSensingAngularVelocityActions(Io& io);
+
+    //! Select the strategy from the angular velocity, false when it could not be read
+    bool selectStrategy(Io& io, const Settings& settings, double& angular_velocity_magnitude_deg_sec);
+
+    //! Actions to perform when exiting the SENSING_ANGULAR_VELOCITY state
+    void stateExitSensingAngularVelocityActions(Io& io,
+                                                const Settings& settings,
+                                                double angular_velocity_magnitude_deg_sec);
+
+    //! Get the next magnetic field sample in the B-Dot scalar, false when none is available
+    bool getMagneticField(Io& io, BDot::Vector& magnetic_field, std::chrono::microseconds& timestamp);
+
+    //! Configure the B-Dot gain, sampling period and derivative method, false when the period could not be read
+    bool configureBDot(Io& io, const Settings& settings);
+
+    //! Actions to perform in the SENSING_MAGNETIC_FIELD state
+    void stateSensingMagneticFieldActions(Io& io);
+
+    //! Actions to perform in the ACTUATING_BDOT state
+    void stateActuatingBDotActions(Io& io);
+
+    //! Actions to perform in the ACTUATING_HYSTERESIS state
+    void stateActuatingHysteresisActions(Io& io);
+
+    //! Actions to perform in the ACTUATING_BDOT_CONTINUOUS state
+    void stateActuatingBDotContinuousActions(Io& io);
+
+    //! Actions to perform when entering the ACTUATING_BDOT_CONTINUOUS state
+    void stateEnterActuatingBDotContinuousActions(Io& io);
+
+    //! Actions to perform when exiting the ACTUATING_BDOT_CONTINUOUS state
+    void stateExitActuatingBDotContinuousActions(Io& io);
+
+  private:
+    // ----------------------------------------------------------------------
+    //  Private member variables
+    // ----------------------------------------------------------------------
+
+    BDot m_bdot;                           //!< B-Dot detumble algorithm class
+    StrategySelector m_strategy_selector;  //!< Detumble helper class
+
+    State m_state = COOLDOWN;                                        //!< Detumble state
+    StrategySelector::Strategy m_strategy = StrategySelector::IDLE;  //!< Detumble strategy
+
+    std::chrono::microseconds m_cooldown_start_time{0};  //!< Cooldown start time, zero when not cooling down
+    std::chrono::microseconds m_torque_start_time{0};    //!< Torque start time, zero when not torquing
+    bool m_continuous_torquing = false;                  //!< Whether continuous B-Dot is torquing or in a gap
+};
+
+}  // namespace Components
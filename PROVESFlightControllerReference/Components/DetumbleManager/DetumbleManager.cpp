@@ -14,14 +14,7 @@ namespace Components {
 // ----------------------------------------------------------------------
 
 DetumbleManager ::DetumbleManager(const char* const compName)
-    : DetumbleManagerComponentBase(compName),
-      m_bdot(),
-      m_strategy_selector(),
-      m_x_plus_magnetorquer(),
-      m_x_minus_magnetorquer(),
-      m_y_plus_magnetorquer(),
-      m_y_minus_magnetorquer(),
-      m_z_minus_magnetorquer() {
+    : DetumbleManagerComponentBase(compName), m_controller() {
     // Compile-time verification that internal CoilShape enum matches FPP-generated enum
     static_assert(
         static_cast<U8>(Magnetorquer::CoilShape::CIRCULAR) == static_cast<U8>(Components::CoilShape::CIRCULAR),
@@ -40,6 +33,13 @@ DetumbleManager ::DetumbleManager(const char* const compName)
     static_assert(static_cast<U8>(StrategySelector::Strategy::HYSTERESIS) ==
                       static_cast<U8>(Components::DetumbleStrategy::HYSTERESIS),
                   "Internal DetumbleStrategy::HYSTERESIS value must match FPP enum");
+
+    // Compile-time verification that the controller enums match FPP-generated enums
+    static_assert(static_cast<U8>(DetumbleController::ACTUATING_BDOT_CONTINUOUS) ==
+                      static_cast<U8>(Components::DetumbleState::ACTUATING_BDOT_CONTINUOUS),
+                  "Internal DetumbleState values must match FPP enum");
+    static_assert(static_cast<U8>(DetumbleController::Z_AXIS) == static_cast<U8>(Components::HysteresisAxis::Z_AXIS),
+                  "Internal HysteresisAxis values must match FPP enum");
 }
 
 DetumbleManager ::~DetumbleManager() {}
@@ -49,37 +49,35 @@ DetumbleManager ::~DetumbleManager() {}
 // ----------------------------------------------------------------------
 
 void DetumbleManager ::run_handler(FwIndexType portNum, U32 context) {
+    // Handle the conversions pushed since the last run, each one by magneticFieldIn_handler
+    if (this->m_runs_since_data_ready < DATA_READY_STALE_RUNS) {
+        this->m_runs_since_data_ready++;
+    }
+    while (this->doDispatch() == MSG_DISPATCH_OK) {
+    }
+
     // Telemeter mode
     this->tlmWrite_Mode(this->m_mode);
 
     // Telemeter state
-    this->tlmWrite_State(this->m_state);
+    this->tlmWrite_State(static_cast<DetumbleState::T>(this->m_controller.getState()));
 
     // If detumble is disabled, ensure magnetorquers are off and exit early
     if (this->m_mode == DetumbleMode::DISABLED) {
-        if (this->m_state != DetumbleState::COOLDOWN) {
-            this->stopMagnetorquers();
-            this->m_state = DetumbleState::COOLDOWN;  // Reset state to COOLDOWN when re-enabled
-        }
+        this->m_controller.disable(*this);
         return;
     }
 
-    switch (this->m_state) {
-        case DetumbleState::COOLDOWN:
-            this->stateCooldownActions();
-            return;
-        case DetumbleState::SENSING_ANGULAR_VELOCITY:
-            this->stateSensingAngularVelocityActions();
-            return;
-        case DetumbleState::SENSING_MAGNETIC_FIELD:
-            this->stateSensingMagneticFieldActions();
-            return;
-        case DetumbleState::ACTUATING_BDOT:
-            this->stateActuatingBDotActions();
-            return;
-        case DetumbleState::ACTUATING_HYSTERESIS:
-            this->stateActuatingHysteresisActions();
-            return;
+    this->m_controller.run(*this);
+}
+
+void DetumbleManager ::magneticFieldIn_handler(FwIndexType portNum, const Drv::MagneticField& magneticField) {
+    this->m_data_ready_field = magneticField;
+    this->m_data_ready_pending = true;
+    this->m_runs_since_data_ready = 0;
+
+    if (this->m_mode != DetumbleMode::DISABLED) {
+        this->m_controller.magneticFieldReady(*this);
     }
 }
 
@@ -121,97 +119,110 @@ void DetumbleManager ::configure() {
     F64 y_turns = this->paramGet_Y_TURNS(isValid);
     F64 z_turns = this->paramGet_Z_TURNS(isValid);
 
+    // Build the coils in locals so the control loop never sees a partly updated set
+    Magnetorquer x_plus;
+    Magnetorquer x_minus;
+    Magnetorquer y_plus;
+    Magnetorquer y_minus;
+    Magnetorquer z_minus;
+
     // X+ Coil
-    m_x_plus_magnetorquer.m_voltage = this->paramGet_X_PLUS_VOLTAGE(isValid);
-    m_x_plus_magnetorquer.m_resistance = this->paramGet_X_PLUS_RESISTANCE(isValid);
-    m_x_plus_magnetorquer.m_turns = x_turns;
-    m_x_plus_magnetorquer.m_direction_sign = Magnetorquer::DirectionSign::POSITIVE;
+    x_plus.m_voltage = this->paramGet_X_PLUS_VOLTAGE(isValid);
+    x_plus.m_resistance = this->paramGet_X_PLUS_RESISTANCE(isValid);
+    x_plus.m_turns = x_turns;
+    x_plus.m_direction_sign = Magnetorquer::DirectionSign::POSITIVE;
     CoilShape xPlus_shape = this->paramGet_X_PLUS_SHAPE(isValid);
-    m_x_plus_magnetorquer.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(xPlus_shape));
-    m_x_plus_magnetorquer.m_width = this->paramGet_X_PLUS_WIDTH(isValid);
-    m_x_plus_magnetorquer.m_length = this->paramGet_X_PLUS_LENGTH(isValid);
+    x_plus.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(xPlus_shape));
+    x_plus.m_width = this->paramGet_X_PLUS_WIDTH(isValid);
+    x_plus.m_length = this->paramGet_X_PLUS_LENGTH(isValid);
 
     // X- Coil
-    m_x_minus_magnetorquer.m_voltage = this->paramGet_X_MINUS_VOLTAGE(isValid);
-    m_x_minus_magnetorquer.m_resistance = this->paramGet_X_MINUS_RESISTANCE(isValid);
-    m_x_minus_magnetorquer.m_turns = x_turns;
-    m_x_minus_magnetorquer.m_direction_sign = Magnetorquer::DirectionSign::NEGATIVE;
+    x_minus.m_voltage = this->paramGet_X_MINUS_VOLTAGE(isValid);
+    x_minus.m_resistance = this->paramGet_X_MINUS_RESISTANCE(isValid);
+    x_minus.m_turns = x_turns;
+    x_minus.m_direction_sign = Magnetorquer::DirectionSign::NEGATIVE;
     CoilShape xMinus_shape = this->paramGet_X_MINUS_SHAPE(isValid);
-    m_x_minus_magnetorquer.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(xMinus_shape));
-    m_x_minus_magnetorquer.m_width = this->paramGet_X_MINUS_WIDTH(isValid);
-    m_x_minus_magnetorquer.m_length = this->paramGet_X_MINUS_LENGTH(isValid);
+    x_minus.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(xMinus_shape));
+    x_minus.m_width = this->paramGet_X_MINUS_WIDTH(isValid);
+    x_minus.m_length = this->paramGet_X_MINUS_LENGTH(isValid);
 
     // Y+ Coil
-    m_y_plus_magnetorquer.m_voltage = this->paramGet_Y_PLUS_VOLTAGE(isValid);
-    m_y_plus_magnetorquer.m_resistance = this->paramGet_Y_PLUS_RESISTANCE(isValid);
-    m_y_plus_magnetorquer.m_turns = y_turns;
-    m_y_plus_magnetorquer.m_direction_sign = Magnetorquer::DirectionSign::POSITIVE;
+    y_plus.m_voltage = this->paramGet_Y_PLUS_VOLTAGE(isValid);
+    y_plus.m_resistance = this->paramGet_Y_PLUS_RESISTANCE(isValid);
+    y_plus.m_turns = y_turns;
+    y_plus.m_direction_sign = Magnetorquer::DirectionSign::POSITIVE;
     CoilShape yPlus_shape = this->paramGet_Y_PLUS_SHAPE(isValid);
-    m_y_plus_magnetorquer.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(yPlus_shape));
-    m_y_plus_magnetorquer.m_width = this->paramGet_Y_PLUS_WIDTH(isValid);
-    m_y_plus_magnetorquer.m_length = this->paramGet_Y_PLUS_LENGTH(isValid);
+    y_plus.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(yPlus_shape));
+    y_plus.m_width = this->paramGet_Y_PLUS_WIDTH(isValid);
+    y_plus.m_length = this->paramGet_Y_PLUS_LENGTH(isValid);
 
     // Y- Coil
-    m_y_minus_magnetorquer.m_voltage = this->paramGet_Y_MINUS_VOLTAGE(isValid);
-    m_y_minus_magnetorquer.m_resistance = this->paramGet_Y_MINUS_RESISTANCE(isValid);
-    m_y_minus_magnetorquer.m_turns = y_turns;
-    m_y_minus_magnetorquer.m_direction_sign = Magnetorquer::DirectionSign::NEGATIVE;
+    y_minus.m_voltage = this->paramGet_Y_MINUS_VOLTAGE(isValid);
+    y_minus.m_resistance = this->paramGet_Y_MINUS_RESISTANCE(isValid);
+    y_minus.m_turns = y_turns;
+    y_minus.m_direction_sign = Magnetorquer::DirectionSign::NEGATIVE;
     CoilShape yMinus_shape = this->paramGet_Y_MINUS_SHAPE(isValid);
-    m_y_minus_magnetorquer.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(yMinus_shape));
-    m_y_minus_magnetorquer.m_width = this->paramGet_Y_MINUS_WIDTH(isValid);
-    m_y_minus_magnetorquer.m_length = this->paramGet_Y_MINUS_LENGTH(isValid);
+    y_minus.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(yMinus_shape));
+    y_minus.m_width = this->paramGet_Y_MINUS_WIDTH(isValid);
+    y_minus.m_length = this->paramGet_Y_MINUS_LENGTH(isValid);
 
     // Z- Coil
-    m_z_minus_magnetorquer.m_voltage = this->paramGet_Z_MINUS_VOLTAGE(isValid);
-    m_z_minus_magnetorquer.m_resistance = this->paramGet_Z_MINUS_RESISTANCE(isValid);
-    m_z_minus_magnetorquer.m_turns = z_turns;
-    m_z_minus_magnetorquer.m_direction_sign = Magnetorquer::DirectionSign::NEGATIVE;
+    z_minus.m_voltage = this->paramGet_Z_MINUS_VOLTAGE(isValid);
+    z_minus.m_resistance = this->paramGet_Z_MINUS_RESISTANCE(isValid);
+    z_minus.m_turns = z_turns;
+    z_minus.m_direction_sign = Magnetorquer::DirectionSign::NEGATIVE;
     CoilShape zMinus_shape = this->paramGet_Z_MINUS_SHAPE(isValid);
-    m_z_minus_magnetorquer.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(zMinus_shape));
-    m_z_minus_magnetorquer.m_diameter = this->paramGet_Z_MINUS_DIAMETER(isValid);
+    z_minus.m_shape = static_cast<Magnetorquer::CoilShape>(static_cast<CoilShape::T>(zMinus_shape));
+    z_minus.m_diameter = this->paramGet_Z_MINUS_DIAMETER(isValid);
+
+    // Precompute the coil gains so actuation is only a few multiplies per coil
+    MagnetorquerArray magnetorquer_array;
+    magnetorquer_array.configure(MagnetorquerArray::X_PLUS, 0, x_plus);
+    magnetorquer_array.configure(MagnetorquerArray::X_MINUS, 0, x_minus);
+    magnetorquer_array.configure(MagnetorquerArray::Y_PLUS, 1, y_plus);
+    magnetorquer_array.configure(MagnetorquerArray::Y_MINUS, 1, y_minus);
+    magnetorquer_array.configure(MagnetorquerArray::Z_MINUS, 2, z_minus);
+
+    Os::ScopeLock lock(this->m_magnetorquer_array_lock);
+    this->m_magnetorquer_array = magnetorquer_array;
 }
 
 // ----------------------------------------------------------------------
 //  Private helper methods
 // ----------------------------------------------------------------------
 
-void DetumbleManager ::startMagnetorquers(I8 x_plus_drive_level,
-                                          I8 x_minus_drive_level,
-                                          I8 y_plus_drive_level,
-                                          I8 y_minus_drive_level,
-                                          I8 z_minus_drive_level) {
-    if (isConnected_xPlusStart_OutputPort(0)) {
-        this->xPlusStart_out(0, x_plus_drive_level);
-    }
-    if (isConnected_xMinusStart_OutputPort(0)) {
-        this->xMinusStart_out(0, x_minus_drive_level);
-    }
-    if (isConnected_yPlusStart_OutputPort(0)) {
-        this->yPlusStart_out(0, y_plus_drive_level);
-    }
-    if (isConnected_yMinusStart_OutputPort(0)) {
-        this->yMinusStart_out(0, y_minus_drive_level);
-    }
-    if (isConnected_zMinusStart_OutputPort(0)) {
-        this->zMinusStart_out(0, z_minus_drive_level);
-    }
-}
-
-void DetumbleManager ::stopMagnetorquers() {
-    if (isConnected_xPlusStop_OutputPort(0)) {
-        this->xPlusStop_out(0);
-    }
-    if (isConnected_xMinusStop_OutputPort(0)) {
-        this->xMinusStop_out(0);
-    }
-    if (isConnected_yPlusStop_OutputPort(0)) {
-        this->yPlusStop_out(0);
-    }
-    if (isConnected_yMinusStop_OutputPort(0)) {
-        this->yMinusStop_out(0);
-    }
-    if (isConnected_zMinusStop_OutputPort(0)) {
-        this->zMinusStop_out(0);
+bool DetumbleManager ::isCoilParameter(FwPrmIdType id) {
+    switch (id) {
+        case DetumbleManager::PARAMID_X_TURNS:
+        case DetumbleManager::PARAMID_Y_TURNS:
+        case DetumbleManager::PARAMID_Z_TURNS:
+        case DetumbleManager::PARAMID_X_PLUS_VOLTAGE:
+        case DetumbleManager::PARAMID_X_PLUS_RESISTANCE:
+        case DetumbleManager::PARAMID_X_PLUS_SHAPE:
+        case DetumbleManager::PARAMID_X_PLUS_WIDTH:
+        case DetumbleManager::PARAMID_X_PLUS_LENGTH:
+        case DetumbleManager::PARAMID_X_MINUS_VOLTAGE:
+        case DetumbleManager::PARAMID_X_MINUS_RESISTANCE:
+        case DetumbleManager::PARAMID_X_MINUS_SHAPE:
+        case DetumbleManager::PARAMID_X_MINUS_WIDTH:
+        case DetumbleManager::PARAMID_X_MINUS_LENGTH:
+        case DetumbleManager::PARAMID_Y_PLUS_VOLTAGE:
+        case DetumbleManager::PARAMID_Y_PLUS_RESISTANCE:
+        case DetumbleManager::PARAMID_Y_PLUS_SHAPE:
+        case DetumbleManager::PARAMID_Y_PLUS_WIDTH:
+        case DetumbleManager::PARAMID_Y_PLUS_LENGTH:
+        case DetumbleManager::PARAMID_Y_MINUS_VOLTAGE:
+        case DetumbleManager::PARAMID_Y_MINUS_RESISTANCE:
+        case DetumbleManager::PARAMID_Y_MINUS_SHAPE:
+        case DetumbleManager::PARAMID_Y_MINUS_WIDTH:
+        case DetumbleManager::PARAMID_Y_MINUS_LENGTH:
+        case DetumbleManager::PARAMID_Z_MINUS_VOLTAGE:
+        case DetumbleManager::PARAMID_Z_MINUS_RESISTANCE:
+        case DetumbleManager::PARAMID_Z_MINUS_SHAPE:
+        case DetumbleManager::PARAMID_Z_MINUS_DIAMETER:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -265,6 +276,22 @@ void DetumbleManager ::parameterUpdated(FwPrmIdType id) {
                 this->tlmWrite_HysteresisAxisParam(parameter);
             }
         } break;
+        case DetumbleManager::PARAMID_BDOT_CONTROL_MODE: {
+            Fw::ParamValid is_valid;
+            BDotControlMode parameter = this->paramGet_BDOT_CONTROL_MODE(is_valid);
+            if ((is_valid != Fw::ParamValid::INVALID) && (is_valid != Fw::ParamValid::UNINIT)) {
+                this->log_ACTIVITY_HI_BdotControlModeParamSet(parameter);
+                this->tlmWrite_BdotControlModeParam(parameter);
+            }
+        } break;
+        case DetumbleManager::PARAMID_BDOT_DERIVATIVE_METHOD: {
+            Fw::ParamValid is_valid;
+            BDotDerivativeMethod parameter = this->paramGet_BDOT_DERIVATIVE_METHOD(is_valid);
+            if ((is_valid != Fw::ParamValid::INVALID) && (is_valid != Fw::ParamValid::UNINIT)) {
+                this->log_ACTIVITY_HI_BdotDerivativeMethodParamSet(parameter);
+                this->tlmWrite_BdotDerivativeMethodParam(parameter);
+            }
+        } break;
         case DetumbleManager::PARAMID_TORQUE_DURATION: {
             Fw::ParamValid is_valid;
             Fw::TimeIntervalValue parameter = this->paramGet_TORQUE_DURATION(is_valid);
@@ -493,226 +520,162 @@ void DetumbleManager ::parameterUpdated(FwPrmIdType id) {
             FW_ASSERT(0);
             break;  // Fallthrough from assert (static analysis)
     }
-}
-
-void DetumbleManager ::stateCooldownActions() {
-    Fw::ParamValid isValid;
-
-    // Perform actions upon entering COOLDOWN state
-    this->stateEnterCooldownActions();
-
-    // Get cooldown duration from parameter
-    Fw::TimeIntervalValue cooldown_duration_param = this->paramGet_COOLDOWN_DURATION(isValid);
-
-    // Calculate elapsed torquing duration
-    Fw::Time current_time = this->getTime();
-    Fw::TimeInterval cooldown_duration = Fw::TimeInterval(this->m_cooldown_start_time, current_time);
-    Fw::TimeInterval required_cooldown_duration(cooldown_duration_param.get_seconds(),
-                                                cooldown_duration_param.get_useconds());
 
-    // Check if cooldown duration has elapsed and exit COOLDOWN state
-    if (Fw::TimeInterval::compare(cooldown_duration, required_cooldown_duration) == Fw::TimeInterval::GT) {
-        this->stateExitCooldownActions();
+    // Rebuild the coil gain table so coil parameter updates apply to the next actuation
+    if (isCoilParameter(id)) {
+        this->configure();
     }
 }
 
-void DetumbleManager ::stateEnterCooldownActions() {
-    // On first call after state transition
-    if (this->m_cooldown_start_time == Fw::ZERO_TIME) {
-        // Record cooldown start time
-        this->m_cooldown_start_time = this->getTime();
+bool DetumbleManager ::getMagneticField(Drv::MagneticField& magnetic_field) {
+    // While conversions are pushed each one is used once, and a run without a new one waits for the next
+    if (this->m_runs_since_data_ready < DATA_READY_STALE_RUNS) {
+        if (!this->m_data_ready_pending) {
+            return false;
+        }
+        this->m_data_ready_pending = false;
+        magnetic_field = this->m_data_ready_field;
+        return true;
     }
-}
 
-void DetumbleManager ::stateExitCooldownActions() {
-    // Reset cooldown start time
-    this->m_cooldown_start_time = Fw::ZERO_TIME;
-
-    // Transition to SENSING state
-    this->m_state = DetumbleState::SENSING_ANGULAR_VELOCITY;
-}
-
-void DetumbleManager ::stateSensingAngularVelocityActions() {
     Fw::Success condition;
-
-    // Perform actions upon entering SENSING_ANGULAR_VELOCITY state
-    this->stateEnterSensingAngularVelocityActions();
-
-    // Get angular velocity
-    F64 angular_velocity_magnitude_deg_sec =
-        this->angularVelocityMagnitudeGet_out(0, condition, AngularUnit::DEG_PER_SEC);
+    magnetic_field = this->magneticFieldGet_out(0, condition);
     if (condition != Fw::Success::SUCCESS) {
-        this->log_WARNING_LO_AngularVelocityRetrievalFailed();
-        return;
+        this->log_WARNING_LO_MagneticFieldRetrievalFailed();
+        return false;
     }
-    this->log_WARNING_LO_AngularVelocityRetrievalFailed_ThrottleClear();
-
-    this->tlmWrite_AngularVelocityMagnitude(angular_velocity_magnitude_deg_sec);
+    this->log_WARNING_LO_MagneticFieldRetrievalFailed_ThrottleClear();
+    return true;
+}
 
-    // Select detumble strategy based on angular velocity
-    StrategySelector::Strategy detumble_strategy =
-        this->m_strategy_selector.fromAngularVelocityMagnitude(angular_velocity_magnitude_deg_sec);
-    this->m_strategy = static_cast<DetumbleStrategy::T>(detumble_strategy);
+// ----------------------------------------------------------------------
+//  DetumbleController::Io implementations
+// ----------------------------------------------------------------------
 
-    // Perform actions upon exiting SENSING_ANGULAR_VELOCITY state
-    this->stateExitSensingAngularVelocityActions(angular_velocity_magnitude_deg_sec);
+std::chrono::microseconds DetumbleManager ::currentTime() {
+    Fw::Time current_time = this->getTime();
+    return std::chrono::microseconds(static_cast<U64>(current_time.getSeconds()) * 1000000 +
+                                     current_time.getUSeconds());
 }
 
-void DetumbleManager ::stateEnterSensingAngularVelocityActions() {
+DetumbleController::Settings DetumbleManager ::settings() {
     Fw::ParamValid isValid;
+    DetumbleController::Settings settings;
 
-    // Get angular velocity thresholds from parameters
-    F64 bdot_max_threshold = this->paramGet_BDOT_MAX_THRESHOLD(isValid);
-    F64 deadband_upper_threshold = this->paramGet_DEADBAND_UPPER_THRESHOLD(isValid);
-    F64 deadband_lower_threshold = this->paramGet_DEADBAND_LOWER_THRESHOLD(isValid);
+    settings.gain = this->paramGet_GAIN(isValid);
 
-    // Configure strategy selector with updated thresholds
-    this->m_strategy_selector.configure(bdot_max_threshold, deadband_upper_threshold, deadband_lower_threshold);
-}
+    Fw::TimeIntervalValue torque_duration = this->paramGet_TORQUE_DURATION(isValid);
+    settings.torque_duration = std::chrono::microseconds(static_cast<U64>(torque_duration.get_seconds()) * 1000000 +
+                                                         torque_duration.get_useconds());
+    Fw::TimeIntervalValue cooldown_duration = this->paramGet_COOLDOWN_DURATION(isValid);
+    settings.cooldown_duration = std::chrono::microseconds(
+        static_cast<U64>(cooldown_duration.get_seconds()) * 1000000 + cooldown_duration.get_useconds());
 
-void DetumbleManager ::stateExitSensingAngularVelocityActions(F64 angular_velocity_magnitude_deg_sec) {
-    switch (this->m_strategy) {
-        case DetumbleStrategy::IDLE:
-            // No detumbling required, remain in SENSING_ANGULAR_VELOCITY state
-            // Telemeter detumble completion
-            this->log_ACTIVITY_LO_DetumbleCompleted(angular_velocity_magnitude_deg_sec);
-            this->log_ACTIVITY_LO_DetumbleStarted_ThrottleClear();
-            return;
-        case DetumbleStrategy::BDOT:
-            this->m_state = DetumbleState::SENSING_MAGNETIC_FIELD;
-            break;
-        case DetumbleStrategy::HYSTERESIS:
-            this->m_state = DetumbleState::ACTUATING_HYSTERESIS;
-            break;
+    settings.bdot_max_threshold = this->paramGet_BDOT_MAX_THRESHOLD(isValid);
+    settings.deadband_upper_threshold = this->paramGet_DEADBAND_UPPER_THRESHOLD(isValid);
+    settings.deadband_lower_threshold = this->paramGet_DEADBAND_LOWER_THRESHOLD(isValid);
+
+    settings.continuous = this->paramGet_BDOT_CONTROL_MODE(isValid) == BDotControlMode::CONTINUOUS;
+    settings.derivative_method = BDot::DerivativeMethod::CENTRAL_DIFFERENCE;
+    if (this->paramGet_BDOT_DERIVATIVE_METHOD(isValid) == BDotDerivativeMethod::LEAST_SQUARES) {
+        settings.derivative_method = BDot::DerivativeMethod::LEAST_SQUARES;
     }
+    settings.hysteresis_axis =
+        static_cast<DetumbleController::HysteresisAxis>(this->paramGet_HYSTERESIS_AXIS(isValid).e);
 
-    // Telemeter detumble start
-    this->log_ACTIVITY_LO_DetumbleStarted(angular_velocity_magnitude_deg_sec);
-    this->log_ACTIVITY_LO_DetumbleCompleted_ThrottleClear();
+    return settings;
 }
 
-void DetumbleManager ::stateSensingMagneticFieldActions() {
+bool DetumbleManager ::angularVelocityMagnitude(double& angular_velocity_magnitude_deg_sec) {
     Fw::Success condition;
-
-    // Get magnetic field
-    Drv::MagneticField magnetic_field = this->magneticFieldGet_out(0, condition);
+    angular_velocity_magnitude_deg_sec = this->angularVelocityMagnitudeGet_out(0, condition, AngularUnit::DEG_PER_SEC);
     if (condition != Fw::Success::SUCCESS) {
-        this->log_WARNING_LO_MagneticFieldRetrievalFailed();
-        return;
+        this->log_WARNING_LO_AngularVelocityRetrievalFailed();
+        return false;
     }
-    this->log_WARNING_LO_MagneticFieldRetrievalFailed_ThrottleClear();
-
-    // Add magnetic field sample to B-Dot controller
-    std::chrono::microseconds sample_time(magnetic_field.get_timestamp().get_seconds() * 1000000 +
-                                          magnetic_field.get_timestamp().get_useconds());
-    std::array<double, 3> magnetic_field_array = {magnetic_field.get_x(), magnetic_field.get_y(),
-                                                  magnetic_field.get_z()};
-    this->m_bdot.addSample(magnetic_field_array, sample_time);
+    this->log_WARNING_LO_AngularVelocityRetrievalFailed_ThrottleClear();
 
-    if (this->m_bdot.samplingComplete()) {
-        // Sampling complete, transition to ACTUATING_BDOT state
-        this->m_state = DetumbleState::ACTUATING_BDOT;
-    }
+    this->tlmWrite_AngularVelocityMagnitude(angular_velocity_magnitude_deg_sec);
+    return true;
 }
 
-void DetumbleManager ::stateActuatingBDotActions() {
-    // Enter ACTUATING_BDOT state
-    this->stateEnterActuatingBDotActions();
-
-    // Get magnetic moment
-    std::array<double, 3> magnetic_moment = this->m_bdot.getMagneticMoment();
-
-    // Perform torqueing action
-    this->startMagnetorquers(this->m_x_plus_magnetorquer.magneticMomentToCurrent(magnetic_moment[0]),
-                             this->m_x_minus_magnetorquer.magneticMomentToCurrent(magnetic_moment[0]),
-                             this->m_y_plus_magnetorquer.magneticMomentToCurrent(magnetic_moment[1]),
-                             this->m_y_minus_magnetorquer.magneticMomentToCurrent(magnetic_moment[1]),
-                             this->m_z_minus_magnetorquer.magneticMomentToCurrent(magnetic_moment[2]));
-
-    // Exit ACTUATING_BDOT state
-    this->stateExitActuatingBDotActions();
+bool DetumbleManager ::magneticField(DetumbleController::Field& magnetic_field, std::chrono::microseconds& timestamp) {
+    Drv::MagneticField field;
+    if (!this->getMagneticField(field)) {
+        return false;
+    }
+    magnetic_field = {field.get_x(), field.get_y(), field.get_z()};
+    timestamp = std::chrono::microseconds(static_cast<U64>(field.get_timestamp().get_seconds()) * 1000000 +
+                                          field.get_timestamp().get_useconds());
+    return true;
 }
 
-void DetumbleManager ::stateEnterActuatingBDotActions() {
+bool DetumbleManager ::magneticFieldSamplingPeriod(std::chrono::microseconds& sampling_period) {
     Fw::Success condition;
-    Fw::ParamValid isValid;
-
-    // Only perform actions on first call after state transition
-    if (this->m_torque_start_time != Fw::ZERO_TIME) {
-        return;
-    }
-
-    // Get gain parameter
-    F64 gain = this->paramGet_GAIN(isValid);
-
-    // Get magnetometer sampling period
-    Fw::TimeIntervalValue sampling_period = this->magneticFieldSamplingPeriodGet_out(0, condition);
+    Fw::TimeIntervalValue period = this->magneticFieldSamplingPeriodGet_out(0, condition);
     if (condition != Fw::Success::SUCCESS) {
         this->log_WARNING_LO_MagneticFieldSamplingPeriodRetrievalFailed();
-        return;
+        return false;
     }
     this->log_WARNING_LO_MagneticFieldSamplingPeriodRetrievalFailed_ThrottleClear();
-    std::chrono::microseconds sampling_period_us(sampling_period.get_useconds());
-
-    // Configure B-Dot controller
-    this->m_bdot.configure(gain, sampling_period_us);
-
-    // Record torque start time
-    this->m_torque_start_time = this->getTime();
+    sampling_period = std::chrono::microseconds(period.get_useconds());
+    return true;
 }
 
-void DetumbleManager ::stateExitActuatingBDotActions() {
-    Fw::ParamValid isValid;
-
-    // Get torque duration from parameter
-    Fw::TimeIntervalValue torque_duration_param = this->paramGet_TORQUE_DURATION(isValid);
-
-    // Calculate elapsed torquing duration
-    Fw::Time current_time = this->getTime();
-    Fw::TimeInterval torque_duration = Fw::TimeInterval(this->m_torque_start_time, current_time);
-    Fw::TimeInterval required_torque_duration(torque_duration_param.get_seconds(),
-                                              torque_duration_param.get_useconds());
-
-    // Check if torquing duration has elapsed
-    if (Fw::TimeInterval::compare(torque_duration, required_torque_duration) != Fw::TimeInterval::GT) {
-        // Torque duration not yet elapsed, remain in ACTUATING_BDOT state
-        return;
+void DetumbleManager ::startMagnetorquers(const BDot::Vector& magnetic_moment) {
+    DetumbleController::DriveLevels drive_levels;
+    {
+        Os::ScopeLock lock(this->m_magnetorquer_array_lock);
+        drive_levels = this->m_magnetorquer_array.magneticMomentToDriveLevels(magnetic_moment);
     }
 
-    // Empty B-Dot sample set for next detumble cycle
-    this->m_bdot.emptySampleSet();
-
-    // Turn off magnetorquers
-    this->stopMagnetorquers();
-
-    // Reset torque start time
-    this->m_torque_start_time = Fw::ZERO_TIME;
-
-    // Transition to COOLDOWN state
-    this->m_state = DetumbleState::COOLDOWN;
+    this->startMagnetorquers(drive_levels);
 }
 
-void DetumbleManager ::stateActuatingHysteresisActions() {
-    Fw::ParamValid isValid;
+void DetumbleManager ::startMagnetorquers(const DetumbleController::DriveLevels& drive_levels) {
+    if (isConnected_xPlusStart_OutputPort(0)) {
+        this->xPlusStart_out(0, drive_levels[MagnetorquerArray::X_PLUS]);
+    }
+    if (isConnected_xMinusStart_OutputPort(0)) {
+        this->xMinusStart_out(0, drive_levels[MagnetorquerArray::X_MINUS]);
+    }
+    if (isConnected_yPlusStart_OutputPort(0)) {
+        this->yPlusStart_out(0, drive_levels[MagnetorquerArray::Y_PLUS]);
+    }
+    if (isConnected_yMinusStart_OutputPort(0)) {
+        this->yMinusStart_out(0, drive_levels[MagnetorquerArray::Y_MINUS]);
+    }
+    if (isConnected_zMinusStart_OutputPort(0)) {
+        this->zMinusStart_out(0, drive_levels[MagnetorquerArray::Z_MINUS]);
+    }
+}
 
-    // Get axis parameter
-    HysteresisAxis axis = this->paramGet_HYSTERESIS_AXIS(isValid);
-
-    // Perform torqueing action
-    switch (axis) {
-        case HysteresisAxis::X_AXIS:
-            this->startMagnetorquers(127, -127, 0, 0, 0);
-            break;
-        case HysteresisAxis::Y_AXIS:
-            this->startMagnetorquers(0, 0, 127, -127, 0);
-            break;
-        case HysteresisAxis::Z_AXIS:
-            this->startMagnetorquers(0, 0, 0, 0, -127);
-            break;
+void DetumbleManager ::stopMagnetorquers() {
+    if (isConnected_xPlusStop_OutputPort(0)) {
+        this->xPlusStop_out(0);
     }
+    if (isConnected_xMinusStop_OutputPort(0)) {
+        this->xMinusStop_out(0);
+    }
+    if (isConnected_yPlusStop_OutputPort(0)) {
+        this->yPlusStop_out(0);
+    }
+    if (isConnected_yMinusStop_OutputPort(0)) {
+        this->yMinusStop_out(0);
+    }
+    if (isConnected_zMinusStop_OutputPort(0)) {
+        this->zMinusStop_out(0);
+    }
+}
+
+void DetumbleManager ::detumbleStarted(double angular_velocity_magnitude_deg_sec) {
+    this->log_ACTIVITY_LO_DetumbleStarted(angular_velocity_magnitude_deg_sec);
+    this->log_ACTIVITY_LO_DetumbleCompleted_ThrottleClear();
+}
 
-    // Transition to COOLDOWN state
-    this->m_state = DetumbleState::COOLDOWN;
+void DetumbleManager ::detumbleCompleted(double angular_velocity_magnitude_deg_sec) {
+    this->log_ACTIVITY_LO_DetumbleCompleted(angular_velocity_magnitude_deg_sec);
+    this->log_ACTIVITY_LO_DetumbleStarted_ThrottleClear();
 }
 
 }  // namespace Components
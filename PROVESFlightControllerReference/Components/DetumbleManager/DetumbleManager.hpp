@@ -6,14 +6,17 @@
 #ifndef Components_DetumbleManager_HPP
 #define Components_DetumbleManager_HPP
 
+#include <Os/Mutex.hpp>
+
 #include "PROVESFlightControllerReference/Components/DetumbleManager/BDot.hpp"
+#include "PROVESFlightControllerReference/Components/DetumbleManager/DetumbleController.hpp"
 #include "PROVESFlightControllerReference/Components/DetumbleManager/DetumbleManagerComponentAc.hpp"
 #include "PROVESFlightControllerReference/Components/DetumbleManager/Magnetorquer.hpp"
-#include "PROVESFlightControllerReference/Components/DetumbleManager/StrategySelector.hpp"
+#include "PROVESFlightControllerReference/Components/DetumbleManager/MagnetorquerArray.hpp"
 
 namespace Components {
 
-class DetumbleManager final : public DetumbleManagerComponentBase {
+class DetumbleManager final : public DetumbleManagerComponentBase, private DetumbleController::Io {
   public:
     // ----------------------------------------------------------------------
     // Component construction and destruction
@@ -50,6 +53,13 @@ class DetumbleManager final : public DetumbleManagerComponentBase {
     void systemModeChanged_handler(FwIndexType portNum,  //!< The port number
                                    const Components::SystemMode& mode) override;
 
+    //! Handler implementation for magneticFieldIn
+    //!
+    //! Port for receiving magnetic field conversions pushed on the magnetometer data-ready interrupt
+    void magneticFieldIn_handler(FwIndexType portNum,                     //!< The port number
+                                 const Drv::MagneticField& magneticField  //!< Magnetic field and conversion time
+                                 ) override;
+
   private:
     // ----------------------------------------------------------------------
     // Handler implementations for commands
@@ -75,74 +85,84 @@ class DetumbleManager final : public DetumbleManagerComponentBase {
     //  Private helper methods
     // ----------------------------------------------------------------------
 
-    //! Turn the magnetorquers on based on the provided values
-    void startMagnetorquers(I8 x_plus_drive_level,
-                            I8 x_minus_drive_level,
-                            I8 y_plus_drive_level,
-                            I8 y_minus_drive_level,
-                            I8 z_minus_drive_level);
-
-    //! Turn the magnetorquers off based on the provided values
-    void stopMagnetorquers();
+    //! Get the next magnetic field sample
+    //!
+    //! While conversions are pushed on magneticFieldIn the newest unused one is returned, and false means none
+    //! arrived since the last call. Otherwise the field is polled on magneticFieldGet.
+    bool getMagneticField(Drv::MagneticField& magnetic_field  //!< Magnetic field in gauss
+    );
 
     //! Parameter update handler
     void parameterUpdated(FwPrmIdType id  //!< The parameter ID
                           ) override;
 
-    //! Actions to perform in the COOLDOWN state
-    void stateCooldownActions();
+    //! Whether a parameter feeds the coil gain table
+    static bool isCoilParameter(FwPrmIdType id  //!< The parameter ID
+    );
+
+  private:
+    // ----------------------------------------------------------------------
+    //  DetumbleController::Io implementations
+    // ----------------------------------------------------------------------
 
-    //! Actions to perform when entering the COOLDOWN state
-    void stateEnterCooldownActions();
+    //! Current time
+    std::chrono::microseconds currentTime() override;
 
-    //! Actions to perform when exiting the COOLDOWN state
-    void stateExitCooldownActions();
+    //! Current parameter values
+    DetumbleController::Settings settings() override;
 
-    //! Actions to perform in the SENSING_ANGULAR_VELOCITY state
-    void stateSensingAngularVelocityActions();
+    //! Angular velocity magnitude from angularVelocityMagnitudeGet, telemetered when read
+    bool angularVelocityMagnitude(double& angular_velocity_magnitude_deg_sec  //!< Angular velocity in deg/s
+                                  ) override;
 
-    //! Actions to perform when entering the SENSING_ANGULAR_VELOCITY state
-    void stateEnterSensingAngularVelocityActions();
+    //! Next magnetic field sample from getMagneticField
+    bool magneticField(DetumbleController::Field& magnetic_field,  //!< Magnetic field in gauss
+                       std::chrono::microseconds& timestamp        //!< Time the field was converted
+                       ) override;
 
-    //! Actions to perform when exiting the SENSING_ANGULAR_VELOCITY state
-    void stateExitSensingAngularVelocityActions(F64 angular_velocity_magnitude_deg_sec);
+    //! Magnetometer sampling period from magneticFieldSamplingPeriodGet
+    bool magneticFieldSamplingPeriod(std::chrono::microseconds& sampling_period  //!< Sampling period
+                                     ) override;
 
-    //! Actions to perform in the SENSING_MAGNETIC_FIELD state
-    void stateSensingMagneticFieldActions();
+    //! Turn the magnetorquers on to produce the requested magnetic moment, preserving its direction at saturation
+    void startMagnetorquers(const BDot::Vector& magnetic_moment  //!< Magnetic moment in A·m²
+                            ) override;
 
-    //! Actions to perform in the ACTUATING_BDOT state
-    void stateActuatingBDotActions();
+    //! Turn the magnetorquers on based on the provided values
+    void startMagnetorquers(const DetumbleController::DriveLevels& drive_levels  //!< Drive level per coil
+                            ) override;
 
-    //! Actions to perform when entering the ACTUATING_BDOT state
-    void stateEnterActuatingBDotActions();
+    //! Turn the magnetorquers off
+    void stopMagnetorquers() override;
 
-    //! Actions to perform when exiting the ACTUATING_BDOT state
-    void stateExitActuatingBDotActions();
+    //! Emit DetumbleStarted
+    void detumbleStarted(double angular_velocity_magnitude_deg_sec  //!< Angular velocity in deg/s
+                         ) override;
 
-    //! Actions to perform in the ACTUATING_HYSTERESIS state
-    void stateActuatingHysteresisActions();
+    //! Emit DetumbleCompleted
+    void detumbleCompleted(double angular_velocity_magnitude_deg_sec  //!< Angular velocity in deg/s
+                           ) override;
 
   private:
     // ----------------------------------------------------------------------
     //  Private member variables
     // ----------------------------------------------------------------------
 
-    BDot m_bdot;                           //!< B-Dot detumble algorithm class
-    StrategySelector m_strategy_selector;  //!< Detumble helper class
-    Magnetorquer m_x_plus_magnetorquer;    //!< X+ Coil parameters
-    Magnetorquer m_x_minus_magnetorquer;   //!< X- Coil parameters
-    Magnetorquer m_y_plus_magnetorquer;    //!< Y+ Coil parameters
-    Magnetorquer m_y_minus_magnetorquer;   //!< Y- Coil parameters
-    Magnetorquer m_z_minus_magnetorquer;   //!< Z- Coil parameters
+    DetumbleController m_controller;  //!< AUTO mode state machine
 
-    DetumbleMode m_mode = DetumbleMode::DISABLED;          //!< Detumble mode
-    DetumbleState m_state = DetumbleState::COOLDOWN;       //!< Detumble state
-    DetumbleStrategy m_strategy = DetumbleStrategy::IDLE;  //!< Detumble strategy
+    MagnetorquerArray m_magnetorquer_array;  //!< Coil gain table built from the coil parameters
+    Os::Mutex m_magnetorquer_array_lock;     //!< Protects the gain table against parameter updates
 
-    Fw::Time m_cooldown_start_time = Fw::ZERO_TIME;  //!< Cooldown start time
-    Fw::Time m_torque_start_time = Fw::ZERO_TIME;    //!< Torque start time
+    DetumbleMode m_mode = DetumbleMode::DISABLED;  //!< Detumble mode
 
     Fw::Time last_cycle_time = Fw::ZERO_TIME;  //!< Time of last run cycle
+
+    //! Runs without a pushed conversion after which the magnetic field is polled again
+    static constexpr U32 DATA_READY_STALE_RUNS = 50;
+
+    Drv::MagneticField m_data_ready_field;                //!< Newest conversion pushed on magneticFieldIn
+    bool m_data_ready_pending = false;                    //!< Whether the newest pushed conversion is unused
+    U32 m_runs_since_data_ready = DATA_READY_STALE_RUNS;  //!< Runs since a conversion was last pushed
 };
 
 }  // namespace Components
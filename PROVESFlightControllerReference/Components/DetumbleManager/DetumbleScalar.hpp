@@ -0,0 +1,193 @@
+// ======================================================================
+// \title  DetumbleScalar.hpp
+// \brief  Scalar types for the detumble control math
+// ======================================================================
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace Components {
+
+//! Signed fixed point number with FRAC_BITS fractional bits stored in 32 bits
+//!
+//! Products and quotients are formed in 64 bits and saturate to the 32 bit range rather than wrapping, so an
+//! overflowing control output keeps its sign.
+template <int FRAC_BITS>
+class FixedPoint {
+    static_assert(FRAC_BITS > 0 && FRAC_BITS < 31, "Fixed point needs integer and fractional bits");
+
+  public:
+    static constexpr std::int64_t ONE = static_cast<std::int64_t>(1) << FRAC_BITS;  //!< Raw value of 1.0
+    static constexpr std::int64_t MAX_RAW = INT32_MAX;                             //!< Largest raw value
+    static constexpr std::int64_t MIN_RAW = -INT32_MAX;                            //!< Smallest raw value
+
+    constexpr FixedPoint() : m_raw(0) {}
+
+    //! Whole numbers convert implicitly so literals such as 0 can initialize any scalar
+    constexpr FixedPoint(int value)
+        : m_raw(static_cast<std::int32_t>(saturate(static_cast<std::int64_t>(value) * ONE))) {}
+
+    //! Wrap a raw value, saturating to the representable range
+    static constexpr FixedPoint fromRaw(std::int64_t raw) { return FixedPoint(saturate(raw), RawTag()); }
+
+    //! Convert from double, rounding to the nearest representable value
+    static constexpr FixedPoint fromDouble(double value) {
+        if (value >= static_cast<double>(MAX_RAW) / ONE) {
+            return fromRaw(MAX_RAW);
+        }
+        if (value <= static_cast<double>(MIN_RAW) / ONE) {
+            return fromRaw(MIN_RAW);
+        }
+        return fromRaw(static_cast<std::int64_t>(value * ONE + ((value < 0.0) ? -0.5 : 0.5)));
+    }
+
+    constexpr double toDouble() const { return static_cast<double>(this->m_raw) / ONE; }
+
+    constexpr std::int32_t raw() const { return this->m_raw; }
+
+    constexpr FixedPoint operator-() const { return fromRaw(-static_cast<std::int64_t>(this->m_raw)); }
+
+    constexpr FixedPoint operator+(FixedPoint other) const {
+        return fromRaw(static_cast<std::int64_t>(this->m_raw) + other.m_raw);
+    }
+
+    constexpr FixedPoint operator-(FixedPoint other) const {
+        return fromRaw(static_cast<std::int64_t>(this->m_raw) - other.m_raw);
+    }
+
+    constexpr FixedPoint operator*(FixedPoint other) const {
+        return fromRaw(roundShift(static_cast<std::int64_t>(this->m_raw) * other.m_raw));
+    }
+
+    //! Division by zero saturates toward the sign of the dividend
+    constexpr FixedPoint operator/(FixedPoint other) const {
+        return (other.m_raw == 0) ? fromRaw((this->m_raw < 0) ? MIN_RAW : MAX_RAW)
+                                  : fromRaw(static_cast<std::int64_t>(this->m_raw) * ONE / other.m_raw);
+    }
+
+    FixedPoint& operator+=(FixedPoint other) { return *this = *this + other; }
+    FixedPoint& operator-=(FixedPoint other) { return *this = *this - other; }
+    FixedPoint& operator*=(FixedPoint other) { return *this = *this * other; }
+    FixedPoint& operator/=(FixedPoint other) { return *this = *this / other; }
+
+    constexpr bool operator==(FixedPoint other) const { return this->m_raw == other.m_raw; }
+    constexpr bool operator!=(FixedPoint other) const { return this->m_raw != other.m_raw; }
+    constexpr bool operator<(FixedPoint other) const { return this->m_raw < other.m_raw; }
+    constexpr bool operator<=(FixedPoint other) const { return this->m_raw <= other.m_raw; }
+    constexpr bool operator>(FixedPoint other) const { return this->m_raw > other.m_raw; }
+    constexpr bool operator>=(FixedPoint other) const { return this->m_raw >= other.m_raw; }
+
+  private:
+    struct RawTag {};
+
+    constexpr FixedPoint(std::int64_t raw, RawTag) : m_raw(static_cast<std::int32_t>(raw)) {}
+
+    static constexpr std::int64_t saturate(std::int64_t raw) {
+        return (raw > MAX_RAW) ? MAX_RAW : ((raw < MIN_RAW) ? MIN_RAW : raw);
+    }
+
+    //! Drop the extra fractional bits of a product, rounding half away from zero
+    static constexpr std::int64_t roundShift(std::int64_t product) {
+        return (product < 0) ? -((-product + ONE / 2) >> FRAC_BITS) : ((product + ONE / 2) >> FRAC_BITS);
+    }
+
+    std::int32_t m_raw;  //!< Value scaled by 2^FRAC_BITS
+};
+
+using FixedPointQ16 = FixedPoint<16>;  //!< Q15.16, ±32767 with a resolution of 1.5e-5
+
+//! Operations the detumble math needs beyond the arithmetic operators, for floating point scalars
+template <typename Scalar>
+struct ScalarMath {
+    static constexpr Scalar fromDouble(double value) { return static_cast<Scalar>(value); }
+
+    static constexpr double toDouble(Scalar value) { return static_cast<double>(value); }
+
+    //! numerator / denominator without forming either in the scalar type first
+    static Scalar ratio(std::int64_t numerator, std::int64_t denominator) {
+        return static_cast<Scalar>(numerator) / static_cast<Scalar>(denominator);
+    }
+
+    static Scalar abs(Scalar value) { return std::fabs(value); }
+
+    //! Euclidean norm of a three vector
+    static Scalar norm(Scalar x, Scalar y, Scalar z) { return std::sqrt(x * x + y * y + z * z); }
+
+    //! Round half away from zero
+    static std::int32_t roundToInt(Scalar value) { return static_cast<std::int32_t>(std::lround(value)); }
+};
+
+//! Operations the detumble math needs beyond the arithmetic operators, for fixed point scalars
+template <int FRAC_BITS>
+struct ScalarMath<FixedPoint<FRAC_BITS>> {
+    using Fixed = FixedPoint<FRAC_BITS>;
+
+    static constexpr Fixed fromDouble(double value) { return Fixed::fromDouble(value); }
+
+    static constexpr double toDouble(Fixed value) { return value.toDouble(); }
+
+    //! numerator / denominator in 64 bit integers, dropping low bits of both if the scaled numerator would overflow
+    static Fixed ratio(std::int64_t numerator, std::int64_t denominator) {
+        while (numerator > (INT64_MAX >> FRAC_BITS) || numerator < -(INT64_MAX >> FRAC_BITS)) {
+            numerator /= 2;
+            denominator /= 2;
+        }
+        if (denominator == 0) {
+            return Fixed::fromRaw((numerator < 0) ? Fixed::MIN_RAW : Fixed::MAX_RAW);
+        }
+        return Fixed::fromRaw(numerator * Fixed::ONE / denominator);
+    }
+
+    static Fixed abs(Fixed value) { return (value.raw() < 0) ? -value : value; }
+
+    //! Euclidean norm of a three vector, summing the squares in 64 bits so large components do not overflow
+    static Fixed norm(Fixed x, Fixed y, Fixed z) {
+        std::uint64_t sum = square(x) + square(y) + square(z);
+        return Fixed::fromRaw(static_cast<std::int64_t>(isqrt(sum)));
+    }
+
+    //! Round half away from zero
+    static std::int32_t roundToInt(Fixed value) {
+        std::int64_t raw = value.raw();
+        std::int64_t magnitude = ((raw < 0 ? -raw : raw) + Fixed::ONE / 2) >> FRAC_BITS;
+        return static_cast<std::int32_t>(raw < 0 ? -magnitude : magnitude);
+    }
+
+  private:
+    static std::uint64_t square(Fixed value) {
+        std::int64_t raw = value.raw();
+        return static_cast<std::uint64_t>(raw * raw);
+    }
+
+    //! Integer square root, bit by bit
+    static std::uint64_t isqrt(std::uint64_t value) {
+        std::uint64_t result = 0;
+        std::uint64_t bit = static_cast<std::uint64_t>(1) << 62;
+        while (bit > value) {
+            bit >>= 2;
+        }
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return result;
+    }
+};
+
+//! Scalar type used by the detumble control path, chosen per board by CONFIG_DETUMBLE_SCALAR_*
+#if defined(CONFIG_DETUMBLE_SCALAR_FIXED)
+using DetumbleScalar = FixedPointQ16;
+#elif defined(CONFIG_DETUMBLE_SCALAR_FLOAT)
+using DetumbleScalar = float;
+#else
+using DetumbleScalar = double;
+#endif
+
+}  // namespace Components
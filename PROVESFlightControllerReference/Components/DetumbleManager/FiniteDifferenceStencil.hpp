@@ -0,0 +1,53 @@
+// ======================================================================
+// \title  FiniteDifferenceStencil.hpp
+// \brief  Compile time central finite difference weights
+// ======================================================================
+
+#pragma once
+
+#include <cstddef>
+
+#include "DetumbleScalar.hpp"
+
+namespace Components {
+
+//! Weights of the N-point central finite difference approximation of the first derivative
+//!
+//! For N = 2m + 1 equally spaced samples f_{-m} ... f_{m} the derivative at the centre sample is
+//!
+//! f'(t_0) ≈ (Σ w_k f_k) / 𝚫t,  w_k = (-1)^(k+1) (m!)² / (k (m-k)! (m+k)!),  w_0 = 0,  w_{-k} = -w_k
+//!
+//! which is exact for polynomials up to degree N - 1, with truncation error O(𝚫t^(N-1)). The weights are
+//! generated in double by the constructor and stored as Scalar, so a constexpr instance costs nothing at run time.
+template <std::size_t N, typename Scalar = double>
+struct CentralDifferenceStencil {
+    static_assert(N >= 3 && N % 2 == 1, "Central difference stencils need an odd number of at least 3 points");
+
+    static constexpr std::size_t HALF_WIDTH = N / 2;  //!< Samples either side of the centre sample
+
+    Scalar weights[N];  //!< Weight of each sample, oldest first
+
+    constexpr CentralDifferenceStencil() : weights{} {
+        const double m_factorial = factorial(HALF_WIDTH);
+        for (std::size_t k = 1; k <= HALF_WIDTH; k++) {
+            double weight = m_factorial * m_factorial /
+                            (static_cast<double>(k) * factorial(HALF_WIDTH - k) * factorial(HALF_WIDTH + k));
+            if (k % 2 == 0) {
+                weight = -weight;
+            }
+            this->weights[HALF_WIDTH + k] = ScalarMath<Scalar>::fromDouble(weight);
+            this->weights[HALF_WIDTH - k] = ScalarMath<Scalar>::fromDouble(-weight);
+        }
+    }
+
+  private:
+    static constexpr double factorial(std::size_t n) {
+        double result = 1.0;
+        for (std::size_t i = 2; i <= n; i++) {
+            result *= static_cast<double>(i);
+        }
+        return result;
+    }
+};
+
+}  // namespace Components
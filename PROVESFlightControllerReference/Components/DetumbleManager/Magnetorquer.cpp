@@ -41,6 +41,18 @@ std::int8_t Magnetorquer ::magneticMomentToCurrent(double magnetic_moment_compon
     return this->m_direction_sign * scaledCurrent;
 }
 
+double Magnetorquer ::getDriveLevelPerMagneticMoment() const {
+    // Moment produced at full drive
+    double max_moment = this->m_turns * this->getCoilArea() * this->getMaxCoilCurrent();
+
+    // Avoid division by zero
+    if (max_moment == 0.0) {
+        return 0.0;
+    }
+
+    return static_cast<double>(this->m_direction_sign) * 127.0 / max_moment;
+}
+
 // ----------------------------------------------------------------------
 //  Private helper methods
 // ----------------------------------------------------------------------
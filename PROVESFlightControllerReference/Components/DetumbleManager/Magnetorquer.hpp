@@ -41,6 +41,16 @@ class Magnetorquer {
         double magnetic_moment_component  //<! Magnetic moment component (x, y, or z) in A·m²
     ) const;
 
+    //! Signed drive level per unit of magnetic moment, so that drive = gain * m below saturation.
+    //!
+    //! g = sign * 127 / (N * A * I_max)
+    //!
+    //! g is the drive level per A·m², zero if the coil cannot produce a moment
+    //! N is the number of turns
+    //! A is the coil area (m²)
+    //! I_max is the maximum current (A)
+    double getDriveLevelPerMagneticMoment() const;
+
   private:
     // ----------------------------------------------------------------------
     //  Private helper methods
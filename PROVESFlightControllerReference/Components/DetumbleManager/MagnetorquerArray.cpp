@@ -0,0 +1,83 @@
+// ======================================================================
+// \title  MagnetorquerArray.cpp
+// \brief  cpp file for MagnetorquerArray implementation class
+// ======================================================================
+
+#include "MagnetorquerArray.hpp"
+
+namespace {
+constexpr double MAX_DRIVE_LEVEL = 127.0;
+}
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+// Component construction and destruction
+// ----------------------------------------------------------------------
+
+template <typename Scalar>
+BasicMagnetorquerArray<Scalar>::BasicMagnetorquerArray() {}
+
+template <typename Scalar>
+BasicMagnetorquerArray<Scalar>::~BasicMagnetorquerArray() {}
+
+// ----------------------------------------------------------------------
+//  Public helper methods
+// ----------------------------------------------------------------------
+
+template <typename Scalar>
+void BasicMagnetorquerArray<Scalar>::configure(Coil coil, std::size_t axis, const Magnetorquer& magnetorquer) {
+    if (coil >= COIL_COUNT || axis >= 3) {
+        return;
+    }
+
+    this->m_drive_per_moment[coil] = ScalarMath<Scalar>::fromDouble(magnetorquer.getDriveLevelPerMagneticMoment());
+    this->m_axis[coil] = axis;
+}
+
+template <typename Scalar>
+std::array<std::int8_t, BasicMagnetorquerArray<Scalar>::COIL_COUNT>
+BasicMagnetorquerArray<Scalar>::magneticMomentToDriveLevels(const std::array<Scalar, 3>& magnetic_moment) const {
+    const Scalar max_drive_level = ScalarMath<Scalar>::fromDouble(MAX_DRIVE_LEVEL);
+
+    // Unsaturated drive level of each coil and the largest magnitude among them
+    std::array<Scalar, COIL_COUNT> drive{};
+    Scalar peak = 0;
+    for (std::size_t coil = 0; coil < COIL_COUNT; coil++) {
+        drive[coil] = this->m_drive_per_moment[coil] * magnetic_moment[this->m_axis[coil]];
+        Scalar magnitude = ScalarMath<Scalar>::abs(drive[coil]);
+        if (magnitude > peak) {
+            peak = magnitude;
+        }
+    }
+
+    // Scale every coil together so the most loaded coil sits at full drive
+    Scalar scale = 1;
+    if (peak > max_drive_level) {
+        scale = max_drive_level / peak;
+    }
+
+    // Clamp after rounding, as a scaled fixed point peak can land a count past full drive
+    std::array<std::int8_t, COIL_COUNT> levels{};
+    for (std::size_t coil = 0; coil < COIL_COUNT; coil++) {
+        std::int32_t level = ScalarMath<Scalar>::roundToInt(drive[coil] * scale);
+        if (level > static_cast<std::int32_t>(MAX_DRIVE_LEVEL)) {
+            level = static_cast<std::int32_t>(MAX_DRIVE_LEVEL);
+        } else if (level < -static_cast<std::int32_t>(MAX_DRIVE_LEVEL)) {
+            level = -static_cast<std::int32_t>(MAX_DRIVE_LEVEL);
+        }
+        levels[coil] = static_cast<std::int8_t>(level);
+    }
+
+    return levels;
+}
+
+// ----------------------------------------------------------------------
+//  Supported scalar types
+// ----------------------------------------------------------------------
+
+template class BasicMagnetorquerArray<double>;
+template class BasicMagnetorquerArray<float>;
+template class BasicMagnetorquerArray<FixedPointQ16>;
+
+}  // namespace Components
@@ -0,0 +1,81 @@
+// ======================================================================
+// \title  MagnetorquerArray.hpp
+// \brief  hpp file for MagnetorquerArray implementation class
+// ======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "DetumbleScalar.hpp"
+#include "Magnetorquer.hpp"
+
+namespace Components {
+
+//! Drive levels for all coils from one magnetic moment, computed in Scalar (double, float or FixedPoint)
+template <typename Scalar>
+class BasicMagnetorquerArray {
+  public:
+    // ----------------------------------------------------------------------
+    //  Public types
+    // ----------------------------------------------------------------------
+
+    //! Coils driven by the array, also the index of each coil in the drive level array
+    enum Coil : std::size_t { X_PLUS = 0, X_MINUS = 1, Y_PLUS = 2, Y_MINUS = 3, Z_MINUS = 4, COIL_COUNT = 5 };
+
+  public:
+    // ----------------------------------------------------------------------
+    // Component construction and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct MagnetorquerArray object
+    BasicMagnetorquerArray();
+
+    //! Destroy MagnetorquerArray object
+    ~BasicMagnetorquerArray();
+
+  public:
+    // ----------------------------------------------------------------------
+    //  Public helper methods
+    // ----------------------------------------------------------------------
+
+    //! Load the gain of one coil from its geometry and electrical parameters
+    //!
+    //! Evaluates the coil area and maximum current once in double, so the drive level computation is only
+    //! Scalar multiplies.
+    void configure(Coil coil,                        //!< Coil to configure
+                   std::size_t axis,                 //!< Dipole axis the coil acts on, 0 = x, 1 = y, 2 = z
+                   const Magnetorquer& magnetorquer  //!< Coil parameters
+    );
+
+    //! Compute the drive level of every coil for the requested magnetic moment.
+    //!
+    //! d_i = round(s * g_i * m_axis(i)),  s = min(1, 127 / max_i |g_i * m_axis(i)|)
+    //!
+    //! d_i is the drive level of coil i in [-127, 127]
+    //! g_i is the drive level per A·m² of coil i
+    //! m is the requested magnetic moment in A·m²
+    //! s is a common scale applied when any coil would saturate, so the commanded dipole keeps its direction
+    //! instead of being clipped one axis at a time.
+    std::array<std::int8_t, COIL_COUNT> magneticMomentToDriveLevels(
+        const std::array<Scalar, 3>& magnetic_moment  //!< Requested magnetic moment in A·m²
+    ) const;
+
+  private:
+    // ----------------------------------------------------------------------
+    //  Private member variables
+    // ----------------------------------------------------------------------
+
+    std::array<Scalar, COIL_COUNT> m_drive_per_moment{};  //!< Signed drive level per A·m² for each coil
+    std::array<std::size_t, COIL_COUNT> m_axis{};         //!< Dipole axis each coil acts on
+};
+
+extern template class BasicMagnetorquerArray<double>;
+extern template class BasicMagnetorquerArray<float>;
+extern template class BasicMagnetorquerArray<FixedPointQ16>;
+
+using MagnetorquerArray = BasicMagnetorquerArray<DetumbleScalar>;  //!< Coil array used by DetumbleManager
+
+}  // namespace Components
@@ -10,15 +10,19 @@ namespace Components {
 // Component construction and destruction
 // ----------------------------------------------------------------------
 
-StrategySelector ::StrategySelector() {}
+template <typename Scalar>
+BasicStrategySelector<Scalar>::BasicStrategySelector() {}
 
-StrategySelector ::~StrategySelector() {}
+template <typename Scalar>
+BasicStrategySelector<Scalar>::~BasicStrategySelector() {}
 
 // ----------------------------------------------------------------------
 //  Public helper methods
 // ----------------------------------------------------------------------
 
-StrategySelector::Strategy StrategySelector ::fromAngularVelocityMagnitude(double angular_velocity_magnitude_deg_sec) {
+template <typename Scalar>
+typename BasicStrategySelector<Scalar>::Strategy BasicStrategySelector<Scalar>::fromAngularVelocityMagnitude(
+    Scalar angular_velocity_magnitude_deg_sec) {
     // If below lower deadband threshold, don't detumble
     if (angular_velocity_magnitude_deg_sec < this->m_deadband_lower_threshold) {
         // Set target rotational threshold to upper deadband
@@ -47,9 +51,10 @@ StrategySelector::Strategy StrategySelector ::fromAngularVelocityMagnitude(doubl
     return IDLE;
 }
 
-void StrategySelector ::configure(double bdot_max_threshold,
-                                  double deadband_upper_threshold,
-                                  double deadband_lower_threshold) {
+template <typename Scalar>
+void BasicStrategySelector<Scalar>::configure(Scalar bdot_max_threshold,
+                                              Scalar deadband_upper_threshold,
+                                              Scalar deadband_lower_threshold) {
     this->m_bdot_max_threshold = bdot_max_threshold;
     this->m_deadband_upper_threshold = deadband_upper_threshold;
     this->m_deadband_lower_threshold = deadband_lower_threshold;
@@ -60,4 +65,12 @@ void StrategySelector ::configure(double bdot_max_threshold,
     }
 }
 
+// ----------------------------------------------------------------------
+//  Supported scalar types
+// ----------------------------------------------------------------------
+
+template class BasicStrategySelector<double>;
+template class BasicStrategySelector<float>;
+template class BasicStrategySelector<FixedPointQ16>;
+
 }  // namespace Components
@@ -7,9 +7,13 @@
 
 #include <array>
 
+#include "DetumbleScalar.hpp"
+
 namespace Components {
 
-class StrategySelector {
+//! Detumble strategy selection with thresholds and angular velocity held in Scalar (double, float or FixedPoint)
+template <typename Scalar>
+class BasicStrategySelector {
   public:
     // ----------------------------------------------------------------------
     //  Public types
@@ -28,10 +32,10 @@ class StrategySelector {
     // ----------------------------------------------------------------------
 
     //! Construct StrategySelector object
-    StrategySelector();
+    BasicStrategySelector();
 
     //! Destroy StrategySelector object
-    ~StrategySelector();
+    ~BasicStrategySelector();
 
   public:
     // ----------------------------------------------------------------------
@@ -40,13 +44,13 @@ class StrategySelector {
 
     //! Determine detumble strategy based on angular velocity magnitude
     Strategy fromAngularVelocityMagnitude(
-        double angular_velocity_magnitude_deg_sec  //!< Angular velocity magnitude in deg/s
+        Scalar angular_velocity_magnitude_deg_sec  //!< Angular velocity magnitude in deg/s
     );
 
     //! Configure detumble strategy thresholds
-    void configure(double bdot_max_threshold,        //!< B-Dot maximum rotational threshold in deg/s
-                   double deadband_upper_threshold,  //!< Upper deadband rotational threshold in deg/s
-                   double deadband_lower_threshold   //!< Lower deadband rotational threshold in deg/s
+    void configure(Scalar bdot_max_threshold,        //!< B-Dot maximum rotational threshold in deg/s
+                   Scalar deadband_upper_threshold,  //!< Upper deadband rotational threshold in deg/s
+                   Scalar deadband_lower_threshold   //!< Lower deadband rotational threshold in deg/s
     );
 
   private:
@@ -54,11 +58,17 @@ class StrategySelector {
     //  Private members variables
     // ----------------------------------------------------------------------
 
-    double m_bdot_max_threshold;        //!< B-Dot maximum rotational threshold in deg/s
-    double m_deadband_lower_threshold;  //!< Lower deadband threshold in deg/s
-    double m_deadband_upper_threshold;  //!< Upper deadband threshold
+    Scalar m_bdot_max_threshold;        //!< B-Dot maximum rotational threshold in deg/s
+    Scalar m_deadband_lower_threshold;  //!< Lower deadband threshold in deg/s
+    Scalar m_deadband_upper_threshold;  //!< Upper deadband threshold
 
-    double m_rotation_target;  //!< Target angular velocity to achieve in deg/s
+    Scalar m_rotation_target;  //!< Target angular velocity to achieve in deg/s
 };
 
+extern template class BasicStrategySelector<double>;
+extern template class BasicStrategySelector<float>;
+extern template class BasicStrategySelector<FixedPointQ16>;
+
+using StrategySelector = BasicStrategySelector<DetumbleScalar>;  //!< Strategy selector used by DetumbleManager
+
 }  // namespace Components
@@ -5,6 +5,22 @@
 
 #include "RtcHelper.hpp"
 
+#include <cmath>
+
+namespace {
+constexpr std::uint64_t USECONDS_PER_SECOND = 1000000;
+constexpr std::int64_t PPB_PER_UNIT = 1000000000;
+
+//! Correction in microseconds accumulated over elapsed microseconds at the given drift
+//!
+//! Split into whole seconds and remainder so long RTC outages cannot overflow the product.
+std::int64_t driftCorrection(std::uint64_t elapsed_useconds, std::int64_t drift_ppb) {
+    std::int64_t elapsed_seconds = static_cast<std::int64_t>(elapsed_useconds / USECONDS_PER_SECOND);
+    std::int64_t elapsed_remainder = static_cast<std::int64_t>(elapsed_useconds % USECONDS_PER_SECOND);
+    return (elapsed_seconds * drift_ppb) / 1000 + (elapsed_remainder * drift_ppb) / PPB_PER_UNIT;
+}
+}  // namespace
+
 namespace Drv {
 
 // ----------------------------------------------------------------------
@@ -38,4 +54,170 @@ std::uint32_t RtcHelper ::rescaleUseconds(std::uint32_t current_seconds, std::ui
     return delta % 1000000;
 }
 
+std::int64_t RtcHelper ::resync(std::uint32_t rtc_seconds, std::uint64_t uptime_useconds) {
+    // The RTC reading bounds the true epoch to [lower, upper]
+    std::uint64_t lower = static_cast<std::uint64_t>(rtc_seconds) * USECONDS_PER_SECOND;
+    std::uint64_t upper = lower + USECONDS_PER_SECOND - 1;
+
+    std::int64_t drift = 0;
+    std::uint64_t anchor = lower;
+    if (this->m_synchronized) {
+        // Compare the extrapolated epoch against the window reported by the RTC
+        std::uint64_t predicted = this->extrapolateUseconds(uptime_useconds);
+        anchor = predicted;
+        if (predicted < lower) {
+            drift = -static_cast<std::int64_t>(lower - predicted);
+            anchor = lower;
+        } else if (predicted > upper) {
+            drift = static_cast<std::int64_t>(predicted - upper);
+            anchor = upper;
+        }
+    }
+
+    // Re-anchor at every reading so a new drift estimate only applies from this point forward
+    this->m_anchor_epoch_useconds = anchor;
+    this->m_anchor_uptime_useconds = uptime_useconds;
+    this->updateDriftModel(rtc_seconds, uptime_useconds);
+
+    this->m_synchronized = true;
+    this->m_last_resync_useconds = uptime_useconds;
+    this->m_last_drift = drift;
+    this->m_resync_count++;
+
+    return drift;
+}
+
+bool RtcHelper ::resyncDue(std::uint64_t uptime_useconds, std::uint64_t resync_period_useconds) const {
+    if (!this->m_synchronized) {
+        return true;
+    }
+
+    return (uptime_useconds - this->m_last_resync_useconds) >= resync_period_useconds;
+}
+
+void RtcHelper ::extrapolate(std::uint64_t uptime_useconds, std::uint32_t& seconds, std::uint32_t& useconds) const {
+    std::uint64_t epoch = this->extrapolateUseconds(uptime_useconds);
+
+    seconds = static_cast<std::uint32_t>(epoch / USECONDS_PER_SECOND);
+    useconds = static_cast<std::uint32_t>(epoch % USECONDS_PER_SECOND);
+}
+
+void RtcHelper ::getTime(std::uint64_t uptime_useconds, std::uint32_t& seconds, std::uint32_t& useconds) {
+    std::uint64_t epoch = this->extrapolateUseconds(uptime_useconds);
+
+    // Hold time rather than step backwards after a resync
+    if (epoch < this->m_last_time_useconds) {
+        epoch = this->m_last_time_useconds;
+    }
+    this->m_last_time_useconds = epoch;
+
+    seconds = static_cast<std::uint32_t>(epoch / USECONDS_PER_SECOND);
+    useconds = static_cast<std::uint32_t>(epoch % USECONDS_PER_SECOND);
+}
+
+void RtcHelper ::invalidate() {
+    this->m_synchronized = false;
+
+    // A time set is a deliberate step, so allow time to move backwards and restart the regression
+    this->m_last_time_useconds = 0;
+    this->m_drift_head = 0;
+    this->m_drift_count = 0;
+}
+
+bool RtcHelper ::isSynchronized() const {
+    return this->m_synchronized;
+}
+
+std::uint32_t RtcHelper ::getResyncCount() const {
+    return this->m_resync_count;
+}
+
+std::int64_t RtcHelper ::getLastDrift() const {
+    return this->m_last_drift;
+}
+
+std::int64_t RtcHelper ::getDriftPpb() const {
+    return this->m_drift_ppb;
+}
+
+// ----------------------------------------------------------------------
+// Private helper methods
+// ----------------------------------------------------------------------
+
+void RtcHelper ::updateDriftModel(std::uint32_t rtc_seconds, std::uint64_t uptime_useconds) {
+    // The true epoch is uniformly distributed within the reported second, so sample its midpoint
+    std::uint64_t rtc_useconds =
+        static_cast<std::uint64_t>(rtc_seconds) * USECONDS_PER_SECOND + USECONDS_PER_SECOND / 2;
+    std::int64_t offset = static_cast<std::int64_t>(rtc_useconds) - static_cast<std::int64_t>(uptime_useconds);
+
+    // Accumulate relative to the first reading to preserve precision
+    if (this->m_drift_count == 0) {
+        this->m_drift_origin_uptime = uptime_useconds;
+        this->m_drift_origin_offset = offset;
+    }
+
+    // Open a new bin once the current one covers its span, evicting the oldest when the window is full
+    if (this->m_drift_count == 0 ||
+        (uptime_useconds - this->m_drift_bin_start[this->m_drift_head]) >= DRIFT_BIN_USECONDS) {
+        if (this->m_drift_count > 0) {
+            this->m_drift_head = (this->m_drift_head + 1) % DRIFT_WINDOW;
+        }
+        if (this->m_drift_count < DRIFT_WINDOW) {
+            this->m_drift_count++;
+        }
+        this->m_drift_bin_start[this->m_drift_head] = uptime_useconds;
+        this->m_drift_sum_x[this->m_drift_head] = 0;
+        this->m_drift_sum_y[this->m_drift_head] = 0;
+        this->m_drift_samples[this->m_drift_head] = 0;
+    }
+
+    this->m_drift_sum_x[this->m_drift_head] += static_cast<std::int64_t>(uptime_useconds - this->m_drift_origin_uptime);
+    this->m_drift_sum_y[this->m_drift_head] += offset - this->m_drift_origin_offset;
+    this->m_drift_samples[this->m_drift_head]++;
+
+    std::size_t oldest = (this->m_drift_head + 1 + DRIFT_WINDOW - this->m_drift_count) % DRIFT_WINDOW;
+    if ((uptime_useconds - this->m_drift_bin_start[oldest]) < DRIFT_MIN_SPAN_USECONDS) {
+        return;
+    }
+
+    // Weighted least squares slope of (RTC - uptime) against uptime over the bin means
+    double weight = 0.0;
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    for (std::size_t i = 0; i < this->m_drift_count; i++) {
+        std::size_t index = (oldest + i) % DRIFT_WINDOW;
+        weight += static_cast<double>(this->m_drift_samples[index]);
+        sum_x += static_cast<double>(this->m_drift_sum_x[index]);
+        sum_y += static_cast<double>(this->m_drift_sum_y[index]);
+    }
+    double mean_x = sum_x / weight;
+    double mean_y = sum_y / weight;
+
+    double sxx = 0.0;
+    double sxy = 0.0;
+    for (std::size_t i = 0; i < this->m_drift_count; i++) {
+        std::size_t index = (oldest + i) % DRIFT_WINDOW;
+        double samples = static_cast<double>(this->m_drift_samples[index]);
+        double dx = static_cast<double>(this->m_drift_sum_x[index]) / samples - mean_x;
+        double dy = static_cast<double>(this->m_drift_sum_y[index]) / samples - mean_y;
+        sxx += samples * dx * dx;
+        sxy += samples * dx * dy;
+    }
+
+    // Slope is in microseconds per microsecond, scale to parts per billion
+    std::int64_t drift_ppb = static_cast<std::int64_t>(std::llround((sxy / sxx) * static_cast<double>(PPB_PER_UNIT)));
+    if (drift_ppb > DRIFT_MAX_PPB) {
+        drift_ppb = DRIFT_MAX_PPB;
+    } else if (drift_ppb < -DRIFT_MAX_PPB) {
+        drift_ppb = -DRIFT_MAX_PPB;
+    }
+    this->m_drift_ppb = drift_ppb;
+}
+
+std::uint64_t RtcHelper ::extrapolateUseconds(std::uint64_t uptime_useconds) const {
+    std::uint64_t elapsed = uptime_useconds - this->m_anchor_uptime_useconds;
+    std::int64_t correction = driftCorrection(elapsed, this->m_drift_ppb);
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(this->m_anchor_epoch_useconds + elapsed) + correction);
+}
+
 }  // namespace Drv
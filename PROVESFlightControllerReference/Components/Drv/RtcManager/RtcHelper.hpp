@@ -5,11 +5,31 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace Drv {
 
 class RtcHelper {
+  public:
+    // ----------------------------------------------------------------------
+    // Drift model configuration
+    // ----------------------------------------------------------------------
+
+    //! Number of bins of RTC readings kept for the drift regression
+    static constexpr std::size_t DRIFT_WINDOW = 32;
+
+    //! Uptime covered by each regression bin, readings within a bin are averaged together
+    static constexpr std::uint64_t DRIFT_BIN_USECONDS = 900000000;
+
+    //! Minimum uptime covered by the regression before its estimate is applied
+    //!
+    //! RTC readings are quantized to whole seconds, so a short baseline yields a noisy slope
+    static constexpr std::uint64_t DRIFT_MIN_SPAN_USECONDS = 14400000000;
+
+    //! Largest drift magnitude the model will apply in parts per billion
+    static constexpr std::int64_t DRIFT_MAX_PPB = 500000;
+
   public:
     // ----------------------------------------------------------------------
     // Component construction and destruction
@@ -35,13 +55,93 @@ class RtcHelper {
         std::uint32_t current_useconds  //<! The microseconds since boot from the system uptime clock
     );
 
+    //! Anchors the cached epoch to a fresh RTC reading and returns the measured drift in microseconds
+    //!
+    //! The RTC only reports whole seconds, so a reading bounds the true epoch to [s, s + 1). When the
+    //! extrapolated epoch is already inside that window the anchor is kept and the drift is zero. Otherwise
+    //! the anchor is moved to the nearest edge of the window and the signed distance is reported: negative
+    //! when the cached clock was behind the RTC, positive when it was ahead.
+    std::int64_t resync(std::uint32_t rtc_seconds,     //<! The epoch seconds read from the RTC
+                        std::uint64_t uptime_useconds  //<! The microseconds since boot when the RTC was read
+    );
+
+    //! Tells the caller whether the cached epoch must be refreshed from the RTC
+    bool resyncDue(std::uint64_t uptime_useconds,        //<! The current microseconds since boot
+                   std::uint64_t resync_period_useconds  //<! The maximum age of the anchor in microseconds
+    ) const;
+
+    //! Extrapolates the cached epoch to the given uptime
+    //!
+    //! epoch = anchor_epoch + elapsed + elapsed * drift_ppb / 1e9, where elapsed = uptime - anchor_uptime
+    void extrapolate(std::uint64_t uptime_useconds,  //<! The current microseconds since boot
+                     std::uint32_t& seconds,         //<! The extrapolated epoch seconds
+                     std::uint32_t& useconds         //<! The extrapolated microseconds in [0, 999999]
+    ) const;
+
+    //! Extrapolates the cached epoch to the given uptime, never returning a time before the previous call
+    //!
+    //! A resync that moves the epoch backwards holds time at the last returned value until the epoch catches up.
+    void getTime(std::uint64_t uptime_useconds,  //<! The current microseconds since boot
+                 std::uint32_t& seconds,         //<! The extrapolated epoch seconds
+                 std::uint32_t& useconds         //<! The extrapolated microseconds in [0, 999999]
+    );
+
+    //! Discards the cached epoch and drift samples so the next time request reads the RTC
+    //!
+    //! The drift estimate itself is kept since it describes the oscillators rather than the epoch.
+    void invalidate();
+
+    //! Tells the caller if the cached epoch is anchored to an RTC reading
+    bool isSynchronized() const;
+
+    //! Number of times the cached epoch has been anchored to the RTC
+    std::uint32_t getResyncCount() const;
+
+    //! Drift measured at the most recent resync in microseconds
+    std::int64_t getLastDrift() const;
+
+    //! Estimated rate of the RTC relative to uptime in parts per billion, positive when the RTC runs fast
+    std::int64_t getDriftPpb() const;
+
+  private:
+    // ----------------------------------------------------------------------
+    // Private helper methods
+    // ----------------------------------------------------------------------
+
+    //! Adds an RTC reading to the drift regression and refits the estimate
+    void updateDriftModel(std::uint32_t rtc_seconds,     //<! The epoch seconds read from the RTC
+                          std::uint64_t uptime_useconds  //<! The microseconds since boot when the RTC was read
+    );
+
+    //! Extrapolated epoch in microseconds at the given uptime
+    std::uint64_t extrapolateUseconds(std::uint64_t uptime_useconds  //<! The current microseconds since boot
+    ) const;
+
   private:
     // ----------------------------------------------------------------------
     // Private member variables
     // ----------------------------------------------------------------------
 
-    std::uint32_t m_last_seen_seconds;  //!< The last seen seconds value from the RTC
-    std::uint32_t m_useconds_offset;    //!< The offset to apply to microseconds to ensure monotonicity
+    std::uint32_t m_last_seen_seconds = UINT32_MAX;  //!< The last seen seconds value from the RTC
+    std::uint32_t m_useconds_offset = 0;             //!< The offset to apply to microseconds to ensure monotonicity
+
+    bool m_synchronized = false;                 //!< Whether the cached epoch is anchored to an RTC reading
+    std::uint64_t m_anchor_epoch_useconds = 0;   //!< The epoch in microseconds at the anchor point
+    std::uint64_t m_anchor_uptime_useconds = 0;  //!< The microseconds since boot at the anchor point
+    std::uint64_t m_last_resync_useconds = 0;    //!< The microseconds since boot of the last RTC reading
+    std::uint32_t m_resync_count = 0;            //!< The number of RTC readings folded into the cache
+    std::int64_t m_last_drift = 0;               //!< The drift measured at the last RTC reading in microseconds
+    std::uint64_t m_last_time_useconds = 0;      //!< The last epoch returned by getTime in microseconds
+
+    std::uint64_t m_drift_origin_uptime = 0;             //!< Microseconds since boot of the first regression reading
+    std::int64_t m_drift_origin_offset = 0;              //!< RTC epoch minus uptime of the first regression reading
+    std::uint64_t m_drift_bin_start[DRIFT_WINDOW] = {};  //!< Microseconds since boot of the first reading in each bin
+    std::int64_t m_drift_sum_x[DRIFT_WINDOW] = {};       //!< Sum of uptime relative to the origin in each bin
+    std::int64_t m_drift_sum_y[DRIFT_WINDOW] = {};       //!< Sum of offset relative to the origin in each bin
+    std::uint32_t m_drift_samples[DRIFT_WINDOW] = {};    //!< Number of readings in each bin
+    std::size_t m_drift_head = 0;                        //!< Index of the bin accepting readings
+    std::size_t m_drift_count = 0;                       //!< Number of bins holding readings
+    std::int64_t m_drift_ppb = 0;                        //!< Applied drift estimate in parts per billion
 };
 
 }  // namespace Drv
@@ -17,7 +17,9 @@ RtcManager ::RtcManager(const char* const compName)
       m_rtcHelper(),
       m_RtcNotReadyThrottle(false),
       m_RtcGetTimeFailedThrottle(false),
-      m_RtcInvalidTimeThrottle(false) {
+      m_RtcInvalidTimeThrottle(false),
+      m_timeCacheEnabled(true),
+      m_resyncPeriodSeconds(60) {
     // alarm time initialization
     memset(&this->m_alarm_time, 0, sizeof(struct rtc_time));
 }
@@ -48,48 +50,71 @@ void RtcManager ::timeGetPort_handler(FwIndexType portNum, Fw::Time& time) {
     U32 seconds_since_boot = static_cast<U32>(t / 1000);
     U32 useconds_since_boot = static_cast<U32>((t % 1000) * 1000);
 
-    // Check device readiness
-    if (!device_is_ready(this->m_dev)) {
-        this->log_CONSOLE_RtcNotReady();
-
-        // Use uptime as fallback
-        time.set(TimeBase::TB_PROC_TIME, 0, seconds_since_boot, useconds_since_boot);
-        return;
-    }
-    this->log_CONSOLE_RtcNotReady_ThrottleClear();
+    // Answer from the cached RTC epoch, only touching the RTC when the cache is stale
+    if (this->m_timeCacheEnabled) {
+        U64 uptime_useconds = k_ticks_to_us_floor64(k_uptime_ticks());
+        U64 resync_period_useconds = static_cast<U64>(this->m_resyncPeriodSeconds) * 1000000;
+
+        Os::ScopeLock lock(this->m_timeCacheLock);
+        if (this->m_rtcHelper.resyncDue(uptime_useconds, resync_period_useconds)) {
+            U32 seconds_real_time = 0;
+            if (this->readRtcSeconds(seconds_real_time)) {
+                this->m_rtcHelper.resync(seconds_real_time, uptime_useconds);
+            }
+        }
 
-    // Get time from RTC
-    struct rtc_time time_rtc = {};
-    const int rc = rtc_get_time(this->m_dev, &time_rtc);
-    if (rc != 0) {
-        this->log_CONSOLE_RtcGetTimeFailed(rc);
+        // Keep serving the last anchor through transient RTC failures
+        if (this->m_rtcHelper.isSynchronized()) {
+            U32 seconds = 0;
+            U32 useconds = 0;
+            this->m_rtcHelper.getTime(uptime_useconds, seconds, useconds);
+            time.set(TimeBase::TB_SC_TIME, 0, seconds, useconds);
+            return;
+        }
 
         // Use uptime as fallback
         time.set(TimeBase::TB_PROC_TIME, 0, seconds_since_boot, useconds_since_boot);
         return;
     }
-    this->log_CONSOLE_RtcGetTimeFailed_ThrottleClear();
-
-    // Convert to generic tm struct
-    struct tm* time_tm = rtc_time_to_tm(&time_rtc);
-
-    // Convert to time_t (seconds since epoch)
-    errno = 0;
-    U32 seconds_real_time = static_cast<U32>(timeutil_timegm(time_tm));
-    if (errno == ERANGE) {
-        this->log_CONSOLE_RtcInvalidTime();
 
+    // Get time from RTC
+    U32 seconds_real_time = 0;
+    if (!this->readRtcSeconds(seconds_real_time)) {
         // Use uptime as fallback
         time.set(TimeBase::TB_PROC_TIME, 0, seconds_since_boot, useconds_since_boot);
         return;
     }
-    this->log_CONSOLE_RtcInvalidTime_ThrottleClear();
 
     // Set FPrime time object
     time.set(TimeBase::TB_SC_TIME, 0, seconds_real_time,
              this->m_rtcHelper.rescaleUseconds(seconds_real_time, useconds_since_boot));
 }
 
+void RtcManager ::run_handler(FwIndexType portNum, U32 context) {
+    Fw::ParamValid valid;
+
+    // Refresh the time service configuration from parameters
+    Drv::RtcTimeMode time_mode = this->paramGet_TIME_MODE(valid);
+    this->m_timeCacheEnabled = (time_mode == Drv::RtcTimeMode::CACHED);
+    this->m_resyncPeriodSeconds = this->paramGet_RESYNC_PERIOD(valid);
+
+    // Snapshot cache statistics, the lock must be released before telemetry asks for the time
+    U32 resync_count = 0;
+    I64 drift = 0;
+    I64 drift_ppb = 0;
+    {
+        Os::ScopeLock lock(this->m_timeCacheLock);
+        resync_count = this->m_rtcHelper.getResyncCount();
+        drift = this->m_rtcHelper.getLastDrift();
+        drift_ppb = this->m_rtcHelper.getDriftPpb();
+    }
+
+    this->tlmWrite_TimeMode(time_mode);
+    this->tlmWrite_ResyncCount(resync_count);
+    this->tlmWrite_ResyncDrift(static_cast<I32>(drift));
+    this->tlmWrite_DriftPpm(static_cast<F32>(drift_ppb) / 1000.0f);
+}
+
 // ----------------------------------------------------------------------
 // Handler implementations for commands
 // ----------------------------------------------------------------------
@@ -151,6 +176,12 @@ void RtcManager ::TIME_SET_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, Drv::Time
         return;
     }
 
+    // Force the cached epoch to be re-read from the new RTC time
+    {
+        Os::ScopeLock lock(this->m_timeCacheLock);
+        this->m_rtcHelper.invalidate();
+    }
+
     // Emit time set event, include previous time for reference
     this->log_ACTIVITY_HI_TimeSet(time_before_set.getSeconds(), time_before_set.getUSeconds());
 
@@ -370,6 +401,38 @@ void RtcManager ::log_CONSOLE_RtcInvalidTime_ThrottleClear() {
     this->m_RtcInvalidTimeThrottle = false;
 }
 
+bool RtcManager ::readRtcSeconds(U32& seconds) {
+    // Check device readiness
+    if (!device_is_ready(this->m_dev)) {
+        this->log_CONSOLE_RtcNotReady();
+        return false;
+    }
+    this->log_CONSOLE_RtcNotReady_ThrottleClear();
+
+    // Get time from RTC
+    struct rtc_time time_rtc = {};
+    const int rc = rtc_get_time(this->m_dev, &time_rtc);
+    if (rc != 0) {
+        this->log_CONSOLE_RtcGetTimeFailed(rc);
+        return false;
+    }
+    this->log_CONSOLE_RtcGetTimeFailed_ThrottleClear();
+
+    // Convert to generic tm struct
+    struct tm* time_tm = rtc_time_to_tm(&time_rtc);
+
+    // Convert to time_t (seconds since epoch)
+    errno = 0;
+    seconds = static_cast<U32>(timeutil_timegm(time_tm));
+    if (errno == ERANGE) {
+        this->log_CONSOLE_RtcInvalidTime();
+        return false;
+    }
+    this->log_CONSOLE_RtcInvalidTime_ThrottleClear();
+
+    return true;
+}
+
 bool RtcManager ::timeDataIsValid(Drv::TimeData t) {
     bool valid = true;
 
@@ -7,6 +7,7 @@
 #define Components_RtcManager_HPP
 
 #include <Fw/Logger/Logger.hpp>
+#include <Os/Mutex.hpp>
 #include <atomic>
 #include <cerrno>
 
@@ -57,6 +58,13 @@ class RtcManager final : public RtcManagerComponentBase {
                              Fw::Time& time        //!< Reference to Time object
                              ) override;
 
+    //! Handler implementation for run
+    //!
+    //! Port to trigger periodic telemetry updating
+    void run_handler(FwIndexType portNum,  //!< The port number
+                     U32 context           //!< The call order
+                     ) override;
+
   private:
     // ----------------------------------------------------------------------
     // Handler implementations for commands
@@ -125,6 +133,12 @@ class RtcManager final : public RtcManagerComponentBase {
     //! Validate time data
     bool timeDataIsValid(Drv::TimeData t);
 
+    //! Read the epoch seconds from the RTC, logging failures to the console with throttling
+    //!
+    //! WARNING: This method is in the critical path of timeGetPort and must not emit events or telemetry.
+    bool readRtcSeconds(U32& seconds  //!< The epoch seconds read from the RTC
+    );
+
   private:
     // ----------------------------------------------------------------------
     // Private member variables
@@ -136,6 +150,11 @@ class RtcManager final : public RtcManagerComponentBase {
     std::atomic<bool> m_RtcGetTimeFailedThrottle;  //!< Throttle for RtcGetTimeFailed
     std::atomic<bool> m_RtcInvalidTimeThrottle;    //!< Throttle for RtcInvalidTime
 
+    // cached time members
+    Os::Mutex m_timeCacheLock;                //!< Protects the cached RTC epoch held by m_rtcHelper
+    std::atomic<bool> m_timeCacheEnabled;     //!< Whether time requests are answered from the cached epoch
+    std::atomic<U32> m_resyncPeriodSeconds;  //!< Maximum age of the cached epoch in seconds
+
     // rtc alarm members
     U16 m_curr_mask;               //!< The mask of the alarm present on hardware
     struct rtc_time m_alarm_time;  //!< Current alarm's time settings
@@ -0,0 +1,84 @@
+// ======================================================================
+// \title  AxisRemap.cpp
+// \brief  cpp file for the sensor to body frame axis remapping
+// ======================================================================
+
+#include "AxisRemap.hpp"
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+//  Construction
+// ----------------------------------------------------------------------
+
+AxisRemap ::AxisRemap() : m_rows{{{0, 1}, {1, 1}, {2, 1}}} {}
+
+bool AxisRemap ::fromSignedAxes(const std::array<SignedAxis, 3>& axes, AxisRemap& remap) {
+    AxisRemap built;
+    bool used[3] = {false, false, false};
+    for (std::uint8_t axis = 0; axis < 3; axis++) {
+        std::uint8_t code = static_cast<std::uint8_t>(axes[axis]);
+        std::uint8_t source = code / 2;
+        if (source > 2 || used[source]) {
+            return false;
+        }
+        used[source] = true;
+        built.m_rows[axis] = Row{source, static_cast<std::int8_t>((code % 2 == 0) ? 1 : -1)};
+    }
+    remap = built;
+    return true;
+}
+
+AxisRemap AxisRemap ::quarterTurnsZ(int turns) {
+    AxisRemap turn;
+    turn.m_rows[0] = Row{1, -1};
+    turn.m_rows[1] = Row{0, 1};
+
+    AxisRemap result;
+    for (int i = 0; i < ((turns % 4) + 4) % 4; i++) {
+        result = turn.compose(result);
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------
+//  Public helper methods
+// ----------------------------------------------------------------------
+
+AxisRemap AxisRemap ::compose(const AxisRemap& first) const {
+    // Body axis i takes sign_i times intermediate axis s_i, which is itself a signed sensor axis of first
+    AxisRemap result;
+    for (std::uint8_t axis = 0; axis < 3; axis++) {
+        const Row& row = this->m_rows[axis];
+        const Row& inner = first.m_rows[row.source];
+        result.m_rows[axis] = Row{inner.source, static_cast<std::int8_t>(row.sign * inner.sign)};
+    }
+    return result;
+}
+
+std::int8_t AxisRemap ::element(std::uint8_t row, std::uint8_t column) const {
+    return (this->m_rows[row].source == column) ? this->m_rows[row].sign : 0;
+}
+
+int AxisRemap ::determinant() const {
+    // Sign of the permutation, from its number of inversions, times the signs of the entries
+    int determinant = 1;
+    for (std::uint8_t i = 0; i < 3; i++) {
+        determinant *= this->m_rows[i].sign;
+        for (std::uint8_t j = i + 1; j < 3; j++) {
+            if (this->m_rows[i].source > this->m_rows[j].source) {
+                determinant = -determinant;
+            }
+        }
+    }
+    return determinant;
+}
+
+void AxisRemap ::apply(double& x, double& y, double& z) const {
+    const double in[3] = {x, y, z};
+    x = this->m_rows[0].sign * in[this->m_rows[0].source];
+    y = this->m_rows[1].sign * in[this->m_rows[1].source];
+    z = this->m_rows[2].sign * in[this->m_rows[2].source];
+}
+
+}  // namespace Components
@@ -0,0 +1,88 @@
+// ======================================================================
+// \title  AxisRemap.hpp
+// \brief  hpp file for the sensor to body frame axis remapping
+// ======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Components {
+
+//! Sensor to body frame axis remapping as a signed permutation matrix
+//!
+//! Row i holds a single ±1 in the column of the sensor axis that becomes body axis i, so applying the matrix only
+//! moves and negates values. Readings in integer fixed point, such as Zephyr's sensor_value (val1, val2), are
+//! remapped exactly without a round trip through floating point. Every axis aligned mounting of a board is a signed
+//! permutation, proper rotations have determinant +1 and mirrored mountings -1.
+class AxisRemap {
+  public:
+    //! Sensor axis and direction feeding one body axis
+    enum class SignedAxis : std::uint8_t {
+        POS_X,  //!< +X of the sensor
+        NEG_X,  //!< -X of the sensor
+        POS_Y,  //!< +Y of the sensor
+        NEG_Y,  //!< -Y of the sensor
+        POS_Z,  //!< +Z of the sensor
+        NEG_Z,  //!< -Z of the sensor
+    };
+
+    //! One row of the matrix
+    struct Row {
+        std::uint8_t source;  //!< Sensor axis index, 0 to 2
+        std::int8_t sign;     //!< +1 or -1
+    };
+
+  public:
+    // ----------------------------------------------------------------------
+    //  Construction
+    // ----------------------------------------------------------------------
+
+    //! Construct the identity remapping
+    AxisRemap();
+
+    //! Build the remapping taking body X, Y and Z from the given sensor axes
+    //!
+    //! Returns false and leaves remap unchanged unless each sensor axis is used exactly once.
+    static bool fromSignedAxes(const std::array<SignedAxis, 3>& axes,  //!< Sensor axis for body X, Y and Z
+                               AxisRemap& remap                        //!< Built remapping
+    );
+
+    //! Rotation by quarter turns about Z, where one turn maps (x, y) to (-y, x)
+    static AxisRemap quarterTurnsZ(int turns);
+
+  public:
+    // ----------------------------------------------------------------------
+    //  Public helper methods
+    // ----------------------------------------------------------------------
+
+    //! Remapping equal to applying first and then this one
+    AxisRemap compose(const AxisRemap& first) const;
+
+    //! Matrix element at row, column, one of -1, 0 and +1
+    std::int8_t element(std::uint8_t row, std::uint8_t column) const;
+
+    //! Determinant of the matrix, +1 for rotations and -1 for mirrored mountings
+    int determinant() const;
+
+    //! Remap a reading held in integer and fractional parts, as Zephyr's sensor_value
+    template <typename Value>
+    void apply(Value& x, Value& y, Value& z) const {
+        const Value in[3] = {x, y, z};
+        Value* out[3] = {&x, &y, &z};
+        for (std::uint8_t axis = 0; axis < 3; axis++) {
+            const Row& row = this->m_rows[axis];
+            out[axis]->val1 = row.sign * in[row.source].val1;
+            out[axis]->val2 = row.sign * in[row.source].val2;
+        }
+    }
+
+    //! Remap a reading in floating point
+    void apply(double& x, double& y, double& z) const;
+
+  private:
+    std::array<Row, 3> m_rows;  //!< Rows of the matrix, body X, Y and Z
+};
+
+}  // namespace Components
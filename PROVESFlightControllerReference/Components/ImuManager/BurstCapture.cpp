@@ -0,0 +1,218 @@
+// ======================================================================
+// \title  BurstCapture.cpp
+// \brief  cpp file for double buffered IMU burst capture records
+// ======================================================================
+
+#include "BurstCapture.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+void putU16(std::uint8_t* bytes, std::uint16_t value) {
+    bytes[0] = static_cast<std::uint8_t>(value);
+    bytes[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+void putU32(std::uint8_t* bytes, std::uint32_t value) {
+    for (std::size_t i = 0; i < 4; i++) {
+        bytes[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+void putF32(std::uint8_t* bytes, float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(bytes, bits);
+}
+
+std::uint16_t getU16(const std::uint8_t* bytes) {
+    return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+std::uint32_t getU32(const std::uint8_t* bytes) {
+    std::uint32_t value = 0;
+    for (std::size_t i = 0; i < 4; i++) {
+        value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+float getF32(const std::uint8_t* bytes) {
+    std::uint32_t bits = getU32(bytes);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+}  // namespace
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+//  Encoding
+// ----------------------------------------------------------------------
+
+void BurstCapture ::encodeHeader(const Header& header, std::uint8_t* bytes) {
+    putU32(bytes + 0, MAGIC);
+    putU16(bytes + 4, VERSION);
+    putU16(bytes + 6, static_cast<std::uint16_t>(RECORD_SIZE));
+    putF32(bytes + 8, header.sampling_frequency_hz);
+    putF32(bytes + 12, header.accel_scale);
+    putF32(bytes + 16, header.gyro_scale);
+    putU32(bytes + 20, header.start_seconds);
+    putU32(bytes + 24, header.start_useconds);
+    putU32(bytes + 28, header.start_ticks);
+    bytes[32] = header.axes[0];
+    bytes[33] = header.axes[1];
+    bytes[34] = header.axes[2];
+    bytes[35] = 0;
+    encodeCounts(header.records, header.dropped, bytes + COUNTS_OFFSET);
+}
+
+bool BurstCapture ::decodeHeader(const std::uint8_t* bytes, Header& header) {
+    if (getU32(bytes + 0) != MAGIC || getU16(bytes + 4) != VERSION || getU16(bytes + 6) != RECORD_SIZE) {
+        return false;
+    }
+    header.sampling_frequency_hz = getF32(bytes + 8);
+    header.accel_scale = getF32(bytes + 12);
+    header.gyro_scale = getF32(bytes + 16);
+    header.start_seconds = getU32(bytes + 20);
+    header.start_useconds = getU32(bytes + 24);
+    header.start_ticks = getU32(bytes + 28);
+    header.axes = {bytes[32], bytes[33], bytes[34]};
+    header.records = getU32(bytes + COUNTS_OFFSET);
+    header.dropped = getU32(bytes + COUNTS_OFFSET + 4);
+    return true;
+}
+
+void BurstCapture ::encodeCounts(std::uint32_t records, std::uint32_t dropped, std::uint8_t* bytes) {
+    putU32(bytes + 0, records);
+    putU32(bytes + 4, dropped);
+}
+
+void BurstCapture ::encodeRecord(const Lsm6dsoFifo::Sample& sample, std::uint8_t* bytes) {
+    putU32(bytes, sample.timestamp_ticks);
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        putU16(bytes + 4 + 2 * axis, static_cast<std::uint16_t>(sample.acceleration_raw[axis]));
+        putU16(bytes + 10 + 2 * axis, static_cast<std::uint16_t>(sample.angular_velocity_raw[axis]));
+    }
+}
+
+void BurstCapture ::decodeRecord(const std::uint8_t* bytes, Lsm6dsoFifo::Sample& sample) {
+    sample.timestamp_ticks = getU32(bytes);
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        sample.acceleration_raw[axis] = static_cast<std::int16_t>(getU16(bytes + 4 + 2 * axis));
+        sample.angular_velocity_raw[axis] = static_cast<std::int16_t>(getU16(bytes + 10 + 2 * axis));
+    }
+}
+
+// ----------------------------------------------------------------------
+//  Staging
+// ----------------------------------------------------------------------
+
+BurstCapture ::BurstCapture(std::uint8_t* storage, std::size_t buffer_size)
+    : m_buffers{{{storage, 0, 0, false}, {storage + buffer_size, 0, 0, false}}},
+      m_buffer_size(buffer_size - (buffer_size % RECORD_SIZE)) {}
+
+void BurstCapture ::start(double sampling_frequency_hz) {
+    for (Buffer& buffer : this->m_buffers) {
+        buffer.used = 0;
+        buffer.written = 0;
+        buffer.full = false;
+    }
+    this->m_filling = 0;
+    this->m_finished = false;
+    this->m_period_ticks =
+        (sampling_frequency_hz > 0.0) ? 1e6 / (sampling_frequency_hz * Lsm6dsoFifo::TIMESTAMP_TICK_US) : 0.0;
+    this->m_have_last = false;
+    this->m_records = 0;
+    this->m_dropped = 0;
+}
+
+void BurstCapture ::append(const Lsm6dsoFifo::Sample& sample) {
+    if (this->m_finished) {
+        return;
+    }
+
+    // Samples the FIFO overwrote show up as a gap of several periods between consecutive timestamps
+    if (this->m_have_last && this->m_period_ticks > 0.0) {
+        double periods = static_cast<double>(sample.timestamp_ticks - this->m_last_ticks) / this->m_period_ticks;
+        long missing = std::lround(periods) - 1;
+        if (missing > 0) {
+            this->m_dropped += static_cast<std::uint32_t>(missing);
+        }
+    }
+    this->m_last_ticks = sample.timestamp_ticks;
+    this->m_have_last = true;
+
+    Buffer* filling = &this->m_buffers[this->m_filling];
+    Buffer& other = this->m_buffers[1 - this->m_filling];
+    if (filling->used + RECORD_SIZE > this->m_buffer_size) {
+        if (other.full) {
+            this->m_dropped++;
+            return;
+        }
+        filling->full = true;
+        this->m_filling = 1 - this->m_filling;
+        filling = &other;
+    }
+
+    encodeRecord(sample, filling->data + filling->used);
+    filling->used += RECORD_SIZE;
+    this->m_records++;
+}
+
+void BurstCapture ::finish() {
+    this->m_finished = true;
+}
+
+bool BurstCapture ::pendingWrite(const std::uint8_t*& data, std::size_t& size) const {
+    std::size_t index = this->writeIndex();
+    if (index == BUFFER_COUNT) {
+        return false;
+    }
+    const Buffer& buffer = this->m_buffers[index];
+    data = buffer.data + buffer.written;
+    size = buffer.used - buffer.written;
+    return true;
+}
+
+void BurstCapture ::written(std::size_t bytes) {
+    std::size_t index = this->writeIndex();
+    if (index == BUFFER_COUNT) {
+        return;
+    }
+    Buffer& buffer = this->m_buffers[index];
+    buffer.written += (bytes < buffer.used - buffer.written) ? bytes : buffer.used - buffer.written;
+    if (buffer.written == buffer.used) {
+        buffer.used = 0;
+        buffer.written = 0;
+        buffer.full = false;
+    }
+}
+
+std::uint32_t BurstCapture ::getRecords() const {
+    return this->m_records;
+}
+
+std::uint32_t BurstCapture ::getDropped() const {
+    return this->m_dropped;
+}
+
+// ----------------------------------------------------------------------
+//  Private helper methods
+// ----------------------------------------------------------------------
+
+std::size_t BurstCapture ::writeIndex() const {
+    // The full buffer is older than the one filling
+    std::size_t other = 1 - this->m_filling;
+    if (this->m_buffers[other].full) {
+        return other;
+    }
+    if (this->m_finished && this->m_buffers[this->m_filling].used > this->m_buffers[this->m_filling].written) {
+        return this->m_filling;
+    }
+    return BUFFER_COUNT;
+}
+
+}  // namespace Components
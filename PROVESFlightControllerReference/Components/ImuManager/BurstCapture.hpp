@@ -0,0 +1,134 @@
+// ======================================================================
+// \title  BurstCapture.hpp
+// \brief  hpp file for double buffered IMU burst capture records
+// ======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Lsm6dsoFifo.hpp"
+
+namespace Components {
+
+//! Double buffered staging of LSM6DSO FIFO samples for a burst capture file
+//!
+//! Samples are packed as fixed size records into one of two buffers while the other is written out. A full buffer is
+//! handed to the writer and filling continues in the other one. When both are full the new sample is dropped. Samples
+//! the FIFO lost to an overrun are counted from gaps in the sensor timestamps.
+//!
+//! The file starts with a HEADER_SIZE byte header followed by RECORD_SIZE byte records, all little endian:
+//!
+//! | Offset | Header field                                   | Record field                     |
+//! | ------ | ---------------------------------------------- | -------------------------------- |
+//! | 0      | magic "IMUB"                                   | sensor timestamp ticks, U32      |
+//! | 4      | version U16, record size U16                   | acceleration X, Y, Z in LSB, I16 |
+//! | 8      | sampling frequency in Hz, F32                  | angular velocity X, Y, Z in LSB  |
+//! | 12     | m/s^2 per acceleration LSB, F32                |                                  |
+//! | 16     | rad/s per angular velocity LSB, F32            |                                  |
+//! | 20     | system time seconds and microseconds, U32 each |                                  |
+//! | 28     | sensor timestamp ticks at that time, U32       |                                  |
+//! | 32     | signed sensor axis of body X, Y and Z, U8 each |                                  |
+//! | 36     | record count and dropped samples, U32 each     |                                  |
+//!
+//! Records are in the sensor frame and ticks are TIMESTAMP_TICK_US apart. Axis codes are AxisRemap::SignedAxis values.
+class BurstCapture {
+  public:
+    static constexpr std::uint32_t MAGIC = 0x42554D49;  //!< "IMUB" read as a little endian U32
+    static constexpr std::uint16_t VERSION = 1;         //!< File format version
+    static constexpr std::size_t HEADER_SIZE = 44;      //!< Bytes before the first record
+    static constexpr std::size_t COUNTS_OFFSET = 36;    //!< Offset of the counts, written when the capture ends
+    static constexpr std::size_t COUNTS_SIZE = 8;       //!< Record count and dropped samples
+    static constexpr std::size_t RECORD_SIZE = 16;      //!< Bytes per sample
+    static constexpr std::size_t BUFFER_COUNT = 2;      //!< One buffer fills while the other is written
+
+    //! File header
+    struct Header {
+        float sampling_frequency_hz;       //!< Batch data rate of both sensors
+        float accel_scale;                 //!< m/s^2 per acceleration LSB
+        float gyro_scale;                  //!< rad/s per angular velocity LSB
+        std::uint32_t start_seconds;       //!< System time paired with start_ticks
+        std::uint32_t start_useconds;      //!< System time paired with start_ticks
+        std::uint32_t start_ticks;         //!< Sensor timestamp counter at the start time
+        std::array<std::uint8_t, 3> axes;  //!< Signed sensor axis of body X, Y and Z
+        std::uint32_t records;             //!< Records in the file
+        std::uint32_t dropped;             //!< Samples lost to FIFO overruns or full buffers
+    };
+
+  public:
+    // ----------------------------------------------------------------------
+    //  Encoding
+    // ----------------------------------------------------------------------
+
+    //! Encode the header into HEADER_SIZE bytes
+    static void encodeHeader(const Header& header, std::uint8_t* bytes);
+
+    //! Decode HEADER_SIZE bytes, returns false if the magic or version does not match
+    static bool decodeHeader(const std::uint8_t* bytes, Header& header);
+
+    //! Encode the record count and dropped samples into the COUNTS_SIZE bytes at COUNTS_OFFSET
+    static void encodeCounts(std::uint32_t records, std::uint32_t dropped, std::uint8_t* bytes);
+
+    //! Encode the raw counts and timestamp of a sample into RECORD_SIZE bytes
+    static void encodeRecord(const Lsm6dsoFifo::Sample& sample, std::uint8_t* bytes);
+
+    //! Decode RECORD_SIZE bytes into the raw counts and timestamp of a sample
+    static void decodeRecord(const std::uint8_t* bytes, Lsm6dsoFifo::Sample& sample);
+
+  public:
+    // ----------------------------------------------------------------------
+    //  Staging
+    // ----------------------------------------------------------------------
+
+    //! Stage records in storage, which holds BUFFER_COUNT buffers of buffer_size bytes each
+    BurstCapture(std::uint8_t* storage,   //!< BUFFER_COUNT * buffer_size bytes
+                 std::size_t buffer_size  //!< Bytes per buffer, a multiple of RECORD_SIZE
+    );
+
+    //! Empty both buffers and reset the counters for a capture at the given sampling frequency
+    void start(double sampling_frequency_hz);
+
+    //! Stage one sample, counting it as dropped if both buffers are full
+    void append(const Lsm6dsoFifo::Sample& sample);
+
+    //! Stop staging, after which pendingWrite also returns the partly filled buffer
+    void finish();
+
+    //! Bytes waiting to be written, oldest first, returns false if there are none
+    bool pendingWrite(const std::uint8_t*& data, std::size_t& size) const;
+
+    //! Mark the first bytes returned by pendingWrite as written
+    void written(std::size_t bytes);
+
+    //! Records staged since start
+    std::uint32_t getRecords() const;
+
+    //! Samples lost to FIFO overruns or full buffers since start
+    std::uint32_t getDropped() const;
+
+  private:
+    //! One staging buffer
+    struct Buffer {
+        std::uint8_t* data;   //!< buffer_size bytes
+        std::size_t used;     //!< Bytes staged
+        std::size_t written;  //!< Bytes already written out
+        bool full;            //!< Handed to the writer
+    };
+
+    //! Index of the buffer pendingWrite returns, or BUFFER_COUNT if none
+    std::size_t writeIndex() const;
+
+    std::array<Buffer, BUFFER_COUNT> m_buffers;  //!< Staging buffers
+    std::size_t m_buffer_size;                   //!< Bytes per buffer
+    std::size_t m_filling = 0;                   //!< Buffer records are staged into
+    bool m_finished = false;                     //!< Staging has stopped
+    double m_period_ticks = 0.0;                 //!< Nominal sensor ticks between samples
+    bool m_have_last = false;                    //!< A sample has been seen since start
+    std::uint32_t m_last_ticks = 0;              //!< Timestamp of the last sample seen
+    std::uint32_t m_records = 0;                 //!< Records staged
+    std::uint32_t m_dropped = 0;                 //!< Samples lost
+};
+
+}  // namespace Components
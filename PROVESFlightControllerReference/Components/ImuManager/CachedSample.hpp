@@ -0,0 +1,58 @@
+// ======================================================================
+// \title  CachedSample.hpp
+// \brief  Freshness stamped cache of the latest reading of one sensor channel
+// ======================================================================
+
+#pragma once
+
+#include <cstdint>
+
+namespace Components {
+
+//! Latest reading of one sensor channel and the uptime it was fetched at
+//!
+//! Readers pass the current uptime and the maximum age they accept. A maximum age of zero never hits, so every read
+//! goes to the bus. Uptime moving backwards, as after a reset of the clock source, also misses.
+template <typename T>
+class CachedSample {
+  public:
+    //! Copy the cached reading into value if it is younger than max_age_useconds, counting a hit
+    bool get(std::uint64_t uptime_useconds,   //!< The current microseconds since boot
+             std::uint64_t max_age_useconds,  //!< The oldest reading accepted in microseconds
+             T& value                         //!< The cached reading, written only on a hit
+    ) {
+        if (!this->m_valid || uptime_useconds < this->m_fetched_useconds ||
+            uptime_useconds - this->m_fetched_useconds >= max_age_useconds) {
+            return false;
+        }
+        value = this->m_value;
+        this->m_hits++;
+        return true;
+    }
+
+    //! Store a reading fetched from the bus
+    void store(const T& value,                //!< The fetched reading
+               std::uint64_t uptime_useconds  //!< The microseconds since boot it was fetched at
+    ) {
+        this->m_value = value;
+        this->m_fetched_useconds = uptime_useconds;
+        this->m_valid = true;
+    }
+
+    //! Forget the cached reading, used when the sensor is reconfigured
+    void invalidate() { this->m_valid = false; }
+
+    //! The most recently stored reading, whatever its age
+    const T& value() const { return this->m_value; }
+
+    //! Number of reads answered from the cache since construction
+    std::uint32_t getHits() const { return this->m_hits; }
+
+  private:
+    T m_value{};                           //!< Latest reading
+    std::uint64_t m_fetched_useconds = 0;  //!< Uptime the reading was fetched at
+    bool m_valid = false;                  //!< A reading has been stored since construction or invalidation
+    std::uint32_t m_hits = 0;              //!< Reads answered from the cache
+};
+
+}  // namespace Components
@@ -6,7 +6,12 @@
 #include "PROVESFlightControllerReference/Components/ImuManager/ImuManager.hpp"
 
 #include <Fw/Types/Assert.hpp>
-#include <cmath>
+#include <Os/Task.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+#include "PROVESFlightControllerReference/Components/DetumbleManager/DetumbleScalar.hpp"
 
 namespace {
 constexpr double PI = 3.14159265358979323846;
@@ -19,21 +24,67 @@ namespace Components {
 // Component construction and destruction
 // ----------------------------------------------------------------------
 
-ImuManager ::ImuManager(const char* const compName) : ImuManagerComponentBase(compName) {}
+ImuManager ::ImuManager(const char* const compName)
+    : ImuManagerComponentBase(compName), m_data_ready(), m_capture(m_capture_storage, CAPTURE_BUFFER_SIZE) {
+    this->m_data_ready.owner = this;
+}
 
 ImuManager ::~ImuManager() {}
 
 // ----------------------------------------------------------------------
 // Public helper methods
 // ----------------------------------------------------------------------
-void ImuManager ::configure(const struct device* lis2mdl, const struct device* lsm6dso) {
+void ImuManager ::configure(const struct device* lis2mdl,
+                            const struct device* lsm6dso,
+                            const struct i2c_dt_spec* lsm6dso_bus,
+                            const struct gpio_dt_spec* lis2mdl_drdy) {
     this->m_lis2mdl = lis2mdl;
     this->m_lsm6dso = lsm6dso;
+    this->m_lsm6dso_bus = lsm6dso_bus;
+    this->m_lis2mdl_drdy = lis2mdl_drdy;
 
-    struct sensor_value magn_odr = this->getMagnetometerSamplingFrequency();
-    struct sensor_value accel_odr = this->getAccelerometerSamplingFrequency();
-    struct sensor_value gyro_odr = this->getGyroscopeSamplingFrequency();
-    this->configureSensors(magn_odr, accel_odr, gyro_odr);
+    this->configureSensorsFromParameters();
+    this->updateAxisRemap();
+
+    Fw::Enabled data_ready = this->getDataReadyMode();
+    this->m_data_ready_enabled = this->configureDataReady(data_ready);
+    this->m_curr_data_ready_mode = data_ready;
+}
+
+void ImuManager ::parameterUpdated(FwPrmIdType id) {
+    switch (id) {
+        case ImuManager::PARAMID_AXIS_ORIENTATION:
+        case ImuManager::PARAMID_AXIS_MAPPING:
+            this->updateAxisRemap();
+            break;
+        case ImuManager::PARAMID_ACCELEROMETER_SAMPLING_FREQUENCY:
+        case ImuManager::PARAMID_GYROSCOPE_SAMPLING_FREQUENCY:
+        case ImuManager::PARAMID_MAGNETOMETER_SAMPLING_FREQUENCY:
+        case ImuManager::PARAMID_FIFO_MODE:
+        case ImuManager::PARAMID_MAGNETOMETER_DATA_READY:
+            // Applied by run, which reconfigures the sensors when these change
+            break;
+        case ImuManager::PARAMID_ACCELERATION_MAX_AGE_MS:
+        case ImuManager::PARAMID_ANGULAR_VELOCITY_MAX_AGE_MS:
+        case ImuManager::PARAMID_MAGNETIC_FIELD_MAX_AGE_MS:
+            // Read on every port call
+            break;
+        case ImuManager::PARAMID_MAG_CALIBRATION_SOLVE_INTERVAL: {
+            Fw::ParamValid valid;
+            U32 interval = this->paramGet_MAG_CALIBRATION_SOLVE_INTERVAL(valid);
+            Os::ScopeLock lock(this->m_sampleCacheLock);
+            this->m_magCalibrationSolveInterval = interval;
+            break;
+        }
+        default:
+            FW_ASSERT(0);
+            break;  // Fallthrough from assert (static analysis)
+    }
+}
+
+void ImuManager ::parametersLoaded() {
+    this->updateAxisRemap();
+    this->parameterUpdated(ImuManager::PARAMID_MAG_CALIBRATION_SOLVE_INTERVAL);
 }
 
 // ----------------------------------------------------------------------
@@ -46,14 +97,34 @@ void ImuManager ::run_handler(FwIndexType portNum, U32 context) {
     Drv::AngularVelocity angular_velocity = this->angularVelocityGet_handler(0, condition);
     Drv::MagneticField magnetic_field = this->magneticFieldGet_handler(0, condition);
 
-    // Check if parameters have changed, and reconfigure sensors if they have
+    bool capture_active;
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        this->tlmWrite_SampleCacheHits(this->m_accelerationCache.getHits() + this->m_angularVelocityCache.getHits() +
+                                       this->m_magneticFieldCache.getHits());
+        this->tlmWrite_BusReads(this->m_busReads);
+        this->tlmWrite_DataReadySamples(this->m_data_ready_samples);
+        this->writeMagCalibrationTelemetry();
+        capture_active = this->m_capture_active;
+    }
+
+    // Check if parameters have changed, and reconfigure sensors if they have. A burst capture runs at its own
+    // sampling frequency and restores the parameters when it ends.
     struct sensor_value magn_odr = this->getMagnetometerSamplingFrequency();
     struct sensor_value accel_odr = this->getAccelerometerSamplingFrequency();
     struct sensor_value gyro_odr = this->getGyroscopeSamplingFrequency();
-    if (!this->sensorValuesEqual(&magn_odr, &this->m_curr_magn_odr) ||
-        !this->sensorValuesEqual(&accel_odr, &this->m_curr_accel_odr) ||
-        !this->sensorValuesEqual(&gyro_odr, &this->m_curr_gyro_odr)) {
-        this->configureSensors(magn_odr, accel_odr, gyro_odr);
+    Fw::Enabled fifo_mode = this->getFifoMode();
+    if (!capture_active && (!this->sensorValuesEqual(&magn_odr, &this->m_curr_magn_odr) ||
+                            !this->sensorValuesEqual(&accel_odr, &this->m_curr_accel_odr) ||
+                            !this->sensorValuesEqual(&gyro_odr, &this->m_curr_gyro_odr) ||
+                            fifo_mode != this->m_curr_fifo_mode)) {
+        this->configureSensors(magn_odr, accel_odr, gyro_odr, fifo_mode);
+    }
+
+    Fw::Enabled data_ready = this->getDataReadyMode();
+    if (data_ready != this->m_curr_data_ready_mode) {
+        this->m_data_ready_enabled = this->configureDataReady(data_ready);
+        this->m_curr_data_ready_mode = data_ready;
     }
 }
 
@@ -66,17 +137,17 @@ Drv::Acceleration ImuManager ::accelerationGet_handler(FwIndexType portNum, Fw::
     }
     this->log_WARNING_HI_Lsm6dsoDeviceNotReady_ThrottleClear();
 
-    sensor_sample_fetch_chan(this->m_lsm6dso, SENSOR_CHAN_ACCEL_XYZ);
-
-    struct sensor_value x, y, z;
-    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_ACCEL_X, &x);
-    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_ACCEL_Y, &y);
-    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_ACCEL_Z, &z);
-
-    this->applyAxisOrientation(x, y, z);
-
-    Drv::Acceleration acceleration =
-        Drv::Acceleration(sensor_value_to_double(&x), sensor_value_to_double(&y), sensor_value_to_double(&z));
+    Drv::Acceleration acceleration;
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        U64 uptime_useconds = k_ticks_to_us_floor64(k_uptime_ticks());
+        if (!this->m_accelerationCache.get(uptime_useconds, this->getMaxAgeUseconds(ACCELERATION), acceleration)) {
+            if (!this->fetchLsm6dso(uptime_useconds)) {
+                return Drv::Acceleration(0.0, 0.0, 0.0);
+            }
+            acceleration = this->m_accelerationCache.value();
+        }
+    }
 
     this->tlmWrite_Acceleration(acceleration);
 
@@ -93,17 +164,18 @@ Drv::AngularVelocity ImuManager ::angularVelocityGet_handler(FwIndexType portNum
     }
     this->log_WARNING_HI_Lsm6dsoDeviceNotReady_ThrottleClear();
 
-    sensor_sample_fetch_chan(this->m_lsm6dso, SENSOR_CHAN_GYRO_XYZ);
-
-    struct sensor_value x, y, z;
-    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_GYRO_X, &x);
-    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_GYRO_Y, &y);
-    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_GYRO_Z, &z);
-
-    this->applyAxisOrientation(x, y, z);
-
-    Drv::AngularVelocity angular_velocity =
-        Drv::AngularVelocity(sensor_value_to_double(&x), sensor_value_to_double(&y), sensor_value_to_double(&z));
+    Drv::AngularVelocity angular_velocity;
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        U64 uptime_useconds = k_ticks_to_us_floor64(k_uptime_ticks());
+        if (!this->m_angularVelocityCache.get(uptime_useconds, this->getMaxAgeUseconds(ANGULAR_VELOCITY),
+                                              angular_velocity)) {
+            if (!this->fetchLsm6dso(uptime_useconds)) {
+                return Drv::AngularVelocity(0.0, 0.0, 0.0);
+            }
+            angular_velocity = this->m_angularVelocityCache.value();
+        }
+    }
 
     this->tlmWrite_AngularVelocity(angular_velocity);
 
@@ -119,10 +191,11 @@ F64 ImuManager ::angularVelocityMagnitudeGet_handler(FwIndexType portNum,
     // Get angular velocity
     Drv::AngularVelocity angular_velocity = this->angularVelocityGet_handler(0, condition);
 
-    // Compute magnitude
-    F64 magnitude = std::sqrt(angular_velocity.get_x() * angular_velocity.get_x() +
-                              angular_velocity.get_y() * angular_velocity.get_y() +
-                              angular_velocity.get_z() * angular_velocity.get_z());
+    // Compute magnitude in the scalar type of the detumble control path, which consumes it
+    using Math = Components::ScalarMath<Components::DetumbleScalar>;
+    F64 magnitude = Math::toDouble(Math::norm(Math::fromDouble(angular_velocity.get_x()),
+                                              Math::fromDouble(angular_velocity.get_y()),
+                                              Math::fromDouble(angular_velocity.get_z())));
 
     // Convert to requested unit
     if (unit == AngularUnit::DEG_PER_SEC) {
@@ -141,20 +214,18 @@ Drv::MagneticField ImuManager ::magneticFieldGet_handler(FwIndexType portNum, Fw
     }
     this->log_WARNING_HI_Lis2mdlDeviceNotReady_ThrottleClear();
 
-    sensor_sample_fetch_chan(this->m_lis2mdl, SENSOR_CHAN_MAGN_XYZ);
-
-    struct sensor_value x, y, z;
-    sensor_channel_get(this->m_lis2mdl, SENSOR_CHAN_MAGN_X, &x);
-    sensor_channel_get(this->m_lis2mdl, SENSOR_CHAN_MAGN_Y, &y);
-    sensor_channel_get(this->m_lis2mdl, SENSOR_CHAN_MAGN_Z, &z);
-
-    this->applyAxisOrientation(x, y, z);
-
-    Fw::Time t = this->getTime();
-    Fw::TimeValue timestamp = Fw::TimeValue(t.getTimeBase(), t.getContext(), t.getSeconds(), t.getUSeconds());
-
-    Drv::MagneticField magnetic_field = Drv::MagneticField(sensor_value_to_double(&x), sensor_value_to_double(&y),
-                                                           sensor_value_to_double(&z), timestamp);
+    Drv::MagneticField magnetic_field;
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        U64 uptime_useconds = k_ticks_to_us_floor64(k_uptime_ticks());
+        if (!this->m_magneticFieldCache.get(uptime_useconds, this->getMaxAgeUseconds(MAGNETIC_FIELD), magnetic_field)) {
+            if (!this->fetchLis2mdl(uptime_useconds)) {
+                return Drv::MagneticField(0.0, 0.0, 0.0, Fw::TimeValue());
+            }
+            magnetic_field = this->m_magneticFieldCache.value();
+        }
+    }
+    this->solveMagCalibration();
 
     this->tlmWrite_MagneticField(magnetic_field);
 
@@ -186,55 +257,481 @@ Fw::TimeIntervalValue ImuManager ::magneticFieldSamplingPeriodGet_handler(FwInde
 //  Private helper methods
 // ----------------------------------------------------------------------
 
-void ImuManager ::configureSensors(struct sensor_value& magn, struct sensor_value& accel, struct sensor_value& gyro) {
+bool ImuManager ::fetchLsm6dso(U64 uptime_useconds) {
+    // In FIFO mode the newest batched sample answers without a fetch of its own. A burst capture owns the FIFO and
+    // keeps the newest sample current itself.
+    if (this->m_fifo_enabled) {
+        if (!this->m_capture_active) {
+            this->drainFifo();
+        }
+        if (!this->m_fifo_has_sample) {
+            return false;
+        }
+        this->m_accelerationCache.store(this->m_fifo_latest.get_acceleration(), uptime_useconds);
+        this->m_angularVelocityCache.store(this->m_fifo_latest.get_angularVelocity(), uptime_useconds);
+        return true;
+    }
+
+    // One fetch reads both sensors, so a request for either refreshes the other
+    int status = sensor_sample_fetch_chan(this->m_lsm6dso, SENSOR_CHAN_ALL);
+    this->m_busReads++;
+    if (status != 0) {
+        return false;
+    }
+
+    struct sensor_value x, y, z;
+    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_ACCEL_X, &x);
+    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_ACCEL_Y, &y);
+    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_ACCEL_Z, &z);
+    this->m_axisRemap.apply(x, y, z);
+    this->m_accelerationCache.store(
+        Drv::Acceleration(sensor_value_to_double(&x), sensor_value_to_double(&y), sensor_value_to_double(&z)),
+        uptime_useconds);
+
+    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_GYRO_X, &x);
+    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_GYRO_Y, &y);
+    sensor_channel_get(this->m_lsm6dso, SENSOR_CHAN_GYRO_Z, &z);
+    this->m_axisRemap.apply(x, y, z);
+    this->m_angularVelocityCache.store(
+        Drv::AngularVelocity(sensor_value_to_double(&x), sensor_value_to_double(&y), sensor_value_to_double(&z)),
+        uptime_useconds);
+
+    return true;
+}
+
+bool ImuManager ::fetchLis2mdl(U64 uptime_useconds, U64 conversion_useconds) {
+    int status = sensor_sample_fetch_chan(this->m_lis2mdl, SENSOR_CHAN_MAGN_XYZ);
+    this->m_busReads++;
+    if (status != 0) {
+        return false;
+    }
+
+    struct sensor_value x, y, z;
+    sensor_channel_get(this->m_lis2mdl, SENSOR_CHAN_MAGN_X, &x);
+    sensor_channel_get(this->m_lis2mdl, SENSOR_CHAN_MAGN_Y, &y);
+    sensor_channel_get(this->m_lis2mdl, SENSOR_CHAN_MAGN_Z, &z);
+
+    // Calibrated in the sensor frame, so a later change of AXIS_MAPPING keeps the calibration valid
+    F64 mx = sensor_value_to_double(&x);
+    F64 my = sensor_value_to_double(&y);
+    F64 mz = sensor_value_to_double(&z);
+    this->calibrateMagneticField(mx, my, mz);
+    this->m_axisRemap.apply(mx, my, mz);
+
+    Fw::Time t = this->getTime();
+    if (conversion_useconds != 0) {
+        // Backdate the read to the conversion, by the uptime elapsed since the data-ready edge
+        U64 now_useconds = k_ticks_to_us_floor64(k_uptime_ticks());
+        U64 age_us = (now_useconds > conversion_useconds) ? now_useconds - conversion_useconds : 0;
+        Fw::Time age(t.getTimeBase(), t.getContext(), static_cast<U32>(age_us / 1000000),
+                     static_cast<U32>(age_us % 1000000));
+        t = Fw::Time::sub(t, age);
+    }
+    Fw::TimeValue timestamp = Fw::TimeValue(t.getTimeBase(), t.getContext(), t.getSeconds(), t.getUSeconds());
+
+    this->m_magneticFieldCache.store(Drv::MagneticField(mx, my, mz, timestamp), uptime_useconds);
+    return true;
+}
+
+U64 ImuManager ::getMaxAgeUseconds(SampleChannel channel) {
+    Fw::ParamValid valid;
+    U32 max_age_ms = 0;
+    switch (channel) {
+        case ACCELERATION:
+            max_age_ms = this->paramGet_ACCELERATION_MAX_AGE_MS(valid);
+            break;
+        case ANGULAR_VELOCITY:
+            max_age_ms = this->paramGet_ANGULAR_VELOCITY_MAX_AGE_MS(valid);
+            break;
+        case MAGNETIC_FIELD:
+            max_age_ms = this->paramGet_MAGNETIC_FIELD_MAX_AGE_MS(valid);
+            break;
+    }
+    return static_cast<U64>(max_age_ms) * 1000;
+}
+
+void ImuManager ::configureSensors(struct sensor_value& magn,
+                                   struct sensor_value& accel,
+                                   struct sensor_value& gyro,
+                                   Fw::Enabled fifo_mode) {
+    // The bus transactions run without the cache lock, so port reads are not held off by a reconfiguration
+
     // Configure the lis2mdl
-    if (sensor_attr_set(this->m_lis2mdl, SENSOR_CHAN_MAGN_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY, &magn) != 0) {
+    bool magn_configured =
+        sensor_attr_set(this->m_lis2mdl, SENSOR_CHAN_MAGN_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY, &magn) == 0;
+    if (!magn_configured) {
         this->log_WARNING_HI_MagnetometerSamplingFrequencyNotConfigured();
-    } else {
-        this->m_curr_magn_odr = magn;
     }
 
     // Configure the lsm6dso
-    if (sensor_attr_set(this->m_lsm6dso, SENSOR_CHAN_ACCEL_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY, &accel) != 0) {
+    bool accel_configured =
+        sensor_attr_set(this->m_lsm6dso, SENSOR_CHAN_ACCEL_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY, &accel) == 0;
+    if (!accel_configured) {
         this->log_WARNING_HI_AccelerometerSamplingFrequencyNotConfigured();
-    } else {
-        this->m_curr_accel_odr = accel;
     }
-    if (sensor_attr_set(this->m_lsm6dso, SENSOR_CHAN_GYRO_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY, &gyro) != 0) {
+    bool gyro_configured =
+        sensor_attr_set(this->m_lsm6dso, SENSOR_CHAN_GYRO_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY, &gyro) == 0;
+    if (!gyro_configured) {
         this->log_WARNING_HI_GyroscopeSamplingFrequencyNotConfigured();
-    } else {
+    }
+
+    // The FIFO batches at the sampling frequencies, so it follows every reconfiguration
+    U8 ctrl[2];
+    bool fifo_enabled = this->configureFifo(fifo_mode, accel, gyro, ctrl);
+
+    // Publish the new configuration
+    Os::ScopeLock lock(this->m_sampleCacheLock);
+
+    // Readings taken under the previous configuration are not served again
+    this->m_accelerationCache.invalidate();
+    this->m_angularVelocityCache.invalidate();
+    this->m_magneticFieldCache.invalidate();
+
+    if (magn_configured) {
+        this->m_curr_magn_odr = magn;
+    }
+    if (accel_configured) {
+        this->m_curr_accel_odr = accel;
+    }
+    if (gyro_configured) {
         this->m_curr_gyro_odr = gyro;
     }
+
+    // Samples batched under the previous configuration are not sent
+    this->m_fifo.reset();
+    this->m_fifo_batch_count = 0;
+    this->m_fifo_has_sample = false;
+    if (fifo_enabled) {
+        this->m_fifo.setFullScale(ctrl[0], ctrl[1]);
+    }
+    this->m_fifo_enabled = fifo_enabled;
+    this->m_curr_fifo_mode = fifo_mode;
 }
 
-void ImuManager ::applyAxisOrientation(struct sensor_value& x, struct sensor_value& y, struct sensor_value& z) {
-    Fw::ParamValid valid;
-    Components::AxisOrientation::T orientation = this->paramGet_AXIS_ORIENTATION(valid);
+bool ImuManager ::configureFifo(Fw::Enabled fifo_mode,
+                                struct sensor_value& accel,
+                                struct sensor_value& gyro,
+                                U8 (&ctrl)[2]) {
+    if (this->m_lsm6dso_bus == nullptr) {
+        if (fifo_mode == Fw::Enabled::ENABLED) {
+            this->log_WARNING_HI_FifoNotConfigured();
+        }
+        return false;
+    }
 
-    this->tlmWrite_AxisOrientation(orientation);
+    if (fifo_mode == Fw::Enabled::DISABLED) {
+        // Bypass mode also empties the FIFO
+        U8 fifo_ctrl4 = Lsm6dsoFifo::fifoCtrl4(false);
+        if (i2c_reg_write_byte_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_FIFO_CTRL4, fifo_ctrl4) != 0) {
+            this->log_WARNING_HI_FifoNotConfigured();
+        }
+        return false;
+    }
 
-    switch (orientation) {
-        case Components::AxisOrientation::ROTATED_90_DEG_CW: {
-            const struct sensor_value temp_x = x;
-            x = y;
-            sensor_value_from_double(&y, -sensor_value_to_double(&temp_x));
-            return;
+    // CTRL1_XL and CTRL2_G hold the full scales the Zephyr driver configured
+    U8 fifo_ctrl3 = Lsm6dsoFifo::fifoCtrl3(Lsm6dsoFifo::batchDataRateCode(sensor_value_to_double(&accel)),
+                                           Lsm6dsoFifo::batchDataRateCode(sensor_value_to_double(&gyro)));
+    if (i2c_burst_read_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_CTRL1_XL, ctrl, sizeof(ctrl)) != 0 ||
+        i2c_reg_update_byte_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_CTRL10_C, Lsm6dsoFifo::CTRL10_C_TIMESTAMP_EN,
+                               Lsm6dsoFifo::CTRL10_C_TIMESTAMP_EN) != 0 ||
+        i2c_reg_write_byte_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_FIFO_CTRL3, fifo_ctrl3) != 0 ||
+        i2c_reg_write_byte_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_FIFO_CTRL4, Lsm6dsoFifo::fifoCtrl4(true)) != 0) {
+        this->log_WARNING_HI_FifoNotConfigured();
+        return false;
+    }
+    this->log_WARNING_HI_FifoNotConfigured_ThrottleClear();
+
+    return true;
+}
+
+void ImuManager ::drainFifo() {
+    // A drain is one fetch, however many bursts it takes, so BusReads stays comparable with direct reads
+    this->m_busReads++;
+
+    U8 status[2];
+    if (i2c_burst_read_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_FIFO_STATUS1, status, sizeof(status)) != 0) {
+        this->log_WARNING_HI_FifoReadFailed();
+        return;
+    }
+
+    // Every word counted above is older than this reference, which anchors the sensor counter to system time
+    U8 timestamp[4];
+    if (i2c_burst_read_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_TIMESTAMP0, timestamp, sizeof(timestamp)) != 0) {
+        this->log_WARNING_HI_FifoReadFailed();
+        return;
+    }
+    Fw::Time reference = this->getTime();
+    U32 reference_ticks = Lsm6dsoFifo::timestampTicks(timestamp);
+
+    if (Lsm6dsoFifo::overrun(status[1])) {
+        this->m_fifo_overruns++;
+        this->tlmWrite_FifoOverruns(this->m_fifo_overruns);
+        this->log_WARNING_LO_FifoOverrun();
+    }
+
+    U32 drained = 0;
+    std::size_t remaining = Lsm6dsoFifo::unreadWords(status[0], status[1]);
+    while (remaining > 0) {
+        std::size_t words = (remaining < FIFO_BURST_WORDS) ? remaining : FIFO_BURST_WORDS;
+        if (i2c_burst_read_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_FIFO_DATA_OUT_TAG, this->m_fifo_buffer,
+                              words * Lsm6dsoFifo::WORD_SIZE) != 0) {
+            this->log_WARNING_HI_FifoReadFailed();
+            break;
         }
-        case Components::AxisOrientation::ROTATED_90_DEG_CCW: {
-            const struct sensor_value temp_x = x;
-            sensor_value_from_double(&x, -sensor_value_to_double(&y));
-            y = temp_x;
-            return;
+        for (std::size_t word = 0; word < words; word++) {
+            Lsm6dsoFifo::Sample sample;
+            if (this->m_fifo.decodeWord(&this->m_fifo_buffer[word * Lsm6dsoFifo::WORD_SIZE], sample)) {
+                this->appendFifoSample(sample, reference, reference_ticks);
+                drained++;
+            }
         }
-        case Components::AxisOrientation::ROTATED_180_DEG: {
-            sensor_value_from_double(&x, -sensor_value_to_double(&x));
-            sensor_value_from_double(&y, -sensor_value_to_double(&y));
-            return;
+        remaining -= words;
+    }
+    if (remaining == 0) {
+        this->log_WARNING_HI_FifoReadFailed_ThrottleClear();
+    }
+
+    this->sendFifoBatch();
+    this->tlmWrite_FifoSamples(drained);
+}
+
+void ImuManager ::appendFifoSample(const Lsm6dsoFifo::Sample& sample, const Fw::Time& reference, U32 reference_ticks) {
+    this->m_fifo_latest = this->timestampFifoSample(sample, reference, reference_ticks);
+    this->m_fifo_has_sample = true;
+
+    this->m_fifo_batch[this->m_fifo_batch_count] = this->m_fifo_latest;
+    this->m_fifo_batch_count++;
+    if (this->m_fifo_batch_count == ImuSamples::SIZE) {
+        this->sendFifoBatch();
+    }
+}
+
+ImuSample ImuManager ::timestampFifoSample(const Lsm6dsoFifo::Sample& sample,
+                                           const Fw::Time& reference,
+                                           U32 reference_ticks) {
+    F64 ax = sample.acceleration[0], ay = sample.acceleration[1], az = sample.acceleration[2];
+    F64 gx = sample.angular_velocity[0], gy = sample.angular_velocity[1], gz = sample.angular_velocity[2];
+    this->m_axisRemap.apply(ax, ay, az);
+    this->m_axisRemap.apply(gx, gy, gz);
+
+    // Samples are never newer than the reference, a negative age is counter jitter
+    I64 age_us = std::max<I64>(Lsm6dsoFifo::microsecondsBefore(reference_ticks, sample.timestamp_ticks), 0);
+    Fw::Time age(reference.getTimeBase(), reference.getContext(), static_cast<U32>(age_us / 1000000),
+                 static_cast<U32>(age_us % 1000000));
+    Fw::Time t = Fw::Time::sub(reference, age);
+
+    return ImuSample(Drv::Acceleration(ax, ay, az), Drv::AngularVelocity(gx, gy, gz),
+                     Fw::TimeValue(t.getTimeBase(), t.getContext(), t.getSeconds(), t.getUSeconds()));
+}
+
+void ImuManager ::sendFifoBatch() {
+    if (this->m_fifo_batch_count == 0) {
+        return;
+    }
+    if (this->isConnected_imuSampleBatchOut_OutputPort(0)) {
+        this->imuSampleBatchOut_out(0, ImuSampleBatch(this->m_fifo_batch, this->m_fifo_batch_count));
+    }
+    this->m_fifo_batch_count = 0;
+}
+
+void ImuManager ::configureSensorsFromParameters() {
+    struct sensor_value magn_odr = this->getMagnetometerSamplingFrequency();
+    struct sensor_value accel_odr = this->getAccelerometerSamplingFrequency();
+    struct sensor_value gyro_odr = this->getGyroscopeSamplingFrequency();
+    this->configureSensors(magn_odr, accel_odr, gyro_odr, this->getFifoMode());
+}
+
+std::size_t ImuManager ::drainCaptureBurst() {
+    U8 status[2];
+    U8 timestamp[4];
+    if (i2c_burst_read_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_FIFO_STATUS1, status, sizeof(status)) != 0 ||
+        i2c_burst_read_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_TIMESTAMP0, timestamp, sizeof(timestamp)) != 0) {
+        this->log_WARNING_HI_FifoReadFailed();
+        return 0;
+    }
+    Fw::Time reference = this->getTime();
+    U32 reference_ticks = Lsm6dsoFifo::timestampTicks(timestamp);
+
+    if (Lsm6dsoFifo::overrun(status[1])) {
+        this->m_fifo_overruns++;
+        this->tlmWrite_FifoOverruns(this->m_fifo_overruns);
+        this->log_WARNING_LO_FifoOverrun();
+    }
+
+    // One burst per step, so file writes interleave with draining instead of waiting for the FIFO to empty
+    std::size_t words = Lsm6dsoFifo::unreadWords(status[0], status[1]);
+    words = (words < FIFO_BURST_WORDS) ? words : FIFO_BURST_WORDS;
+    if (words == 0) {
+        return 0;
+    }
+    if (i2c_burst_read_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_FIFO_DATA_OUT_TAG, this->m_fifo_buffer,
+                          words * Lsm6dsoFifo::WORD_SIZE) != 0) {
+        this->log_WARNING_HI_FifoReadFailed();
+        return 0;
+    }
+    this->log_WARNING_HI_FifoReadFailed_ThrottleClear();
+
+    Lsm6dsoFifo::Sample sample;
+    Lsm6dsoFifo::Sample latest;
+    bool decoded = false;
+    for (std::size_t word = 0; word < words; word++) {
+        if (this->m_fifo.decodeWord(&this->m_fifo_buffer[word * Lsm6dsoFifo::WORD_SIZE], sample)) {
+            this->m_capture.append(sample);
+            latest = sample;
+            decoded = true;
         }
-        case Components::AxisOrientation::STANDARD: {
-            return;
+    }
+
+    if (decoded) {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        this->m_fifo_latest = this->timestampFifoSample(latest, reference, reference_ticks);
+        this->m_fifo_has_sample = true;
+    }
+    return words;
+}
+
+void ImuManager ::finishCapture(Os::File::Status status) {
+    // Write out the partly filled buffer as well
+    this->m_capture.finish();
+    const U8* data;
+    std::size_t pending;
+    while (status == Os::File::OP_OK && this->m_capture.pendingWrite(data, pending)) {
+        FwSizeType size = static_cast<FwSizeType>(pending);
+        status = this->m_capture_file.write(data, size);
+        this->m_capture.written(static_cast<std::size_t>(size));
+        this->m_capture_bytes += static_cast<U32>(size);
+    }
+
+    // The counts are only known now
+    if (status == Os::File::OP_OK) {
+        U8 counts[BurstCapture::COUNTS_SIZE];
+        BurstCapture::encodeCounts(this->m_capture.getRecords(), this->m_capture.getDropped(), counts);
+        FwSizeType size = sizeof(counts);
+        status = this->m_capture_file.seek(BurstCapture::COUNTS_OFFSET, Os::File::SeekType::ABSOLUTE);
+        if (status == Os::File::OP_OK) {
+            status = this->m_capture_file.write(counts, size);
         }
     }
+    if (this->m_capture_file.isOpen()) {
+        this->m_capture_file.close();
+    }
+
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        this->m_capture_active = false;
+    }
+    this->configureSensorsFromParameters();
+
+    U64 elapsed_useconds = k_ticks_to_us_floor64(k_uptime_ticks()) - this->m_capture_start_useconds;
+    U32 throughput = 0;
+    if (elapsed_useconds > 0) {
+        throughput = static_cast<U32>((static_cast<U64>(this->m_capture_bytes) * 1000000) / elapsed_useconds);
+    }
+    this->tlmWrite_BurstCaptureDropped(this->m_capture.getDropped());
+    this->tlmWrite_BurstCaptureThroughput(throughput);
+
+    Fw::LogStringArg file_name(this->m_capture_file_name);
+    if (status != Os::File::OP_OK) {
+        this->log_WARNING_HI_BurstCaptureFailed(file_name, Os::FileStatus(static_cast<Os::FileStatus::T>(status)));
+        this->cmdResponse_out(this->m_capture_opcode, this->m_capture_cmd_seq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    this->log_ACTIVITY_HI_BurstCaptureComplete(file_name, this->m_capture.getRecords(), this->m_capture.getDropped(),
+                                               this->m_capture_bytes, throughput);
+    this->cmdResponse_out(this->m_capture_opcode, this->m_capture_cmd_seq, Fw::CmdResponse::OK);
+}
+
+bool ImuManager ::configureDataReady(Fw::Enabled data_ready) {
+    if (data_ready == Fw::Enabled::DISABLED) {
+        if (this->m_data_ready_enabled) {
+            sensor_trigger_set(this->m_lis2mdl, &this->m_data_ready.trigger, nullptr);
+            gpio_remove_callback_dt(this->m_lis2mdl_drdy, &this->m_data_ready.callback);
+        }
+        return false;
+    }
+
+    if (this->m_lis2mdl_drdy == nullptr || this->m_lis2mdl_drdy->port == nullptr) {
+        this->log_WARNING_HI_DataReadyNotConfigured();
+        return false;
+    }
+
+    // The pin callback runs alongside the driver's own on the same edge and only records when it happened
+    this->m_data_ready.trigger.type = SENSOR_TRIG_DATA_READY;
+    this->m_data_ready.trigger.chan = SENSOR_CHAN_MAGN_XYZ;
+    atomic_set(&this->m_data_ready.conversion_ticks, static_cast<atomic_val_t>(k_uptime_ticks()));
+    gpio_init_callback(&this->m_data_ready.callback, ImuManager::dataReadyIsr, BIT(this->m_lis2mdl_drdy->pin));
+    if (gpio_add_callback_dt(this->m_lis2mdl_drdy, &this->m_data_ready.callback) != 0) {
+        this->log_WARNING_HI_DataReadyNotConfigured();
+        return false;
+    }
+
+    // Fails when the driver is built without CONFIG_LIS2MDL_TRIGGER
+    if (sensor_trigger_set(this->m_lis2mdl, &this->m_data_ready.trigger, ImuManager::dataReadyHandler) != 0) {
+        gpio_remove_callback_dt(this->m_lis2mdl_drdy, &this->m_data_ready.callback);
+        this->log_WARNING_HI_DataReadyNotConfigured();
+        return false;
+    }
+    this->log_WARNING_HI_DataReadyNotConfigured_ThrottleClear();
+
+    return true;
+}
+
+void ImuManager ::dataReadyIsr(const struct device* port, struct gpio_callback* callback, gpio_port_pins_t pins) {
+    DataReadyContext* context = CONTAINER_OF(callback, DataReadyContext, callback);
+    atomic_set(&context->conversion_ticks, static_cast<atomic_val_t>(k_uptime_ticks()));
+}
+
+void ImuManager ::dataReadyHandler(const struct device* dev, const struct sensor_trigger* trigger) {
+    // Only stamp and post, the read is left to the component thread
+    DataReadyContext* context = CONTAINER_OF(trigger, DataReadyContext, trigger);
+    U32 conversion_ticks = static_cast<U32>(atomic_get(&context->conversion_ticks));
+    context->owner->magneticFieldIn_internalInterfaceInvoke(conversion_ticks);
+}
+
+void ImuManager ::updateAxisRemap() {
+    Fw::ParamValid valid;
+    Components::AxisOrientation orientation = this->paramGet_AXIS_ORIENTATION(valid);
+    Components::AxisMapping mapping = this->paramGet_AXIS_MAPPING(valid);
+
+    this->tlmWrite_AxisOrientation(orientation);
+    this->tlmWrite_AxisMapping(mapping);
+
+    // Quarter turns of the in-plane orientation, where one turn maps (x, y) to (-y, x)
+    int turns = 0;
+    switch (orientation) {
+        case Components::AxisOrientation::ROTATED_90_DEG_CW:
+            turns = 3;
+            break;
+        case Components::AxisOrientation::ROTATED_90_DEG_CCW:
+            turns = 1;
+            break;
+        case Components::AxisOrientation::ROTATED_180_DEG:
+            turns = 2;
+            break;
+        case Components::AxisOrientation::STANDARD:
+            turns = 0;
+            break;
+    }
+
+    Os::ScopeLock lock(this->m_sampleCacheLock);
+
+    AxisRemap mounting;
+    std::array<AxisRemap::SignedAxis, 3> axes;
+    for (FwSizeType axis = 0; axis < AxisMapping::SIZE; axis++) {
+        axes[axis] = static_cast<AxisRemap::SignedAxis>(mapping[axis].e);
+    }
+    if (!AxisRemap::fromSignedAxes(axes, mounting)) {
+        this->log_WARNING_LO_AxisMappingInvalid();
+        return;
+    }
+    this->log_WARNING_LO_AxisMappingInvalid_ThrottleClear();
+
+    this->m_axisRemap = AxisRemap::quarterTurnsZ(turns).compose(mounting);
+
+    // Readings in the previous frame are not served again
+    this->m_accelerationCache.invalidate();
+    this->m_angularVelocityCache.invalidate();
+    this->m_magneticFieldCache.invalidate();
 }
 
 struct sensor_value ImuManager ::getAccelerometerSamplingFrequency() {
@@ -306,6 +803,78 @@ struct sensor_value ImuManager::getMagnetometerSamplingFrequency() {
     return sensor_value{0, 0};
 }
 
+Fw::Enabled ImuManager ::getFifoMode() {
+    Fw::ParamValid valid;
+    return this->paramGet_FIFO_MODE(valid);
+}
+
+Fw::Enabled ImuManager ::getDataReadyMode() {
+    Fw::ParamValid valid;
+    return this->paramGet_MAGNETOMETER_DATA_READY(valid);
+}
+
+void ImuManager ::calibrateMagneticField(F64& x, F64& y, F64& z) {
+    if (this->m_magCalibrationState == MagCalibrationState::DISABLED) {
+        return;
+    }
+
+    if (this->m_magCalibrationState == MagCalibrationState::COLLECTING) {
+        this->m_magCalibrator.add(x, y, z);
+        this->m_magCalibrationSinceSolve++;
+        if (this->m_magCalibrationSinceSolve >= this->m_magCalibrationSolveInterval) {
+            this->m_magCalibrationSinceSolve = 0;
+            this->m_magCalibrationSolveDue = true;
+        }
+    }
+
+    MagCalibrator::apply(this->m_magCalibration, x, y, z);
+}
+
+void ImuManager ::solveMagCalibration() {
+    // Copy the sums under the lock and solve outside it, so port reads are not held off by the solve
+    MagCalibrator fit;
+    U32 generation;
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        if (!this->m_magCalibrationSolveDue || this->m_magCalibrationState != MagCalibrationState::COLLECTING) {
+            return;
+        }
+        this->m_magCalibrationSolveDue = false;
+        fit = this->m_magCalibrator;
+        generation = this->m_magCalibrationGeneration;
+    }
+
+    MagCalibrator::Solution solution;
+    if (!fit.solve(solution)) {
+        // Too few samples is expected early in a fit and not reported
+        if (fit.getSamples() >= MagCalibrator::MIN_SAMPLES) {
+            this->log_WARNING_LO_MagCalibrationSolveFailed(fit.getSamples());
+        }
+        return;
+    }
+
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        // A calibration command or a solve over more samples since the copy takes precedence
+        if (generation != this->m_magCalibrationGeneration || fit.getSamples() <= this->m_magCalibrationSolvedSamples) {
+            return;
+        }
+        this->m_magCalibration = solution;
+        this->m_magCalibrationSolvedSamples = fit.getSamples();
+    }
+    this->log_WARNING_LO_MagCalibrationSolveFailed_ThrottleClear();
+}
+
+void ImuManager ::writeMagCalibrationTelemetry() {
+    const MagCalibrator::Solution& solution = this->m_magCalibration;
+    this->tlmWrite_MagCalibrationState(this->m_magCalibrationState);
+    this->tlmWrite_MagCalibrationSamples(this->m_magCalibrator.getSamples());
+    this->tlmWrite_MagCalibrationOffset(
+        MagCalibrationVector(solution.offset[0], solution.offset[1], solution.offset[2]));
+    this->tlmWrite_MagCalibrationScale(MagCalibrationVector(solution.scale[0], solution.scale[1], solution.scale[2]));
+    this->tlmWrite_MagCalibrationResidual(solution.residual);
+}
+
 bool ImuManager ::sensorValuesEqual(struct sensor_value* sv1, struct sensor_value* sv2) {
     return (sv1->val1 == sv2->val1) && (sv1->val2 == sv2->val2);
 }
@@ -342,4 +911,223 @@ void ImuManager ::GET_MAGNETIC_FIELD_cmdHandler(FwOpcodeType opCode, U32 cmdSeq)
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
 }
 
+void ImuManager ::MAG_CALIBRATION_START_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        this->m_magCalibrationState = MagCalibrationState::COLLECTING;
+        this->m_magCalibrationSinceSolve = 0;
+        this->m_magCalibrationGeneration++;
+        this->writeMagCalibrationTelemetry();
+    }
+
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+void ImuManager ::MAG_CALIBRATION_FREEZE_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
+    MagCalibrator fit;
+    MagCalibrationState state;
+    MagCalibrator::Solution solution;
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        fit = this->m_magCalibrator;
+        state = this->m_magCalibrationState;
+        solution = this->m_magCalibration;
+    }
+
+    // Nothing to freeze before a fit was started
+    if (state == MagCalibrationState::DISABLED) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    // Solved outside the lock. Calibration commands all run on this thread, so the state cannot change meanwhile.
+    if (state == MagCalibrationState::COLLECTING && !fit.solve(solution)) {
+        this->log_WARNING_LO_MagCalibrationSolveFailed(fit.getSamples());
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        this->m_magCalibration = solution;
+        this->m_magCalibrationState = MagCalibrationState::FROZEN;
+        this->m_magCalibrationSolveDue = false;
+        this->m_magCalibrationSolvedSamples = fit.getSamples();
+        this->m_magCalibrationGeneration++;
+        this->m_magneticFieldCache.invalidate();
+        this->writeMagCalibrationTelemetry();
+    }
+
+    this->log_ACTIVITY_HI_MagCalibrationFrozen(solution.offset[0], solution.offset[1], solution.offset[2],
+                                               solution.scale[0], solution.scale[1], solution.scale[2],
+                                               solution.residual);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+void ImuManager ::MAG_CALIBRATION_RESET_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        this->m_magCalibrator.reset();
+        this->m_magCalibration = MagCalibrator::identity();
+        this->m_magCalibrationState = MagCalibrationState::DISABLED;
+        this->m_magCalibrationSinceSolve = 0;
+        this->m_magCalibrationSolveDue = false;
+        this->m_magCalibrationSolvedSamples = 0;
+        this->m_magCalibrationGeneration++;
+        this->m_magneticFieldCache.invalidate();
+        this->writeMagCalibrationTelemetry();
+    }
+
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+}
+
+void ImuManager ::CAPTURE_BURST_cmdHandler(FwOpcodeType opCode,
+                                           U32 cmdSeq,
+                                           U32 duration_ms,
+                                           Components::Lsm6dsoSamplingFrequency frequency) {
+    if (duration_ms == 0 || duration_ms > MAX_CAPTURE_DURATION_MS) {
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::VALIDATION_ERROR);
+        return;
+    }
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        if (this->m_capture_active) {
+            this->log_WARNING_LO_BurstCaptureBusy();
+            this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+            return;
+        }
+        // Port reads stop draining the FIFO from here on
+        this->m_capture_active = true;
+    }
+    this->log_WARNING_LO_BurstCaptureBusy_ThrottleClear();
+
+    // Both LSM6DSO sensors batch at the capture frequency, the LIS2MDL is left as it is
+    struct sensor_value odr = this->getLsm6dsoSamplingFrequency(frequency);
+    struct sensor_value magn_odr = this->m_curr_magn_odr;
+    this->configureSensors(magn_odr, odr, odr, Fw::Enabled::ENABLED);
+
+    // Pair the sensor timestamp counter with system time, as the records carry only the counter
+    U8 timestamp[4];
+    if (!this->m_fifo_enabled ||
+        i2c_burst_read_dt(this->m_lsm6dso_bus, Lsm6dsoFifo::REG_TIMESTAMP0, timestamp, sizeof(timestamp)) != 0) {
+        {
+            Os::ScopeLock lock(this->m_sampleCacheLock);
+            this->m_capture_active = false;
+        }
+        this->configureSensorsFromParameters();
+        this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+        return;
+    }
+    Fw::Time start = this->getTime();
+
+    BurstCapture::Header header{};
+    header.sampling_frequency_hz = static_cast<float>(sensor_value_to_double(&odr));
+    header.accel_scale = static_cast<float>(this->m_fifo.getAccelScale());
+    header.gyro_scale = static_cast<float>(this->m_fifo.getGyroScale());
+    header.start_seconds = start.getSeconds();
+    header.start_useconds = start.getUSeconds();
+    header.start_ticks = Lsm6dsoFifo::timestampTicks(timestamp);
+    {
+        // Records stay in the sensor frame, the remap in force goes in the header as signed axis codes
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+        for (U8 row = 0; row < 3; row++) {
+            for (U8 column = 0; column < 3; column++) {
+                I8 sign = this->m_axisRemap.element(row, column);
+                if (sign != 0) {
+                    header.axes[row] = static_cast<U8>(2 * column + ((sign < 0) ? 1 : 0));
+                }
+            }
+        }
+    }
+    U8 header_bytes[BurstCapture::HEADER_SIZE];
+    BurstCapture::encodeHeader(header, header_bytes);
+
+    (void)snprintf(this->m_capture_file_name, sizeof(this->m_capture_file_name), "/imu_burst_%u.bin",
+                   static_cast<unsigned int>(header.start_seconds));
+    Os::File::Status status = this->m_capture_file.open(this->m_capture_file_name, Os::File::OPEN_CREATE);
+    FwSizeType size = sizeof(header_bytes);
+    if (status == Os::File::OP_OK) {
+        status = this->m_capture_file.write(header_bytes, size);
+    }
+
+    this->m_capture.start(sensor_value_to_double(&odr));
+    this->m_capture_bytes = static_cast<U32>(size);
+    this->m_capture_start_useconds = k_ticks_to_us_floor64(k_uptime_ticks());
+    this->m_capture_duration_useconds = static_cast<U64>(duration_ms) * 1000;
+    this->m_capture_pace_useconds = static_cast<U32>(std::min(
+        1000000.0 * FIFO_BURST_WORDS / (CAPTURE_WORDS_PER_SAMPLE * sensor_value_to_double(&odr)),
+        static_cast<double>(CAPTURE_MAX_PACE_US)));
+    this->m_capture_opcode = opCode;
+    this->m_capture_cmd_seq = cmdSeq;
+    if (status != Os::File::OP_OK) {
+        this->finishCapture(status);
+        return;
+    }
+
+    this->log_ACTIVITY_HI_BurstCaptureStarted(Fw::LogStringArg(this->m_capture_file_name), duration_ms, frequency);
+    this->captureStep_internalInterfaceInvoke();
+}
+
+// ----------------------------------------------------------------------
+// Handler implementations for internal ports
+// ----------------------------------------------------------------------
+
+void ImuManager ::captureStep_internalInterfaceHandler() {
+    const std::size_t words = this->drainCaptureBurst();
+
+    // At most one chunk per step, so the FIFO is drained again before it can fill
+    const U8* data;
+    std::size_t pending;
+    if (this->m_capture.pendingWrite(data, pending)) {
+        FwSizeType size = (pending < CAPTURE_WRITE_CHUNK) ? static_cast<FwSizeType>(pending) : CAPTURE_WRITE_CHUNK;
+        Os::File::Status status = this->m_capture_file.write(data, size);
+        if (status != Os::File::OP_OK) {
+            this->finishCapture(status);
+            return;
+        }
+        this->m_capture.written(static_cast<std::size_t>(size));
+        this->m_capture_bytes += static_cast<U32>(size);
+    }
+
+    U64 uptime_useconds = k_ticks_to_us_floor64(k_uptime_ticks());
+    if (uptime_useconds - this->m_capture_start_useconds >= this->m_capture_duration_useconds) {
+        this->finishCapture(Os::File::OP_OK);
+        return;
+    }
+
+    // Once draining has caught up and the file has nothing left to write, wait for the FIFO to batch another burst
+    // instead of polling its status on the shared bus. The next step queues behind any command or port call already
+    // waiting.
+    if (words < FIFO_BURST_WORDS && !this->m_capture.pendingWrite(data, pending)) {
+        Os::Task::delay(Fw::TimeInterval(0, this->m_capture_pace_useconds));
+    }
+    this->captureStep_internalInterfaceInvoke();
+}
+
+void ImuManager ::magneticFieldIn_internalInterfaceHandler(U32 conversionTicks) {
+    Drv::MagneticField magnetic_field;
+    {
+        Os::ScopeLock lock(this->m_sampleCacheLock);
+
+        // Ticks elapsed since the edge, modulo the 32 bits the interrupt could store atomically
+        I64 now_ticks = k_uptime_ticks();
+        U32 elapsed_ticks = static_cast<U32>(now_ticks) - conversionTicks;
+        U64 uptime_useconds = k_ticks_to_us_floor64(now_ticks);
+        U64 conversion_useconds = k_ticks_to_us_floor64(now_ticks - elapsed_ticks);
+
+        // The read also clears the data-ready line for the next conversion
+        if (!this->fetchLis2mdl(uptime_useconds, conversion_useconds)) {
+            this->log_WARNING_LO_DataReadyFetchFailed();
+            return;
+        }
+        magnetic_field = this->m_magneticFieldCache.value();
+        this->m_data_ready_samples++;
+    }
+    this->log_WARNING_LO_DataReadyFetchFailed_ThrottleClear();
+    this->solveMagCalibration();
+
+    if (this->isConnected_magneticFieldOut_OutputPort(0)) {
+        this->magneticFieldOut_out(0, magnetic_field);
+    }
+}
+
 }  // namespace Components
@@ -6,9 +6,20 @@
 #ifndef Components_ImuManager_HPP
 #define Components_ImuManager_HPP
 
+#include <Os/File.hpp>
+#include <Os/Mutex.hpp>
+
+#include "PROVESFlightControllerReference/Components/ImuManager/AxisRemap.hpp"
+#include "PROVESFlightControllerReference/Components/ImuManager/BurstCapture.hpp"
+#include "PROVESFlightControllerReference/Components/ImuManager/CachedSample.hpp"
 #include "PROVESFlightControllerReference/Components/ImuManager/ImuManagerComponentAc.hpp"
+#include "PROVESFlightControllerReference/Components/ImuManager/Lsm6dsoFifo.hpp"
+#include "PROVESFlightControllerReference/Components/ImuManager/MagCalibrator.hpp"
 #include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
 
 namespace Components {
 
@@ -30,9 +41,23 @@ class ImuManager final : public ImuManagerComponentBase {
     // ----------------------------------------------------------------------
 
     //! Configure the IMU devices
-    void configure(const struct device* lis2mdl, const struct device* lsm6dso);
+    //!
+    //! The LSM6DSO bus is used for FIFO register access, which the Zephyr sensor API does not expose. Without it
+    //! FIFO_MODE cannot be enabled. The LIS2MDL data-ready pin is the driver's irq-gpios line, on which conversions
+    //! are stamped. Without it MAGNETOMETER_DATA_READY cannot be enabled.
+    void configure(const struct device* lis2mdl,
+                   const struct device* lsm6dso,
+                   const struct i2c_dt_spec* lsm6dso_bus = nullptr,
+                   const struct gpio_dt_spec* lis2mdl_drdy = nullptr);
 
   private:
+    //! Parameter update handler
+    void parameterUpdated(FwPrmIdType id  //!< The parameter ID
+                          ) override;
+
+    //! Parameters loaded handler
+    void parametersLoaded() override;
+
     // ----------------------------------------------------------------------
     // Handler implementations for typed input ports
     // ----------------------------------------------------------------------
@@ -101,15 +126,146 @@ class ImuManager final : public ImuManagerComponentBase {
     //! Command to get the current magnetic field
     void GET_MAGNETIC_FIELD_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) override;
 
+    //! Handler implementation for MAG_CALIBRATION_START
+    //!
+    //! Command to start folding magnetometer samples into the calibration fit, continuing any fit in progress
+    void MAG_CALIBRATION_START_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) override;
+
+    //! Handler implementation for MAG_CALIBRATION_FREEZE
+    //!
+    //! Command to solve the magnetometer calibration fit once more and keep applying that solution
+    void MAG_CALIBRATION_FREEZE_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) override;
+
+    //! Handler implementation for MAG_CALIBRATION_RESET
+    //!
+    //! Command to discard the magnetometer calibration fit and stop correcting samples
+    void MAG_CALIBRATION_RESET_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) override;
+
+    //! Handler implementation for CAPTURE_BURST
+    //!
+    //! Command to capture accelerometer and gyroscope samples from the LSM6DSO FIFO to a file in flash
+    void CAPTURE_BURST_cmdHandler(FwOpcodeType opCode,
+                                  U32 cmdSeq,
+                                  U32 duration_ms,
+                                  Components::Lsm6dsoSamplingFrequency frequency) override;
+
+    // ----------------------------------------------------------------------
+    // Handler implementations for internal ports
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for captureStep
+    //!
+    //! Drain one FIFO burst and write one chunk of the capture, then post the next step until the duration elapses
+    void captureStep_internalInterfaceHandler() override;
+
+    //! Handler implementation for magneticFieldIn
+    //!
+    //! Read the conversion signalled by a data-ready interrupt and send it on magneticFieldOut. conversionTicks is the
+    //! low word of the uptime ticks of the data-ready edge.
+    void magneticFieldIn_internalInterfaceHandler(U32 conversionTicks) override;
+
+  private:
+    // ----------------------------------------------------------------------
+    //  Private types
+    // ----------------------------------------------------------------------
+
+    //! Sensor channel with its own cache maximum age
+    enum SampleChannel {
+        ACCELERATION,      //!< LSM6DSO accelerometer
+        ANGULAR_VELOCITY,  //!< LSM6DSO gyroscope
+        MAGNETIC_FIELD,    //!< LIS2MDL magnetometer
+    };
+
+    //! LIS2MDL data-ready registration, handed back to the static callbacks by Zephyr
+    struct DataReadyContext {
+        struct sensor_trigger trigger;  //!< Trigger registered with the LIS2MDL driver
+        struct gpio_callback callback;  //!< Callback on the data-ready pin, run in interrupt context
+        atomic_t conversion_ticks;      //!< Low word of the uptime ticks of the latest data-ready edge
+        ImuManager* owner;              //!< Component the conversions are posted to
+    };
+
   private:
     // ----------------------------------------------------------------------
     //  Private helper methods
     // ----------------------------------------------------------------------
-    //! Configure imu sensors
-    void configureSensors(struct sensor_value& magn, struct sensor_value& accel, struct sensor_value& gyro);
 
-    //! Apply axis orientation parameter to sensor readings
-    void applyAxisOrientation(struct sensor_value& x_val, struct sensor_value& y_val, struct sensor_value& z_val);
+    //! Fetch acceleration and angular velocity together and store both in the sample cache
+    //!
+    //! Caller must hold m_sampleCacheLock. Returns false if the fetch failed.
+    bool fetchLsm6dso(U64 uptime_useconds);
+
+    //! Fetch the magnetic field, correct it with the magnetometer calibration and store it in the sample cache
+    //!
+    //! Caller must hold m_sampleCacheLock. Returns false if the fetch failed. The reading is stamped with the time of
+    //! the fetch, or backdated to conversion_useconds when a data-ready interrupt stamped the conversion.
+    bool fetchLis2mdl(U64 uptime_useconds,         //!< The microseconds since boot
+                      U64 conversion_useconds = 0  //!< The microseconds since boot of the conversion, 0 if unknown
+    );
+
+    //! Register or remove the LIS2MDL data-ready trigger and the stamping callback on its pin
+    //!
+    //! Returns true if data-ready sampling is enabled afterwards.
+    bool configureDataReady(Fw::Enabled data_ready);
+
+    //! Data-ready pin callback, stamps the conversion in interrupt context
+    static void dataReadyIsr(const struct device* port, struct gpio_callback* callback, gpio_port_pins_t pins);
+
+    //! LIS2MDL data-ready trigger handler, run from the driver's trigger thread. Posts the edge time to
+    //! magneticFieldIn so the bus read happens on the component thread.
+    static void dataReadyHandler(const struct device* dev, const struct sensor_trigger* trigger);
+
+    //! Get the maximum age of a cached reading from parameter
+    U64 getMaxAgeUseconds(SampleChannel channel);
+
+    //! Configure imu sensors, then publish the new configuration under m_sampleCacheLock
+    void configureSensors(struct sensor_value& magn,
+                          struct sensor_value& accel,
+                          struct sensor_value& gyro,
+                          Fw::Enabled fifo_mode);
+
+    //! Configure the LSM6DSO FIFO to batch both sensors at their sampling frequencies with timestamps, or bypass it
+    //!
+    //! Returns true if the FIFO is enabled afterwards, with CTRL1_XL and CTRL2_G read into ctrl for the decoder. Only
+    //! touches the bus, the caller publishes the result under m_sampleCacheLock.
+    bool configureFifo(Fw::Enabled fifo_mode, struct sensor_value& accel, struct sensor_value& gyro, U8 (&ctrl)[2]);
+
+    //! Drain every unread LSM6DSO FIFO word in bursts of FIFO_BURST_WORDS and send the decoded samples
+    //!
+    //! Sample times come from the sensor timestamp counter, anchored to system time once per drain.
+    void drainFifo();
+
+    //! Append a decoded FIFO sample to the pending batch, sending the batch when it is full
+    void appendFifoSample(const Lsm6dsoFifo::Sample& sample,  //!< Decoded sample in the sensor frame
+                          const Fw::Time& reference,          //!< System time of the reference timestamp
+                          U32 reference_ticks                 //!< Sensor timestamp counter at reference
+    );
+
+    //! Send the pending batch of FIFO samples, if any
+    void sendFifoBatch();
+
+    //! Remap a decoded FIFO sample to the body frame and stamp it with system time
+    //!
+    //! Caller must hold m_sampleCacheLock.
+    ImuSample timestampFifoSample(const Lsm6dsoFifo::Sample& sample,  //!< Decoded sample in the sensor frame
+                                  const Fw::Time& reference,          //!< System time of the reference timestamp
+                                  U32 reference_ticks                 //!< Sensor timestamp counter at reference
+    );
+
+    //! Configure the sensors at the sampling frequencies and FIFO mode from parameters
+    void configureSensorsFromParameters();
+
+    //! Drain one burst of at most FIFO_BURST_WORDS into the capture buffers, returns the number of words read
+    //!
+    //! The newest sample is stamped into m_fifo_latest so port reads during the capture stay current.
+    std::size_t drainCaptureBurst();
+
+    //! Write out what the capture still holds, complete the file header and close the file, then restore the
+    //! sensors from parameters and respond to CAPTURE_BURST
+    void finishCapture(Os::File::Status status  //!< OP_OK unless a file operation already failed
+    );
+
+    //! Compile AXIS_MAPPING followed by AXIS_ORIENTATION into m_axisRemap
+    void updateAxisRemap();
 
     //! Get accelerometer sampling frequency from parameter
     struct sensor_value getAccelerometerSamplingFrequency();
@@ -123,6 +279,28 @@ class ImuManager final : public ImuManagerComponentBase {
     //! Get magnetometer sampling frequency from parameter
     struct sensor_value getMagnetometerSamplingFrequency();
 
+    //! Get FIFO mode from parameter
+    Fw::Enabled getFifoMode();
+
+    //! Get magnetometer data-ready mode from parameter
+    Fw::Enabled getDataReadyMode();
+
+    //! Fold a sensor frame magnetometer sample into the calibration fit while collecting, marking a solve due every
+    //! MAG_CALIBRATION_SOLVE_INTERVAL samples, then correct it
+    //!
+    //! Caller must hold m_sampleCacheLock.
+    void calibrateMagneticField(F64& x, F64& y, F64& z);
+
+    //! Solve the calibration fit if a solve is due and apply the solution to later samples
+    //!
+    //! Caller must not hold m_sampleCacheLock. The fit is copied under the lock and solved outside it.
+    void solveMagCalibration();
+
+    //! Write the magnetometer calibration telemetry
+    //!
+    //! Caller must hold m_sampleCacheLock.
+    void writeMagCalibrationTelemetry();
+
     //! Compare two sensor_value structs for equality
     bool sensorValuesEqual(struct sensor_value* sv1, struct sensor_value* sv2);
 
@@ -139,10 +317,131 @@ class ImuManager final : public ImuManagerComponentBase {
     //! Zephyr device storing the initialized LSM6DSO sensor
     const struct device* m_lsm6dso;
 
+    //! I2C bus and address of the LSM6DSO, for FIFO register access
+    const struct i2c_dt_spec* m_lsm6dso_bus = nullptr;
+
     //! Current odr values for sensors
     struct sensor_value m_curr_magn_odr;
     struct sensor_value m_curr_gyro_odr;
     struct sensor_value m_curr_accel_odr;
+
+    //! Words read from the LSM6DSO FIFO per I2C transaction
+    static constexpr std::size_t FIFO_BURST_WORDS = 32;
+
+    //! FIFO mode requested by the parameter when the sensors were last configured
+    Fw::Enabled m_curr_fifo_mode = Fw::Enabled::DISABLED;
+
+    //! Whether the LSM6DSO FIFO is batching samples
+    bool m_fifo_enabled = false;
+
+    //! LSM6DSO FIFO word decoder
+    Lsm6dsoFifo m_fifo;
+
+    //! Words read from the FIFO by one burst
+    U8 m_fifo_buffer[FIFO_BURST_WORDS * Lsm6dsoFifo::WORD_SIZE];
+
+    //! Samples waiting to be sent on imuSampleBatchOut
+    ImuSamples m_fifo_batch;
+    U8 m_fifo_batch_count = 0;
+
+    //! Newest FIFO sample, returned by the acceleration and angular velocity ports in FIFO mode
+    ImuSample m_fifo_latest;
+    bool m_fifo_has_sample = false;
+
+    //! Number of FIFO overruns since boot
+    U32 m_fifo_overruns = 0;
+
+    //! Latest readings, served to port calls while younger than their *_MAX_AGE_MS parameter
+    CachedSample<Drv::Acceleration> m_accelerationCache;
+    CachedSample<Drv::AngularVelocity> m_angularVelocityCache;
+    CachedSample<Drv::MagneticField> m_magneticFieldCache;
+
+    //! Number of sensor fetches since boot, each one LSM6DSO or LIS2MDL read
+    U32 m_busReads = 0;
+
+    //! Protects the sample cache and sensor fetches, which are reached from several rate groups
+    Os::Mutex m_sampleCacheLock;
+
+    //! Sensor to body frame remapping compiled from AXIS_MAPPING and AXIS_ORIENTATION, guarded by m_sampleCacheLock
+    AxisRemap m_axisRemap;
+
+    //! LIS2MDL data-ready pin, the driver's irq-gpios line
+    const struct gpio_dt_spec* m_lis2mdl_drdy = nullptr;
+
+    //! Data-ready mode requested by the parameter when the trigger was last configured
+    Fw::Enabled m_curr_data_ready_mode = Fw::Enabled::DISABLED;
+
+    //! Whether the LIS2MDL data-ready trigger is registered
+    bool m_data_ready_enabled = false;
+
+    //! Trigger and pin callback registration
+    DataReadyContext m_data_ready;
+
+    //! Number of conversions sent on data-ready since boot, guarded by m_sampleCacheLock
+    U32 m_data_ready_samples = 0;
+
+    //! Magnetometer calibration fit, state and the solution applied to samples, guarded by m_sampleCacheLock
+    MagCalibrator m_magCalibrator;
+    MagCalibrator::Solution m_magCalibration = MagCalibrator::identity();
+    MagCalibrationState m_magCalibrationState = MagCalibrationState::DISABLED;
+
+    //! Samples folded in since the last calibration solve, guarded by m_sampleCacheLock
+    U32 m_magCalibrationSinceSolve = 0;
+
+    //! Whether MAG_CALIBRATION_SOLVE_INTERVAL samples were folded in since the last solve, guarded by m_sampleCacheLock
+    bool m_magCalibrationSolveDue = false;
+
+    //! Samples behind the applied solution, so an older solve finishing late is not applied, guarded by
+    //! m_sampleCacheLock
+    U32 m_magCalibrationSolvedSamples = 0;
+
+    //! Changed by every calibration command, so a solve started before one is discarded, guarded by m_sampleCacheLock
+    U32 m_magCalibrationGeneration = 0;
+
+    //! MAG_CALIBRATION_SOLVE_INTERVAL, read when parameters change rather than per sample
+    U32 m_magCalibrationSolveInterval = 100;
+
+    //! Bytes per capture buffer, one fills while the other is written
+    static constexpr std::size_t CAPTURE_BUFFER_SIZE = 2048;
+
+    //! Bytes written to the capture file per step, so draining is never held off for a whole buffer
+    static constexpr FwSizeType CAPTURE_WRITE_CHUNK = 512;
+
+    //! Longest capture CAPTURE_BURST accepts
+    static constexpr U32 MAX_CAPTURE_DURATION_MS = 60000;
+
+    //! FIFO words batched per captured sample: timestamp, gyroscope and accelerometer
+    static constexpr U32 CAPTURE_WORDS_PER_SAMPLE = 3;
+
+    //! Longest a caught-up capture step sleeps, so queued commands and port calls wait at most one 50 Hz period
+    static constexpr U32 CAPTURE_MAX_PACE_US = 20000;
+
+    //! Whether a burst capture owns the FIFO, guarded by m_sampleCacheLock
+    bool m_capture_active = false;
+
+    //! Storage for both capture buffers
+    U8 m_capture_storage[BurstCapture::BUFFER_COUNT * CAPTURE_BUFFER_SIZE];
+
+    //! Capture records staged in m_capture_storage
+    BurstCapture m_capture;
+
+    //! File the capture is written to
+    Os::File m_capture_file;
+    char m_capture_file_name[32];
+
+    //! Uptime the capture started at and its duration
+    U64 m_capture_start_useconds = 0;
+    U64 m_capture_duration_useconds = 0;
+
+    //! Microseconds a caught-up step sleeps: the time the FIFO takes to batch one burst at the capture frequency
+    U32 m_capture_pace_useconds = 0;
+
+    //! Bytes written to the capture file, header included
+    U32 m_capture_bytes = 0;
+
+    //! CAPTURE_BURST command answered when the capture ends
+    FwOpcodeType m_capture_opcode = 0;
+    U32 m_capture_cmd_seq = 0;
 };
 
 }  // namespace Components
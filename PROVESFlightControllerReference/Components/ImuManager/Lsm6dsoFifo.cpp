@@ -0,0 +1,154 @@
+// ======================================================================
+// \title  Lsm6dsoFifo.cpp
+// \brief  cpp file for LSM6DSO FIFO register settings and word decoding
+// ======================================================================
+
+#include "Lsm6dsoFifo.hpp"
+
+#include <cmath>
+
+namespace {
+constexpr double STANDARD_GRAVITY = 9.80665;  // m/s^2 per g
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+// Accelerometer sensitivity in g per LSB for FS_XL = 0b00, 0b01, 0b10, 0b11, i.e. ±2 g, ±16 g, ±4 g and ±8 g
+constexpr double ACCEL_SENSITIVITY_G[] = {0.061e-3, 0.488e-3, 0.122e-3, 0.244e-3};
+
+// Gyroscope sensitivity in dps per LSB for FS_G = 0b00, 0b01, 0b10, 0b11, i.e. ±250, ±500, ±1000 and ±2000 dps
+constexpr double GYRO_SENSITIVITY_DPS[] = {8.75e-3, 17.5e-3, 35.0e-3, 70.0e-3};
+constexpr double GYRO_SENSITIVITY_125_DPS = 4.375e-3;  // ±125 dps, selected by FS_125 over FS_G
+
+constexpr std::uint8_t FIFO_CTRL4_DEC_TS_BATCH_1 = 0x40;  // Timestamp word at every batch event
+constexpr std::uint8_t FIFO_CTRL4_CONTINUOUS = 0x06;      // Newest words overwrite the oldest when full
+constexpr std::uint8_t FIFO_STATUS2_DIFF_MASK = 0x03;     // Unread word count, high bits
+constexpr std::uint8_t FIFO_STATUS2_OVR = 0x40;           // FIFO_OVR_IA
+constexpr std::uint8_t CTRL2_G_FS_125 = 0x02;
+}  // namespace
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+//  Register values
+// ----------------------------------------------------------------------
+
+std::uint8_t Lsm6dsoFifo ::batchDataRateCode(double frequency_hz) {
+    if (frequency_hz <= 0.0) {
+        return 0;
+    }
+    long code = std::lround(std::log2(frequency_hz / 12.5)) + 1;
+    if (code < 1) {
+        return 1;
+    }
+    if (code > MAX_BATCH_DATA_RATE) {
+        return MAX_BATCH_DATA_RATE;
+    }
+    return static_cast<std::uint8_t>(code);
+}
+
+std::uint8_t Lsm6dsoFifo ::fifoCtrl3(std::uint8_t accel_code, std::uint8_t gyro_code) {
+    return static_cast<std::uint8_t>(((gyro_code & 0x0F) << 4) | (accel_code & 0x0F));
+}
+
+std::uint8_t Lsm6dsoFifo ::fifoCtrl4(bool enabled) {
+    return enabled ? static_cast<std::uint8_t>(FIFO_CTRL4_DEC_TS_BATCH_1 | FIFO_CTRL4_CONTINUOUS) : 0;
+}
+
+std::size_t Lsm6dsoFifo ::unreadWords(std::uint8_t status1, std::uint8_t status2) {
+    return (static_cast<std::size_t>(status2 & FIFO_STATUS2_DIFF_MASK) << 8) | status1;
+}
+
+bool Lsm6dsoFifo ::overrun(std::uint8_t status2) {
+    return (status2 & FIFO_STATUS2_OVR) != 0;
+}
+
+std::uint32_t Lsm6dsoFifo ::timestampTicks(const std::uint8_t* bytes) {
+    return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) |
+           (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+}
+
+std::int64_t Lsm6dsoFifo ::microsecondsBefore(std::uint32_t reference_ticks, std::uint32_t sample_ticks) {
+    // Unsigned subtraction handles the counter wrapping, the cast keeps samples a little after the reference
+    std::int32_t ticks = static_cast<std::int32_t>(reference_ticks - sample_ticks);
+    return static_cast<std::int64_t>(ticks) * TIMESTAMP_TICK_US;
+}
+
+// ----------------------------------------------------------------------
+//  Decoding
+// ----------------------------------------------------------------------
+
+Lsm6dsoFifo ::Lsm6dsoFifo() {
+    this->setFullScale(0, 0);
+}
+
+void Lsm6dsoFifo ::setFullScale(std::uint8_t ctrl1_xl, std::uint8_t ctrl2_g) {
+    this->m_accel_scale = ACCEL_SENSITIVITY_G[(ctrl1_xl >> 2) & 0x03] * STANDARD_GRAVITY;
+    double gyro_dps =
+        (ctrl2_g & CTRL2_G_FS_125) ? GYRO_SENSITIVITY_125_DPS : GYRO_SENSITIVITY_DPS[(ctrl2_g >> 2) & 0x03];
+    this->m_gyro_scale = gyro_dps * DEG_TO_RAD;
+}
+
+double Lsm6dsoFifo ::getAccelScale() const {
+    return this->m_accel_scale;
+}
+
+double Lsm6dsoFifo ::getGyroScale() const {
+    return this->m_gyro_scale;
+}
+
+void Lsm6dsoFifo ::reset() {
+    this->m_pending = Sample{};
+    this->m_have_timestamp = false;
+    this->m_have_data = false;
+}
+
+bool Lsm6dsoFifo ::decodeWord(const std::uint8_t* word, Sample& sample) {
+    const std::uint8_t* data = word + 1;
+
+    switch (static_cast<Tag>(word[0] >> 3)) {
+        case Tag::TIMESTAMP: {
+            bool complete = this->m_have_timestamp && this->m_have_data;
+            if (complete) {
+                sample = this->m_pending;
+            }
+            this->m_pending.timestamp_ticks = timestampTicks(data);
+            this->m_have_timestamp = true;
+            this->m_have_data = false;
+            return complete;
+        }
+        case Tag::ACCELEROMETER:
+            for (std::size_t axis = 0; axis < 3; axis++) {
+                this->m_pending.acceleration_raw[axis] = toInt16(data + 2 * axis);
+                this->m_pending.acceleration[axis] = this->m_pending.acceleration_raw[axis] * this->m_accel_scale;
+            }
+            this->m_have_data = true;
+            return false;
+        case Tag::GYROSCOPE:
+            for (std::size_t axis = 0; axis < 3; axis++) {
+                this->m_pending.angular_velocity_raw[axis] = toInt16(data + 2 * axis);
+                this->m_pending.angular_velocity[axis] =
+                    this->m_pending.angular_velocity_raw[axis] * this->m_gyro_scale;
+            }
+            this->m_have_data = true;
+            return false;
+        case Tag::TEMPERATURE:
+        case Tag::CONFIG_CHANGE:
+        default:
+            this->m_discarded++;
+            return false;
+    }
+}
+
+std::uint32_t Lsm6dsoFifo ::getDiscardedWords() const {
+    return this->m_discarded;
+}
+
+// ----------------------------------------------------------------------
+//  Private helper methods
+// ----------------------------------------------------------------------
+
+std::int16_t Lsm6dsoFifo ::toInt16(const std::uint8_t* bytes) {
+    return static_cast<std::int16_t>(static_cast<std::uint16_t>(bytes[0]) |
+                                     (static_cast<std::uint16_t>(bytes[1]) << 8));
+}
+
+}  // namespace Components
@@ -0,0 +1,126 @@
+// ======================================================================
+// \title  Lsm6dsoFifo.hpp
+// \brief  hpp file for LSM6DSO FIFO register settings and word decoding
+// ======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Components {
+
+//! LSM6DSO FIFO register settings and decoding of the tagged words drained from FIFO_DATA_OUT
+//!
+//! With timestamp batching at decimation 1 the FIFO writes a TIMESTAMP word at every batch event, followed by the
+//! gyroscope and accelerometer words batched at that instant. The decoder groups each TIMESTAMP word with the data
+//! words after it into one Sample. A group is complete when the next TIMESTAMP word arrives, so the newest group of a
+//! burst is handed out by the following burst. A sensor batched slower than the other keeps its most recent value.
+class Lsm6dsoFifo {
+  public:
+    // ----------------------------------------------------------------------
+    //  Registers
+    // ----------------------------------------------------------------------
+
+    static constexpr std::uint8_t REG_FIFO_CTRL3 = 0x09;         //!< Accelerometer and gyroscope batch data rates
+    static constexpr std::uint8_t REG_FIFO_CTRL4 = 0x0A;         //!< Timestamp batching and FIFO mode
+    static constexpr std::uint8_t REG_CTRL1_XL = 0x10;           //!< Accelerometer data rate and full scale
+    static constexpr std::uint8_t REG_CTRL10_C = 0x19;           //!< Timestamp counter enable
+    static constexpr std::uint8_t REG_FIFO_STATUS1 = 0x3A;       //!< Unread word count, low bits
+    static constexpr std::uint8_t REG_TIMESTAMP0 = 0x40;         //!< Timestamp counter, four bytes little endian
+    static constexpr std::uint8_t REG_FIFO_DATA_OUT_TAG = 0x78;  //!< First byte of the oldest unread word
+
+    static constexpr std::uint8_t CTRL10_C_TIMESTAMP_EN = 0x20;  //!< Enables the timestamp counter
+
+    static constexpr std::size_t WORD_SIZE = 7;              //!< Tag byte followed by six data bytes
+    static constexpr std::uint32_t TIMESTAMP_TICK_US = 25;   //!< Timestamp counter resolution in microseconds
+    static constexpr std::uint8_t MAX_BATCH_DATA_RATE = 10;  //!< Code for 6667 Hz, codes double from 12.5 Hz
+
+    //! Sensor identified by the upper five bits of the tag byte
+    enum class Tag : std::uint8_t {
+        GYROSCOPE = 0x01,      //!< Gyroscope, not compressed
+        ACCELEROMETER = 0x02,  //!< Accelerometer, not compressed
+        TEMPERATURE = 0x03,    //!< Temperature
+        TIMESTAMP = 0x04,      //!< Timestamp counter
+        CONFIG_CHANGE = 0x05,  //!< Batch configuration change
+    };
+
+    //! One accelerometer and gyroscope sample in SI units and raw counts, in the sensor frame
+    struct Sample {
+        std::array<double, 3> acceleration;                //!< Acceleration in m/s^2
+        std::array<double, 3> angular_velocity;            //!< Angular velocity in rad/s
+        std::array<std::int16_t, 3> acceleration_raw;      //!< Acceleration in LSB
+        std::array<std::int16_t, 3> angular_velocity_raw;  //!< Angular velocity in LSB
+        std::uint32_t timestamp_ticks;                     //!< Timestamp counter when the sample was batched
+    };
+
+  public:
+    // ----------------------------------------------------------------------
+    //  Register values
+    // ----------------------------------------------------------------------
+
+    //! Batch data rate code for a sampling frequency in Hz, the nearest of 12.5 Hz doubling up to 6667 Hz
+    static std::uint8_t batchDataRateCode(double frequency_hz);
+
+    //! FIFO_CTRL3 value batching both sensors at the given codes
+    static std::uint8_t fifoCtrl3(std::uint8_t accel_code, std::uint8_t gyro_code);
+
+    //! FIFO_CTRL4 value, timestamps at every batch event in continuous mode when enabled, otherwise bypass
+    static std::uint8_t fifoCtrl4(bool enabled);
+
+    //! Unread word count from FIFO_STATUS1 and FIFO_STATUS2
+    static std::size_t unreadWords(std::uint8_t status1, std::uint8_t status2);
+
+    //! Whether FIFO_STATUS2 reports words overwritten before they were read
+    static bool overrun(std::uint8_t status2);
+
+    //! Timestamp counter from the four little endian bytes at TIMESTAMP0
+    static std::uint32_t timestampTicks(const std::uint8_t* bytes);
+
+    //! Microseconds from the sample timestamp to the reference timestamp, negative if the sample is later
+    static std::int64_t microsecondsBefore(std::uint32_t reference_ticks, std::uint32_t sample_ticks);
+
+  public:
+    // ----------------------------------------------------------------------
+    //  Decoding
+    // ----------------------------------------------------------------------
+
+    //! Construct the decoder at the sensor's power on full scales, ±2 g and ±250 dps
+    Lsm6dsoFifo();
+
+    //! Set the raw to SI scale factors from CTRL1_XL and CTRL2_G, which follows it
+    void setFullScale(std::uint8_t ctrl1_xl,  //!< CTRL1_XL register value
+                      std::uint8_t ctrl2_g    //!< CTRL2_G register value
+    );
+
+    //! Acceleration in m/s^2 per LSB at the current full scale
+    double getAccelScale() const;
+
+    //! Angular velocity in rad/s per LSB at the current full scale
+    double getGyroScale() const;
+
+    //! Forget any partial group and the held sensor values, used when the FIFO is reconfigured
+    void reset();
+
+    //! Decode one FIFO word, returns true when it completes a sample
+    bool decodeWord(const std::uint8_t* word,  //!< WORD_SIZE bytes read from FIFO_DATA_OUT_TAG
+                    Sample& sample             //!< Completed sample, written only when true is returned
+    );
+
+    //! Number of words with a tag the decoder does not use since construction
+    std::uint32_t getDiscardedWords() const;
+
+  private:
+    //! Signed 16 bit value from two little endian bytes
+    static std::int16_t toInt16(const std::uint8_t* bytes);
+
+    double m_accel_scale;           //!< m/s^2 per LSB
+    double m_gyro_scale;            //!< rad/s per LSB
+    Sample m_pending{};             //!< Group collected since the last TIMESTAMP word
+    bool m_have_timestamp = false;  //!< A TIMESTAMP word opened the pending group
+    bool m_have_data = false;       //!< The pending group holds at least one data word
+    std::uint32_t m_discarded = 0;  //!< Words with an unused tag
+};
+
+}  // namespace Components
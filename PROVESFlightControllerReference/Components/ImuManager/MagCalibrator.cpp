@@ -0,0 +1,147 @@
+// ======================================================================
+// \title  MagCalibrator.cpp
+// \brief  cpp file for the streaming hard and soft iron magnetometer calibration
+// ======================================================================
+
+#include "MagCalibrator.hpp"
+
+#include <cmath>
+
+namespace Components {
+
+// ----------------------------------------------------------------------
+//  Construction
+// ----------------------------------------------------------------------
+
+MagCalibrator ::MagCalibrator() {
+    this->reset();
+}
+
+MagCalibrator::Solution MagCalibrator ::identity() {
+    return Solution{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}, 0.0};
+}
+
+// ----------------------------------------------------------------------
+//  Public helper methods
+// ----------------------------------------------------------------------
+
+void MagCalibrator ::apply(const Solution& solution, double& x, double& y, double& z) {
+    x = (x - solution.offset[0]) * solution.scale[0];
+    y = (y - solution.offset[1]) * solution.scale[1];
+    z = (z - solution.offset[2]) * solution.scale[2];
+}
+
+void MagCalibrator ::reset() {
+    this->m_normal.fill(0.0);
+    this->m_rhs.fill(0.0);
+    this->m_samples = 0;
+}
+
+void MagCalibrator ::add(double x, double y, double z) {
+    const double terms[TERMS] = {x * x, y * y, z * z, x, y, z};
+    for (std::size_t i = 0; i < TERMS; i++) {
+        for (std::size_t j = i; j < TERMS; j++) {
+            this->m_normal[packed(i, j)] += terms[i] * terms[j];
+        }
+        this->m_rhs[i] += terms[i];
+    }
+    this->m_samples++;
+}
+
+std::uint32_t MagCalibrator ::getSamples() const {
+    return this->m_samples;
+}
+
+bool MagCalibrator ::solve(Solution& solution) const {
+    if (this->m_samples < MIN_SAMPLES) {
+        return false;
+    }
+
+    // Gaussian elimination with partial pivoting on the full normal equations
+    double a[TERMS][TERMS + 1];
+    double largest = 0.0;
+    for (std::size_t i = 0; i < TERMS; i++) {
+        for (std::size_t j = 0; j < TERMS; j++) {
+            a[i][j] = this->m_normal[(i <= j) ? packed(i, j) : packed(j, i)];
+        }
+        a[i][TERMS] = this->m_rhs[i];
+        largest = std::fmax(largest, a[i][i]);
+    }
+    for (std::size_t column = 0; column < TERMS; column++) {
+        std::size_t pivot = column;
+        for (std::size_t row = column + 1; row < TERMS; row++) {
+            if (std::fabs(a[row][column]) > std::fabs(a[pivot][column])) {
+                pivot = row;
+            }
+        }
+        // Samples confined to a plane or a line leave the system singular
+        if (std::fabs(a[pivot][column]) <= 1e-12 * largest) {
+            return false;
+        }
+        for (std::size_t j = 0; j <= TERMS; j++) {
+            double swap = a[column][j];
+            a[column][j] = a[pivot][j];
+            a[pivot][j] = swap;
+        }
+        for (std::size_t row = column + 1; row < TERMS; row++) {
+            double factor = a[row][column] / a[column][column];
+            for (std::size_t j = column; j <= TERMS; j++) {
+                a[row][j] -= factor * a[column][j];
+            }
+        }
+    }
+    double p[TERMS];
+    for (std::size_t i = TERMS; i-- > 0;) {
+        double sum = a[i][TERMS];
+        for (std::size_t j = i + 1; j < TERMS; j++) {
+            sum -= a[i][j] * p[j];
+        }
+        p[i] = sum / a[i][i];
+    }
+
+    // Completing the square: a (x - x0)^2 + b (y - y0)^2 + c (z - z0)^2 = g
+    if (p[0] <= 0.0 || p[1] <= 0.0 || p[2] <= 0.0) {
+        return false;
+    }
+    double g = 1.0;
+    std::array<double, 3> offset;
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        offset[axis] = -p[3 + axis] / (2.0 * p[axis]);
+        g += p[axis] * offset[axis] * offset[axis];
+    }
+    if (g <= 0.0) {
+        return false;
+    }
+    std::array<double, 3> radius;
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        radius[axis] = std::sqrt(g / p[axis]);
+    }
+    double mean_radius = std::cbrt(radius[0] * radius[1] * radius[2]);
+
+    // Sum of squared residuals of terms . p = 1 from the same sums: p' N p - 2 p' r + samples
+    double squared = static_cast<double>(this->m_samples);
+    for (std::size_t i = 0; i < TERMS; i++) {
+        double row = 0.0;
+        for (std::size_t j = 0; j < TERMS; j++) {
+            row += this->m_normal[(i <= j) ? packed(i, j) : packed(j, i)] * p[j];
+        }
+        squared += p[i] * row - 2.0 * p[i] * this->m_rhs[i];
+    }
+
+    solution.offset = offset;
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        solution.scale[axis] = mean_radius / radius[axis];
+    }
+    solution.residual = std::sqrt(std::fmax(squared, 0.0) / static_cast<double>(this->m_samples));
+    return true;
+}
+
+// ----------------------------------------------------------------------
+//  Private helper methods
+// ----------------------------------------------------------------------
+
+std::size_t MagCalibrator ::packed(std::size_t i, std::size_t j) {
+    return i * TERMS - (i * (i - 1)) / 2 + (j - i);
+}
+
+}  // namespace Components
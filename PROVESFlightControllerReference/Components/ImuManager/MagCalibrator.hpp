@@ -0,0 +1,67 @@
+// ======================================================================
+// \title  MagCalibrator.hpp
+// \brief  hpp file for the streaming hard and soft iron magnetometer calibration
+// ======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Components {
+
+//! Streaming axis-aligned ellipsoid fit for magnetometer hard and soft iron calibration
+//!
+//! A distorted field of constant magnitude traces the ellipsoid a x^2 + b y^2 + c z^2 + d x + e y + f z = 1. Each
+//! sample folds its terms into the least squares normal equations, so memory is fixed however many samples are added
+//! and no sample is kept. Solving the normal equations gives the centre, the hard iron offset, and the semi-axes, whose
+//! ratios are the soft iron scale. The scale maps each semi-axis onto their geometric mean, which keeps the corrected
+//! magnitude close to the true field.
+class MagCalibrator {
+  public:
+    static constexpr std::size_t TERMS = 6;           //!< Unknowns of the ellipsoid equation
+    static constexpr std::uint32_t MIN_SAMPLES = 32;  //!< Samples needed before a solve is attempted
+
+    //! Correction applied as (raw - offset) * scale
+    struct Solution {
+        std::array<double, 3> offset;  //!< Hard iron offset, in the units of the samples
+        std::array<double, 3> scale;   //!< Soft iron scale per axis
+        double residual;               //!< RMS of the ellipsoid equation residual, 0 for a perfect fit
+    };
+
+  public:
+    //! Construct with no samples
+    MagCalibrator();
+
+    //! The correction that leaves samples unchanged
+    static Solution identity();
+
+    //! Correct a sample in place
+    static void apply(const Solution& solution, double& x, double& y, double& z);
+
+    //! Forget every sample
+    void reset();
+
+    //! Fold one sample into the normal equations
+    void add(double x, double y, double z);
+
+    //! Samples folded in since the last reset
+    std::uint32_t getSamples() const;
+
+    //! Fit the ellipsoid to the samples so far
+    //!
+    //! Returns false, leaving solution unchanged, with fewer than MIN_SAMPLES samples, when the samples do not span
+    //! all three axes, or when they do not fit an ellipsoid.
+    bool solve(Solution& solution) const;
+
+  private:
+    //! Index of row i, column j, with i <= j, in the packed upper triangle of the normal matrix
+    static std::size_t packed(std::size_t i, std::size_t j);
+
+    std::array<double, TERMS * (TERMS + 1) / 2> m_normal;  //!< Upper triangle of the sum of terms times terms
+    std::array<double, TERMS> m_rhs;                       //!< Sum of terms
+    std::uint32_t m_samples;                               //!< Samples folded in
+};
+
+}  // namespace Components
@@ -0,0 +1,82 @@
+// ======================================================================
+// \title  Batch.cpp
+// \brief  cpp file for command batch packet helper functions
+// ======================================================================
+
+#include "Batch.hpp"
+
+namespace Components {
+namespace CommandBatch {
+namespace {
+
+constexpr uint32_t kBatchMask = 0x7FFFFF;  //!< Batch number bits below the flag
+constexpr uint32_t kIndexMask = 0xFF;      //!< Command index bits
+
+size_t readLength(const uint8_t* buffer) {
+    return (static_cast<size_t>(buffer[0]) << 8) | static_cast<size_t>(buffer[1]);
+}
+
+}  // namespace
+
+Status validate(const uint8_t* buffer, size_t size, size_t maxCommandSize, size_t maxCommands, size_t& count) {
+    if (!buffer || size <= kHeaderSize) {
+        return Status::Empty;
+    }
+
+    size_t commands = 0;
+    size_t offset = kHeaderSize;
+    while (offset < size) {
+        if (size - offset < kLengthSize) {
+            return Status::Truncated;
+        }
+        const size_t length = readLength(buffer + offset);
+        offset += kLengthSize;
+        if (length > size - offset) {
+            return Status::Truncated;
+        }
+        if (length < kMinCommandSize) {
+            return Status::CommandTooShort;
+        }
+        if (length > maxCommandSize) {
+            return Status::CommandTooLong;
+        }
+        offset += length;
+        commands++;
+        if (commands > maxCommands) {
+            return Status::TooManyCommands;
+        }
+    }
+
+    count = commands;
+    return Status::Ok;
+}
+
+bool next(const uint8_t* buffer, size_t size, size_t& offset, Entry& entry) {
+    if (!buffer || offset >= size || size - offset < kLengthSize) {
+        return false;
+    }
+    const size_t length = readLength(buffer + offset);
+    if (length > size - offset - kLengthSize) {
+        return false;
+    }
+    entry.data = buffer + offset + kLengthSize;
+    entry.size = length;
+    offset += kLengthSize + length;
+    return true;
+}
+
+uint32_t commandContext(uint32_t batch, uint32_t index) {
+    return kContextFlag | ((batch & kBatchMask) << 8) | (index & kIndexMask);
+}
+
+bool decodeCommandContext(uint32_t context, uint32_t& batch, uint32_t& index) {
+    if ((context & kContextFlag) == 0) {
+        return false;
+    }
+    batch = (context >> 8) & kBatchMask;
+    index = context & kIndexMask;
+    return true;
+}
+
+}  // namespace CommandBatch
+}  // namespace Components
@@ -0,0 +1,70 @@
+// ======================================================================
+// \title  Batch.hpp
+// \brief  hpp file for command batch packet helper functions
+// ======================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Components {
+
+//! A command batch packet carries several command packets in one authenticated frame:
+//!
+//!   [Packet descriptor (2)] [Length (2)] [Command packet] [Length (2)] [Command packet] ...
+//!
+//! Lengths are big-endian, and each command packet is exactly what a single command frame would carry: packet
+//! descriptor, opcode and arguments.
+namespace CommandBatch {
+
+constexpr const size_t kHeaderSize = 2;            //!< The batch packet descriptor size in bytes
+constexpr const size_t kLengthSize = 2;            //!< The command length prefix size in bytes
+constexpr const size_t kMinCommandSize = 6;        //!< A command packet descriptor and opcode
+constexpr const uint32_t kContextFlag = 1u << 31;  //!< Set in the cmdSeq context of every batched command
+
+//! Status of batch validation
+//! Must match the BatchStatus enum in the .fpp file
+enum class Status {
+    Ok,               //!< The batch is well formed
+    Empty,            //!< The batch carries no commands
+    Truncated,        //!< A length prefix or command runs past the end of the packet
+    CommandTooShort,  //!< A command is shorter than a packet descriptor and opcode
+    CommandTooLong,   //!< A command does not fit in a com buffer
+    TooManyCommands,  //!< The batch carries more commands than may be queued at once
+};
+
+//! A command packet inside a batch
+struct Entry {
+    const uint8_t* data;  //!< Start of the command packet
+    size_t size;          //!< Size of the command packet in bytes
+};
+
+//! Check that the whole batch is well formed before any of it is dispatched
+Status validate(const uint8_t* buffer,  //!< The batch packet
+                size_t size,            //!< The batch packet size
+                size_t maxCommandSize,  //!< The largest command packet accepted
+                size_t maxCommands,     //!< The most commands accepted
+                size_t& count           //!< The number of commands, set when the batch is well formed
+);
+
+//! Read the command at offset and advance offset past it; returns false at the end of a validated batch
+bool next(const uint8_t* buffer,  //!< The batch packet
+          size_t size,            //!< The batch packet size
+          size_t& offset,         //!< The offset of the next length prefix, start at kHeaderSize
+          Entry& entry            //!< The command read
+);
+
+//! The cmdSeq context dispatched with a batched command, never 0 so it is not mistaken for a single command
+uint32_t commandContext(uint32_t batch,  //!< The batch number
+                        uint32_t index   //!< The command index within the batch
+);
+
+//! Recover the batch number and command index from a cmdSeq context; returns false for a single command
+bool decodeCommandContext(uint32_t context,  //!< The cmdSeq context returned with the command response
+                          uint32_t& batch,   //!< The batch number, modulo 2^23
+                          uint32_t& index    //!< The command index within the batch
+);
+
+}  // namespace CommandBatch
+}  // namespace Components
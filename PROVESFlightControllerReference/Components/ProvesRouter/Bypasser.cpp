@@ -76,5 +76,15 @@ bool bypassPacket(const uint8_t* buffer, const size_t size) {
     return false;
 }
 
+Admission admitPacket(const uint8_t* buffer, const size_t size, bool authenticated, bool batch) {
+    if (authenticated) {
+        return Admission::Authenticated;
+    }
+    if (!batch && bypassPacket(buffer, size)) {
+        return Admission::Bypassed;
+    }
+    return Admission::Rejected;
+}
+
 }  // namespace PacketBypasser
 }  // namespace Components
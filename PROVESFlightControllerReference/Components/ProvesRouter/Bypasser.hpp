@@ -11,10 +11,26 @@
 namespace Components {
 namespace PacketBypasser {
 
+//! How a packet was let into the router
+enum class Admission {
+    Rejected,       //!< Neither authenticated nor allowed to bypass authentication
+    Authenticated,  //!< Authenticated by TcSecurityDeframer
+    Bypassed,       //!< Unauthenticated single command on the bypass allowlist
+};
+
 //! Determine if the packet can bypass authentication
 bool bypassPacket(const uint8_t* buffer,  //!< The packet buffer
                   const size_t size       //!< The packet size
 );
 
+//! Decide whether the router may route a packet
+//!
+//! The bypass allowlist applies to single commands only, never to a batch that merely starts with an allowed opcode.
+Admission admitPacket(const uint8_t* buffer,  //!< The packet buffer
+                      const size_t size,      //!< The packet size
+                      bool authenticated,     //!< Whether TcSecurityDeframer authenticated the frame
+                      bool batch              //!< Whether the packet is a command batch
+);
+
 }  // namespace PacketBypasser
 }  // namespace Components
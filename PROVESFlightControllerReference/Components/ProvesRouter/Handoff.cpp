@@ -0,0 +1,48 @@
+// ======================================================================
+// \title  Handoff.cpp
+// \brief  cpp file for tracking packet buffers lent to downstream components
+// ======================================================================
+
+#include "Handoff.hpp"
+
+namespace Components {
+namespace PacketHandoff {
+
+void reset(Slot* slots, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        slots[i].data = nullptr;
+        slots[i].size = 0;
+    }
+}
+
+size_t claim(Slot* slots, size_t count, const uint8_t* data, size_t size) {
+    if (data == nullptr) {
+        return kNoSlot;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (slots[i].data == nullptr) {
+            slots[i].data = data;
+            slots[i].size = size;
+            return i;
+        }
+    }
+    return kNoSlot;
+}
+
+size_t release(Slot* slots, size_t count, const uint8_t* data, size_t& size) {
+    if (data == nullptr) {
+        return kNoSlot;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (slots[i].data == data) {
+            size = slots[i].size;
+            slots[i].data = nullptr;
+            slots[i].size = 0;
+            return i;
+        }
+    }
+    return kNoSlot;
+}
+
+}  // namespace PacketHandoff
+}  // namespace Components
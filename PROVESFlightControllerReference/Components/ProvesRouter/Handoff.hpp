@@ -0,0 +1,42 @@
+// ======================================================================
+// \title  Handoff.hpp
+// \brief  hpp file for tracking packet buffers lent to downstream components
+// ======================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Components {
+namespace PacketHandoff {
+
+constexpr const size_t kNoSlot = SIZE_MAX;  //!< Returned when no slot matches or is free
+
+//! A packet buffer handed downstream whose return upstream is deferred
+struct Slot {
+    const uint8_t* data;  //!< Start of the packet as received, nullptr when the slot is free
+    size_t size;          //!< Size of the packet as received
+};
+
+//! Mark every slot free
+void reset(Slot* slots,  //!< The slots
+           size_t count  //!< The number of slots
+);
+
+//! Record a packet in a free slot; returns the slot index or kNoSlot when all slots are in use
+size_t claim(Slot* slots,          //!< The slots
+             size_t count,         //!< The number of slots
+             const uint8_t* data,  //!< Start of the packet
+             size_t size           //!< Size of the packet
+);
+
+//! Free the slot holding data and report the size it was claimed with; returns kNoSlot when data is not tracked
+size_t release(Slot* slots,          //!< The slots
+               size_t count,         //!< The number of slots
+               const uint8_t* data,  //!< Start of the returned packet
+               size_t& size          //!< Size of the packet when it was claimed
+);
+
+}  // namespace PacketHandoff
+}  // namespace Components
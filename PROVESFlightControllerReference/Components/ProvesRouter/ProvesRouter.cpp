@@ -10,6 +10,7 @@
 #include <Fw/Time/Time.hpp>
 #include <Fw/Types/String.hpp>
 
+#include "Batch.hpp"
 #include "Bypasser.hpp"
 #include "Fw/Com/ComPacket.hpp"
 #include "Fw/FPrimeBasicTypes.hpp"
@@ -23,7 +24,17 @@ namespace Svc {
 // ----------------------------------------------------------------------
 
 ProvesRouter ::ProvesRouter(const char* const compName)
-    : ProvesRouterComponentBase(compName), m_routedPackets(0), m_bypassedPackets(0), m_rejectedPackets(0) {}
+    : ProvesRouterComponentBase(compName),
+      m_routedPackets(0),
+      m_bypassedPackets(0),
+      m_rejectedPackets(0),
+      m_zeroCopyHandoffs(0),
+      m_bufferAllocations(0),
+      m_routedBatches(0),
+      m_batchedCommands(0),
+      m_batchCommandFailures(0) {
+    Components::PacketHandoff::reset(this->m_handoffs, ROUTER_MAX_HANDOFFS);
+}
 ProvesRouter ::~ProvesRouter() {}
 
 // ----------------------------------------------------------------------
@@ -31,10 +42,13 @@ ProvesRouter ::~ProvesRouter() {}
 // ----------------------------------------------------------------------
 
 void ProvesRouter ::dataIn_handler(FwIndexType portNum, Fw::Buffer& packetBuffer, const ComCfg::FrameContext& context) {
+    Fw::ComPacketType packetType = context.get_apid();
+
     // Validate that the packet is authenticated or can bypass authentication
-    bool allowed = context.get_authenticated() ||
-                   Components::PacketBypasser::bypassPacket(packetBuffer.getData(), packetBuffer.getSize());
-    if (!allowed) {
+    const Components::PacketBypasser::Admission admission = Components::PacketBypasser::admitPacket(
+        packetBuffer.getData(), packetBuffer.getSize(), context.get_authenticated(),
+        packetType == Fw::ComPacketType::PROVES_COMMAND_BATCH);
+    if (admission == Components::PacketBypasser::Admission::Rejected) {
         // Telemeter the rejection
         this->m_rejectedPackets += 1;
         this->tlmWrite_RejectedPackets(this->m_rejectedPackets);
@@ -45,20 +59,24 @@ void ProvesRouter ::dataIn_handler(FwIndexType portNum, Fw::Buffer& packetBuffer
     }
 
     // Telemeter the bypass if the packet was allowed to bypass authentication
-    bool bypassed = !context.get_authenticated() && allowed;
-    if (bypassed) {
+    if (admission == Components::PacketBypasser::Admission::Bypassed) {
         this->m_bypassedPackets += 1;
         this->tlmWrite_BypassedPackets(this->m_bypassedPackets);
     }
 
     // Route based on packet type
-    Fw::ComPacketType packetType = context.get_apid();
     switch (packetType) {
         case Fw::ComPacketType::FW_PACKET_COMMAND:
             this->handleCommandPacket(packetBuffer);
             break;
+        case Fw::ComPacketType::PROVES_COMMAND_BATCH:
+            this->handleCommandBatch(packetBuffer);
+            break;
         case Fw::ComPacketType::FW_PACKET_FILE:
-            this->handleFilePacket(packetBuffer);
+            if (this->handleFilePacket(packetBuffer, context)) {
+                // FileUplink owns the frame buffer now; it is returned from fileBufferReturnIn_handler
+                return;
+            }
             break;
         default:
             this->handleUnknownPacket(packetBuffer, context);
@@ -88,14 +106,75 @@ void ProvesRouter::handleCommandPacket(Fw::Buffer& packetBuffer) {
     this->notifyPacketRouted();
 }
 
-void ProvesRouter::handleFilePacket(Fw::Buffer& packetBuffer) {
+void ProvesRouter::handleCommandBatch(Fw::Buffer& packetBuffer) {
+    // Check the whole batch first so that a malformed one dispatches nothing
+    size_t count = 0;
+    const Components::CommandBatch::Status status =
+        Components::CommandBatch::validate(packetBuffer.getData(), packetBuffer.getSize(), FW_COM_BUFFER_MAX_SIZE,
+                                           ROUTER_MAX_BATCH_COMMANDS, count);
+    if (status != Components::CommandBatch::Status::Ok) {
+        // Telemeter the error
+        this->log_WARNING_HI_BatchInvalid(static_cast<ProvesRouter_BatchStatus::T>(status));
+        return;
+    }
+
+    this->m_routedBatches += 1;
+    this->tlmWrite_RoutedBatches(this->m_routedBatches);
+
+    // Dispatch each command in order. The batch number and index travel in the command context, so each response
+    // on cmdResponseIn can be matched to its command.
+    size_t offset = Components::CommandBatch::kHeaderSize;
+    Components::CommandBatch::Entry entry;
+    U32 index = 0;
+    while (Components::CommandBatch::next(packetBuffer.getData(), packetBuffer.getSize(), offset, entry)) {
+        Fw::ComBuffer com;
+        Fw::SerializeStatus serializeStatus = com.setBuff(entry.data, entry.size);
+        if (serializeStatus != Fw::FW_SERIALIZE_OK) {
+            // Telemeter the error
+            this->log_WARNING_HI_SerializationError(serializeStatus);
+            break;
+        }
+        this->commandOut_out(0, com, Components::CommandBatch::commandContext(this->m_routedBatches, index));
+        index++;
+    }
+
+    this->m_batchedCommands += index;
+    this->tlmWrite_BatchedCommands(this->m_batchedCommands);
+
+    // Notify connected components that a packet was routed
+    this->notifyPacketRouted();
+}
+
+bool ProvesRouter::handleFilePacket(Fw::Buffer& packetBuffer, const ComCfg::FrameContext& context) {
     // Exit early if no components are connected
     if (!this->isConnected_fileOut_OutputPort(0)) {
-        return;
+        return false;
+    }
+
+    // Lend the frame buffer itself to FileUplink, remembering what to return upstream when it comes back. The slot
+    // is claimed before sending because FileUplink may return the buffer from its own thread at any time.
+    size_t slot = Components::PacketHandoff::kNoSlot;
+    {
+        Os::ScopeLock lock(this->m_handoffLock);
+        slot = Components::PacketHandoff::claim(this->m_handoffs, ROUTER_MAX_HANDOFFS, packetBuffer.getData(),
+                                                packetBuffer.getSize());
+        if (slot != Components::PacketHandoff::kNoSlot) {
+            this->m_handoffContexts[slot] = context;
+        }
     }
+    if (slot != Components::PacketHandoff::kNoSlot) {
+        this->m_zeroCopyHandoffs += 1;
+        this->tlmWrite_ZeroCopyHandoffs(this->m_zeroCopyHandoffs);
 
-    // Copy buffer into a new allocated buffer. This lets us return the original buffer with dataReturnOut,
-    // and ProvesRouter can handle the deallocation of the unknown buffer when it returns on bufferReturnIn
+        // Send the frame buffer to connected components
+        this->fileOut_out(0, packetBuffer);
+
+        // Notify connected components that a packet was routed
+        this->notifyPacketRouted();
+        return true;
+    }
+
+    // Every slot is lent out, so copy into a new allocated buffer and return the original buffer with dataReturnOut
     Fw::Buffer copy = this->allocateCopy(packetBuffer, ProvesRouter_AllocationReason::FILE_UPLINK);
     if (copy.isValid()) {
         // Send the copied buffer to connected components
@@ -104,6 +183,7 @@ void ProvesRouter::handleFilePacket(Fw::Buffer& packetBuffer) {
         // Notify connected components that a packet was routed
         this->notifyPacketRouted();
     }
+    return false;
 }
 
 void ProvesRouter::handleUnknownPacket(Fw::Buffer& packetBuffer, const ComCfg::FrameContext& context) {
@@ -112,16 +192,12 @@ void ProvesRouter::handleUnknownPacket(Fw::Buffer& packetBuffer, const ComCfg::F
         return;
     }
 
-    // Copy buffer into a new allocated buffer. This lets us return the original buffer with dataReturnOut,
-    // and ProvesRouter can handle the deallocation of the unknown buffer when it returns on bufferReturnIn
-    Fw::Buffer copy = this->allocateCopy(packetBuffer, ProvesRouter_AllocationReason::USER_BUFFER);
-    if (copy.isValid()) {
-        // Send the copied buffer to connected components
-        this->unknownDataOut_out(0, copy, context);
+    // Ownership is retained across unknownDataOut, so the frame buffer is forwarded as is and returned with
+    // dataReturnOut once the receiver is done with it
+    this->unknownDataOut_out(0, packetBuffer, context);
 
-        // Notify connected components that a packet was routed
-        this->notifyPacketRouted();
-    }
+    // Notify connected components that a packet was routed
+    this->notifyPacketRouted();
 }
 
 void ProvesRouter ::notifyPacketRouted() {
@@ -140,6 +216,8 @@ Fw::Buffer ProvesRouter ::allocateCopy(Fw::Buffer& src, ProvesRouter_AllocationR
         this->log_WARNING_HI_AllocationError(reason);
         return copy;
     }
+    this->m_bufferAllocations += 1;
+    this->tlmWrite_BufferAllocations(this->m_bufferAllocations);
 
     auto serializer = copy.getSerializer();
     Fw::SerializeStatus status = serializer.serializeFrom(src.getData(), src.getSize(), Fw::Serialization::OMIT_LENGTH);
@@ -156,11 +234,41 @@ void ProvesRouter ::cmdResponseIn_handler(FwIndexType portNum,
                                           FwOpcodeType opcode,
                                           U32 cmdSeq,
                                           const Fw::CmdResponse& response) {
-    // Nothing to do
+    // Single commands are dispatched with a context of 0 and need no reporting
+    U32 batch = 0;
+    U32 index = 0;
+    if (!Components::CommandBatch::decodeCommandContext(cmdSeq, batch, index)) {
+        return;
+    }
+
+    this->log_ACTIVITY_LO_BatchCommandResponse(batch, index, opcode, response);
+    if (response != Fw::CmdResponse::OK) {
+        this->m_batchCommandFailures += 1;
+        this->tlmWrite_BatchCommandFailures(this->m_batchCommandFailures);
+    }
 }
 
 void ProvesRouter ::fileBufferReturnIn_handler(FwIndexType portNum, Fw::Buffer& fwBuffer) {
-    this->bufferDeallocate_out(0, fwBuffer);
+    size_t slot = Components::PacketHandoff::kNoSlot;
+    size_t size = 0;
+    ComCfg::FrameContext context;
+    {
+        Os::ScopeLock lock(this->m_handoffLock);
+        slot = Components::PacketHandoff::release(this->m_handoffs, ROUTER_MAX_HANDOFFS, fwBuffer.getData(), size);
+        if (slot != Components::PacketHandoff::kNoSlot) {
+            context = this->m_handoffContexts[slot];
+        }
+    }
+
+    // A copy made when every slot was lent out
+    if (slot == Components::PacketHandoff::kNoSlot) {
+        this->bufferDeallocate_out(0, fwBuffer);
+        return;
+    }
+
+    // A lent frame buffer: restore the size it was lent with and return it upstream for deallocation
+    fwBuffer.setSize(static_cast<FwSizeType>(size));
+    this->dataReturnOut_out(0, fwBuffer, context);
 }
 
 }  // namespace Svc
@@ -7,6 +7,10 @@
 #ifndef Svc_ProvesRouter_HPP
 #define Svc_ProvesRouter_HPP
 
+#include <Os/Mutex.hpp>
+
+#include "PROVESFlightControllerReference/Components/ProvesRouter/FppConstantsAc.hpp"
+#include "PROVESFlightControllerReference/Components/ProvesRouter/Handoff.hpp"
 #include "PROVESFlightControllerReference/Components/ProvesRouter/ProvesRouterComponentAc.hpp"
 
 namespace Svc {
@@ -36,9 +40,8 @@ class ProvesRouter final : public ProvesRouterComponentBase {
                         const ComCfg::FrameContext& context  //!< The context object
                         ) override;
 
-    // ! Handler for input port cmdResponseIn
-    // ! This is a no-op because ProvesRouter does not need to handle command responses
-    // ! but the port must be connected
+    //! Handler for input port cmdResponseIn
+    //! Reports the responses to commands dispatched from a batch; responses to single commands are ignored
     void cmdResponseIn_handler(FwIndexType portNum,             //!< The port number
                                FwOpcodeType opcode,             //!< The command opcode
                                U32 cmdSeq,                      //!< The command sequence number
@@ -47,7 +50,8 @@ class ProvesRouter final : public ProvesRouterComponentBase {
 
     //! Handler implementation for fileBufferReturnIn
     //!
-    //! Port for receiving ownership back of buffers sent on fileOut
+    //! Port for receiving ownership back of buffers sent on fileOut. Packet buffers lent to FileUplink are
+    //! returned upstream on dataReturnOut; copies are deallocated.
     void fileBufferReturnIn_handler(FwIndexType portNum,  //!< The port number
                                     Fw::Buffer& fwBuffer  //!< The buffer
                                     ) override;
@@ -60,8 +64,13 @@ class ProvesRouter final : public ProvesRouterComponentBase {
     void handleCommandPacket(Fw::Buffer& packetBuffer  //!< The packet buffer
     );
 
-    //! Handler for file packets
-    void handleFilePacket(Fw::Buffer& packetBuffer  //<! The packet buffer
+    //! Handler for file packets; returns true when packetBuffer was handed off and must not be returned yet
+    bool handleFilePacket(Fw::Buffer& packetBuffer,            //!< The packet buffer
+                          const ComCfg::FrameContext& context  //!< The context object
+    );
+
+    //! Handler for command batch packets
+    void handleCommandBatch(Fw::Buffer& packetBuffer  //!< The packet buffer
     );
 
     //! Handler for unknown packet types
@@ -79,9 +88,18 @@ class ProvesRouter final : public ProvesRouterComponentBase {
     // Private member variables
     // ----------------------------------------------------------------------
 
-    U32 m_routedPackets;    //!< The count of packets routed
-    U32 m_bypassedPackets;  //!< The count of packets bypassed
-    U32 m_rejectedPackets;  //!< The count of packets rejected
+    U32 m_routedPackets;         //!< The count of packets routed
+    U32 m_bypassedPackets;       //!< The count of packets bypassed
+    U32 m_rejectedPackets;       //!< The count of packets rejected
+    U32 m_zeroCopyHandoffs;      //!< The count of packet buffers handed to FileUplink without a copy
+    U32 m_bufferAllocations;     //!< The count of buffers allocated to copy a packet
+    U32 m_routedBatches;         //!< The count of command batches routed, also the number of the last batch
+    U32 m_batchedCommands;       //!< The count of commands dispatched from batches
+    U32 m_batchCommandFailures;  //!< The count of batched commands that completed with an error
+
+    Components::PacketHandoff::Slot m_handoffs[ROUTER_MAX_HANDOFFS];  //!< Packet buffers lent to FileUplink
+    ComCfg::FrameContext m_handoffContexts[ROUTER_MAX_HANDOFFS];      //!< Frame context of each lent buffer
+    Os::Mutex m_handoffLock;                                          //!< Guards m_handoffs across threads
 };
 
 }  // namespace Svc
@@ -10,7 +10,21 @@
 #include <zephyr/kernel.h>
 
 FprimeHal::FprimeHal(Components::SBand* component)
-    : RadioLibHal(0, 0, FPRIME_HAL_GPIO_LEVEL_LOW, FPRIME_HAL_GPIO_LEVEL_HIGH, 0, 0), m_component(component) {}
+    : RadioLibHal(0, 0, FPRIME_HAL_GPIO_LEVEL_LOW, FPRIME_HAL_GPIO_LEVEL_HIGH, FPRIME_HAL_GPIO_RISING,
+                  FPRIME_HAL_GPIO_FALLING),
+      m_component(component) {}
+
+void FprimeHal::setIrqLine(const struct gpio_dt_spec* irq) {
+    this->m_irqLine = irq;
+}
+
+bool FprimeHal::isIrqAttached() const {
+    return this->m_irqAttached;
+}
+
+uint32_t FprimeHal::getSpiTransfers() const {
+    return this->m_spiTransfers;
+}
 
 void FprimeHal::init() {}
 
@@ -41,9 +55,43 @@ uint32_t FprimeHal::digitalRead(uint32_t pin) {
     return FPRIME_HAL_GPIO_LEVEL_LOW;
 }
 
-void FprimeHal::attachInterrupt(uint32_t interruptNum, void (*interruptCb)(void), uint32_t mode) {}
+void FprimeHal::attachInterrupt(uint32_t interruptNum, void (*interruptCb)(void), uint32_t mode) {
+    if (interruptNum != SBAND_PIN_IRQ || this->m_irqLine == nullptr || this->m_irqLine->port == nullptr) {
+        return;
+    }
+    this->detachInterrupt(interruptNum);
+
+    this->m_irq.hal = this;
+    this->m_irq.action = interruptCb;
+    gpio_init_callback(&this->m_irq.callback, FprimeHal::irqIsr, BIT(this->m_irqLine->pin));
+    if (gpio_add_callback_dt(this->m_irqLine, &this->m_irq.callback) != 0) {
+        return;
+    }
+    gpio_flags_t edge = (mode == FPRIME_HAL_GPIO_FALLING) ? GPIO_INT_EDGE_FALLING : GPIO_INT_EDGE_RISING;
+    if (gpio_pin_interrupt_configure_dt(this->m_irqLine, edge) != 0) {
+        gpio_remove_callback_dt(this->m_irqLine, &this->m_irq.callback);
+        return;
+    }
+    this->m_irqAttached = true;
+}
+
+void FprimeHal::detachInterrupt(uint32_t interruptNum) {
+    if (interruptNum != SBAND_PIN_IRQ || !this->m_irqAttached) {
+        return;
+    }
+    gpio_pin_interrupt_configure_dt(this->m_irqLine, GPIO_INT_DISABLE);
+    gpio_remove_callback_dt(this->m_irqLine, &this->m_irq.callback);
+    this->m_irqAttached = false;
+}
 
-void FprimeHal::detachInterrupt(uint32_t interruptNum) {}
+void FprimeHal::irqIsr(const struct device* port, struct gpio_callback* callback, gpio_port_pins_t pins) {
+    // RadioLib callbacks take no context, so the component is notified directly
+    IrqContext* context = CONTAINER_OF(callback, IrqContext, callback);
+    context->hal->m_component->irqAsserted();
+    if (context->action != nullptr) {
+        context->action();
+    }
+}
 
 void FprimeHal::delay(unsigned long ms) {
     Os::Task::delay(Fw::TimeInterval(0, ms * 1000));
@@ -77,6 +125,7 @@ void FprimeHal::spiTransfer(uint8_t* out, size_t len, uint8_t* in) {
     Fw::Buffer writeBuffer(out, len);
     Fw::Buffer readBuffer(in, len);
     this->m_component->spiSend_out(0, writeBuffer, readBuffer);
+    this->m_spiTransfers++;
 }
 
 void FprimeHal::yield() {}
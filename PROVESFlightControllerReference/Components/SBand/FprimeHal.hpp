@@ -2,9 +2,12 @@
 #define FPRIME_HAL_H
 
 #include <RadioLib.h>
+#include <zephyr/drivers/gpio.h>
 
 #define FPRIME_HAL_GPIO_LEVEL_LOW 0
 #define FPRIME_HAL_GPIO_LEVEL_HIGH 1
+#define FPRIME_HAL_GPIO_RISING 1
+#define FPRIME_HAL_GPIO_FALLING 2
 
 // SX1280 virtual pin numbers for RadioLib Module
 // These are logical pin IDs used by the HAL to route operations to F Prime ports
@@ -22,6 +25,15 @@ class FprimeHal : public RadioLibHal {
   public:
     explicit FprimeHal(Components::SBand* component);
 
+    //! Set the GPIO behind SBAND_PIN_IRQ so attachInterrupt can route it to a Zephyr interrupt
+    void setIrqLine(const struct gpio_dt_spec* irq);
+
+    //! Whether the IRQ line currently raises interrupts
+    bool isIrqAttached() const;
+
+    //! Count of SPI transfers since construction, each one SX1280 command
+    uint32_t getSpiTransfers() const;
+
     void init() override;
 
     void term() override;
@@ -63,7 +75,21 @@ class FprimeHal : public RadioLibHal {
     void spiEnd();
 
   private:
+    //! Zephyr callback for the IRQ line, recoverable from the gpio_callback in interrupt context
+    struct IrqContext {
+        struct gpio_callback callback;  //!< Zephyr GPIO callback, must stay valid while attached
+        FprimeHal* hal;                 //!< HAL owning the line
+        void (*action)(void);           //!< RadioLib callback, may be nullptr
+    };
+
+    //! Notify the component of an IRQ edge, then run the RadioLib callback. Interrupt context.
+    static void irqIsr(const struct device* port, struct gpio_callback* callback, gpio_port_pins_t pins);
+
     Components::SBand* m_component;
+    const struct gpio_dt_spec* m_irqLine = nullptr;  //!< GPIO behind SBAND_PIN_IRQ, nullptr when not wired
+    IrqContext m_irq = {};                           //!< IRQ line callback
+    bool m_irqAttached = false;                      //!< Whether m_irq is registered
+    uint32_t m_spiTransfers = 0;                     //!< SPI transfers since construction
 };
 
 #endif
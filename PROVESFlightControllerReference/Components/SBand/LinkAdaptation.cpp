@@ -0,0 +1,231 @@
+// ======================================================================
+// \title  LinkAdaptation.cpp
+// \brief  cpp file for choosing SBand modulation from measured link margin
+// ======================================================================
+
+#include "LinkAdaptation.hpp"
+
+namespace Components {
+namespace LinkAdaptation {
+namespace {
+
+//! SNR offset of each SBandBandwidth value from 203.125 kHz, 10 * log10(bandwidth / 203.125 kHz)
+constexpr float kBandwidthOffsetDb[] = {0.0f, 3.01f, 6.02f, 9.03f};
+
+//! Bandwidth in Hz of each SBandBandwidth value
+constexpr uint32_t kBandwidthHz[] = {203125, 406250, 812500, 1625000};
+
+//! Announcement header, "SBMC"
+constexpr uint8_t kMagic[] = {'S', 'B', 'M', 'C'};
+
+//! Acknowledgement header, "SBMA"
+constexpr uint8_t kAcknowledgementMagic[] = {'S', 'B', 'M', 'A'};
+
+void clearWindow(State& state) {
+    state.count = 0;
+    state.next = 0;
+}
+
+//! Start announcing a change to a rung
+Action propose(State& state, const Config& config, size_t rung) {
+    state.pending = rung;
+    state.countdown = (config.announcements > 0) ? config.announcements : 1;
+    state.phase = Phase::Announcing;
+    return Action::Announce;
+}
+
+}  // namespace
+
+// The nominal SX1280 LoRa demodulation thresholds run from -2.5 dB at SF5 to -20 dB at SF12, 2.5 dB per spreading
+// factor. Each doubling of bandwidth needs 3 dB more SNR. Rungs that are no faster than a neighbour needing less SNR
+// are left out.
+const Rung kLadder[kRungs] = {
+    {5, 3, -2.5f + 9.03f},    // 203 kbps at 4/5
+    {6, 3, -5.0f + 9.03f},    // 122 kbps
+    {7, 3, -7.5f + 9.03f},    // 71 kbps
+    {7, 2, -7.5f + 6.02f},    // 36 kbps
+    {7, 1, -7.5f + 3.01f},    // 18 kbps, the default parameters
+    {8, 1, -10.0f + 3.01f},   // 10 kbps
+    {9, 1, -12.5f + 3.01f},   // 5.7 kbps
+    {10, 1, -15.0f + 3.01f},  // 3.2 kbps
+    {10, 0, -15.0f},          // 1.6 kbps
+    {11, 0, -17.5f},          // 0.9 kbps
+    {12, 0, -20.0f},          // 0.5 kbps
+};
+
+size_t findRung(uint8_t spreadingFactor, uint8_t bandwidth) {
+    for (size_t i = 0; i < kRungs; i++) {
+        if (kLadder[i].spreadingFactor == spreadingFactor && kLadder[i].bandwidth == bandwidth) {
+            return i;
+        }
+    }
+    return kNoRung;
+}
+
+uint32_t bitRate(const Rung& rung, uint8_t codingRate) {
+    // SF bits per symbol, 2^SF chips per symbol, 4 data bits in every codingRate coded bits
+    const uint64_t chipsPerSecond = kBandwidthHz[rung.bandwidth];
+    return static_cast<uint32_t>((chipsPerSecond * rung.spreadingFactor * 4) /
+                                 ((static_cast<uint64_t>(1) << rung.spreadingFactor) * codingRate));
+}
+
+void reset(State& state, size_t home) {
+    state.home = home;
+    state.rung = home;
+    state.previous = home;
+    state.pending = home;
+    state.phase = Phase::Steady;
+    state.countdown = 0;
+    state.ticks = 0;
+    state.holdoff = 0;
+    state.idle = 0;
+    clearWindow(state);
+}
+
+void addSnr(State& state, const Config& config, float snrDb) {
+    state.idle = 0;
+
+    const uint8_t window = (config.window > kMaxWindow) ? kMaxWindow : config.window;
+    if (window == 0) {
+        return;
+    }
+    if (state.next >= window) {
+        state.next = 0;
+    }
+    state.snr[state.next++] = snrDb;
+    if (state.count < window) {
+        state.count++;
+    }
+}
+
+bool acknowledged(State& state, size_t rung) {
+    // Any other packet may be a frame the ground sent before it retuned, so only the named rung confirms
+    if ((state.phase != Phase::Confirming) || (rung != state.rung)) {
+        return false;
+    }
+    state.phase = Phase::Steady;
+    return true;
+}
+
+float margin(const State& state, size_t rung) {
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < state.count; i++) {
+        sum += state.snr[i];
+    }
+    const float mean = (state.count > 0) ? sum / static_cast<float>(state.count) : 0.0f;
+    // Refer the measurement to 203.125 kHz, then compare against the rung's threshold
+    return mean + kBandwidthOffsetDb[kLadder[state.rung].bandwidth] - kLadder[rung].requiredSnrDb;
+}
+
+Action tick(State& state, const Config& config) {
+    if (state.idle < UINT32_MAX) {
+        state.idle++;
+    }
+
+    // The ground returns home after the same silence, so an unfinished announcement is dropped too
+    if ((state.idle >= config.idleTicks) && (state.phase != Phase::Confirming)) {
+        const bool moved = (state.rung != state.home);
+        state.rung = state.home;
+        state.phase = Phase::Steady;
+        state.holdoff = 0;
+        clearWindow(state);
+        return moved ? Action::Home : Action::None;
+    }
+
+    switch (state.phase) {
+        case Phase::Announcing:
+            return Action::Announce;
+        case Phase::Confirming:
+            if (++state.ticks >= config.confirmTicks) {
+                // No acknowledgement arrived, so go back to where the ground was last heard
+                state.rung = state.previous;
+                state.phase = Phase::Steady;
+                state.holdoff = config.holdoffTicks;
+                clearWindow(state);
+                return Action::Revert;
+            }
+            return Action::None;
+        case Phase::Steady:
+        default:
+            break;
+    }
+
+    if (state.holdoff > 0) {
+        state.holdoff--;
+    }
+
+    const uint8_t window = (config.window > kMaxWindow) ? kMaxWindow : config.window;
+    if (window == 0 || state.count < window) {
+        return Action::None;
+    }
+
+    // Fall straight to the fastest slower rung that holds the target
+    if (margin(state, state.rung) < config.targetMarginDb) {
+        if (state.rung + 1 >= kRungs) {
+            return Action::None;
+        }
+        size_t rung = state.rung + 1;
+        while (rung + 1 < kRungs && margin(state, rung) < config.targetMarginDb) {
+            rung++;
+        }
+        return propose(state, config, rung);
+    }
+
+    // Climb one rung at a time, and only with margin to spare
+    if (state.rung > 0 && state.holdoff == 0 &&
+        margin(state, state.rung - 1) >= config.targetMarginDb + config.hysteresisDb) {
+        return propose(state, config, state.rung - 1);
+    }
+    return Action::None;
+}
+
+bool announced(State& state) {
+    if (state.phase != Phase::Announcing) {
+        return false;
+    }
+    if (state.countdown > 0) {
+        state.countdown--;
+    }
+    if (state.countdown > 0) {
+        return false;
+    }
+    state.previous = state.rung;
+    state.rung = state.pending;
+    state.phase = Phase::Confirming;
+    state.ticks = 0;
+    clearWindow(state);
+    return true;
+}
+
+size_t encodeAnnouncement(const State& state, uint8_t codingRate, uint8_t* buffer, size_t size) {
+    if (size < kAnnouncementSize || state.pending >= kRungs) {
+        return 0;
+    }
+    const Rung& rung = kLadder[state.pending];
+    for (size_t i = 0; i < sizeof(kMagic); i++) {
+        buffer[i] = kMagic[i];
+    }
+    buffer[4] = static_cast<uint8_t>(state.pending);
+    buffer[5] = rung.spreadingFactor;
+    buffer[6] = rung.bandwidth;
+    buffer[7] = codingRate;
+    // Announcements still to follow this one; the ground switches after the one carrying 0
+    buffer[8] = (state.countdown > 0) ? static_cast<uint8_t>(state.countdown - 1) : 0;
+    return kAnnouncementSize;
+}
+
+bool decodeAcknowledgement(const uint8_t* buffer, size_t size, size_t& rung) {
+    if (buffer == nullptr || size != kAcknowledgementSize) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(kAcknowledgementMagic); i++) {
+        if (buffer[i] != kAcknowledgementMagic[i]) {
+            return false;
+        }
+    }
+    rung = buffer[4];
+    return true;
+}
+
+}  // namespace LinkAdaptation
+}  // namespace Components
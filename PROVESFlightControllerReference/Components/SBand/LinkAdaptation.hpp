@@ -0,0 +1,137 @@
+// ======================================================================
+// \title  LinkAdaptation.hpp
+// \brief  hpp file for choosing SBand modulation from measured link margin
+// ======================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Components {
+
+//! Link-margin adaptive modulation for the SX1280
+//!
+//! Modulations are ordered on a ladder from fastest to slowest. The mean SNR of a window of received packets gives
+//! the margin every rung would have, by moving it between bandwidths at 3 dB per octave. The controller drops straight
+//! to the fastest rung holding the target margin when the current one loses it, and climbs one rung at a time once
+//! the next has the target plus a hysteresis.
+//!
+//! Every change is announced to the ground in the old modulation before it takes effect. The change holds once the
+//! ground acknowledges the new rung in the new modulation, and is reverted otherwise. Both ends return to the home
+//! rung when no packet has been received for a while, so they meet again after a pass without any announcement.
+namespace LinkAdaptation {
+
+constexpr const size_t kRungs = 11;               //!< Rungs on the ladder
+constexpr const size_t kNoRung = SIZE_MAX;        //!< A modulation that is not on the ladder
+constexpr const size_t kMaxWindow = 16;           //!< Largest SNR window
+constexpr const size_t kAnnouncementSize = 9;     //!< Bytes in a modulation change announcement
+constexpr const size_t kAcknowledgementSize = 5;  //!< Bytes in a ground acknowledgement of a change
+
+//! One modulation on the ladder
+struct Rung {
+    uint8_t spreadingFactor;  //!< SBandDataRate value
+    uint8_t bandwidth;        //!< SBandBandwidth value
+    float requiredSnrDb;      //!< Demodulation SNR threshold, referred to the 203.125 kHz bandwidth
+};
+
+//! The ladder, fastest first
+extern const Rung kLadder[kRungs];
+
+//! Controller settings
+struct Config {
+    float targetMarginDb;   //!< Margin a rung must hold
+    float hysteresisDb;     //!< Extra margin needed to climb a rung
+    uint8_t window;         //!< SNR samples averaged, at most kMaxWindow
+    uint8_t announcements;  //!< Announcements sent before a change takes effect
+    uint32_t confirmTicks;  //!< Ticks a change waits for a packet before it is reverted
+    uint32_t holdoffTicks;  //!< Ticks after a revert before climbing again
+    uint32_t idleTicks;     //!< Ticks without a packet before returning to the home rung
+};
+
+//! Where a change is in its handshake
+enum class Phase {
+    Steady,      //!< No change in progress
+    Announcing,  //!< Announcing a change in the old modulation
+    Confirming   //!< Waiting for the ground to acknowledge the new modulation
+};
+
+//! What the radio must do after a tick
+enum class Action {
+    None,      //!< Nothing
+    Announce,  //!< Send an announcement, then call announced
+    Revert,    //!< The ground did not acknowledge the change; the previous rung is current again
+    Home       //!< The link went idle; the home rung is current again
+};
+
+//! Controller state, owned by one thread
+struct State {
+    size_t home;            //!< Rung the parameters select, used when the link is idle
+    size_t rung;            //!< Current rung
+    size_t previous;        //!< Rung before the change being confirmed
+    size_t pending;         //!< Rung being announced
+    Phase phase;            //!< Handshake phase
+    uint8_t countdown;      //!< Announcements still to send
+    uint32_t ticks;         //!< Ticks spent confirming
+    uint32_t holdoff;       //!< Ticks before climbing is allowed again
+    uint32_t idle;          //!< Ticks since the last packet
+    float snr[kMaxWindow];  //!< SNR samples in the current rung
+    uint8_t count;          //!< Samples held
+    uint8_t next;           //!< Next sample slot
+};
+
+//! The rung with this modulation, or kNoRung
+size_t findRung(uint8_t spreadingFactor,  //!< SBandDataRate value
+                uint8_t bandwidth         //!< SBandBandwidth value
+);
+
+//! LoRa bit rate of a rung in bits per second
+uint32_t bitRate(const Rung& rung,   //!< The rung
+                 uint8_t codingRate  //!< SBandCodingRate value, 5 to 8
+);
+
+//! Start at the home rung with an empty window
+void reset(State& state,  //!< The controller
+           size_t home    //!< The home rung
+);
+
+//! Add the SNR of a received packet
+void addSnr(State& state,          //!< The controller
+            const Config& config,  //!< The settings
+            float snrDb            //!< Packet SNR in dB, in the current rung's bandwidth
+);
+
+//! Record a ground acknowledgement of a rung; returns true when it confirms the change in progress
+bool acknowledged(State& state,  //!< The controller
+                  size_t rung    //!< The rung the ground acknowledged
+);
+
+//! Margin the window mean gives a rung; only meaningful with samples held
+float margin(const State& state,  //!< The controller
+             size_t rung          //!< The rung to evaluate
+);
+
+//! Advance the controller one rate group tick
+Action tick(State& state,         //!< The controller
+            const Config& config  //!< The settings
+);
+
+//! Record that an announcement was sent; returns true when the change takes effect
+bool announced(State& state  //!< The controller
+);
+
+//! Serialize the announcement for the change in progress; returns the bytes written, 0 when size is too small
+size_t encodeAnnouncement(const State& state,  //!< The controller, announcing
+                          uint8_t codingRate,  //!< SBandCodingRate value
+                          uint8_t* buffer,     //!< Destination
+                          size_t size          //!< Destination size
+);
+
+//! Whether a received packet is a ground acknowledgement, and the rung it acknowledges
+bool decodeAcknowledgement(const uint8_t* buffer,  //!< The received packet
+                           size_t size,            //!< Packet size
+                           size_t& rung            //!< Set to the acknowledged rung
+);
+
+}  // namespace LinkAdaptation
+}  // namespace Components
@@ -0,0 +1,38 @@
+// ======================================================================
+// \title  ModulationCache.cpp
+// \brief  cpp file for tracking the modulation last written to the SX1280
+// ======================================================================
+
+#include "ModulationCache.hpp"
+
+namespace Components {
+namespace ModulationCache {
+
+uint8_t changes(const Cache& cache, const Modulation& wanted) {
+    if (!cache.valid) {
+        return kAll;
+    }
+    uint8_t changed = 0;
+    if (cache.current.spreadingFactor != wanted.spreadingFactor) {
+        changed |= kSpreadingFactor;
+    }
+    if (cache.current.codingRate != wanted.codingRate) {
+        changed |= kCodingRate;
+    }
+    if (cache.current.bandwidth != wanted.bandwidth) {
+        changed |= kBandwidth;
+    }
+    return changed;
+}
+
+void applied(Cache& cache, const Modulation& modulation) {
+    cache.current = modulation;
+    cache.valid = true;
+}
+
+void invalidate(Cache& cache) {
+    cache.valid = false;
+}
+
+}  // namespace ModulationCache
+}  // namespace Components
@@ -0,0 +1,48 @@
+// ======================================================================
+// \title  ModulationCache.hpp
+// \brief  hpp file for tracking the modulation last written to the SX1280
+// ======================================================================
+
+#pragma once
+
+#include <cstdint>
+
+namespace Components {
+
+//! The SX1280 modulation parameters last written, so unchanged ones need no SPI writes
+namespace ModulationCache {
+
+constexpr const uint8_t kSpreadingFactor = 0x1;                              //!< Spreading factor differs
+constexpr const uint8_t kCodingRate = 0x2;                                   //!< Coding rate differs
+constexpr const uint8_t kBandwidth = 0x4;                                    //!< Bandwidth differs
+constexpr const uint8_t kAll = kSpreadingFactor | kCodingRate | kBandwidth;  //!< Every parameter
+
+//! LoRa modulation parameters, as their SBand parameter enum values
+struct Modulation {
+    uint8_t spreadingFactor;  //!< SBandDataRate value
+    uint8_t codingRate;       //!< SBandCodingRate value
+    uint8_t bandwidth;        //!< SBandBandwidth value
+};
+
+//! What the radio is known to hold
+struct Cache {
+    bool valid;          //!< False until written, and after any failed write
+    Modulation current;  //!< The radio's modulation when valid
+};
+
+//! The parameters that must be written to move the radio to wanted; kAll when the radio's state is unknown
+uint8_t changes(const Cache& cache,       //!< The cache
+                const Modulation& wanted  //!< The modulation needed next
+);
+
+//! Record that the radio now holds modulation
+void applied(Cache& cache,                 //!< The cache
+             const Modulation& modulation  //!< The modulation written
+);
+
+//! Forget the radio's state, forcing the next change to write every parameter
+void invalidate(Cache& cache  //!< The cache
+);
+
+}  // namespace ModulationCache
+}  // namespace Components
@@ -0,0 +1,28 @@
+// ======================================================================
+// \title  RxWatchdog.cpp
+// \brief  cpp file for deciding when the SBand receive path must be polled
+// ======================================================================
+
+#include "RxWatchdog.hpp"
+
+namespace Components {
+namespace RxWatchdog {
+
+Reason check(State& state, bool interruptsEnabled, bool irqLineHigh, uint32_t periodTicks) {
+    if (!interruptsEnabled) {
+        return Reason::Polling;
+    }
+    if (irqLineHigh) {
+        return Reason::MissedEdge;
+    }
+
+    state.ticks++;
+    if (periodTicks > 0 && state.ticks >= periodTicks) {
+        state.ticks = 0;
+        return Reason::Period;
+    }
+    return Reason::None;
+}
+
+}  // namespace RxWatchdog
+}  // namespace Components
@@ -0,0 +1,41 @@
+// ======================================================================
+// \title  RxWatchdog.hpp
+// \brief  hpp file for deciding when the SBand receive path must be polled
+// ======================================================================
+
+#pragma once
+
+#include <cstdint>
+
+namespace Components {
+
+//! Fallback polling of the SX1280 for an interrupt-driven receive path
+//!
+//! With the IRQ line interrupt driven, a received packet queues the RX handler from its RX_DONE edge. The rate group
+//! only reads the IRQ line level, which costs no SPI transfer, to catch an edge that was missed. Once per period it
+//! polls the radio over SPI, and the RX handler restarts receive when no RX_DONE is pending and nothing is being
+//! transmitted, in case the radio has dropped out of receive mode.
+namespace RxWatchdog {
+
+//! Why the RX handler is queued from the rate group
+enum class Reason {
+    None,        //!< Nothing to do, the interrupt will report the next packet
+    Polling,     //!< Interrupts are not available, so the radio is polled every tick
+    MissedEdge,  //!< The IRQ line is asserted but no handler was queued for it
+    Period       //!< The watchdog period has elapsed, receive is restarted unless a packet is pending
+};
+
+//! Watchdog state, owned by the rate group thread
+struct State {
+    uint32_t ticks;  //!< Rate group ticks since the last periodic poll
+};
+
+//! Decide on one rate group tick, while no RX handler is queued, whether to queue one
+Reason check(State& state,            //!< The watchdog state
+             bool interruptsEnabled,  //!< Whether the IRQ line is interrupt driven
+             bool irqLineHigh,        //!< The IRQ line level
+             uint32_t periodTicks     //!< Ticks between periodic polls, 0 for none
+);
+
+}  // namespace RxWatchdog
+}  // namespace Components
@@ -17,6 +17,19 @@
 
 namespace Components {
 
+//! LoRa preamble length in symbols, written by configureRadio
+static constexpr uint16_t LORA_PREAMBLE_LENGTH = 12;
+
+//! Time allowed past twice the time on air before a frame without TX_DONE is failed
+static constexpr U32 TX_DEADLINE_MARGIN_US = 100000;
+
+//! Link adaptation settings that are not parameters; ticks are of the 10 Hz rate group
+static constexpr U8 ADAPT_WINDOW = 8;            //!< Received packets averaged for the link margin
+static constexpr U8 ADAPT_ANNOUNCEMENTS = 3;     //!< Announcements sent before each change
+static constexpr U32 ADAPT_CONFIRM_TICKS = 100;  //!< Wait for a packet in a new modulation
+static constexpr U32 ADAPT_HOLDOFF_TICKS = 600;  //!< Wait after a revert before moving faster
+static constexpr U32 ADAPT_IDLE_TICKS = 3000;    //!< Silence before returning to the parameter modulation
+
 static float bandwidthEnumToKHz(SBandBandwidth bw) {
     switch (bw.e) {
         case SBandBandwidth::BW_203_125_KHZ:
@@ -45,6 +58,35 @@ SBand ::SBand(const char* const compName)
 
 SBand ::~SBand() {}
 
+void SBand ::parameterUpdated(FwPrmIdType id) {
+    switch (id) {
+        case SBand::PARAMID_ADAPTIVE_MODULATION: {
+            // Cached for run, which queues deferredAdapt only while adaptation can do anything
+            Fw::ParamValid isValid = Fw::ParamValid::INVALID;
+            const Fw::Enabled adaptive = this->paramGet_ADAPTIVE_MODULATION(isValid);
+            atomic_set(&this->m_adaptEnabled, (adaptive == Fw::Enabled::ENABLED) ? 1 : 0);
+            break;
+        }
+        case SBand::PARAMID_DATA_RATE:
+        case SBand::PARAMID_CODING_RATE:
+        case SBand::PARAMID_BANDWIDTH_TX:
+        case SBand::PARAMID_BANDWIDTH_RX:
+        case SBand::PARAMID_RX_WATCHDOG_PERIOD:
+        case SBand::PARAMID_TX_BURST_HOLD:
+        case SBand::PARAMID_ADAPT_TARGET_MARGIN:
+        case SBand::PARAMID_ADAPT_HYSTERESIS:
+            // Read when used
+            break;
+        default:
+            FW_ASSERT(0);
+            break;  // Fallthrough from assert (static analysis)
+    }
+}
+
+void SBand ::parametersLoaded() {
+    this->parameterUpdated(SBand::PARAMID_ADAPTIVE_MODULATION);
+}
+
 // ----------------------------------------------------------------------
 // Handler implementations for typed input ports
 // ----------------------------------------------------------------------
@@ -54,15 +96,97 @@ void SBand ::run_handler(FwIndexType portNum, U32 context) {
     if (!m_configured) {
         return;
     }
+    this->updateDutyCycle();
+
+    // Link adaptation steps once per tick, behind anything else queued, while enabled or until it has wound down
+    const bool adaptNeeded = (atomic_get(&this->m_adaptEnabled) != 0) || (atomic_get(&this->m_adaptPending) != 0);
+    if (adaptNeeded && atomic_cas(&this->m_adaptQueued, 0, 1)) {
+        this->deferredAdapt_internalInterfaceInvoke();
+    }
+
+    // A frame whose TX_DONE never arrived is failed from the IRQ handler
+    const U32 txDeadline = static_cast<U32>(atomic_get(&this->m_txDeadline));
+    if ((txDeadline != 0) && (static_cast<I32>(static_cast<U32>(k_uptime_ticks()) - txDeadline) >= 0)) {
+        this->queueRxHandler();
+        return;
+    }
+
+    // The radio is not receiving during a burst; check whether the burst is over instead
+    if (atomic_get(&this->m_txBurst) != 0) {
+        if (atomic_cas(&this->m_burstCheckQueued, 0, 1)) {
+            this->deferredBurstCheck_internalInterfaceInvoke();
+        }
+        return;
+    }
+
+    // A queued handler will service the radio anyway
+    if (atomic_get(&this->m_rxHandlerQueued) != 0) {
+        return;
+    }
+
+    Fw::ParamValid isValid = Fw::ParamValid::INVALID;
+    const U32 watchdogPeriod = this->paramGet_RX_WATCHDOG_PERIOD(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
 
-    // Queue RX handler only if not already queued
-    if (!m_rxHandlerQueued) {
-        m_rxHandlerQueued = true;
+    // Reading the line level is a GPIO read, so the SPI bus stays idle between packets
+    const bool lineHigh = this->m_irqEnabled && this->isIrqLineHigh();
+    switch (RxWatchdog::check(this->m_rxWatchdog, this->m_irqEnabled, lineHigh, watchdogPeriod)) {
+        case RxWatchdog::Reason::None:
+            return;
+        case RxWatchdog::Reason::MissedEdge:
+            this->m_rxMissedInterrupts++;
+            this->tlmWrite_RxMissedInterrupts(this->m_rxMissedInterrupts);
+            break;
+        case RxWatchdog::Reason::Period:
+            this->m_rxWatchdogPolls++;
+            this->tlmWrite_RxWatchdogPolls(this->m_rxWatchdogPolls);
+            atomic_set(&this->m_rxWatchdogPoll, 1);
+            break;
+        default:
+            break;
+    }
+    this->queueRxHandler();
+}
+
+void SBand ::irqAsserted() {
+    atomic_set(&this->m_irq.edgeTicks, static_cast<atomic_val_t>(static_cast<U32>(k_uptime_ticks())));
+    (void)k_work_submit(&this->m_irq.work);
+}
+
+void SBand ::irqWorkHandler(struct k_work* work) {
+    // Internal ports post to an Os::Queue, which is not safe to call from interrupt context
+    IrqContext* context = CONTAINER_OF(work, IrqContext, work);
+    context->owner->queueRxHandler();
+}
+
+void SBand ::queueRxHandler() {
+    if (atomic_cas(&this->m_rxHandlerQueued, 0, 1)) {
         this->deferredRxHandler_internalInterfaceInvoke();
     }
 }
 
+bool SBand ::isIrqLineHigh() {
+    if (!this->isConnected_getIRQLine_OutputPort(0)) {
+        return false;
+    }
+    Fw::Logic irqState = Fw::Logic::LOW;
+    Drv::GpioStatus status = this->getIRQLine_out(0, irqState);
+    return (status == Drv::GpioStatus::OP_OK) && (irqState == Fw::Logic::HIGH);
+}
+
 void SBand ::deferredRxHandler_internalInterfaceHandler() {
+    // Edge of the packet being handled, if it arrived by interrupt
+    const U32 edgeTicks = static_cast<U32>(atomic_clear(&this->m_irq.edgeTicks));
+    const bool watchdogPoll = atomic_clear(&this->m_rxWatchdogPoll) != 0;
+
+    // DIO1 reports TX_DONE while a frame is on air
+    if (this->m_txPipeline.onAir) {
+        this->serviceTransmit();
+        atomic_clear(&this->m_rxHandlerQueued);
+        return;
+    }
+
     // Check IRQ status
     uint16_t irqStatus = this->m_rlb_radio.getIrqStatus();
 
@@ -70,18 +194,41 @@ void SBand ::deferredRxHandler_internalInterfaceHandler() {
     if (irqStatus & RADIOLIB_SX128X_IRQ_RX_DONE) {
         // Process received data
         SX1280* radio = &this->m_rlb_radio;
-        uint8_t data[256] = {0};
         size_t len = radio->getPacketLength();
-        int16_t state = radio->readData(data, len);
-
-        if (state != RADIOLIB_ERR_NONE) {
-            this->log_WARNING_HI_RadioLibFailed(state);
+        int16_t state = RADIOLIB_ERR_NONE;
+
+        // Read the payload straight into the buffer that goes downstream
+        Fw::Buffer buffer = this->allocate_out(0, static_cast<FwSizeType>(len));
+        if (!buffer.isValid()) {
+            this->log_WARNING_HI_AllocationFailed(static_cast<FwSizeType>(len));
+            // Reading clears RX_DONE; the rest of the packet is dropped
+            state = radio->readData(this->m_rxScratch, FW_MIN(len, sizeof(this->m_rxScratch)));
+            if (state != RADIOLIB_ERR_NONE) {
+                this->log_WARNING_HI_RadioLibFailed(state);
+            }
         } else {
-            Fw::Buffer buffer = this->allocate_out(0, static_cast<FwSizeType>(len));
-            if (buffer.isValid()) {
-                (void)::memcpy(buffer.getData(), data, len);
-                ComCfg::FrameContext frameContext;
-                this->dataOut_out(0, buffer, frameContext);
+            state = radio->readData(buffer.getData(), len);
+            if (state != RADIOLIB_ERR_NONE) {
+                this->log_WARNING_HI_RadioLibFailed(state);
+                this->deallocate_out(0, buffer);
+            } else {
+                // Acknowledgements of a modulation change are for link adaptation, not the deframer
+                size_t acknowledgedRung = LinkAdaptation::kNoRung;
+                const bool acknowledgement =
+                    this->m_adaptActive &&
+                    LinkAdaptation::decodeAcknowledgement(buffer.getData(), len, acknowledgedRung);
+                if (acknowledgement) {
+                    this->deallocate_out(0, buffer);
+                } else {
+                    ComCfg::FrameContext frameContext;
+                    if (edgeTicks != 0) {
+                        const U32 latency = k_ticks_to_us_floor32(static_cast<U32>(k_uptime_ticks()) - edgeTicks);
+                        this->m_rxLatencyMax = FW_MAX(this->m_rxLatencyMax, latency);
+                        this->tlmWrite_RxLatency(latency);
+                        this->tlmWrite_RxLatencyMax(this->m_rxLatencyMax);
+                    }
+                    this->dataOut_out(0, buffer, frameContext);
+                }
 
                 // Log RSSI and SNR for received packet
                 float rssi = radio->getRSSI();
@@ -89,11 +236,21 @@ void SBand ::deferredRxHandler_internalInterfaceHandler() {
                 this->tlmWrite_LastRssi(rssi);
                 this->tlmWrite_LastSnr(snr);
 
+                // Uplink packets measure the link; an acknowledgement of the new rung confirms a change
+                if (this->m_adaptActive) {
+                    LinkAdaptation::addSnr(this->m_adaptation, this->m_adaptConfig, snr);
+                    if (acknowledgement && LinkAdaptation::acknowledged(this->m_adaptation, acknowledgedRung)) {
+                        this->m_modulationChanges++;
+                        this->tlmWrite_ModulationChanges(this->m_modulationChanges);
+                        this->log_ACTIVITY_HI_ModulationChanged(static_cast<U8>(this->m_adaptation.rung));
+                        this->log_WARNING_LO_ModulationReverted_ThrottleClear();
+                    }
+                    this->tlmWrite_LinkMargin(LinkAdaptation::margin(this->m_adaptation, this->m_adaptation.rung));
+                }
+
                 // Clear throttled warnings on success
                 this->log_WARNING_HI_RadioLibFailed_ThrottleClear();
                 this->log_WARNING_HI_AllocationFailed_ThrottleClear();
-            } else {
-                this->log_WARNING_HI_AllocationFailed(static_cast<FwSizeType>(len));
             }
         }
 
@@ -102,10 +259,13 @@ void SBand ::deferredRxHandler_internalInterfaceHandler() {
         if (state != RADIOLIB_ERR_NONE) {
             this->log_WARNING_HI_RadioLibFailed(state);
         }
+    } else if (watchdogPoll) {
+        // Nothing was received in a whole watchdog period, so restart receive in case the radio has dropped out of it
+        this->resumeRx();
     }
 
     // Clear the queued flag
-    m_rxHandlerQueued = false;
+    atomic_clear(&this->m_rxHandlerQueued);
 }
 
 void SBand ::deferredTxHandler_internalInterfaceHandler(const Fw::Buffer& data, const ComCfg::FrameContext& context) {
@@ -118,25 +278,311 @@ void SBand ::deferredTxHandler_internalInterfaceHandler(const Fw::Buffer& data,
         return;
     }
 
+    // Without the IRQ interrupt nothing reports TX_DONE promptly, so transmission blocks
+    if (!this->m_irqEnabled) {
+        this->transmitBlocking(mutableData, context);
+        return;
+    }
+
+    switch (TxPipeline::accept(this->m_txPipeline)) {
+        case TxPipeline::Accept::Start:
+            this->startFrame(mutableData, context);
+            break;
+        default:
+            // Upstream sends only after a status, so this frame has none to wait for
+            this->m_txFailures++;
+            this->tlmWrite_TxFailures(this->m_txFailures);
+            this->dataReturnOut_out(0, mutableData, context);
+            break;
+    }
+}
+
+void SBand ::transmitBlocking(Fw::Buffer& data, const ComCfg::FrameContext& context) {
+    Fw::Success returnStatus = Fw::Success::FAILURE;
+    const U32 spiTransfers = this->m_rlb_hal.getSpiTransfers();
+
     // Enable transmit mode
     Status status = this->enableTx();
     if (status == Status::SUCCESS) {
         // Transmit data
+        const I64 start = k_uptime_ticks();
         int16_t state = this->m_rlb_radio.transmit(data.getData(), data.getSize());
+        atomic_add(&this->m_txOnAirUs, static_cast<atomic_val_t>(k_ticks_to_us_floor32(k_uptime_ticks() - start)));
         if (state != RADIOLIB_ERR_NONE) {
             this->log_WARNING_HI_RadioLibFailed(state);
+            ModulationCache::invalidate(this->m_modulation);
             returnStatus = Fw::Success::FAILURE;
+            status = Status::ERROR;
         } else {
             returnStatus = Fw::Success::SUCCESS;
             // Clear throttled warnings on success
             this->log_WARNING_HI_RadioLibFailed_ThrottleClear();
         }
     }
+    if (status != Status::SUCCESS) {
+        this->m_txFailures++;
+        this->tlmWrite_TxFailures(this->m_txFailures);
+    }
 
-    this->dataReturnOut_out(0, mutableData, context);
+    this->dataReturnOut_out(0, data, context);
     this->comStatusOut_out(0, returnStatus);
+    this->afterFrame(status == Status::SUCCESS);
+
+    this->tlmWrite_TxSpiTransactions(this->m_rlb_hal.getSpiTransfers() - spiTransfers);
+}
+
+void SBand ::startFrame(Fw::Buffer& data, const ComCfg::FrameContext& context) {
+    bool started = false;
+    this->m_txSpiStart = this->m_rlb_hal.getSpiTransfers();
+    atomic_clear(&this->m_txBurst);
+
+    if ((this->m_transmit_enabled == SBandTransmitState::ENABLED) && (this->enableTx() == Status::SUCCESS)) {
+        // Unlike transmit(), startTransmit() does not enter standby itself, and enableTx leaves the radio receiving
+        // when the modulation is unchanged
+        int16_t state = this->m_rlb_radio.standby();
+        if (state == RADIOLIB_ERR_NONE) {
+            state = this->m_rlb_radio.startTransmit(data.getData(), data.getSize());
+        }
+        if (state != RADIOLIB_ERR_NONE) {
+            this->log_WARNING_HI_RadioLibFailed(state);
+            ModulationCache::invalidate(this->m_modulation);
+        } else {
+            started = true;
+        }
+    }
+
+    if (!started) {
+        Fw::Success returnStatus = Fw::Success::FAILURE;
+        TxPipeline::abort(this->m_txPipeline);
+        this->m_txFailures++;
+        this->tlmWrite_TxFailures(this->m_txFailures);
+        this->dataReturnOut_out(0, data, context);
+        this->comStatusOut_out(0, returnStatus);
+        this->afterFrame(false);
+        return;
+    }
+
+    this->m_txFrame = data;
+    this->m_txContext = context;
+    this->m_txStart = k_uptime_ticks();
+
+    // enableTx left the transmit modulation in the cache
+    const ModulationCache::Modulation& modulation = this->m_modulation.current;
+    const U32 bandwidthHz =
+        static_cast<U32>(bandwidthEnumToKHz(static_cast<SBandBandwidth::T>(modulation.bandwidth)) * 1000.0f);
+    const U32 timeOnAir =
+        TxPipeline::timeOnAirUs(modulation.spreadingFactor, bandwidthHz, modulation.codingRate, LORA_PREAMBLE_LENGTH,
+                                data.getSize(), true, true);
+    const U64 allowedUs = 2 * static_cast<U64>(timeOnAir) + TX_DEADLINE_MARGIN_US;
+    const U32 deadline = static_cast<U32>(this->m_txStart + static_cast<I64>(k_us_to_ticks_ceil64(allowedUs)));
+    atomic_set(&this->m_txDeadline, static_cast<atomic_val_t>((deadline != 0) ? deadline : 1));
+
+    // The status goes out from completeFrame, once TX_DONE or the deadline gives the outcome
+}
+
+void SBand ::serviceTransmit() {
+    const uint16_t irqStatus = this->m_rlb_radio.getIrqStatus();
+    if ((irqStatus & RADIOLIB_SX128X_IRQ_TX_DONE) != 0) {
+        this->completeFrame(true);
+        return;
+    }
+
+    const U32 txDeadline = static_cast<U32>(atomic_get(&this->m_txDeadline));
+    if (static_cast<I32>(static_cast<U32>(k_uptime_ticks()) - txDeadline) >= 0) {
+        this->log_WARNING_HI_RadioLibFailed(RADIOLIB_ERR_TX_TIMEOUT);
+        this->completeFrame(false);
+    }
+}
+
+void SBand ::completeFrame(bool sent) {
+    atomic_clear(&this->m_txDeadline);
+    atomic_add(&this->m_txOnAirUs,
+               static_cast<atomic_val_t>(k_ticks_to_us_floor32(k_uptime_ticks() - this->m_txStart)));
+
+    // Clears the IRQ flags and returns the radio to standby
+    int16_t state = this->m_rlb_radio.finishTransmit();
+    if (state != RADIOLIB_ERR_NONE) {
+        this->log_WARNING_HI_RadioLibFailed(state);
+        sent = false;
+    }
+    if (sent) {
+        this->log_WARNING_HI_RadioLibFailed_ThrottleClear();
+    } else {
+        ModulationCache::invalidate(this->m_modulation);
+        this->m_txFailures++;
+        this->tlmWrite_TxFailures(this->m_txFailures);
+    }
+
+    Fw::Success returnStatus = sent ? Fw::Success::SUCCESS : Fw::Success::FAILURE;
+    this->dataReturnOut_out(0, this->m_txFrame, this->m_txContext);
+    this->comStatusOut_out(0, returnStatus);
+    this->tlmWrite_TxSpiTransactions(this->m_rlb_hal.getSpiTransfers() - this->m_txSpiStart);
+
+    TxPipeline::complete(this->m_txPipeline);
+    this->afterFrame(sent);
+}
+
+void SBand ::afterFrame(bool sent) {
+    // Hold the radio in transmit for the next frame of a burst, returning to receive from deferredBurstCheck
+    Fw::ParamValid isValid = Fw::ParamValid::INVALID;
+    const U8 burstHold = this->paramGet_TX_BURST_HOLD(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
+    if (sent && (burstHold > 0)) {
+        this->m_burstIdleTicks = 0;
+        atomic_set(&this->m_txBurst, 1);
+    } else {
+        this->endBurst();
+    }
+}
+
+void SBand ::deferredAdapt_internalInterfaceHandler() {
+    atomic_clear(&this->m_adaptQueued);
+
+    Fw::ParamValid isValid = Fw::ParamValid::INVALID;
+    const Fw::Enabled adaptive = this->paramGet_ADAPTIVE_MODULATION(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
+    const SBandDataRate dataRate = this->paramGet_DATA_RATE(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
+    const SBandCodingRate codingRate = this->paramGet_CODING_RATE(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
+    const SBandBandwidth bandwidthTx = this->paramGet_BANDWIDTH_TX(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
+    const SBandBandwidth bandwidthRx = this->paramGet_BANDWIDTH_RX(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
+    const F32 targetMargin = this->paramGet_ADAPT_TARGET_MARGIN(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
+    const F32 hysteresis = this->paramGet_ADAPT_HYSTERESIS(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
 
-    status = this->enableRx();
+    // The ladder shares one bandwidth between directions, so the parameters must select a rung on it
+    const size_t home = (bandwidthTx == bandwidthRx)
+                            ? LinkAdaptation::findRung(static_cast<uint8_t>(dataRate.e),
+                                                       static_cast<uint8_t>(bandwidthTx.e))
+                            : LinkAdaptation::kNoRung;
+    const bool active = (adaptive == Fw::Enabled::ENABLED) && (home != LinkAdaptation::kNoRung);
+    if (!active || (home != this->m_adaptation.home)) {
+        // Disabled or re-parameterized: drop any change in progress and use the parameters
+        const bool adapted = this->m_adaptActive && (this->m_adaptation.rung != home);
+        LinkAdaptation::reset(this->m_adaptation, home);
+        this->m_adaptActive = active;
+        atomic_set(&this->m_adaptPending, active ? 1 : 0);
+        if (adapted) {
+            this->resumeRx();
+        }
+        if (!active) {
+            return;
+        }
+        this->tlmWrite_ModulationRung(static_cast<U8>(home));
+    }
+
+    this->m_adaptConfig.targetMarginDb = targetMargin;
+    this->m_adaptConfig.hysteresisDb = hysteresis;
+    this->m_adaptConfig.window = ADAPT_WINDOW;
+    this->m_adaptConfig.announcements = ADAPT_ANNOUNCEMENTS;
+    this->m_adaptConfig.confirmTicks = ADAPT_CONFIRM_TICKS;
+    this->m_adaptConfig.holdoffTicks = ADAPT_HOLDOFF_TICKS;
+    this->m_adaptConfig.idleTicks = ADAPT_IDLE_TICKS;
+
+    switch (LinkAdaptation::tick(this->m_adaptation, this->m_adaptConfig)) {
+        case LinkAdaptation::Action::Announce:
+            // Announcements go out between frames; the change waits while transmit is disabled
+            if (!this->m_txPipeline.onAir && (this->m_transmit_enabled == SBandTransmitState::ENABLED)) {
+                this->announceModulation(static_cast<uint8_t>(codingRate.e));
+            }
+            break;
+        case LinkAdaptation::Action::Revert:
+            this->m_modulationReverts++;
+            this->tlmWrite_ModulationReverts(this->m_modulationReverts);
+            this->log_WARNING_LO_ModulationReverted(static_cast<U8>(this->m_adaptation.rung));
+            this->tlmWrite_ModulationRung(static_cast<U8>(this->m_adaptation.rung));
+            this->resumeRx();
+            break;
+        case LinkAdaptation::Action::Home:
+            this->log_ACTIVITY_HI_ModulationIdleReset(static_cast<U8>(this->m_adaptation.rung));
+            this->tlmWrite_ModulationRung(static_cast<U8>(this->m_adaptation.rung));
+            this->resumeRx();
+            break;
+        default:
+            break;
+    }
+}
+
+void SBand ::announceModulation(uint8_t codingRate) {
+    U8 packet[LinkAdaptation::kAnnouncementSize];
+    const size_t size = LinkAdaptation::encodeAnnouncement(this->m_adaptation, codingRate, packet, sizeof(packet));
+    FW_ASSERT(size == sizeof(packet), static_cast<FwAssertArgType>(size));
+    const F32 margin = LinkAdaptation::margin(this->m_adaptation, this->m_adaptation.rung);
+
+    // Sent in the old modulation, blocking for the few milliseconds a bare announcement is on air
+    if (this->enableTx() != Status::SUCCESS) {
+        this->resumeRx();
+        return;
+    }
+    const I64 start = k_uptime_ticks();
+    int16_t state = this->m_rlb_radio.transmit(packet, size);
+    atomic_add(&this->m_txOnAirUs, static_cast<atomic_val_t>(k_ticks_to_us_floor32(k_uptime_ticks() - start)));
+    if (state != RADIOLIB_ERR_NONE) {
+        this->log_WARNING_HI_RadioLibFailed(state);
+        ModulationCache::invalidate(this->m_modulation);
+    } else if (LinkAdaptation::announced(this->m_adaptation)) {
+        const LinkAdaptation::Rung& rung = LinkAdaptation::kLadder[this->m_adaptation.rung];
+        this->log_ACTIVITY_HI_ModulationChangeAnnounced(static_cast<U8>(this->m_adaptation.rung),
+                                                       static_cast<SBandDataRate::T>(rung.spreadingFactor),
+                                                       static_cast<SBandBandwidth::T>(rung.bandwidth), margin);
+        this->tlmWrite_ModulationRung(static_cast<U8>(this->m_adaptation.rung));
+    }
+    this->resumeRx();
+}
+
+void SBand ::resumeRx() {
+    // A frame on air or a burst returns to receive when it ends, in whatever rung is current then
+    if (!this->m_txPipeline.onAir && (atomic_get(&this->m_txBurst) == 0)) {
+        (void)this->enableRx();
+    }
+}
+
+void SBand ::deferredBurstCheck_internalInterfaceHandler() {
+    atomic_clear(&this->m_burstCheckQueued);
+    if (atomic_get(&this->m_txBurst) == 0) {
+        return;
+    }
+
+    Fw::ParamValid isValid = Fw::ParamValid::INVALID;
+    const U8 burstHold = this->paramGet_TX_BURST_HOLD(isValid);
+    FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
+              static_cast<FwAssertArgType>(isValid));
+
+    // Frames queued behind a TX frame are handled first, so this only counts ticks with nothing to send
+    this->m_burstIdleTicks++;
+    if (this->m_burstIdleTicks >= burstHold) {
+        this->endBurst();
+    }
+}
+
+void SBand ::endBurst() {
+    atomic_clear(&this->m_txBurst);
+    (void)this->enableRx();
+}
+
+void SBand ::updateDutyCycle() {
+    const I64 now = k_uptime_ticks();
+    const I64 elapsed = now - this->m_dutyWindowStart;
+    if (elapsed < static_cast<I64>(k_ms_to_ticks_ceil64(SBAND_DUTY_CYCLE_WINDOW_MS))) {
+        return;
+    }
+    const U32 onAirUs = static_cast<U32>(atomic_clear(&this->m_txOnAirUs));
+    const F32 dutyCycle = static_cast<F32>(100.0 * static_cast<F64>(onAirUs) /
+                                           static_cast<F64>(k_ticks_to_us_floor64(static_cast<U64>(elapsed))));
+    this->tlmWrite_TxDutyCycle(dutyCycle);
+    this->m_dutyWindowStart = now;
 }
 
 // ----------------------------------------------------------------------
@@ -176,33 +622,16 @@ SBand::Status SBand ::enableRx() {
     this->txEnable_out(0, Fw::Logic::LOW);
     this->rxEnable_out(0, Fw::Logic::HIGH);
 
-    SX1280* radio = &this->m_rlb_radio;
-
-    int16_t state = radio->standby();
-    if (state != RADIOLIB_ERR_NONE) {
-        this->log_WARNING_HI_RadioLibFailed(state);
-        return Status::ERROR;
-    }
-
-    state = radio->setSpreadingFactor(static_cast<uint8_t>(dataRate.e));
-    if (state != RADIOLIB_ERR_NONE) {
-        this->log_WARNING_HI_RadioLibFailed(state);
-        return Status::ERROR;
-    }
-
-    state = radio->setCodingRate(static_cast<uint8_t>(codingRate.e));
-    if (state != RADIOLIB_ERR_NONE) {
-        this->log_WARNING_HI_RadioLibFailed(state);
+    const ModulationCache::Modulation modulation = this->adapt({static_cast<uint8_t>(dataRate.e),
+                                                                static_cast<uint8_t>(codingRate.e),
+                                                                static_cast<uint8_t>(bandwidth.e)});
+    Status status = this->applyModulation(modulation);
+    if (status != Status::SUCCESS) {
         return Status::ERROR;
     }
 
-    state = radio->setBandwidth(bandwidthEnumToKHz(bandwidth));
-    if (state != RADIOLIB_ERR_NONE) {
-        this->log_WARNING_HI_RadioLibFailed(state);
-        return Status::ERROR;
-    }
-
-    state = radio->startReceive(RADIOLIB_SX128X_RX_TIMEOUT_INF);
+    // The radio is in standby after a transmission, so receive is always restarted
+    int16_t state = this->m_rlb_radio.startReceive(RADIOLIB_SX128X_RX_TIMEOUT_INF);
     if (state != RADIOLIB_ERR_NONE) {
         this->log_WARNING_HI_RadioLibFailed(state);
         return Status::ERROR;
@@ -225,6 +654,30 @@ SBand::Status SBand ::enableTx() {
     this->rxEnable_out(0, Fw::Logic::LOW);
     this->txEnable_out(0, Fw::Logic::HIGH);
 
+    // transmit() enters standby itself and startFrame calls standby() before startTransmit(), so an unchanged
+    // modulation needs no SPI transfer here
+    const ModulationCache::Modulation modulation = this->adapt({static_cast<uint8_t>(dataRate.e),
+                                                                static_cast<uint8_t>(codingRate.e),
+                                                                static_cast<uint8_t>(bandwidth.e)});
+    return this->applyModulation(modulation);
+}
+
+ModulationCache::Modulation SBand ::adapt(const ModulationCache::Modulation& configured) const {
+    if (!this->m_adaptActive) {
+        return configured;
+    }
+    const LinkAdaptation::Rung& rung = LinkAdaptation::kLadder[this->m_adaptation.rung];
+    return {rung.spreadingFactor, configured.codingRate, rung.bandwidth};
+}
+
+SBand::Status SBand ::applyModulation(const ModulationCache::Modulation& wanted) {
+    const uint8_t changes = ModulationCache::changes(this->m_modulation, wanted);
+    if (changes == 0) {
+        return Status::SUCCESS;
+    }
+
+    // Any failure leaves the radio's modulation unknown
+    ModulationCache::invalidate(this->m_modulation);
     SX1280* radio = &this->m_rlb_radio;
 
     int16_t state = radio->standby();
@@ -233,28 +686,35 @@ SBand::Status SBand ::enableTx() {
         return Status::ERROR;
     }
 
-    state = radio->setSpreadingFactor(static_cast<uint8_t>(dataRate.e));
-    if (state != RADIOLIB_ERR_NONE) {
-        this->log_WARNING_HI_RadioLibFailed(state);
-        return Status::ERROR;
+    if ((changes & ModulationCache::kSpreadingFactor) != 0) {
+        state = radio->setSpreadingFactor(wanted.spreadingFactor);
+        if (state != RADIOLIB_ERR_NONE) {
+            this->log_WARNING_HI_RadioLibFailed(state);
+            return Status::ERROR;
+        }
     }
 
-    state = radio->setCodingRate(static_cast<uint8_t>(codingRate.e));
-    if (state != RADIOLIB_ERR_NONE) {
-        this->log_WARNING_HI_RadioLibFailed(state);
-        return Status::ERROR;
+    if ((changes & ModulationCache::kCodingRate) != 0) {
+        state = radio->setCodingRate(wanted.codingRate);
+        if (state != RADIOLIB_ERR_NONE) {
+            this->log_WARNING_HI_RadioLibFailed(state);
+            return Status::ERROR;
+        }
     }
 
-    state = radio->setBandwidth(bandwidthEnumToKHz(bandwidth));
-    if (state != RADIOLIB_ERR_NONE) {
-        this->log_WARNING_HI_RadioLibFailed(state);
-        return Status::ERROR;
+    if ((changes & ModulationCache::kBandwidth) != 0) {
+        state = radio->setBandwidth(bandwidthEnumToKHz(static_cast<SBandBandwidth::T>(wanted.bandwidth)));
+        if (state != RADIOLIB_ERR_NONE) {
+            this->log_WARNING_HI_RadioLibFailed(state);
+            return Status::ERROR;
+        }
     }
 
+    ModulationCache::applied(this->m_modulation, wanted);
     return Status::SUCCESS;
 }
 
-SBand::Status SBand ::configureRadio() {
+SBand::Status SBand ::configureRadio(const struct gpio_dt_spec* irq) {
     Fw::ParamValid isValid = Fw::ParamValid::INVALID;
     const SBandDataRate dataRate = this->paramGet_DATA_RATE(isValid);
     FW_ASSERT((isValid == Fw::ParamValid::VALID) || (isValid == Fw::ParamValid::DEFAULT),
@@ -272,7 +732,7 @@ SBand::Status SBand ::configureRadio() {
     uint8_t codingRateValue = static_cast<uint8_t>(codingRate.e);
     uint8_t syncWord = RADIOLIB_SX128X_SYNC_WORD_PRIVATE;
     int8_t outputPowerDbm = 13;  // 13 dBm is max
-    uint16_t preambleLength = 12;
+    uint16_t preambleLength = LORA_PREAMBLE_LENGTH;
 
     int16_t state = this->m_rlb_radio.begin(frequencyMHz, bandwidthKHz, spreadingFactor, codingRateValue, syncWord,
                                             outputPowerDbm, preambleLength);
@@ -281,6 +741,11 @@ SBand::Status SBand ::configureRadio() {
         return Status::ERROR;
     }
 
+    // begin() wrote the receive modulation
+    const ModulationCache::Modulation modulation = {spreadingFactor, codingRateValue,
+                                                    static_cast<uint8_t>(bandwidthRx.e)};
+    ModulationCache::applied(this->m_modulation, modulation);
+
     state = this->m_rlb_radio.setPacketParamsLoRa(preambleLength, RADIOLIB_SX128X_LORA_HEADER_EXPLICIT, 255,
                                                   RADIOLIB_SX128X_LORA_CRC_ON, RADIOLIB_SX128X_LORA_IQ_STANDARD);
     if (state != RADIOLIB_ERR_NONE) {
@@ -293,6 +758,22 @@ SBand::Status SBand ::configureRadio() {
         return Status::ERROR;
     }
 
+    // RadioLib routes RX_DONE to DIO1 in startReceive; its rising edge reports each packet
+    if (irq != nullptr) {
+        this->m_irq.owner = this;
+        k_work_init(&this->m_irq.work, SBand::irqWorkHandler);
+        this->m_rlb_hal.setIrqLine(irq);
+        this->m_rlb_hal.attachInterrupt(SBAND_PIN_IRQ, nullptr, FPRIME_HAL_GPIO_RISING);
+        this->m_irqEnabled = this->m_rlb_hal.isIrqAttached();
+        if (!this->m_irqEnabled) {
+            this->log_WARNING_HI_RxInterruptNotConfigured();
+        }
+    }
+
+    // The first deferredAdapt reads the parameters and starts from the rung they select
+    LinkAdaptation::reset(this->m_adaptation, LinkAdaptation::kNoRung);
+
+    this->m_dutyWindowStart = k_uptime_ticks();
     m_configured = true;
 
     // Only start ping-pong protocol if transmit is enabled
@@ -321,11 +802,18 @@ void SBand ::deferredTransmitCmd_internalInterfaceHandler(const SBandTransmitSta
         if (this->m_transmit_enabled == SBandTransmitState::DISABLED) {
             // Must transition to ENABLED **BEFORE** calling comStatusOut
             this->m_transmit_enabled = SBandTransmitState::ENABLED;
-            Fw::Success comStatus = Fw::Success::SUCCESS;
-            this->comStatusOut_out(0, comStatus);
+
+            // A frame still on air from before the disable readies upstream with its own status
+            if (!this->m_txPipeline.onAir) {
+                Fw::Success comStatus = Fw::Success::SUCCESS;
+                this->comStatusOut_out(0, comStatus);
+            }
         }
     } else {
         this->m_transmit_enabled = SBandTransmitState::DISABLED;
+        if (atomic_get(&this->m_txBurst) != 0) {
+            this->endBurst();
+        }
     }
 }
 
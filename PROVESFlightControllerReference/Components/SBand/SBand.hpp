@@ -8,7 +8,12 @@
 #define Components_SBand_HPP
 
 #include "FprimeHal.hpp"
+#include "LinkAdaptation.hpp"
+#include "ModulationCache.hpp"
 #include "PROVESFlightControllerReference/Components/SBand/SBandComponentAc.hpp"
+#include "RxWatchdog.hpp"
+#include "TxPipeline.hpp"
+#include <zephyr/kernel.h>
 
 namespace Components {
 
@@ -29,7 +34,14 @@ class SBand final : public SBandComponentBase {
     ~SBand();
 
     //! Configure the radio and start operation
-    Status configureRadio();
+    //!
+    //! With an IRQ GPIO, received packets are reported by interrupt and the rate group only polls as a watchdog.
+    //! Without one, the rate group polls the radio on every call.
+    Status configureRadio(const struct gpio_dt_spec* irq = nullptr  //!< SX1280 DIO1 line, nullptr to poll
+    );
+
+    //! Record an IRQ edge and queue the RX handler. Called by the HAL in interrupt context.
+    void irqAsserted();
 
     using SBandComponentBase::getIRQLine_out;
     using SBandComponentBase::getTime;
@@ -37,6 +49,13 @@ class SBand final : public SBandComponentBase {
     using SBandComponentBase::spiSend_out;
 
   private:
+    //! Parameter update handler
+    void parameterUpdated(FwPrmIdType id  //!< The parameter ID
+                          ) override;
+
+    //! Parameters loaded handler
+    void parametersLoaded() override;
+
     // ----------------------------------------------------------------------
     // Handler implementations for typed input ports
     // ----------------------------------------------------------------------
@@ -73,6 +92,16 @@ class SBand final : public SBandComponentBase {
     void deferredTxHandler_internalInterfaceHandler(const Fw::Buffer& data,
                                                     const ComCfg::FrameContext& context) override;
 
+    //! Handler implementation for deferredBurstCheck
+    //!
+    //! Internal async handler returning to receive once a transmit burst has been idle for TX_BURST_HOLD ticks
+    void deferredBurstCheck_internalInterfaceHandler() override;
+
+    //! Handler implementation for deferredAdapt
+    //!
+    //! Internal async handler stepping link adaptation and announcing modulation changes
+    void deferredAdapt_internalInterfaceHandler() override;
+
     //! Handler implementation for deferredTransmitCmd
     //!
     //! Internal async handler for processing TRANSMIT command state changes
@@ -84,19 +113,106 @@ class SBand final : public SBandComponentBase {
     void TRANSMIT_cmdHandler(FwOpcodeType opCode, U32 cmdSeq, SBandTransmitState enabled) override;
 
   private:
+    //! Work item queueing the RX handler from an IRQ edge, with the edge time for latency telemetry
+    struct IrqContext {
+        struct k_work work;  //!< Submitted from interrupt context
+        atomic_t edgeTicks;  //!< Low word of the uptime ticks of the last edge, 0 once handled
+        SBand* owner;        //!< Component to queue the handler on
+    };
+
+    //! Queue the RX handler from the system work queue
+    static void irqWorkHandler(struct k_work* work);
+
+    //! Queue the RX handler unless it is already queued
+    void queueRxHandler();
+
+    //! Read the IRQ line level, LOW when it cannot be read
+    bool isIrqLineHigh();
+
     //! Enable receive mode
     Status enableRx();
 
     //! Enable transmit mode
     Status enableTx();
 
+    //! Replace the spreading factor and bandwidth with the adapted rung while link adaptation is active
+    ModulationCache::Modulation adapt(const ModulationCache::Modulation& configured  //!< The parameter modulation
+    ) const;
+
+    //! Send the pending modulation change announcement in the current modulation
+    void announceModulation(uint8_t codingRate  //!< SBandCodingRate value
+    );
+
+    //! Return to receive in the current rung unless a frame or burst will do so
+    void resumeRx();
+
+    //! Write the modulation parameters that differ from what the radio holds, from standby
+    Status applyModulation(const ModulationCache::Modulation& wanted  //!< The modulation needed next
+    );
+
+    //! Transmit a frame with the thread blocked until TX_DONE, when the IRQ line is not interrupt driven
+    void transmitBlocking(Fw::Buffer& data,                    //!< The frame
+                          const ComCfg::FrameContext& context  //!< The frame context
+    );
+
+    //! Start a frame without waiting for TX_DONE, reporting its status once it is on air
+    void startFrame(Fw::Buffer& data,                    //!< The frame
+                    const ComCfg::FrameContext& context  //!< The frame context
+    );
+
+    //! Complete the frame on air if TX_DONE is set or its deadline has passed
+    void serviceTransmit();
+
+    //! Return the frame on air and start the staged one, if any
+    void completeFrame(bool sent  //!< Whether the frame completed with TX_DONE
+    );
+
+    //! Hold the radio in transmit for a burst, or return to receive
+    void afterFrame(bool sent  //!< Whether the last frame was sent
+    );
+
+    //! Leave a transmit burst and return to receive
+    void endBurst();
+
+    //! Report the transmit duty cycle once per SBAND_DUTY_CYCLE_WINDOW_MS
+    void updateDutyCycle();
+
   private:
     FprimeHal m_rlb_hal;                                                   //!< RadioLib HAL instance
     Module m_rlb_module;                                                   //!< RadioLib Module instance
     SX1280 m_rlb_radio;                                                    //!< RadioLib SX1280 radio instance
     bool m_configured = false;                                             //!< Flag indicating radio is configured
-    bool m_rxHandlerQueued = false;                                        //!< Flag indicating RX handler is queued
+    atomic_t m_rxHandlerQueued = ATOMIC_INIT(0);                           //!< Flag indicating RX handler is queued
+    bool m_irqEnabled = false;                                             //!< IRQ line raises interrupts
+    IrqContext m_irq = {};                                                 //!< IRQ edge work item
+    RxWatchdog::State m_rxWatchdog = {};                                   //!< Fallback polling state
+    U32 m_rxLatencyMax = 0;                                                //!< Largest IRQ-to-dataOut latency
+    U32 m_rxWatchdogPolls = 0;                                             //!< Periodic watchdog polls
+    atomic_t m_rxWatchdogPoll = ATOMIC_INIT(0);                            //!< Queued RX handler is a periodic poll
+    U32 m_rxMissedInterrupts = 0;                                          //!< Asserted lines found by the watchdog
     SBandTransmitState m_transmit_enabled = SBandTransmitState::DISABLED;  //!< Transmit state
+    U8 m_rxScratch[16];                                                    //!< Drains a packet when allocation fails
+    ModulationCache::Cache m_modulation = {};                              //!< Modulation the radio holds
+    atomic_t m_txBurst = ATOMIC_INIT(0);                                   //!< Radio is held in transmit
+    atomic_t m_burstCheckQueued = ATOMIC_INIT(0);                          //!< deferredBurstCheck is queued
+    U8 m_burstIdleTicks = 0;                                               //!< Ticks since the last burst frame
+    atomic_t m_txOnAirUs = ATOMIC_INIT(0);                                 //!< Transmit time in this window
+    I64 m_dutyWindowStart = 0;                                             //!< Uptime ticks the window began
+    TxPipeline::State m_txPipeline = {};                                   //!< Frame on air
+    Fw::Buffer m_txFrame;                                                  //!< Frame on air
+    ComCfg::FrameContext m_txContext;                                      //!< Context of the frame on air
+    I64 m_txStart = 0;                                                     //!< Uptime ticks the frame started
+    U32 m_txSpiStart = 0;                                                  //!< SPI transfers when the frame started
+    atomic_t m_txDeadline = ATOMIC_INIT(0);                                //!< Low word of the TX_DONE deadline, 0 idle
+    U32 m_txFailures = 0;                                                  //!< Frames not sent
+    atomic_t m_adaptQueued = ATOMIC_INIT(0);                               //!< deferredAdapt is queued
+    atomic_t m_adaptEnabled = ATOMIC_INIT(0);                              //!< ADAPTIVE_MODULATION is ENABLED
+    atomic_t m_adaptPending = ATOMIC_INIT(0);                              //!< deferredAdapt has a rung to wind down
+    bool m_adaptActive = false;                                            //!< Adapted rung replaces the parameters
+    LinkAdaptation::Config m_adaptConfig = {};                             //!< Link adaptation settings
+    LinkAdaptation::State m_adaptation = {};                               //!< Link adaptation state
+    U32 m_modulationChanges = 0;                                           //!< Confirmed modulation changes
+    U32 m_modulationReverts = 0;                                           //!< Reverted modulation changes
 };
 
 }  // namespace Components
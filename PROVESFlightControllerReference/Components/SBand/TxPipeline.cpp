@@ -0,0 +1,58 @@
+// ======================================================================
+// \title  TxPipeline.cpp
+// \brief  cpp file for pipelining SBand frames around the SX1280 TX_DONE interrupt
+// ======================================================================
+
+#include "TxPipeline.hpp"
+
+namespace Components {
+namespace TxPipeline {
+
+Accept accept(State& state) {
+    if (!state.onAir) {
+        state.onAir = true;
+        return Accept::Start;
+    }
+    return Accept::Reject;
+}
+
+void complete(State& state) {
+    state.onAir = false;
+}
+
+void abort(State& state) {
+    state.onAir = false;
+}
+
+uint32_t timeOnAirUs(uint8_t spreadingFactor,
+                     uint32_t bandwidthHz,
+                     uint8_t codingRate,
+                     uint16_t preambleLength,
+                     size_t payloadSize,
+                     bool crc,
+                     bool explicitHeader) {
+    const int64_t sf = spreadingFactor;
+    const int64_t header = explicitHeader ? 20 : 0;
+    const int64_t crcBits = crc ? 16 : 0;
+
+    // Payload bits beyond those carried by the first symbols, and the bits each symbol group carries
+    int64_t bits = 8 * static_cast<int64_t>(payloadSize) + crcBits - 4 * sf + header;
+    int64_t bitsPerGroup = 4 * sf;
+    if (sf >= 7) {
+        bits += 8;
+    }
+    if (sf >= 11) {
+        bitsPerGroup = 4 * (sf - 2);
+    }
+    bits = (bits > 0) ? bits : 0;
+    const int64_t groups = (bits + bitsPerGroup - 1) / bitsPerGroup;
+
+    // Quarter symbols: preamble, 6.25 or 4.25 sync symbols, 8 header symbols and the payload
+    const int64_t quarterSymbols = 4 * static_cast<int64_t>(preambleLength) + ((sf <= 6) ? 25 : 17) + 32 +
+                                   4 * groups * static_cast<int64_t>(codingRate);
+    const int64_t symbolScale = (int64_t{1} << sf) * 1000000;
+    return static_cast<uint32_t>((quarterSymbols * symbolScale) / (4 * static_cast<int64_t>(bandwidthHz)));
+}
+
+}  // namespace TxPipeline
+}  // namespace Components
@@ -0,0 +1,54 @@
+// ======================================================================
+// \title  TxPipeline.hpp
+// \brief  hpp file for pipelining SBand frames around the SX1280 TX_DONE interrupt
+// ======================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Components {
+
+//! One-frame transmit pipeline for a radio that reports completion by interrupt
+//!
+//! The component thread is free while a frame is on air. Each frame's status is reported once TX_DONE or its
+//! deadline gives the outcome, and upstream sends its next frame only after a status, so at most one frame is in the
+//! pipeline.
+namespace TxPipeline {
+
+//! What to do with a frame handed to the pipeline
+enum class Accept {
+    Start,  //!< The radio is idle; start the frame now
+    Reject  //!< A frame is on air; upstream sent without a ready status
+};
+
+//! Pipeline occupancy, owned by the component thread
+struct State {
+    bool onAir;  //!< A frame is being transmitted
+};
+
+//! Hand a frame to the pipeline
+Accept accept(State& state  //!< The pipeline
+);
+
+//! Complete the frame on air
+void complete(State& state  //!< The pipeline
+);
+
+//! Record that the frame just started failed to start
+void abort(State& state  //!< The pipeline
+);
+
+//! SX1280 LoRa time on air in microseconds, per the SX1280 datasheet section 7.4.4
+uint32_t timeOnAirUs(uint8_t spreadingFactor,  //!< Spreading factor, 5 to 12
+                     uint32_t bandwidthHz,     //!< Bandwidth in Hz
+                     uint8_t codingRate,       //!< Coding rate denominator, 5 to 8 for 4/5 to 4/8
+                     uint16_t preambleLength,  //!< Preamble length in symbols
+                     size_t payloadSize,       //!< Payload size in bytes
+                     bool crc,                 //!< Whether the payload CRC is on
+                     bool explicitHeader       //!< Whether the header is explicit
+);
+
+}  // namespace TxPipeline
+}  // namespace Components
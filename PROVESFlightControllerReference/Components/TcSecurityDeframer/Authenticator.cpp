@@ -119,4 +119,36 @@ PacketAuthenticator::AuthenticationResult authenticatePacket(const uint8_t* data
     return {PacketAuthenticator::AuthenticationStatus::Authenticated, PSA_SUCCESS};
 }
 
+PacketAuthenticator::KeyImportResult importHmacMidstate(const char* key, HmacSha256::Midstate& midstate) {
+    // Parse the hex-encoded default key into raw bytes
+    uint8_t keyBytes[Ccsds355_0_B_2::kTCSecurityTrailer];
+    if (!parseHexKey(key, keyBytes)) {
+        return {PacketAuthenticator::KeyImportStatus::ParseKeyError, PSA_ERROR_INVALID_ARGUMENT};
+    }
+
+    // Run the key schedule once; only the resulting hash states are kept
+    HmacSha256::precompute(keyBytes, sizeof(keyBytes), midstate);
+    mbedtls_platform_zeroize(keyBytes, sizeof keyBytes);
+
+    return {PacketAuthenticator::KeyImportStatus::Success, PSA_SUCCESS};
+}
+
+PacketAuthenticator::AuthenticationResult authenticatePacket(const uint8_t* dataBuffer,
+                                                             size_t dataSize,
+                                                             const Mac& hmac,
+                                                             const HmacSha256::Midstate& midstate) {
+    // Basic input validation: buffer present and at least trailer-sized
+    if (!dataBuffer || dataSize < Ccsds355_0_B_2::kTCSecurityTrailer) {
+        return {PacketAuthenticator::AuthenticationStatus::VerifyError, PSA_ERROR_INVALID_ARGUMENT};
+    }
+
+    // Verify the HMAC on the packet data
+    const size_t authenticatedDataSize = dataSize - Ccsds355_0_B_2::kTCSecurityTrailer;
+    if (!HmacSha256::verify(midstate, dataBuffer, authenticatedDataSize, hmac.data(), hmac.size())) {
+        return {PacketAuthenticator::AuthenticationStatus::VerifyError, PSA_ERROR_INVALID_SIGNATURE};
+    }
+
+    return {PacketAuthenticator::AuthenticationStatus::Authenticated, PSA_SUCCESS};
+}
+
 }  // namespace Components
@@ -8,6 +8,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "HmacSha256.hpp"
 #include "Types.hpp"
 
 namespace Components {
@@ -47,6 +48,8 @@ PacketAuthenticator::KeyImportResult importHmacKey(const char* key,  //!< The he
 );
 
 //! Check the validity of the packet HMAC
+//!
+//! Reference implementation through psa_mac_verify, which reruns the HMAC key schedule on every call.
 PacketAuthenticator::AuthenticationResult authenticatePacket(
     const uint8_t* buffer,  //!< The packet data buffer
     size_t size,            //!< The size of the data buffer
@@ -54,4 +57,21 @@ PacketAuthenticator::AuthenticationResult authenticatePacket(
     uint32_t& keyId         //!< The hex-encoded authentication key to use for validation
 );
 
+//! Precompute the HMAC key schedule for midstate verification.
+PacketAuthenticator::KeyImportResult importHmacMidstate(
+    const char* key,                //!< The hex-encoded authentication key to import
+    HmacSha256::Midstate& midstate  //!< The precomputed inner and outer hash states
+);
+
+//! Check the validity of the packet HMAC against a precomputed key schedule
+//!
+//! Hashes only the authenticated data, straight from the packet buffer, and compares the truncated MAC in constant
+//! time. Results match the PSA reference implementation, including its status codes.
+PacketAuthenticator::AuthenticationResult authenticatePacket(
+    const uint8_t* buffer,                //!< The packet data buffer
+    size_t size,                          //!< The size of the data buffer
+    const Mac& hmac,                      //!< The HMAC extracted from the packet to validate against
+    const HmacSha256::Midstate& midstate  //!< The precomputed inner and outer hash states
+);
+
 }  // namespace Components
@@ -0,0 +1,173 @@
+// ======================================================================
+// \title  HmacSha256.cpp
+// \brief  cpp file for HMAC-SHA-256 with a precomputed key schedule
+// ======================================================================
+
+#include "HmacSha256.hpp"
+
+#include <cstring>
+
+namespace Components {
+namespace HmacSha256 {
+namespace {
+
+constexpr uint8_t kIpad = 0x36;  //!< RFC 2104 inner pad byte
+constexpr uint8_t kOpad = 0x5c;  //!< RFC 2104 outer pad byte
+
+//! FIPS 180-4 Section 4.2.2 round constants
+constexpr uint32_t kRound[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+//! FIPS 180-4 Section 5.3.3 initial hash value
+constexpr State kInitial = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+uint32_t rotr(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+uint32_t loadBigEndian(const uint8_t* bytes) {
+    return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+           (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+}
+
+void storeBigEndian(uint32_t value, uint8_t* bytes) {
+    bytes[0] = static_cast<uint8_t>(value >> 24);
+    bytes[1] = static_cast<uint8_t>(value >> 16);
+    bytes[2] = static_cast<uint8_t>(value >> 8);
+    bytes[3] = static_cast<uint8_t>(value);
+}
+
+//! Compress one 64-byte block into the state, FIPS 180-4 Section 6.2.2
+void compress(State& state, const uint8_t* block) {
+    uint32_t w[64];
+    for (size_t t = 0; t < 16; t++) {
+        w[t] = loadBigEndian(block + 4 * t);
+    }
+    for (size_t t = 16; t < 64; t++) {
+        const uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+        const uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+        w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (size_t t = 0; t < 64; t++) {
+        const uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + kRound[t] + w[t];
+        const uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+//! Hash a message continuing from state, which has already absorbed prefixSize bytes, and write the digest
+void finish(State state, size_t prefixSize, const uint8_t* data, size_t size, uint8_t* digest) {
+    // Whole blocks are compressed straight from the caller's buffer
+    const size_t whole = size - (size % kBlockSize);
+    for (size_t offset = 0; offset < whole; offset += kBlockSize) {
+        compress(state, data + offset);
+    }
+
+    // The tail, the 0x80 terminator and the 64-bit bit length take one or two more blocks
+    uint8_t tail[2 * kBlockSize] = {};
+    const size_t remainder = size - whole;
+    if (remainder > 0) {
+        std::memcpy(tail, data + whole, remainder);
+    }
+    tail[remainder] = 0x80;
+    const size_t tailSize = (remainder + 1 + 8 <= kBlockSize) ? kBlockSize : 2 * kBlockSize;
+    const uint64_t bits = static_cast<uint64_t>(prefixSize + size) * 8;
+    storeBigEndian(static_cast<uint32_t>(bits >> 32), tail + tailSize - 8);
+    storeBigEndian(static_cast<uint32_t>(bits), tail + tailSize - 4);
+    for (size_t offset = 0; offset < tailSize; offset += kBlockSize) {
+        compress(state, tail + offset);
+    }
+
+    for (size_t i = 0; i < state.size(); i++) {
+        storeBigEndian(state[i], digest + 4 * i);
+    }
+}
+
+}  // namespace
+
+void precompute(const uint8_t* key, size_t keySize, Midstate& midstate) {
+    uint8_t block[kBlockSize] = {};
+    if (keySize > kBlockSize) {
+        finish(kInitial, 0, key, keySize, block);
+    } else if (keySize > 0) {
+        std::memcpy(block, key, keySize);
+    }
+
+    for (size_t i = 0; i < kBlockSize; i++) {
+        block[i] ^= kIpad;
+    }
+    midstate.inner = kInitial;
+    compress(midstate.inner, block);
+
+    for (size_t i = 0; i < kBlockSize; i++) {
+        block[i] ^= kIpad ^ kOpad;
+    }
+    midstate.outer = kInitial;
+    compress(midstate.outer, block);
+
+    // The padded key must not linger on the stack
+    volatile uint8_t* wipe = block;
+    for (size_t i = 0; i < kBlockSize; i++) {
+        wipe[i] = 0;
+    }
+}
+
+void compute(const Midstate& midstate, const uint8_t* data, size_t size, Digest& digest) {
+    uint8_t inner[kDigestSize];
+    finish(midstate.inner, kBlockSize, data, size, inner);
+    finish(midstate.outer, kBlockSize, inner, kDigestSize, digest.data());
+}
+
+bool verify(const Midstate& midstate, const uint8_t* data, size_t size, const uint8_t* mac, size_t macSize) {
+    if (macSize > kDigestSize) {
+        return false;
+    }
+    Digest digest;
+    compute(midstate, data, size, digest);
+
+    // Accumulate every difference so the time taken does not depend on where the first mismatch is
+    uint8_t difference = 0;
+    for (size_t i = 0; i < macSize; i++) {
+        difference |= static_cast<uint8_t>(digest[i] ^ mac[i]);
+    }
+    return difference == 0;
+}
+
+void clear(Midstate& midstate) {
+    volatile uint32_t* inner = midstate.inner.data();
+    volatile uint32_t* outer = midstate.outer.data();
+    for (size_t i = 0; i < midstate.inner.size(); i++) {
+        inner[i] = 0;
+        outer[i] = 0;
+    }
+}
+
+}  // namespace HmacSha256
+}  // namespace Components
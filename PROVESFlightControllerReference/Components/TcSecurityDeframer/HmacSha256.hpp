@@ -0,0 +1,60 @@
+// ======================================================================
+// \title  HmacSha256.hpp
+// \brief  hpp file for HMAC-SHA-256 with a precomputed key schedule
+// ======================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Components {
+
+//! HMAC-SHA-256 (RFC 2104, FIPS 180-4) verified from precomputed midstates
+//!
+//! The ipad and opad blocks depend only on the key, so the SHA-256 states after compressing them are computed once
+//! when the key is loaded. Each message then costs only its own blocks plus one outer block, and is hashed directly
+//! from the caller's buffer.
+namespace HmacSha256 {
+
+constexpr const size_t kBlockSize = 64;   //!< SHA-256 block size in bytes
+constexpr const size_t kDigestSize = 32;  //!< SHA-256 digest size in bytes
+
+using State = std::array<uint32_t, 8>;            //!< SHA-256 chaining state
+using Digest = std::array<uint8_t, kDigestSize>;  //!< Full HMAC-SHA-256 output
+
+//! SHA-256 states after the key schedule. Equivalent to the key, so treat as secret.
+struct Midstate {
+    State inner;  //!< State after compressing key XOR ipad
+    State outer;  //!< State after compressing key XOR opad
+};
+
+//! Precompute the inner and outer states for a key. Keys longer than a block are hashed first, per RFC 2104.
+void precompute(const uint8_t* key,  //!< The raw key bytes
+                size_t keySize,      //!< The key size in bytes
+                Midstate& midstate   //!< The precomputed states
+);
+
+//! Compute the full HMAC of a message
+void compute(const Midstate& midstate,  //!< The precomputed states
+             const uint8_t* data,       //!< The message
+             size_t size,               //!< The message size in bytes
+             Digest& digest             //!< The HMAC output
+);
+
+//! Compare the leading macSize bytes of the message HMAC against mac in constant time
+bool verify(const Midstate& midstate,  //!< The precomputed states
+            const uint8_t* data,       //!< The message
+            size_t size,               //!< The message size in bytes
+            const uint8_t* mac,        //!< The truncated MAC to check
+            size_t macSize             //!< The truncated MAC size in bytes, at most kDigestSize
+);
+
+//! Erase the precomputed states
+void clear(Midstate& midstate  //!< The states to erase
+);
+
+}  // namespace HmacSha256
+
+}  // namespace Components
@@ -0,0 +1,30 @@
+// ======================================================================
+// \title  Reservation.cpp
+// \brief  cpp file for write-behind sequence number reservation helper functions
+// ======================================================================
+
+#include "Reservation.hpp"
+
+namespace Components {
+namespace {
+
+//! Limit the reservation so the mark stays a short serial distance ahead of the live counter
+uint32_t clampReservation(uint32_t reservation) {
+    return (reservation > SequenceReservation::kMaxReservation) ? SequenceReservation::kMaxReservation : reservation;
+}
+
+}  // namespace
+
+bool sequenceNumberReserved(uint32_t sequenceNumber, uint32_t mark, uint32_t reservation) {
+    /*
+     * Serial distance from the sequence number up to the mark (RFC 1982). A sequence number
+     * beyond the mark wraps this distance to nearly 2^32, so it is never taken as covered.
+     */
+    return (mark - sequenceNumber) <= clampReservation(reservation);
+}
+
+uint32_t reserveSequenceNumber(uint32_t sequenceNumber, uint32_t reservation) {
+    return sequenceNumber + clampReservation(reservation);
+}
+
+}  // namespace Components
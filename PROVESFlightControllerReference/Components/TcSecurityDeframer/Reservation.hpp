@@ -0,0 +1,32 @@
+// ======================================================================
+// \title  Reservation.hpp
+// \brief  hpp file for write-behind sequence number reservation helper functions
+// ======================================================================
+
+#pragma once
+
+#include <cstdint>
+
+namespace Components {
+namespace SequenceReservation {
+
+//! Largest reservation accepted, keeping the persisted mark far from wrapping back behind the live counter
+constexpr const uint32_t kMaxReservation = 1u << 20;
+
+}  // namespace SequenceReservation
+
+//! Check whether an accepted sequence number is already covered by the persisted mark
+//!
+//! The persisted mark is a high-water mark at or ahead of every accepted sequence number. A sequence number at most
+//! reservation behind the mark needs no write; one beyond the mark, or a mark left behind by a failed write, does.
+bool sequenceNumberReserved(uint32_t sequenceNumber,  //!< The sequence number about to be accepted
+                            uint32_t mark,            //!< The mark currently persisted
+                            uint32_t reservation      //!< The reservation size
+);
+
+//! Compute the mark to persist before accepting a sequence number that is not reserved
+uint32_t reserveSequenceNumber(uint32_t sequenceNumber,  //!< The sequence number about to be accepted
+                               uint32_t reservation      //!< The reservation size
+);
+
+}  // namespace Components
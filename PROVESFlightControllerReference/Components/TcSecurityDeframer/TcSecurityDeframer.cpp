@@ -12,6 +12,8 @@
 #include "Authenticator.hpp"
 #include "TcSecurityDeframer.hpp"
 #include "Types.hpp"
+#include "Verifier.hpp"
+#include <zephyr/kernel.h>
 
 // Include generated header with default key (generated at build time)
 #include "AuthDefaultKey.h"
@@ -25,10 +27,19 @@ namespace Components {
 TcSecurityDeframer ::TcSecurityDeframer(const char* const compName)
     : TcSecurityDeframerComponentBase(compName),
       m_sequenceNumberFilePath(),
-      m_sequenceNumber(0),
-      m_sequenceNumberWindow(0) {}
-
-TcSecurityDeframer ::~TcSecurityDeframer() {}
+      m_replayWindow(PacketValidator::replayWindowFrom(0)),
+      m_sequenceNumberWindow(0),
+      m_sequenceNumberMark(0),
+      m_sequenceNumberReservation(0),
+      m_sequenceNumberWrites(0),
+      m_acceptedFrames(0),
+      m_reorderedFrames(0),
+      m_rejectedFrames(0),
+      m_hmacMidstate() {}
+
+TcSecurityDeframer ::~TcSecurityDeframer() {
+    HmacSha256::clear(this->m_hmacMidstate);
+}
 
 // ----------------------------------------------------------------------
 // Handler implementations for typed input ports
@@ -53,42 +64,56 @@ void TcSecurityDeframer ::dataIn_handler(FwIndexType portNum, Fw::Buffer& data,
     }
     this->log_WARNING_HI_ParsingFailed_ThrottleClear();
 
+    const I64 startTicks = k_uptime_ticks();
     {
         Os::ScopeLock lock(this->m_sequenceNumberLock);
 
-        // --- Validate SPI and anti-replay sequence number ---
-        const PacketValidator::Status validationStatus =
-            validatePacket(parseResult.securityHeader, this->m_sequenceNumber, this->m_sequenceNumberWindow);
+        // --- Validate SPI and sequence number, authenticate, and record the sequence number ---
+        // The key schedule was precomputed at configure(), so only the frame itself is hashed
+        const FrameVerifier::Result result =
+            verifyFrame(data.getData(), data.getSize(), parseResult, this->m_replayWindow,
+                        this->m_sequenceNumberWindow, this->m_sequenceNumberMark, this->m_sequenceNumberReservation,
+                        this->m_hmacMidstate);
 
-        if (validationStatus == PacketValidator::Status::SpiInvalid) {
+        if (result.status == FrameVerifier::Status::SpiInvalid) {
             this->log_WARNING_HI_SpiInvalid(parseResult.securityHeader.spi);
-        } else if (validationStatus == PacketValidator::Status::SequenceNumberInvalid) {
+        } else if (result.status == FrameVerifier::Status::SequenceNumberInvalid) {
             this->log_WARNING_HI_SequenceNumberInvalid(parseResult.securityHeader.sequenceNumber,
-                                                       this->m_sequenceNumber, this->m_sequenceNumberWindow);
+                                                       this->m_replayWindow.highest, this->m_sequenceNumberWindow);
         } else {
             this->log_WARNING_HI_SpiInvalid_ThrottleClear();
             this->log_WARNING_HI_SequenceNumberInvalid_ThrottleClear();
 
-            // --- Authenticate: HMAC over Security Header + Data Field ---
-            const PacketAuthenticator::AuthenticationResult authResult =
-                authenticatePacket(data.getData(), data.getSize(), parseResult.securityTrailer.mac, this->m_hmacKeyId);
-
-            if (authResult.status != PacketAuthenticator::AuthenticationStatus::Authenticated) {
-                this->log_WARNING_HI_AuthenticationFailed(static_cast<PacketAuthenticatorStatus::T>(authResult.status),
-                                                          authResult.psaStatus);
+            if (result.status == FrameVerifier::Status::AuthenticationFailed) {
+                this->log_WARNING_HI_AuthenticationFailed(
+                    static_cast<PacketAuthenticatorStatus::T>(result.authentication.status),
+                    result.authentication.psaStatus);
             } else {
                 this->log_WARNING_HI_AuthenticationFailed_ThrottleClear();
 
-                // --- Accept: persist new sequence number ---
-                // Only fully verified frames advance the counter, so bypass and replayed
-                // frames can never desync ground and spacecraft (issue #426)
-                this->m_sequenceNumber = parseResult.securityHeader.sequenceNumber;
-                this->writeSequenceNumber(this->m_sequenceNumber);
-                this->tlmWrite_CurrentSequenceNumber(this->m_sequenceNumber);
+                // --- Accept: persist a new high-water mark before the frame is forwarded ---
+                // Only fully verified frames are recorded, so bypass and replayed
+                // frames can never desync ground and spacecraft (issue #426).
+                if (result.reordered) {
+                    this->m_reorderedFrames++;
+                    this->tlmWrite_ReorderedFrames(this->m_reorderedFrames);
+                } else if (result.reserve) {
+                    (void)this->writeSequenceNumber(result.mark);
+                }
+                this->tlmWrite_CurrentSequenceNumber(this->m_replayWindow.highest);
                 contextOut.set_authenticated(true);
             }
         }
+
+        if (contextOut.get_authenticated()) {
+            this->m_acceptedFrames++;
+            this->tlmWrite_AcceptedFrames(this->m_acceptedFrames);
+        } else {
+            this->m_rejectedFrames++;
+            this->tlmWrite_RejectedFrames(this->m_rejectedFrames);
+        }
     }
+    this->tlmWrite_AuthenticationLatency(static_cast<U32>(k_ticks_to_us_floor64(k_uptime_ticks() - startTicks)));
 
     // Forward only the Data Field per CCSDS 355.0-B-2 §3.3.3.3:
     //   start = first octet after Security Header
@@ -120,7 +145,7 @@ void TcSecurityDeframer ::GET_SEQ_NUM_cmdHandler(FwOpcodeType opCode, U32 cmdSeq
     Os::ScopeLock lock(this->m_sequenceNumberLock);
 
     // Log the successful sequence number get
-    this->log_ACTIVITY_HI_SequenceNumberGet(this->m_sequenceNumber);
+    this->log_ACTIVITY_HI_SequenceNumberGet(this->m_replayWindow.highest);
 
     // Return success response
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
@@ -137,14 +162,14 @@ void TcSecurityDeframer ::SET_SEQ_NUM_cmdHandler(FwOpcodeType opCode, U32 cmdSeq
         return;
     }
 
-    // Set runtime sequence number to the new value
-    this->m_sequenceNumber = seq_num;
+    // Set runtime sequence number to the new value, with nothing at or behind it accepted again
+    this->m_replayWindow = PacketValidator::replayWindowFrom(seq_num);
 
     // Telemeter the updated sequence number
-    this->tlmWrite_CurrentSequenceNumber(this->m_sequenceNumber);
+    this->tlmWrite_CurrentSequenceNumber(this->m_replayWindow.highest);
 
     // Log the successful sequence number set
-    this->log_ACTIVITY_HI_SequenceNumberSet(this->m_sequenceNumber);
+    this->log_ACTIVITY_HI_SequenceNumberSet(this->m_replayWindow.highest);
 
     // Return success response
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
@@ -162,22 +187,30 @@ void TcSecurityDeframer ::configure() {
     this->m_sequenceNumberWindow = this->paramGet_SEQ_NUM_WINDOW(is_valid);
     FW_ASSERT(is_valid == Fw::ParamValid::VALID || is_valid == Fw::ParamValid::DEFAULT);
 
+    // Get the number of sequence numbers reserved by each file write from the parameter
+    this->m_sequenceNumberReservation = this->paramGet_SEQ_NUM_RESERVATION(is_valid);
+    FW_ASSERT(is_valid == Fw::ParamValid::VALID || is_valid == Fw::ParamValid::DEFAULT);
+
     // Get the file path from the parameter
     this->m_sequenceNumberFilePath = this->paramGet_SEQ_NUM_FILE_PATH(is_valid);
     FW_ASSERT(is_valid == Fw::ParamValid::VALID || is_valid == Fw::ParamValid::DEFAULT);
 
-    // Get the sequence number from the file system. On a read failure (already evented
-    // by readSequenceNumber) fall back to 0 rather than refusing to boot; the operator
-    // can correct the counter with SET_SEQ_NUM.
+    // Get the sequence number from the file system. The file holds the reserved high-water
+    // mark, so resuming from it skips any reserved but unused sequence numbers and never
+    // reopens one accepted before the reset. On a read failure (already evented by
+    // readSequenceNumber) fall back to 0 rather than refusing to boot; the operator can
+    // correct the counter with SET_SEQ_NUM.
     U32 sequenceNumber = 0;
     (void)this->readSequenceNumber(sequenceNumber);
-    this->m_sequenceNumber = sequenceNumber;
+    // Which sequence numbers behind the mark were accepted is not persisted, so all of them are treated as accepted
+    this->m_replayWindow = PacketValidator::replayWindowFrom(sequenceNumber);
+    this->m_sequenceNumberMark = sequenceNumber;
 
     // Telemeter the current sequence number
-    this->tlmWrite_CurrentSequenceNumber(this->m_sequenceNumber);
+    this->tlmWrite_CurrentSequenceNumber(this->m_replayWindow.highest);
 
-    // Import the HMAC key
-    PacketAuthenticator::KeyImportResult result = importHmacKey(AUTH_DEFAULT_KEY, this->m_hmacKeyId);
+    // Precompute the HMAC key schedule
+    PacketAuthenticator::KeyImportResult result = importHmacMidstate(AUTH_DEFAULT_KEY, this->m_hmacMidstate);
     FW_ASSERT(result.status == PacketAuthenticator::KeyImportStatus::Success);
 }
 
@@ -206,12 +239,17 @@ Os::File::Status TcSecurityDeframer ::readSequenceNumber(U32& value) {
 
 Os::File::Status TcSecurityDeframer ::writeSequenceNumber(const U32 value) {
     Os::File::Status status = Utilities::FileHelper::writeToFile(this->m_sequenceNumberFilePath.toChar(), value);
+    this->m_sequenceNumberWrites++;
+    this->tlmWrite_SequenceNumberWrites(this->m_sequenceNumberWrites);
     if (status != Os::File::OP_OK) {
         // Log the failure to write the default sequence number
         this->log_WARNING_HI_SequenceNumberWriteFailed(static_cast<Os::FileStatus::T>(status));
     } else {
         // Clear throttle for sequence number write failure
         this->log_WARNING_HI_SequenceNumberWriteFailed_ThrottleClear();
+
+        // The file now holds this value, so it is the mark a reset would resume from
+        this->m_sequenceNumberMark = value;
     }
 
     return status;
@@ -15,6 +15,7 @@
 
 #include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Authenticator.hpp"
 #include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Parser.hpp"
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Reservation.hpp"
 #include "PROVESFlightControllerReference/Components/TcSecurityDeframer/TcSecurityDeframerComponentAc.hpp"
 #include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Validator.hpp"
 
@@ -81,7 +82,8 @@ class TcSecurityDeframer final : public TcSecurityDeframerComponentBase {
 
     //! Initialize component
     //!
-    //! Loads the sequence number from persistent storage
+    //! Loads the sequence number from persistent storage. The file holds a reserved high-water mark, so the
+    //! counter resumes from the mark and every sequence number accepted before a reset stays rejected
     void configure();
 
   private:
@@ -104,12 +106,18 @@ class TcSecurityDeframer final : public TcSecurityDeframerComponentBase {
 
     // Sequence number state is coupled between in-memory runtime state and on-disk persistent storage
     // they are protected by the same mutex to ensure atomicity of updates across both mediums
-    Os::Mutex m_sequenceNumberLock;       //!< Mutex protecting sequence number state atomicity
-    Fw::String m_sequenceNumberFilePath;  //!< File path where sequence number is stored
-    U32 m_sequenceNumber;                 //!< The current sequence number
-    U32 m_sequenceNumberWindow;           //!< The allowed window for sequence number validation
-
-    uint32_t m_hmacKeyId;  //!< The HMAC key ID used for authentication
+    Os::Mutex m_sequenceNumberLock;                //!< Mutex protecting sequence number state atomicity
+    Fw::String m_sequenceNumberFilePath;           //!< File path where sequence number is stored
+    PacketValidator::ReplayWindow m_replayWindow;  //!< The highest accepted sequence number and those behind it
+    U32 m_sequenceNumberWindow;                    //!< The allowed window for sequence number validation
+    U32 m_sequenceNumberMark;                      //!< The high-water mark last persisted to the file
+    U32 m_sequenceNumberReservation;               //!< Sequence numbers reserved by each file write
+    U32 m_sequenceNumberWrites;                    //!< Count of sequence number file writes since boot
+    U32 m_acceptedFrames;                          //!< Count of frames accepted as authenticated since boot
+    U32 m_reorderedFrames;                         //!< Count of accepted frames that arrived behind the highest
+    U32 m_rejectedFrames;                          //!< Count of parsed frames that failed validation or authentication
+
+    HmacSha256::Midstate m_hmacMidstate;  //!< The precomputed HMAC key schedule used for authentication
 };
 
 }  // namespace Components
@@ -31,8 +31,29 @@ bool sequenceNumberValid(uint32_t packetSequenceNumber, uint32_t sequenceNumber,
     return (packetSequenceNumber - sequenceNumber) <= sequenceNumberWindow;
 }
 
+//! Validate a sequence number against the replay window: ahead within the window, or behind and not yet accepted
+bool sequenceNumberUnseen(uint32_t packetSequenceNumber,
+                          const PacketValidator::ReplayWindow& replayWindow,
+                          uint32_t sequenceNumberWindow) {
+    // Ahead of the highest accepted sequence number, with the same serial arithmetic as sequenceNumberValid
+    if (sequenceNumberValid(packetSequenceNumber, replayWindow.highest, sequenceNumberWindow)) {
+        return true;
+    }
+
+    // Behind it: only unmarked sequence numbers still tracked by the bitmap are accepted
+    const uint32_t behind = replayWindow.highest - packetSequenceNumber;
+    if (behind >= PacketValidator::kReplayWindowSize) {
+        return false;
+    }
+    return (replayWindow.bitmap & (static_cast<uint64_t>(1) << behind)) == 0;
+}
+
 }  // namespace
 
+PacketValidator::ReplayWindow PacketValidator::replayWindowFrom(uint32_t highest) {
+    return {highest, ~static_cast<uint64_t>(0)};
+}
+
 PacketValidator::Status validatePacket(const Ccsds355_0_B_2::TCSecurityHeader& secHeader,
                                        uint32_t sequenceNumber,
                                        uint32_t sequenceNumberWindow) {
@@ -47,4 +68,32 @@ PacketValidator::Status validatePacket(const Ccsds355_0_B_2::TCSecurityHeader& s
     return PacketValidator::Status::Valid;
 }
 
+PacketValidator::Status validatePacket(const Ccsds355_0_B_2::TCSecurityHeader& secHeader,
+                                       const PacketValidator::ReplayWindow& replayWindow,
+                                       uint32_t sequenceNumberWindow) {
+    if (!spiValid(secHeader.spi)) {
+        return PacketValidator::Status::SpiInvalid;
+    }
+
+    if (!sequenceNumberUnseen(secHeader.sequenceNumber, replayWindow, sequenceNumberWindow)) {
+        return PacketValidator::Status::SequenceNumberInvalid;
+    }
+
+    return PacketValidator::Status::Valid;
+}
+
+bool acceptSequenceNumber(PacketValidator::ReplayWindow& replayWindow, uint32_t sequenceNumber) {
+    const uint32_t behind = replayWindow.highest - sequenceNumber;
+    if (behind < PacketValidator::kReplayWindowSize) {
+        replayWindow.bitmap |= static_cast<uint64_t>(1) << behind;
+        return false;
+    }
+
+    // A new highest: slide the bitmap forward, dropping sequence numbers that fall out of the window
+    const uint32_t ahead = sequenceNumber - replayWindow.highest;
+    replayWindow.bitmap = (ahead < PacketValidator::kReplayWindowSize) ? (replayWindow.bitmap << ahead) | 1 : 1;
+    replayWindow.highest = sequenceNumber;
+    return true;
+}
+
 }  // namespace Components
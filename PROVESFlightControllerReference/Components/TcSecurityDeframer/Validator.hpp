@@ -20,6 +20,22 @@ enum class Status {
     SequenceNumberInvalid,  //!< The packet sequence number is outside the acceptable window
 };
 
+//! Sequence numbers at and behind the highest accepted one that are tracked individually
+constexpr const uint32_t kReplayWindowSize = 64;
+
+//! Sliding anti-replay window (RFC 4303 Section 3.4.3)
+//!
+//! Frames reordered in flight are accepted once each as long as they are no more than kReplayWindowSize - 1 behind
+//! the highest accepted sequence number. Anything further behind, or already marked, is a replay.
+struct ReplayWindow {
+    uint32_t highest;  //!< The highest accepted sequence number
+    uint64_t bitmap;   //!< Bit n is set when sequence number highest - n has been accepted
+};
+
+//! A window where every sequence number at or behind highest counts as accepted, as when resuming from storage
+ReplayWindow replayWindowFrom(uint32_t highest  //!< The highest sequence number that may have been accepted
+);
+
 }  // namespace PacketValidator
 
 //! Validate the packet against ruleset
@@ -29,4 +45,18 @@ PacketValidator::Status validatePacket(
     uint32_t sequenceNumberWindow                       //!< The acceptable sequence number window
 );
 
+//! Validate the packet against ruleset, accepting unseen sequence numbers behind the highest in any order
+PacketValidator::Status validatePacket(
+    const Ccsds355_0_B_2::TCSecurityHeader& secHeader,  //!< The parsed security header
+    const PacketValidator::ReplayWindow& replayWindow,  //!< The sequence numbers accepted so far
+    uint32_t sequenceNumberWindow                       //!< The acceptable forward sequence number window
+);
+
+//! Record a validated and authenticated sequence number in the replay window
+//!
+//! Returns true when the sequence number became the new highest, false when it filled a gap behind it.
+bool acceptSequenceNumber(PacketValidator::ReplayWindow& replayWindow,  //!< The window to update
+                          uint32_t sequenceNumber                       //!< The accepted sequence number
+);
+
 }  // namespace Components
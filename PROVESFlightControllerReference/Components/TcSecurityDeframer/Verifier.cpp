@@ -0,0 +1,58 @@
+// ======================================================================
+// \title  Verifier.cpp
+// \brief  cpp file for security header verification helper functions
+// ======================================================================
+
+#include "Verifier.hpp"
+
+#include "Reservation.hpp"
+
+namespace Components {
+
+FrameVerifier::Result verifyFrame(const uint8_t* buffer,
+                                  size_t size,
+                                  const Ccsds355_0_B_2::TcTransferFrame::Parser::Result& parsed,
+                                  PacketValidator::ReplayWindow& replayWindow,
+                                  uint32_t sequenceNumberWindow,
+                                  uint32_t sequenceNumberMark,
+                                  uint32_t sequenceNumberReservation,
+                                  const HmacSha256::Midstate& midstate) {
+    FrameVerifier::Result result = {FrameVerifier::Status::Accepted,
+                                    {PacketAuthenticator::AuthenticationStatus::VerifyError, 0},
+                                    false,
+                                    false,
+                                    sequenceNumberMark};
+
+    // Validate SPI and anti-replay sequence number
+    const PacketValidator::Status validationStatus =
+        validatePacket(parsed.securityHeader, replayWindow, sequenceNumberWindow);
+    if (validationStatus == PacketValidator::Status::SpiInvalid) {
+        result.status = FrameVerifier::Status::SpiInvalid;
+        return result;
+    }
+    if (validationStatus == PacketValidator::Status::SequenceNumberInvalid) {
+        result.status = FrameVerifier::Status::SequenceNumberInvalid;
+        return result;
+    }
+
+    // Authenticate: HMAC over Security Header + Data Field
+    result.authentication = authenticatePacket(buffer, size, parsed.securityTrailer.mac, midstate);
+    if (result.authentication.status != PacketAuthenticator::AuthenticationStatus::Authenticated) {
+        result.status = FrameVerifier::Status::AuthenticationFailed;
+        return result;
+    }
+
+    // Accept: a frame that fills a gap behind the highest accepted sequence number only marks the bitmap. A new
+    // highest may pass the persisted high-water mark, which must then be rewritten before the frame is accepted, so
+    // a reset always resumes at or beyond every frame already accepted.
+    const uint32_t sequenceNumber = parsed.securityHeader.sequenceNumber;
+    if (!acceptSequenceNumber(replayWindow, sequenceNumber)) {
+        result.reordered = true;
+    } else if (!sequenceNumberReserved(sequenceNumber, sequenceNumberMark, sequenceNumberReservation)) {
+        result.reserve = true;
+        result.mark = reserveSequenceNumber(sequenceNumber, sequenceNumberReservation);
+    }
+    return result;
+}
+
+}  // namespace Components
@@ -0,0 +1,53 @@
+// ======================================================================
+// \title  Verifier.hpp
+// \brief  hpp file for security header verification helper functions
+// ======================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Authenticator.hpp"
+#include "HmacSha256.hpp"
+#include "Parser.hpp"
+#include "Validator.hpp"
+
+namespace Components {
+namespace FrameVerifier {
+
+//! Status of verification attempt
+enum class Status {
+    Accepted,               //!< The frame is authenticated and its sequence number recorded
+    SpiInvalid,             //!< The packet SPI field is invalid
+    SequenceNumberInvalid,  //!< The sequence number is a replay or outside the acceptable window
+    AuthenticationFailed,   //!< The packet HMAC did not match
+};
+
+//! Result of verification attempt
+struct Result {
+    Status status;                                             //!< The status of the verification attempt
+    PacketAuthenticator::AuthenticationResult authentication;  //!< Authentication outcome, when it was attempted
+    bool reordered;                                            //!< The sequence number filled a gap behind the highest
+    bool reserve;                                              //!< The mark must be persisted before forwarding
+    uint32_t mark;                                             //!< The mark to persist when reserve is set
+};
+
+}  // namespace FrameVerifier
+
+//! Validate, authenticate and record a parsed frame in the anti-replay window
+//!
+//! Only fully verified frames are recorded, so bypass and replayed frames can never desync ground and spacecraft.
+//! The caller holds the lock protecting the window and persists result.mark when result.reserve is set.
+FrameVerifier::Result verifyFrame(
+    const uint8_t* buffer,                                          //!< The frame after the TC primary header
+    size_t size,                                                    //!< The size of the frame buffer
+    const Ccsds355_0_B_2::TcTransferFrame::Parser::Result& parsed,  //!< The parsed security header and trailer
+    PacketValidator::ReplayWindow& replayWindow,                    //!< The sequence numbers accepted so far
+    uint32_t sequenceNumberWindow,                                  //!< The acceptable forward sequence number window
+    uint32_t sequenceNumberMark,                                    //!< The mark currently persisted
+    uint32_t sequenceNumberReservation,                             //!< Sequence numbers reserved by each write
+    const HmacSha256::Midstate& midstate                            //!< The precomputed HMAC key schedule
+);
+
+}  // namespace Components
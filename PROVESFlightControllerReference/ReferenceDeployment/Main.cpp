@@ -26,7 +26,9 @@ const struct device* lora = DEVICE_DT_GET(DT_NODELABEL(lora0));
 const struct device* peripheral_uart = DEVICE_DT_GET(DT_NODELABEL(uart0));
 const struct device* peripheral_uart1 = DEVICE_DT_GET(DT_NODELABEL(uart1));
 const struct device* lsm6dso = DEVICE_DT_GET(DT_NODELABEL(lsm6dso0));
+const struct i2c_dt_spec lsm6dso_bus = I2C_DT_SPEC_GET(DT_NODELABEL(lsm6dso0));
 const struct device* lis2mdl = DEVICE_DT_GET(DT_NODELABEL(lis2mdl0));
+const struct gpio_dt_spec lis2mdl_drdy = GPIO_DT_SPEC_GET_OR(DT_NODELABEL(lis2mdl0), irq_gpios, {0});
 const struct device* rtc = DEVICE_DT_GET(DT_NODELABEL(rtc0));
 const struct device* tca9548a = DEVICE_DT_GET(DT_NODELABEL(tca9548a));
 const struct device* mux_channel_0 = DEVICE_DT_GET(DT_NODELABEL(mux_channel_0));
@@ -79,7 +81,9 @@ int main(int argc, char* argv[]) {
     inputs.loraDevice = lora;
     inputs.uartDevice = serial;
     inputs.lsm6dsoDevice = lsm6dso;
+    inputs.lsm6dsoBus = &lsm6dso_bus;
     inputs.lis2mdlDevice = lis2mdl;
+    inputs.lis2mdlDrdy = &lis2mdl_drdy;
     inputs.rtcDevice = rtc;
     inputs.tca9548aDevice = tca9548a;
     inputs.muxChannel0Device = mux_channel_0;
@@ -39,6 +39,13 @@ Fw::MallocAllocator mallocator;
 
 constexpr FwSizeType BASE_RATEGROUP_PERIOD_MS = 1;  // 1Khz
 
+// Every command a router or sequencer sends holds a CmdDispatcher sequence table slot until its response returns
+constexpr FwSizeType COMMAND_BATCH_ROUTERS = 2;  // LoRa and UART, S-Band is not connected to cmdDisp
+constexpr FwSizeType COMMAND_SEQUENCERS = 3;     // cmdSeq, payloadSeq and safeModeSeq
+static_assert(CMD_DISPATCHER_SEQUENCER_TABLE_SIZE >=
+                  COMMAND_BATCH_ROUTERS * Svc::ROUTER_MAX_BATCH_COMMANDS + COMMAND_SEQUENCERS,
+              "CmdDispatcher must track a full command batch from each radio plus the sequencers");
+
 // Helper function to calculate the period for a given rate group frequency
 constexpr FwSizeType getRateGroupPeriod(const FwSizeType hz) {
     return 1000 / (hz * BASE_RATEGROUP_PERIOD_MS);
@@ -140,11 +147,11 @@ void setupTopology(const TopologyState& state) {
     //     .word_delay = 0,
     // };
     //    spiDriver.configure(state.spi0Device, cfg);
-    //    sband.configureRadio();
+    //    sband.configureRadio(&sbandTxEnIRQ);
 
     // UART from the board to the payload
     peripheralUartDriver.configure(state.peripheralUart, state.peripheralBaudRate);
-    imuManager.configure(state.lis2mdlDevice, state.lsm6dsoDevice);
+    imuManager.configure(state.lis2mdlDevice, state.lsm6dsoDevice, state.lsm6dsoBus, state.lis2mdlDrdy);
     ina219SysManager.configure(state.ina219SysDevice);
     ina219SolManager.configure(state.ina219SolDevice);
 
@@ -34,6 +34,8 @@
 // Include autocoded FPP constants
 #include "PROVESFlightControllerReference/ReferenceDeployment/Top/FppConstantsAc.hpp"
 #include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/uart.h>
 #include <zephyr/kernel.h>
 
@@ -127,7 +129,9 @@ struct TopologyState {
     const device* ina219SysDevice;                //!< device path for battery board ina219
     const device* ina219SolDevice;                //!< device path for solar panel ina219
     const device* lsm6dsoDevice;                  //!< LSM6DSO device path for accelerometer/gyroscope
+    const i2c_dt_spec* lsm6dsoBus;                //!< LSM6DSO I2C bus and address for FIFO access
     const device* lis2mdlDevice;                  //!< LIS2MDL device path for magnetometer
+    const gpio_dt_spec* lis2mdlDrdy;              //!< LIS2MDL data-ready pin, unset without irq-gpios
     const device* rtcDevice;                      //!< RTC device path
     const device* tca9548aDevice;                 //!< TCA9548A I2C multiplexer device
     const device* muxChannel0Device;              //!< Multiplexer channel 0 device
@@ -12,7 +12,8 @@
 
 enum {
     CMD_DISPATCHER_DISPATCH_TABLE_SIZE = 350,  // !< The size of the table holding opcodes to dispatch
-    CMD_DISPATCHER_SEQUENCER_TABLE_SIZE = 10,  // !< The size of the table holding commands in progress
+    CMD_DISPATCHER_SEQUENCER_TABLE_SIZE = 20,  // !< The size of the table holding commands in progress, room for a
+                                               // !< full command batch from each radio plus the sequencers
 };
 
 #endif /* CMDDISPATCHER_COMMANDDISPATCHERIMPLCFG_HPP_ */
@@ -0,0 +1,727 @@
+// ======================================================================
+// \title  bench_ComCcsds_UplinkPipeline.cpp
+// \brief  Throughput baseline for the ComCcsds uplink chain
+// ======================================================================
+//
+// Signed TC frames are generated on the ground side and fed to the ComCcsdsUart uplink chain through a byte-stream
+// driver stand-in, in fixed size reads:
+//
+//   FrameAccumulator -> TcDeframer -> TcSecurityDeframer -> SpacePacketDeframer -> ProvesRouter -> CmdDispatcher
+//                                                                                              -> FileUplink
+//
+// The TcSecurityDeframer and ProvesRouter stages take their accept, reject and bypass decisions from the same
+// verifyFrame and admitPacket helpers the components call, and the router hands file packets off through Handoff.
+// The F Prime stages are reduced to the header checks, CRCs and copies they perform, and Fw::Buffer allocation to a
+// fixed pool sized like the comms BufferManager, because this directory builds without F Prime. Keep those stand-ins
+// in step with ComCcsdsConfig.fpp.
+//
+// Each scenario reports sustained frames per second, per-stage latency, pool allocations per frame, peak pool usage
+// and heap allocations made while frames are flowing.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/ProvesRouter/Bypasser.hpp"
+#include "PROVESFlightControllerReference/Components/ProvesRouter/Handoff.hpp"
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/HmacSha256.hpp"
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Parser.hpp"
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Validator.hpp"
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Verifier.hpp"
+
+//! Heap allocations so far; the flight chain only allocates from the buffer pool
+static std::size_t g_heapAllocations = 0;
+
+void* operator new(std::size_t size) {
+    g_heapAllocations++;
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+using namespace Components;
+
+namespace {
+
+// project/config/ComCfg.fpp, ComCcsdsConfig.fpp and FpConstants.fpp
+constexpr std::uint16_t SPACECRAFT_ID = 0x0044;
+constexpr std::uint8_t VC_ID = 1;
+constexpr std::uint16_t APID_COMMAND = 0x0000;
+constexpr std::uint16_t APID_FILE = 0x0003;
+constexpr std::size_t RING_SIZE = 1024;         // BuffMgr.frameAccumulatorSize
+constexpr std::size_t POOL_BUFFER_SIZE = 1024;  // BuffMgr.commsBuffSize and commsFileBuffSize
+constexpr std::size_t POOL_BUFFERS = 5 + 5;     // BuffMgr.commsBuffCount + commsFileBuffCount
+constexpr std::size_t COM_BUFFER_SIZE = FW_COM_BUFFER_MAX_SIZE;
+constexpr std::size_t CMD_QUEUE_DEPTH = 10;     // CmdDispatcher queue stand-in
+
+// TcSecurityDeframer parameter defaults
+constexpr std::uint32_t SEQ_NUM_WINDOW = 50000;
+constexpr std::uint32_t SEQ_NUM_RESERVATION = 100;
+
+// Same format as AUTH_DEFAULT_KEY in AuthDefaultKey.h: 32 hex digits, no 0x prefix
+constexpr char AUTH_KEY[] = "14408c2711281f4d70452ce3730bb4fa";
+
+// CCSDS framing sizes
+constexpr std::size_t TC_HEADER_SIZE = 5;
+constexpr std::size_t TC_TRAILER_SIZE = 2;
+constexpr std::size_t SPACE_PACKET_HEADER_SIZE = 6;
+constexpr std::size_t TC_MAX_FRAME_SIZE = 1024;
+
+using Clock = std::chrono::steady_clock;
+
+// ----------------------------------------------------------------------
+// Ground side
+// ----------------------------------------------------------------------
+
+bool parseKey(const char* hex, std::uint8_t (&key)[Ccsds355_0_B_2::kTCSecurityTrailer]) {
+    if (std::strlen(hex) != 2 * sizeof(key)) {
+        return false;
+    }
+    for (std::size_t i = 0; i < sizeof(key); i++) {
+        unsigned value = 0;
+        if (std::sscanf(hex + 2 * i, "%2x", &value) != 1) {
+            return false;
+        }
+        key[i] = static_cast<std::uint8_t>(value);
+    }
+    return true;
+}
+
+//! CRC-16/CCITT-FALSE, the TC frame FECF (CCSDS 232.0-B-4 Section 4.1.4.2)
+class Crc16 {
+  public:
+    Crc16() {
+        for (std::uint32_t i = 0; i < 256; i++) {
+            std::uint16_t crc = static_cast<std::uint16_t>(i << 8);
+            for (int bit = 0; bit < 8; bit++) {
+                crc = static_cast<std::uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1));
+            }
+            m_table[i] = crc;
+        }
+    }
+
+    std::uint16_t update(std::uint16_t crc, std::uint8_t byte) const {
+        return static_cast<std::uint16_t>((crc << 8) ^ m_table[((crc >> 8) ^ byte) & 0xFF]);
+    }
+
+    std::uint16_t compute(const std::uint8_t* data, std::size_t size) const {
+        std::uint16_t crc = 0xFFFF;
+        for (std::size_t i = 0; i < size; i++) {
+            crc = update(crc, data[i]);
+        }
+        return crc;
+    }
+
+  private:
+    std::array<std::uint16_t, 256> m_table;
+};
+
+//! Builds the byte stream the ground station sends: Space Packet, security header and trailer, TC frame
+class Ground {
+  public:
+    Ground(const HmacSha256::Midstate& midstate, const Crc16& crc)
+        : m_midstate(midstate), m_crc(crc), m_sequenceNumber(0), m_frameSequence(0), m_packetSequence(0) {}
+
+    //! A command packet: descriptor, opcode and arguments
+    void command(std::vector<std::uint8_t>& stream, std::uint32_t opcode, std::size_t argsSize, bool forged) {
+        std::vector<std::uint8_t> payload = {0x00, 0x00, static_cast<std::uint8_t>(opcode >> 24),
+                                             static_cast<std::uint8_t>(opcode >> 16),
+                                             static_cast<std::uint8_t>(opcode >> 8), static_cast<std::uint8_t>(opcode)};
+        for (std::size_t i = 0; i < argsSize; i++) {
+            payload.push_back(static_cast<std::uint8_t>(i));
+        }
+        append(stream, APID_COMMAND, payload, forged);
+    }
+
+    //! A FileUplink data packet: type, sequence index, byte offset, data size and data
+    void fileChunk(std::vector<std::uint8_t>& stream, std::uint32_t offset, std::size_t dataSize) {
+        std::vector<std::uint8_t> payload = {0x01};
+        putU32(payload, m_packetSequence);
+        putU32(payload, offset);
+        payload.push_back(static_cast<std::uint8_t>(dataSize >> 8));
+        payload.push_back(static_cast<std::uint8_t>(dataSize));
+        for (std::size_t i = 0; i < dataSize; i++) {
+            payload.push_back(static_cast<std::uint8_t>(offset + i));
+        }
+        append(stream, APID_FILE, payload, false);
+    }
+
+  private:
+    static void putU32(std::vector<std::uint8_t>& bytes, std::uint32_t value) {
+        bytes.push_back(static_cast<std::uint8_t>(value >> 24));
+        bytes.push_back(static_cast<std::uint8_t>(value >> 16));
+        bytes.push_back(static_cast<std::uint8_t>(value >> 8));
+        bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    void append(std::vector<std::uint8_t>& stream, std::uint16_t apid, const std::vector<std::uint8_t>& payload,
+                bool forged) {
+        // Security header, then the Space Packet
+        std::vector<std::uint8_t> frame(TC_HEADER_SIZE, 0);
+        frame.push_back(0x00);
+        frame.push_back(0x00);
+        putU32(frame, ++m_sequenceNumber);
+
+        const std::uint16_t packetSequence = static_cast<std::uint16_t>(m_packetSequence++ & 0x3FFF);
+        const std::size_t packetLength = payload.size() - 1;
+        frame.push_back(static_cast<std::uint8_t>(0x10 | ((apid >> 8) & 0x07)));
+        frame.push_back(static_cast<std::uint8_t>(apid));
+        frame.push_back(static_cast<std::uint8_t>(0xC0 | (packetSequence >> 8)));
+        frame.push_back(static_cast<std::uint8_t>(packetSequence));
+        frame.push_back(static_cast<std::uint8_t>(packetLength >> 8));
+        frame.push_back(static_cast<std::uint8_t>(packetLength));
+        frame.insert(frame.end(), payload.begin(), payload.end());
+
+        // Truncated HMAC over the security header and data field, as authenticate_plugin.py signs
+        HmacSha256::Digest digest;
+        HmacSha256::compute(m_midstate, frame.data() + TC_HEADER_SIZE, frame.size() - TC_HEADER_SIZE, digest);
+        if (forged) {
+            digest[0] ^= 0x01;
+        }
+        frame.insert(frame.end(), digest.begin(), digest.begin() + Ccsds355_0_B_2::kTCSecurityTrailer);
+
+        // TC primary header and FECF
+        const std::size_t frameLength = frame.size() + TC_TRAILER_SIZE - 1;
+        frame[0] = static_cast<std::uint8_t>(0x20 | ((SPACECRAFT_ID >> 8) & 0x03));
+        frame[1] = static_cast<std::uint8_t>(SPACECRAFT_ID);
+        frame[2] = static_cast<std::uint8_t>((VC_ID << 2) | ((frameLength >> 8) & 0x03));
+        frame[3] = static_cast<std::uint8_t>(frameLength);
+        frame[4] = static_cast<std::uint8_t>(m_frameSequence++);
+        const std::uint16_t fecf = m_crc.compute(frame.data(), frame.size());
+        frame.push_back(static_cast<std::uint8_t>(fecf >> 8));
+        frame.push_back(static_cast<std::uint8_t>(fecf));
+
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+
+    const HmacSha256::Midstate& m_midstate;
+    const Crc16& m_crc;
+    std::uint32_t m_sequenceNumber;
+    std::uint8_t m_frameSequence;
+    std::uint32_t m_packetSequence;
+};
+
+// ----------------------------------------------------------------------
+// Flight side
+// ----------------------------------------------------------------------
+
+//! Svc::BufferManager stand-in with the comms pool geometry
+class BufferPool {
+  public:
+    BufferPool() : m_used(), m_inUse(0), m_peak(0), m_allocations(0), m_failures(0) {}
+
+    std::uint8_t* allocate(std::size_t size) {
+        if (size > POOL_BUFFER_SIZE) {
+            m_failures++;
+            return nullptr;
+        }
+        for (std::size_t i = 0; i < POOL_BUFFERS; i++) {
+            if (!m_used[i]) {
+                m_used[i] = true;
+                m_inUse++;
+                m_peak = std::max(m_peak, m_inUse);
+                m_allocations++;
+                return m_buffers[i].data();
+            }
+        }
+        m_failures++;
+        return nullptr;
+    }
+
+    //! Deallocate the buffer containing data, wherever the deframers have moved the pointer to
+    void deallocate(const std::uint8_t* data) {
+        for (std::size_t i = 0; i < POOL_BUFFERS; i++) {
+            if (data >= m_buffers[i].data() && data < m_buffers[i].data() + POOL_BUFFER_SIZE) {
+                m_used[i] = false;
+                m_inUse--;
+                return;
+            }
+        }
+    }
+
+    std::size_t inUse() const { return m_inUse; }
+    std::size_t peak() const { return m_peak; }
+    std::size_t allocations() const { return m_allocations; }
+    std::size_t failures() const { return m_failures; }
+
+  private:
+    std::array<std::array<std::uint8_t, POOL_BUFFER_SIZE>, POOL_BUFFERS> m_buffers;
+    std::array<bool, POOL_BUFFERS> m_used;
+    std::size_t m_inUse;
+    std::size_t m_peak;
+    std::size_t m_allocations;
+    std::size_t m_failures;
+};
+
+//! Fw::Buffer and ComCfg::FrameContext as they travel down the chain
+struct Packet {
+    std::uint8_t* data;
+    std::size_t size;
+    std::uint16_t apid;
+    bool authenticated;
+};
+
+enum Stage { ACCUMULATE, TC_DEFRAME, SECURITY, SPACE_PACKET, ROUTE, DISPATCH, STAGES };
+
+const char* const STAGE_NAMES[STAGES] = {"FrameAccumulator", "TcDeframer", "TcSecurityDeframer", "SpacePacketDeframer",
+                                         "ProvesRouter", "CmdDispatcher"};
+
+struct StageTime {
+    std::uint64_t totalNs;
+    std::uint64_t maxNs;
+    std::uint64_t calls;
+};
+
+//! The uplink chain of one ComCcsds subtopology, called synchronously from the driver read as on flight
+class Pipeline {
+  public:
+    Pipeline(const HmacSha256::Midstate& midstate, const Crc16& crc, bool timed, std::size_t drainInterval)
+        : m_midstate(midstate),
+          m_crc(crc),
+          m_timed(timed),
+          m_drainInterval(drainInterval),
+          m_ringHead(0),
+          m_ringCount(0),
+          m_replayWindow(PacketValidator::replayWindowFrom(0)),
+          m_sequenceNumberMark(0),
+          m_fileUplinkHead(0),
+          m_fileUplinkCount(0),
+          m_reads(0),
+          m_downstreamNs(0),
+          m_routerAllocations(0),
+          m_sequenceNumberWrites(0),
+          m_frames(0),
+          m_commands(0),
+          m_fileChunks(0),
+          m_rejected(0),
+          m_ringOverflows(0),
+          m_opcodeSum(0),
+          m_times() {
+        PacketHandoff::reset(m_handoffs, POOL_BUFFERS);
+    }
+
+    //! Bytes delivered by one driver read
+    void read(const std::uint8_t* bytes, std::size_t size) {
+        const Clock::time_point start = now();
+        m_downstreamNs = 0;
+        push(bytes, size);
+        processRing();
+        if (m_timed) {
+            const std::uint64_t total = elapsed(start);
+            record(ACCUMULATE, total > m_downstreamNs ? total - m_downstreamNs : 0);
+        }
+
+        // FileUplink runs on its own thread; here it returns buffers at a fixed rate per driver read
+        m_reads++;
+        if (m_drainInterval == 0) {
+            while (m_fileUplinkCount > 0) {
+                fileUplinkReturn();
+            }
+        } else if (m_reads % m_drainInterval == 0 && m_fileUplinkCount > 0) {
+            fileUplinkReturn();
+        }
+    }
+
+    //! Return every buffer FileUplink still holds
+    void drain() {
+        while (m_fileUplinkCount > 0) {
+            fileUplinkReturn();
+        }
+    }
+
+    const BufferPool& pool() const { return m_pool; }
+    const StageTime& time(Stage stage) const { return m_times[stage]; }
+    std::size_t routerAllocations() const { return m_routerAllocations; }
+    std::size_t sequenceNumberWrites() const { return m_sequenceNumberWrites; }
+    std::size_t frames() const { return m_frames; }
+    std::size_t commands() const { return m_commands; }
+    std::size_t fileChunks() const { return m_fileChunks; }
+    std::size_t rejected() const { return m_rejected; }
+    std::size_t ringOverflows() const { return m_ringOverflows; }
+    std::uint32_t opcodeSum() const { return m_opcodeSum; }
+
+  private:
+    Clock::time_point now() const { return m_timed ? Clock::now() : Clock::time_point(); }
+
+    static std::uint64_t elapsed(Clock::time_point start) {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    void record(Stage stage, std::uint64_t ns) {
+        m_times[stage].totalNs += ns;
+        m_times[stage].maxNs = std::max(m_times[stage].maxNs, ns);
+        m_times[stage].calls++;
+    }
+
+    //! Time a downstream stage, keeping it out of the FrameAccumulator figure
+    void finish(Stage stage, Clock::time_point start) {
+        if (m_timed) {
+            const std::uint64_t ns = elapsed(start);
+            record(stage, ns);
+            m_downstreamNs += ns;
+        }
+    }
+
+    std::uint8_t peek(std::size_t offset) const { return m_ring[(m_ringHead + offset) % RING_SIZE]; }
+
+    void rotate(std::size_t count) {
+        m_ringHead = (m_ringHead + count) % RING_SIZE;
+        m_ringCount -= count;
+    }
+
+    // --- FrameAccumulator: ring buffer and TC frame detection ---
+
+    void push(const std::uint8_t* bytes, std::size_t size) {
+        if (size > RING_SIZE - m_ringCount) {
+            m_ringOverflows++;
+            return;
+        }
+        for (std::size_t i = 0; i < size; i++) {
+            m_ring[(m_ringHead + m_ringCount + i) % RING_SIZE] = bytes[i];
+        }
+        m_ringCount += size;
+    }
+
+    void processRing() {
+        while (m_ringCount >= TC_HEADER_SIZE) {
+            // Version 0 and our spacecraft ID, else slide forward a byte
+            const std::uint16_t scid = static_cast<std::uint16_t>(((peek(0) & 0x03) << 8) | peek(1));
+            if ((peek(0) >> 6) != 0 || scid != SPACECRAFT_ID) {
+                rotate(1);
+                continue;
+            }
+            const std::size_t length = static_cast<std::size_t>(((peek(2) & 0x03) << 8) | peek(3)) + 1;
+            if (length < TC_HEADER_SIZE + TC_TRAILER_SIZE || length > TC_MAX_FRAME_SIZE) {
+                rotate(1);
+                continue;
+            }
+            if (m_ringCount < length) {
+                return;
+            }
+            std::uint16_t crc = 0xFFFF;
+            for (std::size_t i = 0; i < length - TC_TRAILER_SIZE; i++) {
+                crc = m_crc.update(crc, peek(i));
+            }
+            const std::uint16_t fecf = static_cast<std::uint16_t>((peek(length - 2) << 8) | peek(length - 1));
+            if (crc != fecf) {
+                rotate(1);
+                continue;
+            }
+
+            // A frame: copy it out of the ring into a pool buffer, or drop it when the pool is empty
+            std::uint8_t* buffer = m_pool.allocate(length);
+            if (buffer != nullptr) {
+                const std::size_t first = std::min(length, RING_SIZE - m_ringHead);
+                std::memcpy(buffer, m_ring.data() + m_ringHead, first);
+                std::memcpy(buffer + first, m_ring.data(), length - first);
+            }
+            rotate(length);
+            if (buffer != nullptr) {
+                m_frames++;
+                tcDeframe(Packet{buffer, length, 0, false});
+            }
+        }
+    }
+
+    // --- TcDeframer: header checks, FECF, strip header and trailer ---
+
+    void tcDeframe(Packet packet) {
+        const Clock::time_point start = now();
+        const std::uint8_t* frame = packet.data;
+        const std::size_t length = static_cast<std::size_t>(((frame[2] & 0x03) << 8) | frame[3]) + 1;
+        const std::uint16_t scid = static_cast<std::uint16_t>(((frame[0] & 0x03) << 8) | frame[1]);
+        const std::uint8_t vcid = static_cast<std::uint8_t>(frame[2] >> 2);
+        const std::uint16_t fecf = static_cast<std::uint16_t>((frame[length - 2] << 8) | frame[length - 1]);
+        if (length != packet.size || scid != SPACECRAFT_ID || vcid != VC_ID ||
+            m_crc.compute(frame, length - TC_TRAILER_SIZE) != fecf) {
+            finish(TC_DEFRAME, start);
+            m_pool.deallocate(packet.data);
+            return;
+        }
+        packet.data += TC_HEADER_SIZE;
+        packet.size -= TC_HEADER_SIZE + TC_TRAILER_SIZE;
+        finish(TC_DEFRAME, start);
+        securityDeframe(packet);
+    }
+
+    // --- TcSecurityDeframer: parse, verifyFrame and strip, as dataIn_handler does ---
+
+    void securityDeframe(Packet packet) {
+        const Clock::time_point start = now();
+        const Ccsds355_0_B_2::TcTransferFrame::Parser::Result parseResult =
+            Ccsds355_0_B_2::parse(packet.data, packet.size);
+        if (parseResult.status != Ccsds355_0_B_2::TcTransferFrame::Parser::Status::Ok) {
+            finish(SECURITY, start);
+            m_pool.deallocate(packet.data);
+            return;
+        }
+
+        const FrameVerifier::Result result = verifyFrame(packet.data, packet.size, parseResult, m_replayWindow,
+                                                         SEQ_NUM_WINDOW, m_sequenceNumberMark, SEQ_NUM_RESERVATION,
+                                                         m_midstate);
+        if (result.status == FrameVerifier::Status::Accepted) {
+            if (result.reserve) {
+                // The file write itself is not modelled
+                m_sequenceNumberMark = result.mark;
+                m_sequenceNumberWrites++;
+            }
+            packet.authenticated = true;
+        }
+
+        packet.data += Ccsds355_0_B_2::kTCSecurityHeaderSize;
+        packet.size -= Ccsds355_0_B_2::kTCSecurityHeaderSize + Ccsds355_0_B_2::kTCSecurityTrailer;
+        finish(SECURITY, start);
+        spacePacketDeframe(packet);
+    }
+
+    // --- SpacePacketDeframer: header checks, APID into the context, strip header ---
+
+    void spacePacketDeframe(Packet packet) {
+        const Clock::time_point start = now();
+        if (packet.size < SPACE_PACKET_HEADER_SIZE) {
+            finish(SPACE_PACKET, start);
+            m_pool.deallocate(packet.data);
+            return;
+        }
+        const std::uint8_t* header = packet.data;
+        const std::size_t dataLength = static_cast<std::size_t>((header[4] << 8) | header[5]) + 1;
+        if (dataLength > packet.size - SPACE_PACKET_HEADER_SIZE) {
+            finish(SPACE_PACKET, start);
+            m_pool.deallocate(packet.data);
+            return;
+        }
+        packet.apid = static_cast<std::uint16_t>(((header[0] & 0x07) << 8) | header[1]);
+        packet.data += SPACE_PACKET_HEADER_SIZE;
+        packet.size = dataLength;
+        finish(SPACE_PACKET, start);
+        route(packet);
+    }
+
+    // --- ProvesRouter: admitPacket, then the APID routing of dataIn_handler ---
+
+    void route(Packet packet) {
+        Clock::time_point start = now();
+        if (PacketBypasser::admitPacket(packet.data, packet.size, packet.authenticated, false) ==
+            PacketBypasser::Admission::Rejected) {
+            m_rejected++;
+            finish(ROUTE, start);
+            m_pool.deallocate(packet.data);
+            return;
+        }
+
+        if (packet.apid == APID_COMMAND) {
+            // Fw::ComBuffer on the stack
+            std::array<std::uint8_t, COM_BUFFER_SIZE> com;
+            const std::size_t size = std::min(packet.size, com.size());
+            std::memcpy(com.data(), packet.data, size);
+            finish(ROUTE, start);
+            dispatch(com.data(), size);
+            m_pool.deallocate(packet.data);
+            return;
+        }
+
+        if (packet.apid == APID_FILE) {
+            if (PacketHandoff::claim(m_handoffs, POOL_BUFFERS, packet.data, packet.size) != PacketHandoff::kNoSlot) {
+                finish(ROUTE, start);
+                fileUplinkReceive(packet);
+                return;
+            }
+            // Copy fallback when every slot is lent out
+            m_routerAllocations++;
+        }
+        finish(ROUTE, start);
+        m_pool.deallocate(packet.data);
+    }
+
+    // --- CmdDispatcher: ComBuffer through the async queue, then opcode lookup ---
+
+    void dispatch(const std::uint8_t* com, std::size_t size) {
+        const Clock::time_point start = now();
+        std::array<std::uint8_t, COM_BUFFER_SIZE>& slot = m_cmdQueue[m_commands % CMD_QUEUE_DEPTH];
+        std::memcpy(slot.data(), com, size);
+        std::array<std::uint8_t, COM_BUFFER_SIZE> received;
+        std::memcpy(received.data(), slot.data(), size);
+        const std::uint32_t opcode = (static_cast<std::uint32_t>(received[2]) << 24) |
+                                     (static_cast<std::uint32_t>(received[3]) << 16) |
+                                     (static_cast<std::uint32_t>(received[4]) << 8) | received[5];
+        m_opcodeSum += opcode;
+        m_commands++;
+        finish(DISPATCH, start);
+    }
+
+    // --- FileUplink: holds lent buffers until its thread is done with them ---
+
+    void fileUplinkReceive(const Packet& packet) {
+        m_fileUplink[(m_fileUplinkHead + m_fileUplinkCount) % POOL_BUFFERS] = packet;
+        m_fileUplinkCount++;
+        m_fileChunks++;
+    }
+
+    //! ProvesRouter::fileBufferReturnIn_handler, then deallocation at the top of the dataReturnOut chain
+    void fileUplinkReturn() {
+        const Packet& packet = m_fileUplink[m_fileUplinkHead];
+        m_fileUplinkHead = (m_fileUplinkHead + 1) % POOL_BUFFERS;
+        m_fileUplinkCount--;
+        std::size_t size = 0;
+        PacketHandoff::release(m_handoffs, POOL_BUFFERS, packet.data, size);
+        m_pool.deallocate(packet.data);
+    }
+
+    const HmacSha256::Midstate& m_midstate;
+    const Crc16& m_crc;
+    const bool m_timed;
+    const std::size_t m_drainInterval;
+
+    BufferPool m_pool;
+    std::array<std::uint8_t, RING_SIZE> m_ring;
+    std::size_t m_ringHead;
+    std::size_t m_ringCount;
+
+    PacketValidator::ReplayWindow m_replayWindow;
+    std::uint32_t m_sequenceNumberMark;
+
+    PacketHandoff::Slot m_handoffs[POOL_BUFFERS];
+    std::array<Packet, POOL_BUFFERS> m_fileUplink;
+    std::size_t m_fileUplinkHead;
+    std::size_t m_fileUplinkCount;
+    std::array<std::array<std::uint8_t, COM_BUFFER_SIZE>, CMD_QUEUE_DEPTH> m_cmdQueue;
+
+    std::size_t m_reads;
+    std::uint64_t m_downstreamNs;
+    std::size_t m_routerAllocations;
+    std::size_t m_sequenceNumberWrites;
+    std::size_t m_frames;
+    std::size_t m_commands;
+    std::size_t m_fileChunks;
+    std::size_t m_rejected;
+    std::size_t m_ringOverflows;
+    std::uint32_t m_opcodeSum;
+    std::array<StageTime, STAGES> m_times;
+};
+
+// ----------------------------------------------------------------------
+// Scenarios
+// ----------------------------------------------------------------------
+
+enum class Traffic { COMMANDS, FILE };
+
+struct Scenario {
+    const char* name;
+    Traffic traffic;
+    std::size_t frames;         //!< Frames sent
+    std::size_t payloadSize;    //!< Command argument or file chunk bytes
+    std::size_t readSize;       //!< Bytes per driver read
+    std::size_t drainInterval;  //!< Driver reads per buffer FileUplink returns, 0 to keep up
+    std::size_t forgedEvery;    //!< Every nth frame carries a bad MAC, 0 for none
+};
+
+struct RunResult {
+    double seconds;
+    std::size_t heapAllocations;
+};
+
+RunResult run(Pipeline& pipeline, const std::vector<std::uint8_t>& stream, std::size_t readSize) {
+    const std::size_t heapBefore = g_heapAllocations;
+    const Clock::time_point begin = Clock::now();
+    for (std::size_t offset = 0; offset < stream.size(); offset += readSize) {
+        pipeline.read(stream.data() + offset, std::min(readSize, stream.size() - offset));
+    }
+    pipeline.drain();
+    const Clock::time_point end = Clock::now();
+    return {std::chrono::duration<double>(end - begin).count(), g_heapAllocations - heapBefore};
+}
+
+bool report(const Scenario& scenario, const HmacSha256::Midstate& midstate, const Crc16& crc) {
+    std::vector<std::uint8_t> stream;
+    Ground ground(midstate, crc);
+    for (std::size_t i = 0; i < scenario.frames; i++) {
+        if (scenario.traffic == Traffic::COMMANDS) {
+            const bool forged = scenario.forgedEvery != 0 && (i % scenario.forgedEvery) == scenario.forgedEvery - 1;
+            // CmdDispatcher opcodes past CMD_NO_OP, so forged frames are not let through by the bypass allowlist
+            ground.command(stream, 0x01000001u + static_cast<std::uint32_t>(i % 6), scenario.payloadSize, forged);
+        } else {
+            ground.fileChunk(stream, static_cast<std::uint32_t>(i * scenario.payloadSize), scenario.payloadSize);
+        }
+    }
+
+    // Untimed for sustained throughput, then timed per stage
+    Pipeline sustained(midstate, crc, false, scenario.drainInterval);
+    const RunResult throughput = run(sustained, stream, scenario.readSize);
+    Pipeline staged(midstate, crc, true, scenario.drainInterval);
+    const RunResult timed = run(staged, stream, scenario.readSize);
+
+    const double frames = static_cast<double>(sustained.frames());
+    std::printf("\n== %s: %zu frames of %zu bytes, %zu byte reads\n", scenario.name, scenario.frames,
+                stream.size() / scenario.frames, scenario.readSize);
+    std::printf("  sustained        %12.0f frames/s delivered, %.2f Mbit/s offered\n", frames / throughput.seconds,
+                8.0 * static_cast<double>(stream.size()) / throughput.seconds / 1e6);
+    std::printf("  delivered        %12zu frames  (%zu commands, %zu file chunks, %zu rejected)\n", sustained.frames(),
+                sustained.commands(), sustained.fileChunks(), sustained.rejected());
+    std::printf("  dropped          %12zu no buffer, %zu ring overflow\n", sustained.pool().failures(),
+                sustained.ringOverflows());
+    std::printf("  pool allocations %12.2f per frame, peak %zu of %zu buffers\n",
+                static_cast<double>(sustained.pool().allocations()) / frames, sustained.pool().peak(), POOL_BUFFERS);
+    std::printf("  router copies    %12zu\n", sustained.routerAllocations());
+    std::printf("  seq num writes   %12zu\n", sustained.sequenceNumberWrites());
+    std::printf("  heap allocations %12zu\n", throughput.heapAllocations + timed.heapAllocations);
+    std::printf("  %-20s %10s %10s  (FrameAccumulator per driver read, others per frame)\n", "stage", "mean ns",
+                "max ns");
+    for (int stage = 0; stage < STAGES; stage++) {
+        const StageTime& time = staged.time(static_cast<Stage>(stage));
+        const double mean = time.calls == 0 ? 0.0 : static_cast<double>(time.totalNs) / time.calls;
+        std::printf("  %-20s %10.0f %10llu\n", STAGE_NAMES[stage], mean,
+                    static_cast<unsigned long long>(time.maxNs));
+    }
+
+    // Every pool buffer must be back once FileUplink has drained
+    if (sustained.pool().inUse() != 0 || staged.pool().inUse() != 0) {
+        std::printf("buffer leak: %zu and %zu still allocated\n", sustained.pool().inUse(), staged.pool().inUse());
+        return false;
+    }
+    return sustained.opcodeSum() == staged.opcodeSum();
+}
+
+}  // namespace
+
+int main() {
+    std::uint8_t key[Ccsds355_0_B_2::kTCSecurityTrailer];
+    if (!parseKey(AUTH_KEY, key)) {
+        std::printf("key parse failed\n");
+        return 1;
+    }
+    HmacSha256::Midstate midstate;
+    HmacSha256::precompute(key, sizeof(key), midstate);
+    const Crc16 crc;
+
+    const Scenario scenarios[] = {
+        {"commands", Traffic::COMMANDS, 100000, 8, 64, 0, 0},
+        {"commands, 1 in 4 forged", Traffic::COMMANDS, 100000, 8, 64, 0, 4},
+        {"file uplink", Traffic::FILE, 50000, 512, 64, 0, 0},
+        {"file uplink, FileUplink lagging", Traffic::FILE, 50000, 512, 64, 12, 0},
+    };
+
+    std::printf("ComCcsds uplink chain, %zu pool buffers of %zu bytes\n", POOL_BUFFERS, POOL_BUFFER_SIZE);
+    for (const Scenario& scenario : scenarios) {
+        if (!report(scenario, midstate, crc)) {
+            return 1;
+        }
+    }
+    return 0;
+}
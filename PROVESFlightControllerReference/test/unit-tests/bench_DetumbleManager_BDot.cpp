@@ -0,0 +1,190 @@
+// ======================================================================
+// \title  bench_DetumbleManager_BDot.cpp
+// \brief  Compares B-Dot derivative methods on jittered, noisy magnetometer traces
+// ======================================================================
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "PROVESFlightControllerReference/Components/DetumbleManager/BDot.hpp"
+
+using Components::BDot;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr long long SAMPLING_PERIOD_USECONDS = 20000;  // 50Hz rate group
+constexpr std::size_t WINDOWS = 20000;
+constexpr double FIELD_GAUSS = 0.3;  // Typical LEO field strength
+
+struct Trace {
+    const char* name;
+    double rate_deg_s;        //!< Tumble rate
+    double jitter_ms;         //!< Half width of the uniform sampling jitter
+    double noise_milligauss;  //!< Standard deviation of the magnetometer noise
+};
+
+//! Small deterministic generator so runs are repeatable
+class Random {
+  public:
+    double uniform() {
+        m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(m_state >> 11) / 9007199254740992.0;
+    }
+
+    double gaussian() {
+        double u1 = this->uniform() + 1e-300;
+        double u2 = this->uniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * PI * u2);
+    }
+
+  private:
+    std::uint64_t m_state = 88172645463325252ULL;
+};
+
+//! Body frame field of a spacecraft tumbling about Z through a field tilted from the spin axis
+std::array<double, 3> field(double rate_rad_s, double t_seconds) {
+    double angle = rate_rad_s * t_seconds;
+    return {FIELD_GAUSS * std::cos(angle), -FIELD_GAUSS * std::sin(angle), 0.4 * FIELD_GAUSS};
+}
+
+std::array<double, 3> fieldDerivative(double rate_rad_s, double t_seconds) {
+    double angle = rate_rad_s * t_seconds;
+    return {-FIELD_GAUSS * rate_rad_s * std::sin(angle), -FIELD_GAUSS * rate_rad_s * std::cos(angle), 0.0};
+}
+
+struct MethodResult {
+    double rms_error;  //!< RMS vector error in G/s
+    double max_error;  //!< Largest vector error in G/s
+};
+
+struct TraceResult {
+    MethodResult stencil;
+    MethodResult least_squares;
+    double true_rms;  //!< RMS magnitude of the true derivative in G/s
+};
+
+TraceResult replay(const Trace& trace) {
+    const double rate_rad_s = trace.rate_deg_s * PI / 180.0;
+    Random random;
+
+    BDot stencil;
+    BDot least_squares;
+    // Negative unit gain so the dipole equals Ḃ
+    stencil.configure(-1.0, std::chrono::microseconds(SAMPLING_PERIOD_USECONDS));
+    least_squares.configure(-1.0, std::chrono::microseconds(SAMPLING_PERIOD_USECONDS));
+    least_squares.setDerivativeMethod(BDot::DerivativeMethod::LEAST_SQUARES);
+
+    double stencil_sum = 0.0;
+    double least_squares_sum = 0.0;
+    double true_sum = 0.0;
+    TraceResult result = {};
+
+    for (std::size_t window = 0; window < WINDOWS; window++) {
+        stencil.emptySampleSet();
+        least_squares.emptySampleSet();
+
+        // Start each window at a random point in the tumble
+        double start_seconds = random.uniform() * 3600.0;
+        double mean_seconds = 0.0;
+        for (std::size_t i = 0; i < BDot::SAMPLING_SET_SIZE; i++) {
+            double jitter_seconds = (2.0 * random.uniform() - 1.0) * trace.jitter_ms / 1000.0;
+            double t_seconds =
+                start_seconds + static_cast<double>(i) * SAMPLING_PERIOD_USECONDS / 1e6 + jitter_seconds;
+            mean_seconds += t_seconds;
+
+            std::array<double, 3> sample = field(rate_rad_s, t_seconds);
+            for (double& axis : sample) {
+                axis += random.gaussian() * trace.noise_milligauss / 1000.0;
+            }
+
+            std::chrono::microseconds timestamp(static_cast<long long>(std::llround(t_seconds * 1e6)));
+            stencil.addSample(sample, timestamp);
+            least_squares.addSample(sample, timestamp);
+        }
+        mean_seconds /= static_cast<double>(BDot::SAMPLING_SET_SIZE);
+
+        // Both estimates are compared with the true derivative at the mean sample time
+        std::array<double, 3> truth = fieldDerivative(rate_rad_s, mean_seconds);
+        std::array<double, 3> stencil_estimate = stencil.getMagneticMoment();
+        std::array<double, 3> least_squares_estimate = least_squares.getMagneticMoment();
+
+        double stencil_error = 0.0;
+        double least_squares_error = 0.0;
+        for (std::size_t axis = 0; axis < 3; axis++) {
+            stencil_error += (stencil_estimate[axis] - truth[axis]) * (stencil_estimate[axis] - truth[axis]);
+            least_squares_error +=
+                (least_squares_estimate[axis] - truth[axis]) * (least_squares_estimate[axis] - truth[axis]);
+            true_sum += truth[axis] * truth[axis];
+        }
+        stencil_sum += stencil_error;
+        least_squares_sum += least_squares_error;
+        result.stencil.max_error = std::fmax(result.stencil.max_error, std::sqrt(stencil_error));
+        result.least_squares.max_error = std::fmax(result.least_squares.max_error, std::sqrt(least_squares_error));
+    }
+
+    result.stencil.rms_error = std::sqrt(stencil_sum / WINDOWS);
+    result.least_squares.rms_error = std::sqrt(least_squares_sum / WINDOWS);
+    result.true_rms = std::sqrt(true_sum / WINDOWS);
+    return result;
+}
+
+//! Cost of one streaming sample and derivative in nanoseconds
+double derivativeNanoseconds(BDot::DerivativeMethod method) {
+    BDot bdot;
+    bdot.configure(1.0, std::chrono::microseconds(SAMPLING_PERIOD_USECONDS));
+    bdot.setSamplingMode(BDot::SamplingMode::STREAMING);
+    bdot.setDerivativeMethod(method);
+
+    constexpr std::size_t ITERATIONS = 5000000;
+    double checksum = 0.0;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; i++) {
+        double value = static_cast<double>(i % 89);
+        long long jitter = static_cast<long long>(i % 7) * 500;
+        bdot.addSample({value, -value, 0.5 * value},
+                       std::chrono::microseconds(static_cast<long long>(i) * SAMPLING_PERIOD_USECONDS + jitter));
+        checksum += bdot.getMagneticMoment()[0];
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Keep the loop observable so it is not optimized away
+    if (checksum == 0.0) {
+        std::printf("checksum %f\n", checksum);
+    }
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(ITERATIONS);
+}
+
+}  // namespace
+
+int main() {
+    const Trace traces[] = {
+        {"ideal 30deg/s", 30.0, 0.0, 0.0},
+        {"jitter 2ms", 30.0, 2.0, 0.0},
+        {"jitter 5ms", 30.0, 5.0, 0.0},
+        {"noise 2mG", 30.0, 0.0, 2.0},
+        {"jitter 5ms + noise", 30.0, 5.0, 2.0},
+        {"slow 5deg/s + all", 5.0, 5.0, 2.0},
+        {"fast 180deg/s + all", 180.0, 5.0, 2.0},
+    };
+
+    std::printf("B-Dot derivative replay: %zu-point windows at 50Hz, %zu windows per trace, errors in mG/s\n",
+                BDot::SAMPLING_SET_SIZE, WINDOWS);
+    std::printf("%-22s %10s %12s %12s %12s %12s\n", "trace", "true rms", "stencil rms", "stencil max", "lsq rms",
+                "lsq max");
+    for (const Trace& trace : traces) {
+        TraceResult r = replay(trace);
+        std::printf("%-22s %10.2f %12.3f %12.3f %12.3f %12.3f\n", trace.name, r.true_rms * 1000.0,
+                    r.stencil.rms_error * 1000.0, r.stencil.max_error * 1000.0, r.least_squares.rms_error * 1000.0,
+                    r.least_squares.max_error * 1000.0);
+    }
+
+    std::printf("central difference: %.1f ns per sample\n",
+                derivativeNanoseconds(BDot::DerivativeMethod::CENTRAL_DIFFERENCE));
+    std::printf("least squares:      %.1f ns per sample\n",
+                derivativeNanoseconds(BDot::DerivativeMethod::LEAST_SQUARES));
+    return 0;
+}
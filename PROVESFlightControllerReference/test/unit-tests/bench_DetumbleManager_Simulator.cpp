@@ -0,0 +1,565 @@
+// ======================================================================
+// \title  bench_DetumbleManager_Simulator.cpp
+// \brief  Closed-loop detumble simulation comparing DetumbleManager parameter sets
+// ======================================================================
+//
+// A rigid-body spacecraft in a 420 km, 51.6° circular orbit tumbles through a tilted dipole geomagnetic field.
+// IMU and DRV2605 stand-ins feed the DetumbleController AUTO state machine that DetumbleManager runs, through
+// the real MagnetorquerArray, at 50Hz simulated time. Each scenario reports the time to detumble, the coil energy
+// spent and the CPU time of the control step.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "PROVESFlightControllerReference/Components/DetumbleManager/BDot.hpp"
+#include "PROVESFlightControllerReference/Components/DetumbleManager/DetumbleController.hpp"
+#include "PROVESFlightControllerReference/Components/DetumbleManager/Magnetorquer.hpp"
+#include "PROVESFlightControllerReference/Components/DetumbleManager/MagnetorquerArray.hpp"
+
+using Components::BDot;
+using Components::DetumbleController;
+using Components::Magnetorquer;
+using Components::MagnetorquerArray;
+
+namespace {
+
+using Vector3 = std::array<double, 3>;
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double DEG_TO_RAD = PI / 180.0;
+constexpr double RAD_TO_DEG = 180.0 / PI;
+
+constexpr std::int64_t TICK_USECONDS = 20000;                       // 50Hz rate group
+constexpr std::int64_t EPOCH_USECONDS = 1700000000000000LL;         // Non-zero start so ZERO_TIME checks behave
+constexpr std::int64_t MAX_DURATION_USECONDS = 3LL * 3600000000LL;  // Give up after three hours
+constexpr int SUBSTEPS = 2;                                         // RK4 steps per rate group tick
+
+constexpr double EARTH_RADIUS_M = 6371.2e3;
+constexpr double EARTH_MU = 3.986004418e14;
+constexpr double ORBIT_ALTITUDE_M = 420e3;
+constexpr double ORBIT_INCLINATION_RAD = 51.6 * DEG_TO_RAD;
+constexpr double DIPOLE_EQUATOR_GAUSS = 0.3012;  // IGRF g10 at the Earth's surface
+constexpr double DIPOLE_TILT_RAD = 9.4 * DEG_TO_RAD;
+constexpr double GAUSS_TO_TESLA = 1e-4;
+
+// ----------------------------------------------------------------------
+//  Vector and quaternion helpers
+// ----------------------------------------------------------------------
+
+Vector3 add(const Vector3& a, const Vector3& b) {
+    return {a[0] + b[0], a[1] + b[1], a[2] + b[2]};
+}
+
+Vector3 scale(const Vector3& a, double s) {
+    return {a[0] * s, a[1] * s, a[2] * s};
+}
+
+double dot(const Vector3& a, const Vector3& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vector3 cross(const Vector3& a, const Vector3& b) {
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+double norm(const Vector3& a) {
+    return std::sqrt(dot(a, a));
+}
+
+//! Unit quaternion (w, x, y, z) rotating body vectors into the inertial frame
+struct Quaternion {
+    double w = 1.0;
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+
+    //! Rotate an inertial vector into the body frame
+    Vector3 toBody(const Vector3& v) const {
+        Vector3 u = {-x, -y, -z};
+        Vector3 t = scale(cross(u, v), 2.0);
+        return add(add(v, scale(t, w)), cross(u, t));
+    }
+
+    //! Time derivative for body rate omega
+    Quaternion derivative(const Vector3& omega) const {
+        Quaternion d;
+        d.w = 0.5 * (-x * omega[0] - y * omega[1] - z * omega[2]);
+        d.x = 0.5 * (w * omega[0] + y * omega[2] - z * omega[1]);
+        d.y = 0.5 * (w * omega[1] + z * omega[0] - x * omega[2]);
+        d.z = 0.5 * (w * omega[2] + x * omega[1] - y * omega[0]);
+        return d;
+    }
+
+    Quaternion plus(const Quaternion& d, double h) const {
+        Quaternion q;
+        q.w = w + d.w * h;
+        q.x = x + d.x * h;
+        q.y = y + d.y * h;
+        q.z = z + d.z * h;
+        return q;
+    }
+
+    void normalize() {
+        double n = std::sqrt(w * w + x * x + y * y + z * z);
+        w /= n;
+        x /= n;
+        y /= n;
+        z /= n;
+    }
+};
+
+//! Small deterministic generator so runs are repeatable
+class Random {
+  public:
+    explicit Random(std::uint64_t seed) : m_state(seed * 2862933555777941757ULL + 3037000493ULL) {}
+
+    double uniform(double low, double high) {
+        m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return low + (high - low) * static_cast<double>(m_state >> 11) / 9007199254740992.0;
+    }
+
+    double gaussian() {
+        double u1 = this->uniform(1e-300, 1.0);
+        double u2 = this->uniform(0.0, 1.0);
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * PI * u2);
+    }
+
+  private:
+    std::uint64_t m_state;
+};
+
+// ----------------------------------------------------------------------
+//  Environment and spacecraft
+// ----------------------------------------------------------------------
+
+//! Circular orbit through a tilted dipole field, both in an Earth-centred inertial frame
+class Environment {
+  public:
+    explicit Environment(double orbit_offset_seconds) : m_orbit_offset_seconds(orbit_offset_seconds) {}
+
+    //! Geomagnetic field in gauss at simulation time t
+    Vector3 field(double t_seconds) const {
+        t_seconds += m_orbit_offset_seconds;
+        const double radius = EARTH_RADIUS_M + ORBIT_ALTITUDE_M;
+        const double mean_motion = std::sqrt(EARTH_MU / (radius * radius * radius));
+        double u = mean_motion * t_seconds;
+        Vector3 r_hat = {std::cos(u), std::sin(u) * std::cos(ORBIT_INCLINATION_RAD),
+                         std::sin(u) * std::sin(ORBIT_INCLINATION_RAD)};
+
+        // The dipole axis sweeps around the spin axis once per sidereal day
+        double longitude = 7.2921159e-5 * t_seconds;
+        Vector3 m_hat = {std::sin(DIPOLE_TILT_RAD) * std::cos(longitude),
+                         std::sin(DIPOLE_TILT_RAD) * std::sin(longitude), -std::cos(DIPOLE_TILT_RAD)};
+
+        double ratio = EARTH_RADIUS_M / radius;
+        double strength = DIPOLE_EQUATOR_GAUSS * ratio * ratio * ratio;
+        return scale(add(scale(r_hat, 3.0 * dot(m_hat, r_hat)), scale(m_hat, -1.0)), strength);
+    }
+
+  private:
+    double m_orbit_offset_seconds;  //!< Position along the orbit at the start of the run
+};
+
+//! Rigid 1U spacecraft attitude and rate, integrated with RK4
+class Spacecraft {
+  public:
+    Vector3 m_inertia = {0.0021, 0.0022, 0.0018};  //!< Principal moments of inertia in kg·m²
+    Vector3 m_omega = {0.0, 0.0, 0.0};             //!< Body rate in rad/s
+    Quaternion m_attitude;                         //!< Body to inertial rotation
+
+    //! Advance by h seconds with a constant body dipole through the field at the start of the step
+    void step(const Environment& environment, double t_seconds, double h, const Vector3& dipole) {
+        Vector3 field_eci = scale(environment.field(t_seconds + 0.5 * h), GAUSS_TO_TESLA);
+
+        auto omega_dot = [&](const Quaternion& q, const Vector3& w) {
+            Vector3 torque = cross(dipole, q.toBody(field_eci));
+            Vector3 h_body = {m_inertia[0] * w[0], m_inertia[1] * w[1], m_inertia[2] * w[2]};
+            Vector3 net = add(torque, scale(cross(w, h_body), -1.0));
+            return Vector3{net[0] / m_inertia[0], net[1] / m_inertia[1], net[2] / m_inertia[2]};
+        };
+
+        Quaternion q1 = m_attitude;
+        Vector3 w1 = m_omega;
+        Quaternion dq1 = q1.derivative(w1);
+        Vector3 dw1 = omega_dot(q1, w1);
+
+        Quaternion q2 = m_attitude.plus(dq1, 0.5 * h);
+        Vector3 w2 = add(m_omega, scale(dw1, 0.5 * h));
+        Quaternion dq2 = q2.derivative(w2);
+        Vector3 dw2 = omega_dot(q2, w2);
+
+        Quaternion q3 = m_attitude.plus(dq2, 0.5 * h);
+        Vector3 w3 = add(m_omega, scale(dw2, 0.5 * h));
+        Quaternion dq3 = q3.derivative(w3);
+        Vector3 dw3 = omega_dot(q3, w3);
+
+        Quaternion q4 = m_attitude.plus(dq3, h);
+        Vector3 w4 = add(m_omega, scale(dw3, h));
+        Quaternion dq4 = q4.derivative(w4);
+        Vector3 dw4 = omega_dot(q4, w4);
+
+        for (std::size_t axis = 0; axis < 3; axis++) {
+            m_omega[axis] += h / 6.0 * (dw1[axis] + 2.0 * dw2[axis] + 2.0 * dw3[axis] + dw4[axis]);
+        }
+        m_attitude.w += h / 6.0 * (dq1.w + 2.0 * dq2.w + 2.0 * dq3.w + dq4.w);
+        m_attitude.x += h / 6.0 * (dq1.x + 2.0 * dq2.x + 2.0 * dq3.x + dq4.x);
+        m_attitude.y += h / 6.0 * (dq1.y + 2.0 * dq2.y + 2.0 * dq3.y + dq4.y);
+        m_attitude.z += h / 6.0 * (dq1.z + 2.0 * dq2.z + 2.0 * dq3.z + dq4.z);
+        m_attitude.normalize();
+    }
+};
+
+// ----------------------------------------------------------------------
+//  Hardware stand-ins
+// ----------------------------------------------------------------------
+
+//! LSM6DSO gyroscope and LIS2MDL magnetometer as seen through ImuManager
+class ImuStandIn {
+  public:
+    static constexpr double GYRO_NOISE_DEG_S = 0.1;              //!< Gyroscope noise standard deviation
+    static constexpr std::int64_t READ_LATENCY_USECONDS = 2000;  //!< Largest I2C read latency
+
+    ImuStandIn(const Environment& environment,
+               const Spacecraft& spacecraft,
+               Random& random,
+               double magnetometer_noise_gauss)
+        : m_environment(environment),
+          m_spacecraft(spacecraft),
+          m_random(random),
+          m_magnetometer_noise_gauss(magnetometer_noise_gauss) {}
+
+    //! angularVelocityMagnitudeGet in deg/s
+    double angularVelocityMagnitude() {
+        Vector3 measured = m_spacecraft.m_omega;
+        for (double& axis : measured) {
+            axis += m_random.gaussian() * GYRO_NOISE_DEG_S * DEG_TO_RAD;
+        }
+        return norm(measured) * RAD_TO_DEG;
+    }
+
+    //! magneticFieldGet, with the timestamp of the moment the sample was taken
+    Vector3 magneticField(std::int64_t now_useconds, std::int64_t& timestamp_useconds) {
+        timestamp_useconds = now_useconds + static_cast<std::int64_t>(m_random.uniform(0.0, READ_LATENCY_USECONDS));
+        double t_seconds = static_cast<double>(timestamp_useconds - EPOCH_USECONDS) / 1e6;
+        Vector3 measured = m_spacecraft.m_attitude.toBody(m_environment.field(t_seconds));
+        for (double& axis : measured) {
+            axis += m_random.gaussian() * m_magnetometer_noise_gauss;
+        }
+        return measured;
+    }
+
+    //! magneticFieldSamplingPeriodGet for the default 100Hz LIS2MDL output data rate
+    std::int64_t magneticFieldSamplingPeriodUseconds() const { return 10000; }
+
+  private:
+    const Environment& m_environment;
+    const Spacecraft& m_spacecraft;
+    Random& m_random;
+    double m_magnetometer_noise_gauss;  //!< Magnetometer noise standard deviation
+};
+
+//! Five DRV2605 coil drivers, turning drive levels into a body dipole and tracking coil energy
+class CoilDriverStandIn {
+  public:
+    explicit CoilDriverStandIn(const std::array<Magnetorquer, MagnetorquerArray::COIL_COUNT>& coils)
+        : m_coils(coils) {}
+
+    void start(const std::array<std::int8_t, MagnetorquerArray::COIL_COUNT>& levels) { m_levels = levels; }
+
+    void stop() { m_levels = {}; }
+
+    //! Body dipole in A·m² produced by the current drive levels
+    Vector3 dipole() const {
+        static constexpr std::size_t AXIS[MagnetorquerArray::COIL_COUNT] = {0, 0, 1, 1, 2};
+        Vector3 dipole = {0.0, 0.0, 0.0};
+        for (std::size_t coil = 0; coil < MagnetorquerArray::COIL_COUNT; coil++) {
+            const Magnetorquer& m = m_coils[coil];
+            double current = static_cast<double>(m_levels[coil]) / 127.0 * m.m_voltage / m.m_resistance;
+            dipole[AXIS[coil]] += static_cast<double>(m.m_direction_sign) * m.m_turns * area(m) * current;
+        }
+        return dipole;
+    }
+
+    //! Accumulate I²R losses over h seconds
+    void accumulateEnergy(double h) {
+        for (std::size_t coil = 0; coil < MagnetorquerArray::COIL_COUNT; coil++) {
+            const Magnetorquer& m = m_coils[coil];
+            double voltage = static_cast<double>(m_levels[coil]) / 127.0 * m.m_voltage;
+            m_energy_joules += voltage * voltage / m.m_resistance * h;
+        }
+    }
+
+    double energyJoules() const { return m_energy_joules; }
+
+  private:
+    static double area(const Magnetorquer& m) {
+        if (m.m_shape == Magnetorquer::CoilShape::CIRCULAR) {
+            return PI * m.m_diameter * m.m_diameter / 4.0;
+        }
+        return m.m_width * m.m_length;
+    }
+
+    const std::array<Magnetorquer, MagnetorquerArray::COIL_COUNT>& m_coils;
+    std::array<std::int8_t, MagnetorquerArray::COIL_COUNT> m_levels{};
+    double m_energy_joules = 0.0;
+};
+
+//! DetumbleManager parameter defaults from DetumbleManager.fpp
+struct Parameters {
+    double gain = 3.0;
+    std::int64_t torque_duration_useconds = 320000;
+    std::int64_t cooldown_duration_useconds = 20000;
+    double bdot_max_threshold = 720.0;
+    double deadband_upper_threshold = 8.0;
+    double deadband_lower_threshold = 5.0;
+    bool continuous = false;
+    bool least_squares = false;
+};
+
+//! Coil parameter defaults from DetumbleManager.fpp
+std::array<Magnetorquer, MagnetorquerArray::COIL_COUNT> defaultCoils() {
+    std::array<Magnetorquer, MagnetorquerArray::COIL_COUNT> coils{};
+    const Magnetorquer::DirectionSign signs[] = {Magnetorquer::POSITIVE, Magnetorquer::NEGATIVE,
+                                                 Magnetorquer::POSITIVE, Magnetorquer::NEGATIVE};
+    for (std::size_t coil = 0; coil < 4; coil++) {
+        coils[coil].m_shape = Magnetorquer::CoilShape::RECTANGULAR;
+        coils[coil].m_turns = 96.0;
+        coils[coil].m_voltage = 3.3;
+        coils[coil].m_resistance = 13.0;
+        coils[coil].m_length = 0.053;
+        coils[coil].m_width = 0.045;
+        coils[coil].m_direction_sign = signs[coil];
+    }
+    Magnetorquer& z_minus = coils[MagnetorquerArray::Z_MINUS];
+    z_minus.m_shape = Magnetorquer::CoilShape::CIRCULAR;
+    z_minus.m_turns = 153.0;
+    z_minus.m_voltage = 3.3;
+    z_minus.m_resistance = 150.7;
+    z_minus.m_diameter = 0.05755;
+    z_minus.m_direction_sign = Magnetorquer::NEGATIVE;
+    return coils;
+}
+
+// ----------------------------------------------------------------------
+//  DetumbleManager AUTO mode
+// ----------------------------------------------------------------------
+
+//! DetumbleManager's side of DetumbleController, with ports, parameters and time replaced by the stand-ins
+class DetumbleIo : public DetumbleController::Io {
+  public:
+    DetumbleIo(const Parameters& parameters,
+               const std::array<Magnetorquer, MagnetorquerArray::COIL_COUNT>& coils,
+               ImuStandIn& imu,
+               CoilDriverStandIn& coil_driver)
+        : m_parameters(parameters), m_imu(imu), m_coil_driver(coil_driver) {
+        for (std::size_t coil = 0; coil < MagnetorquerArray::COIL_COUNT; coil++) {
+            const std::size_t axis = (coil < 2) ? 0 : ((coil < 4) ? 1 : 2);
+            m_magnetorquer_array.configure(static_cast<MagnetorquerArray::Coil>(coil), axis, coils[coil]);
+        }
+    }
+
+    //! Advance simulated time to the next run
+    void setTime(std::int64_t now_useconds) { m_now = now_useconds; }
+
+    //! True once the DetumbleCompleted event would have been emitted after a detumble started
+    bool completed() const { return m_completed; }
+
+    std::chrono::microseconds currentTime() override { return std::chrono::microseconds(m_now); }
+
+    DetumbleController::Settings settings() override {
+        DetumbleController::Settings settings;
+        settings.gain = m_parameters.gain;
+        settings.torque_duration = std::chrono::microseconds(m_parameters.torque_duration_useconds);
+        settings.cooldown_duration = std::chrono::microseconds(m_parameters.cooldown_duration_useconds);
+        settings.bdot_max_threshold = m_parameters.bdot_max_threshold;
+        settings.deadband_upper_threshold = m_parameters.deadband_upper_threshold;
+        settings.deadband_lower_threshold = m_parameters.deadband_lower_threshold;
+        settings.continuous = m_parameters.continuous;
+        settings.derivative_method = m_parameters.least_squares ? BDot::DerivativeMethod::LEAST_SQUARES
+                                                                : BDot::DerivativeMethod::CENTRAL_DIFFERENCE;
+        settings.hysteresis_axis = DetumbleController::X_AXIS;  // HYSTERESIS_AXIS default
+        return settings;
+    }
+
+    bool angularVelocityMagnitude(double& angular_velocity_magnitude_deg_sec) override {
+        angular_velocity_magnitude_deg_sec = m_imu.angularVelocityMagnitude();
+        return true;
+    }
+
+    bool magneticField(DetumbleController::Field& magnetic_field, std::chrono::microseconds& timestamp) override {
+        std::int64_t timestamp_useconds = 0;
+        magnetic_field = m_imu.magneticField(m_now, timestamp_useconds);
+        timestamp = std::chrono::microseconds(timestamp_useconds);
+        return true;
+    }
+
+    bool magneticFieldSamplingPeriod(std::chrono::microseconds& sampling_period) override {
+        sampling_period = std::chrono::microseconds(m_imu.magneticFieldSamplingPeriodUseconds());
+        return true;
+    }
+
+    void startMagnetorquers(const BDot::Vector& magnetic_moment) override {
+        m_coil_driver.start(m_magnetorquer_array.magneticMomentToDriveLevels(magnetic_moment));
+    }
+
+    void startMagnetorquers(const DetumbleController::DriveLevels& drive_levels) override {
+        m_coil_driver.start(drive_levels);
+    }
+
+    void stopMagnetorquers() override { m_coil_driver.stop(); }
+
+    void detumbleStarted(double) override { m_started = true; }
+
+    void detumbleCompleted(double) override { m_completed = m_started; }
+
+  private:
+    const Parameters& m_parameters;
+    ImuStandIn& m_imu;
+    CoilDriverStandIn& m_coil_driver;
+    MagnetorquerArray m_magnetorquer_array;
+
+    std::int64_t m_now = 0;
+    bool m_started = false;
+    bool m_completed = false;
+};
+
+// ----------------------------------------------------------------------
+//  Scenarios
+// ----------------------------------------------------------------------
+
+struct RunResult {
+    double detumble_seconds;  //!< Simulated time until DetumbleCompleted, negative if it never happened
+    double energy_joules;     //!< Coil energy spent until then
+    double step_nanoseconds;  //!< Mean CPU time of one control step
+};
+
+struct Scenario {
+    const char* name;
+    Parameters parameters;
+    double initial_rate_deg_s;
+    double magnetometer_noise_gauss;
+};
+
+RunResult simulate(const Scenario& scenario, std::uint64_t seed) {
+    Random random(seed);
+    Environment environment(random.uniform(0.0, 5500.0));
+    Spacecraft spacecraft;
+    std::array<Magnetorquer, MagnetorquerArray::COIL_COUNT> coils = defaultCoils();
+
+    // Tumble about a random axis from a random attitude and orbit position
+    Vector3 axis = {random.gaussian(), random.gaussian(), random.gaussian()};
+    spacecraft.m_omega = scale(axis, scenario.initial_rate_deg_s * DEG_TO_RAD / norm(axis));
+    spacecraft.m_attitude = {random.gaussian(), random.gaussian(), random.gaussian(), random.gaussian()};
+    spacecraft.m_attitude.normalize();
+
+    ImuStandIn imu(environment, spacecraft, random, scenario.magnetometer_noise_gauss);
+    CoilDriverStandIn coil_driver(coils);
+    DetumbleIo io(scenario.parameters, coils, imu, coil_driver);
+    DetumbleController controller;
+
+    double control_nanoseconds = 0.0;
+    std::int64_t steps = 0;
+    const double h = static_cast<double>(TICK_USECONDS) / 1e6 / SUBSTEPS;
+    for (std::int64_t elapsed = 0; elapsed < MAX_DURATION_USECONDS; elapsed += TICK_USECONDS) {
+        auto begin = std::chrono::steady_clock::now();
+        io.setTime(EPOCH_USECONDS + elapsed);
+        controller.run(io);
+        auto end = std::chrono::steady_clock::now();
+        control_nanoseconds += std::chrono::duration<double, std::nano>(end - begin).count();
+        steps++;
+
+        if (io.completed()) {
+            return {static_cast<double>(elapsed) / 1e6, coil_driver.energyJoules(), control_nanoseconds / steps};
+        }
+
+        Vector3 dipole = coil_driver.dipole();
+        for (int substep = 0; substep < SUBSTEPS; substep++) {
+            double t_seconds = static_cast<double>(elapsed) / 1e6 + substep * h;
+            spacecraft.step(environment, t_seconds, h, dipole);
+            coil_driver.accumulateEnergy(h);
+        }
+    }
+    return {-1.0, coil_driver.energyJoules(), control_nanoseconds / steps};
+}
+
+Parameters withGain(double gain) {
+    Parameters p;
+    p.gain = gain;
+    return p;
+}
+
+Parameters withDurations(std::int64_t torque_useconds, std::int64_t cooldown_useconds) {
+    Parameters p;
+    p.torque_duration_useconds = torque_useconds;
+    p.cooldown_duration_useconds = cooldown_useconds;
+    return p;
+}
+
+Parameters withMode(bool continuous, bool least_squares) {
+    Parameters p;
+    p.continuous = continuous;
+    p.least_squares = least_squares;
+    return p;
+}
+
+}  // namespace
+
+int main() {
+    // LIS2MDL noise is about 3 mG RMS, 1 mG with its low pass filter enabled
+    const Scenario scenarios[] = {
+        {"defaults", Parameters(), 30.0, 3e-3},
+        {"defaults 10deg/s", Parameters(), 10.0, 3e-3},
+        {"defaults 90deg/s", Parameters(), 90.0, 3e-3},
+        {"magnetometer 1mG", Parameters(), 30.0, 1e-3},
+        {"magnetometer 0mG", Parameters(), 30.0, 0.0},
+        {"gain 1.0", withGain(1.0), 30.0, 3e-3},
+        {"gain 10.0", withGain(10.0), 30.0, 3e-3},
+        {"torque 160ms", withDurations(160000, 20000), 30.0, 3e-3},
+        {"torque 640ms", withDurations(640000, 20000), 30.0, 3e-3},
+        {"cooldown 200ms", withDurations(320000, 200000), 30.0, 3e-3},
+        {"least squares", withMode(false, true), 30.0, 3e-3},
+        {"continuous", withMode(true, false), 30.0, 3e-3},
+        {"continuous + lsq", withMode(true, true), 30.0, 3e-3},
+    };
+    constexpr std::uint64_t SEEDS = 5;
+
+    std::printf("Closed-loop detumble at 50Hz to DEADBAND_LOWER_THRESHOLD, mean of %llu random tumbles\n",
+                static_cast<unsigned long long>(SEEDS));
+    std::printf("%-20s %8s %12s %12s %12s %10s\n", "scenario", "start", "detumble s", "worst s", "energy J",
+                "step ns");
+    for (const Scenario& scenario : scenarios) {
+        double time_sum = 0.0;
+        double time_worst = 0.0;
+        double energy_sum = 0.0;
+        double step_sum = 0.0;
+        int failures = 0;
+        for (std::uint64_t seed = 0; seed < SEEDS; seed++) {
+            RunResult result = simulate(scenario, seed);
+            if (result.detumble_seconds < 0.0) {
+                failures++;
+                continue;
+            }
+            time_sum += result.detumble_seconds;
+            time_worst = std::max(time_worst, result.detumble_seconds);
+            energy_sum += result.energy_joules;
+            step_sum += result.step_nanoseconds;
+        }
+
+        int successes = static_cast<int>(SEEDS) - failures;
+        if (successes == 0) {
+            std::printf("%-20s %6.0f/s %12s\n", scenario.name, scenario.initial_rate_deg_s, "no detumble");
+            continue;
+        }
+        std::printf("%-20s %6.0f/s %12.0f %12.0f %12.1f %10.0f", scenario.name, scenario.initial_rate_deg_s,
+                    time_sum / successes, time_worst, energy_sum / successes, step_sum / successes);
+        if (failures > 0) {
+            std::printf("  (%d of %llu did not detumble)", failures, static_cast<unsigned long long>(SEEDS));
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+// ======================================================================
+// \title  bench_RtcManager_RtcHelper.cpp
+// \brief  Replays long synthetic RTC drift traces through RtcHelper
+// ======================================================================
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "PROVESFlightControllerReference/Components/Drv/RtcManager/RtcHelper.hpp"
+
+using Drv::RtcHelper;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr std::uint64_t USECONDS_PER_SECOND = 1000000;
+constexpr std::uint64_t TRACE_USECONDS = 7ULL * 24ULL * 3600ULL * USECONDS_PER_SECOND;
+constexpr std::uint64_t REQUEST_PERIOD_USECONDS = 100000;
+constexpr std::uint64_t RESYNC_PERIOD_USECONDS = 60ULL * USECONDS_PER_SECOND;
+constexpr std::uint64_t START_EPOCH_USECONDS = 1700000000ULL * USECONDS_PER_SECOND + 421000ULL;
+
+//! RTC rate relative to uptime in ppm as a function of uptime in hours
+struct DriftProfile {
+    const char* name;
+    double (*ppm)(double hours);
+};
+
+double constantSlow(double) {
+    return -35.0;
+}
+
+double constantFast(double) {
+    return 120.0;
+}
+
+//! Crystal tracking the thermal cycle of a 90 minute orbit
+double orbitalThermal(double hours) {
+    return 25.0 + 4.0 * std::sin(2.0 * PI * hours / 1.5);
+}
+
+//! Oscillator aging slowly over the week
+double aging(double hours) {
+    return 10.0 + 0.2 * hours;
+}
+
+//! Step in rate halfway through, as after a safe mode heater change
+double step(double hours) {
+    return (hours < 84.0) ? 15.0 : 45.0;
+}
+
+struct TraceResult {
+    double final_ppm;
+    double true_final_ppm;
+    double rms_error_ms;
+    double max_error_ms;
+    double corrections_ms;
+    std::uint64_t backwards;
+    std::uint32_t resyncs;
+};
+
+std::uint64_t nextJitter(std::uint32_t& state) {
+    state = state * 1664525U + 1013904223U;
+    return static_cast<std::uint64_t>(state % REQUEST_PERIOD_USECONDS);
+}
+
+TraceResult replay(const DriftProfile& profile) {
+    RtcHelper helper;
+    TraceResult result = {};
+    std::uint32_t jitter_state = 12345U;
+
+    // Accumulated true epoch minus uptime, integrated from the drift profile
+    double offset_useconds = 0.0;
+    std::uint64_t previous_uptime = 0;
+    std::uint64_t last_served = 0;
+    double sum_squared_error = 0.0;
+    std::uint64_t samples = 0;
+    double corrections = 0.0;
+
+    for (std::uint64_t tick = 0; tick <= TRACE_USECONDS; tick += REQUEST_PERIOD_USECONDS) {
+        std::uint64_t uptime = tick + nextJitter(jitter_state);
+        double hours = static_cast<double>(uptime) / 3.6e9;
+        offset_useconds += static_cast<double>(uptime - previous_uptime) * profile.ppm(hours) * 1e-6;
+        previous_uptime = uptime;
+
+        double true_epoch = static_cast<double>(START_EPOCH_USECONDS + uptime) + offset_useconds;
+
+        if (helper.resyncDue(uptime, RESYNC_PERIOD_USECONDS)) {
+            std::uint32_t rtc_seconds = static_cast<std::uint32_t>(true_epoch / 1e6);
+            std::int64_t drift = helper.resync(rtc_seconds, uptime);
+            corrections += std::fabs(static_cast<double>(drift));
+        }
+
+        std::uint32_t seconds = 0;
+        std::uint32_t useconds = 0;
+        helper.getTime(uptime, seconds, useconds);
+        std::uint64_t served = static_cast<std::uint64_t>(seconds) * USECONDS_PER_SECOND + useconds;
+        if (served < last_served) {
+            result.backwards++;
+        }
+        last_served = served;
+
+        // Skip the first day while the regression converges
+        if (hours >= 24.0) {
+            double error_ms = (static_cast<double>(served) - true_epoch) / 1000.0;
+            sum_squared_error += error_ms * error_ms;
+            result.max_error_ms = std::fmax(result.max_error_ms, std::fabs(error_ms));
+            samples++;
+        }
+    }
+
+    result.final_ppm = static_cast<double>(helper.getDriftPpb()) / 1000.0;
+    result.true_final_ppm = profile.ppm(static_cast<double>(TRACE_USECONDS) / 3.6e9);
+    result.rms_error_ms = std::sqrt(sum_squared_error / static_cast<double>(samples));
+    result.corrections_ms = corrections / 1000.0;
+    result.resyncs = helper.getResyncCount();
+    return result;
+}
+
+//! Cost of answering a time request from the cache
+double timeRequestNanoseconds() {
+    RtcHelper helper;
+    helper.resync(1700000000U, 0U);
+
+    constexpr std::uint64_t ITERATIONS = 20000000;
+    std::uint64_t checksum = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::uint64_t i = 0; i < ITERATIONS; i++) {
+        std::uint32_t seconds = 0;
+        std::uint32_t useconds = 0;
+        helper.getTime(i * 13U, seconds, useconds);
+        checksum += useconds;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Keep the loop observable so it is not optimized away
+    if (checksum == 0) {
+        std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    }
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(ITERATIONS);
+}
+
+}  // namespace
+
+int main() {
+    const DriftProfile profiles[] = {
+        {"constant -35ppm", constantSlow}, {"constant +120ppm", constantFast}, {"orbital thermal", orbitalThermal},
+        {"aging", aging},                  {"step 15->45ppm", step},
+    };
+
+    std::printf("RtcHelper drift replay: 7 days, 10Hz time requests, 60s resync\n");
+    std::printf("%-18s %10s %10s %10s %10s %12s %9s %9s\n", "profile", "est ppm", "true ppm", "rms ms", "max ms",
+                "correct ms", "backward", "resyncs");
+    for (const DriftProfile& profile : profiles) {
+        TraceResult r = replay(profile);
+        std::printf("%-18s %10.3f %10.3f %10.3f %10.3f %12.1f %9llu %9u\n", profile.name, r.final_ppm,
+                    r.true_final_ppm, r.rms_error_ms, r.max_error_ms, r.corrections_ms,
+                    static_cast<unsigned long long>(r.backwards), r.resyncs);
+    }
+
+    std::printf("getTime: %.2f ns per request\n", timeRequestNanoseconds());
+    return 0;
+}
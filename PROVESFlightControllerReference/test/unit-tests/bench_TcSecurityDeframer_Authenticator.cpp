@@ -0,0 +1,106 @@
+// ======================================================================
+// \title  bench_TcSecurityDeframer_Authenticator.cpp
+// \brief  Compares PSA and precomputed-midstate HMAC verification of uplink frames
+// ======================================================================
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Authenticator.hpp"
+
+using namespace Components;
+
+namespace {
+
+constexpr char TEST_KEY_HEX[] = "14408c2711281f4d70452ce3730bb4fa";
+constexpr std::size_t FRAMES = 200000;
+
+//! Time stamp counter where available, for cycles per byte; 0 elsewhere
+std::uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct Measurement {
+    double frames_per_second;
+    double cycles_per_byte;
+    std::size_t failures;
+};
+
+//! Verify the same signed frame repeatedly through one backend
+template <typename Verify>
+Measurement measure(std::size_t data_size, Verify verify) {
+    std::size_t failures = 0;
+    auto begin = std::chrono::steady_clock::now();
+    std::uint64_t start = cycles();
+    for (std::size_t i = 0; i < FRAMES; i++) {
+        if (!verify()) {
+            failures++;
+        }
+    }
+    std::uint64_t stop = cycles();
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - begin).count();
+    double bytes = static_cast<double>(data_size) * static_cast<double>(FRAMES);
+    return {static_cast<double>(FRAMES) / seconds, static_cast<double>(stop - start) / bytes, failures};
+}
+
+}  // namespace
+
+int main() {
+    std::uint32_t key_id = 0;
+    HmacSha256::Midstate midstate{};
+    if (importHmacKey(TEST_KEY_HEX, key_id).status != PacketAuthenticator::KeyImportStatus::Success ||
+        importHmacMidstate(TEST_KEY_HEX, midstate).status != PacketAuthenticator::KeyImportStatus::Success) {
+        std::printf("key import failed\n");
+        return 1;
+    }
+
+    // Authenticated data sizes from a bare command up to a full file uplink chunk
+    const std::size_t sizes[] = {16, 32, 64, 128, 256, 512, 1024};
+
+    std::printf("HMAC-SHA-256/128 frame verification, %zu frames per size\n", FRAMES);
+    std::printf("%8s %14s %12s %14s %12s %8s\n", "bytes", "psa frames/s", "psa cyc/B", "mid frames/s", "mid cyc/B",
+                "speedup");
+    for (std::size_t data_size : sizes) {
+        // Sign with the midstate backend; test_TcSecurityDeframer_Authenticator.cpp checks it against PSA
+        std::vector<std::uint8_t> frame(data_size + Ccsds355_0_B_2::kTCSecurityTrailer);
+        for (std::size_t i = 0; i < data_size; i++) {
+            frame[i] = static_cast<std::uint8_t>(i * 31U);
+        }
+        HmacSha256::Digest digest;
+        HmacSha256::compute(midstate, frame.data(), data_size, digest);
+        Mac mac{};
+        for (std::size_t i = 0; i < mac.size(); i++) {
+            mac[i] = digest[i];
+            frame[data_size + i] = digest[i];
+        }
+
+        Measurement psa = measure(data_size, [&]() {
+            return authenticatePacket(frame.data(), frame.size(), mac, key_id).status ==
+                   PacketAuthenticator::AuthenticationStatus::Authenticated;
+        });
+        Measurement mid = measure(data_size, [&]() {
+            return authenticatePacket(frame.data(), frame.size(), mac, midstate).status ==
+                   PacketAuthenticator::AuthenticationStatus::Authenticated;
+        });
+        if (psa.failures != 0 || mid.failures != 0) {
+            std::printf("verification failed: psa %zu, midstate %zu\n", psa.failures, mid.failures);
+            return 1;
+        }
+        std::printf("%8zu %14.0f %12.2f %14.0f %12.2f %7.2fx\n", data_size, psa.frames_per_second,
+                    psa.cycles_per_byte, mid.frames_per_second, mid.cycles_per_byte,
+                    mid.frames_per_second / psa.frames_per_second);
+    }
+    return 0;
+}
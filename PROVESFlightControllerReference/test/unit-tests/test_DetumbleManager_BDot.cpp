@@ -2,10 +2,14 @@
 
 #include <array>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 
 #include "PROVESFlightControllerReference/Components/DetumbleManager/BDot.hpp"
 
+using Components::BasicBDot;
 using Components::BDot;
+using Components::CentralDifferenceStencil;
 
 // Standard sampling period for tests (100 Hz = 10 ms = 10000 us)
 const std::chrono::microseconds SAMPLING_PERIOD_US(10000);
@@ -110,3 +114,308 @@ TEST(BDotTest, EmptySampleSetCanBeReused) {
 
     EXPECT_TRUE(bdot.samplingComplete());
 }
+
+TEST(BDotTest, BatchModeIgnoresSamplesWhenFull) {
+    BDot bdot;
+    bdot.configure(1.0, SAMPLING_PERIOD_US);
+
+    for (std::size_t i = 0; i < 8; ++i) {
+        std::array<double, 3> b_field = {static_cast<double>(i), 0.0, 0.0};
+        bdot.addSample(b_field, SAMPLING_PERIOD_US * static_cast<long long>(i));
+    }
+
+    // Only the first 5 samples are kept
+    EXPECT_TRUE(bdot.samplingComplete());
+    EXPECT_EQ(bdot.getTimeBetweenSamples(), SAMPLING_PERIOD_US * 4);
+}
+
+TEST(BDotTest, StreamingModeUpdatesEverySample) {
+    BDot bdot;
+    const double gain = 2.0;
+    bdot.configure(gain, SAMPLING_PERIOD_US);
+    bdot.setSamplingMode(BDot::SamplingMode::STREAMING);
+
+    const double dt_seconds = SAMPLING_PERIOD_US.count() / 1e6;
+
+    // Field ramps at 10 G/s then reverses to -4 G/s after sample 6
+    double bx = 0.0;
+    for (std::size_t i = 0; i < 16; ++i) {
+        double slope_x = (i <= 6) ? 10.0 : -4.0;
+        if (i > 0) {
+            bx += slope_x * dt_seconds;
+        }
+        std::array<double, 3> b_field = {bx, 0.0, 0.0};
+        bdot.addSample(b_field, SAMPLING_PERIOD_US * static_cast<long long>(i));
+
+        if (i < 4) {
+            EXPECT_FALSE(bdot.samplingComplete());
+            continue;
+        }
+
+        // The window always spans the latest 5 samples without being emptied
+        EXPECT_TRUE(bdot.samplingComplete());
+        EXPECT_EQ(bdot.getTimeBetweenSamples(), SAMPLING_PERIOD_US * 4);
+
+        // Once the window only holds the new ramp the derivative follows it
+        auto moment = bdot.getMagneticMoment();
+        if (i <= 6) {
+            EXPECT_NEAR(moment[0], -gain * 10.0, 1e-6) << "sample " << i;
+        } else if (i >= 11) {
+            EXPECT_NEAR(moment[0], -gain * -4.0, 1e-6) << "sample " << i;
+        }
+    }
+}
+
+TEST(BDotTest, StreamingModeUsesSampleSpacing) {
+    BDot bdot;
+    const double gain = 1.0;
+    bdot.configure(gain, SAMPLING_PERIOD_US);
+    bdot.setSamplingMode(BDot::SamplingMode::STREAMING);
+
+    // Samples arrive once per control cycle, much slower than the magnetometer sampling period
+    const std::chrono::microseconds control_period(360000);
+    const double slope_y = -0.75;
+    for (std::size_t i = 0; i < 7; ++i) {
+        double t_seconds = control_period.count() / 1e6 * static_cast<double>(i);
+        std::array<double, 3> b_field = {0.0, slope_y * t_seconds, 0.0};
+        bdot.addSample(b_field, control_period * static_cast<long long>(i));
+    }
+
+    auto moment = bdot.getMagneticMoment();
+    EXPECT_NEAR(moment[0], 0.0, 1e-9);
+    EXPECT_NEAR(moment[1], -gain * slope_y, 1e-9);
+    EXPECT_NEAR(moment[2], 0.0, 1e-9);
+}
+
+TEST(BDotTest, SetSamplingModeEmptiesSampleSet) {
+    BDot bdot;
+    bdot.configure(1.0, SAMPLING_PERIOD_US);
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        std::array<double, 3> b_field = {static_cast<double>(i), 0.0, 0.0};
+        bdot.addSample(b_field, SAMPLING_PERIOD_US * static_cast<long long>(i));
+    }
+    ASSERT_TRUE(bdot.samplingComplete());
+
+    bdot.setSamplingMode(BDot::SamplingMode::STREAMING);
+    EXPECT_FALSE(bdot.samplingComplete());
+    EXPECT_EQ(bdot.getTimeBetweenSamples(), std::chrono::microseconds(0));
+}
+
+TEST(BDotTest, LeastSquaresRecoversJitteredRamp) {
+    const double gain = 2.0;
+    const double slope_x = 10.0;
+    const double slope_z = -4.0;
+
+    // Samples land up to 5 ms either side of the nominal 10 ms grid
+    const long long jitter_us[] = {0, -4000, 2000, 5000, -1000};
+
+    BDot stencil;
+    BDot least_squares;
+    stencil.configure(gain, SAMPLING_PERIOD_US);
+    least_squares.configure(gain, SAMPLING_PERIOD_US);
+    least_squares.setDerivativeMethod(BDot::DerivativeMethod::LEAST_SQUARES);
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        std::chrono::microseconds timestamp =
+            SAMPLING_PERIOD_US * static_cast<long long>(i + 1) + std::chrono::microseconds(jitter_us[i]);
+        double t_seconds = timestamp.count() / 1e6;
+        std::array<double, 3> b_field = {slope_x * t_seconds, 0.25, slope_z * t_seconds};
+        stencil.addSample(b_field, timestamp);
+        least_squares.addSample(b_field, timestamp);
+    }
+
+    // The line fit is exact however the samples are spaced
+    auto moment = least_squares.getMagneticMoment();
+    EXPECT_NEAR(moment[0], -gain * slope_x, 1e-9);
+    EXPECT_NEAR(moment[1], 0.0, 1e-9);
+    EXPECT_NEAR(moment[2], -gain * slope_z, 1e-9);
+
+    // The stencil assumes the nominal spacing and misses the slope
+    EXPECT_GT(std::fabs(stencil.getMagneticMoment()[0] - -gain * slope_x), 1.0);
+}
+
+TEST(BDotTest, LeastSquaresUsesTimestampsInStreamingMode) {
+    BDot bdot;
+    const double gain = 1.0;
+    bdot.configure(gain, SAMPLING_PERIOD_US);
+    bdot.setSamplingMode(BDot::SamplingMode::STREAMING);
+    bdot.setDerivativeMethod(BDot::DerivativeMethod::LEAST_SQUARES);
+
+    // Too few samples gives no dipole
+    bdot.addSample({1.0, 1.0, 1.0}, std::chrono::microseconds(0));
+    auto moment = bdot.getMagneticMoment();
+    EXPECT_EQ(moment[0], 0.0);
+
+    // Uneven control cycles after the first sample
+    const long long times_us[] = {0, 350000, 730000, 1060000, 1440000, 1790000, 2160000};
+    const double slope_y = 0.3;
+    bdot.emptySampleSet();
+    for (long long time_us : times_us) {
+        double t_seconds = static_cast<double>(time_us) / 1e6;
+        bdot.addSample({0.0, 1.0 + slope_y * t_seconds, 0.0}, std::chrono::microseconds(time_us));
+    }
+
+    moment = bdot.getMagneticMoment();
+    EXPECT_NEAR(moment[1], -gain * slope_y, 1e-9);
+}
+
+TEST(BDotTest, LeastSquaresIgnoresWindowWithoutTimeSpread) {
+    BDot bdot;
+    bdot.configure(1.0, SAMPLING_PERIOD_US);
+    bdot.setDerivativeMethod(BDot::DerivativeMethod::LEAST_SQUARES);
+
+    // Identical timestamps leave the normal equations singular
+    for (std::size_t i = 0; i < 5; ++i) {
+        bdot.addSample({static_cast<double>(i), 0.0, 0.0}, SAMPLING_PERIOD_US);
+    }
+
+    auto moment = bdot.getMagneticMoment();
+    EXPECT_EQ(moment[0], 0.0);
+    EXPECT_EQ(moment[1], 0.0);
+    EXPECT_EQ(moment[2], 0.0);
+}
+
+// ----------------------------------------------------------------------
+// Stencil order comparisons
+// ----------------------------------------------------------------------
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+//! Field of a fast tumble, one full rotation every half second
+double tumbleField(double t_seconds) {
+    return 0.5 * std::sin(4.0 * PI * t_seconds);
+}
+
+//! Absolute error in Bx derivative at the centre of an N-point window sampled from tumbleField
+template <std::size_t N>
+double tumbleDerivativeError() {
+    BasicBDot<N> bdot;
+    bdot.configure(-1.0, SAMPLING_PERIOD_US);  // Negative unit gain so the moment equals Ḃ
+
+    const double dt_seconds = SAMPLING_PERIOD_US.count() / 1e6;
+    for (std::size_t i = 0; i < N; ++i) {
+        std::array<double, 3> b_field = {tumbleField(dt_seconds * static_cast<double>(i)), 0.0, 0.0};
+        bdot.addSample(b_field, SAMPLING_PERIOD_US * static_cast<long long>(i));
+    }
+
+    double t_centre = dt_seconds * static_cast<double>(N / 2);
+    double expected = 0.5 * 4.0 * PI * std::cos(4.0 * PI * t_centre);
+    return std::fabs(bdot.getMagneticMoment()[0] - expected);
+}
+
+//! Mean time of one derivative and dipole computation in nanoseconds
+template <std::size_t N>
+double magneticMomentNanoseconds() {
+    BasicBDot<N> bdot;
+    bdot.configure(1.0, SAMPLING_PERIOD_US);
+    bdot.setSamplingMode(BasicBDot<N>::SamplingMode::STREAMING);
+
+    constexpr std::size_t ITERATIONS = 200000;
+    double checksum = 0.0;
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < ITERATIONS; ++i) {
+        double value = static_cast<double>(i % 97);
+        bdot.addSample({value, -value, 0.5 * value}, SAMPLING_PERIOD_US * static_cast<long long>(i));
+        checksum += bdot.getMagneticMoment()[0];
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Keep the loop observable so it is not optimized away
+    EXPECT_TRUE(std::isfinite(checksum));
+    return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(ITERATIONS);
+}
+
+//! Checks an N-point stencil recovers the derivative of a degree N - 1 polynomial exactly
+template <std::size_t N>
+void expectExactForPolynomial() {
+    BasicBDot<N> bdot;
+    bdot.configure(-1.0, SAMPLING_PERIOD_US);
+
+    // p(t) = Σ t^j for j up to N - 1, evaluated about the centre sample so the derivative there is 1
+    const double dt_seconds = SAMPLING_PERIOD_US.count() / 1e6;
+    for (std::size_t i = 0; i < N; ++i) {
+        double t = dt_seconds * (static_cast<double>(i) - static_cast<double>(N / 2));
+        double value = 0.0;
+        double power = 1.0;
+        for (std::size_t j = 0; j < N; ++j) {
+            value += power;
+            power *= t;
+        }
+        bdot.addSample({value, 0.0, -value}, SAMPLING_PERIOD_US * static_cast<long long>(i));
+    }
+
+    auto moment = bdot.getMagneticMoment();
+    EXPECT_NEAR(moment[0], 1.0, 1e-9) << N << "-point stencil";
+    EXPECT_NEAR(moment[2], -1.0, 1e-9) << N << "-point stencil";
+}
+
+}  // namespace
+
+TEST(BDotStencilTest, WeightsMatchClassicalFormulas) {
+    constexpr CentralDifferenceStencil<3> three;
+    static_assert(three.weights[0] == -0.5 && three.weights[1] == 0.0 && three.weights[2] == 0.5,
+                  "3-point stencil is (-1, 0, 1) / 2");
+
+    constexpr CentralDifferenceStencil<5> five;
+    const double expected_five[] = {1.0 / 12.0, -8.0 / 12.0, 0.0, 8.0 / 12.0, -1.0 / 12.0};
+    for (std::size_t i = 0; i < 5; ++i) {
+        EXPECT_NEAR(five.weights[i], expected_five[i], 1e-15) << "weight " << i;
+    }
+
+    constexpr CentralDifferenceStencil<7> seven;
+    const double expected_seven[] = {-1.0 / 60.0, 9.0 / 60.0, -45.0 / 60.0, 0.0, 45.0 / 60.0, -9.0 / 60.0, 1.0 / 60.0};
+    for (std::size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(seven.weights[i], expected_seven[i], 1e-15) << "weight " << i;
+    }
+
+    // Every stencil is antisymmetric and differentiates t exactly
+    constexpr CentralDifferenceStencil<9> nine;
+    double sum = 0.0;
+    double first_moment = 0.0;
+    for (std::size_t i = 0; i < 9; ++i) {
+        EXPECT_DOUBLE_EQ(nine.weights[i], -nine.weights[8 - i]);
+        sum += nine.weights[i];
+        first_moment += nine.weights[i] * (static_cast<double>(i) - 4.0);
+    }
+    EXPECT_NEAR(sum, 0.0, 1e-15);
+    EXPECT_NEAR(first_moment, 1.0, 1e-15);
+}
+
+TEST(BDotStencilTest, ExactForPolynomialsOfStencilOrder) {
+    expectExactForPolynomial<3>();
+    expectExactForPolynomial<5>();
+    expectExactForPolynomial<7>();
+    expectExactForPolynomial<9>();
+}
+
+TEST(BDotStencilTest, WiderStencilsAreMoreAccurate) {
+    const double error_3 = tumbleDerivativeError<3>();
+    const double error_5 = tumbleDerivativeError<5>();
+    const double error_7 = tumbleDerivativeError<7>();
+    const double error_9 = tumbleDerivativeError<9>();
+
+    std::printf("Bx derivative error at 2 Hz tumble: 3pt %.3e, 5pt %.3e, 7pt %.3e, 9pt %.3e G/s\n", error_3, error_5,
+                error_7, error_9);
+
+    EXPECT_LT(error_5, error_3);
+    EXPECT_LT(error_7, error_5);
+    EXPECT_LT(error_9, error_7);
+}
+
+TEST(BDotStencilTest, ComputeCostScalesWithStencilOrder) {
+    const double ns_3 = magneticMomentNanoseconds<3>();
+    const double ns_5 = magneticMomentNanoseconds<5>();
+    const double ns_7 = magneticMomentNanoseconds<7>();
+    const double ns_9 = magneticMomentNanoseconds<9>();
+
+    std::printf("addSample + getMagneticMoment: 3pt %.1f, 5pt %.1f, 7pt %.1f, 9pt %.1f ns\n", ns_3, ns_5, ns_7, ns_9);
+
+    // Timing is host dependent, so only check every order was measured
+    EXPECT_GT(ns_3, 0.0);
+    EXPECT_GT(ns_5, 0.0);
+    EXPECT_GT(ns_7, 0.0);
+    EXPECT_GT(ns_9, 0.0);
+}
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+#include "PROVESFlightControllerReference/Components/DetumbleManager/DetumbleController.hpp"
+
+using Components::BDot;
+using Components::BDOT_STENCIL_POINTS;
+using Components::DetumbleController;
+using Components::StrategySelector;
+
+namespace {
+
+//! Scripted Io recording what the state machine asked for
+class FakeIo : public DetumbleController::Io {
+  public:
+    FakeIo() {
+        settings_value.gain = 3.0;
+        settings_value.torque_duration = std::chrono::microseconds(100000);
+        settings_value.cooldown_duration = std::chrono::microseconds(20000);
+        settings_value.bdot_max_threshold = 720.0;
+        settings_value.deadband_upper_threshold = 8.0;
+        settings_value.deadband_lower_threshold = 5.0;
+        settings_value.continuous = false;
+        settings_value.derivative_method = BDot::DerivativeMethod::CENTRAL_DIFFERENCE;
+        settings_value.hysteresis_axis = DetumbleController::X_AXIS;
+    }
+
+    std::chrono::microseconds currentTime() override { return std::chrono::microseconds(now_us); }
+
+    DetumbleController::Settings settings() override { return settings_value; }
+
+    bool angularVelocityMagnitude(double& angular_velocity_magnitude_deg_sec) override {
+        angular_velocity_magnitude_deg_sec = rate_deg_sec;
+        return rate_valid;
+    }
+
+    bool magneticField(DetumbleController::Field& magnetic_field, std::chrono::microseconds& timestamp) override {
+        if (!field_available) {
+            return false;
+        }
+        field_reads++;
+        magnetic_field = {0.2 + 0.01 * static_cast<double>(field_reads), -0.1, 0.3};
+        timestamp = std::chrono::microseconds(now_us);
+        return true;
+    }
+
+    bool magneticFieldSamplingPeriod(std::chrono::microseconds& sampling_period) override {
+        sampling_period = std::chrono::microseconds(10000);
+        return true;
+    }
+
+    void startMagnetorquers(const BDot::Vector&) override { dipole_starts++; }
+
+    void startMagnetorquers(const DetumbleController::DriveLevels& drive_levels) override { levels = drive_levels; }
+
+    void stopMagnetorquers() override { stops++; }
+
+    void detumbleStarted(double) override { started++; }
+
+    void detumbleCompleted(double) override { completed++; }
+
+    DetumbleController::Settings settings_value;
+    std::int64_t now_us = 1000000;
+    double rate_deg_sec = 30.0;
+    bool rate_valid = true;
+    bool field_available = true;
+    std::size_t field_reads = 0;
+    int dipole_starts = 0;
+    int stops = 0;
+    int started = 0;
+    int completed = 0;
+    DetumbleController::DriveLevels levels{};
+};
+
+//! Run once per 20ms rate group cycle
+void runFor(DetumbleController& controller, FakeIo& io, std::size_t runs) {
+    for (std::size_t run = 0; run < runs; run++) {
+        controller.run(io);
+        io.now_us += 20000;
+    }
+}
+
+}  // namespace
+
+TEST(DetumbleControllerTest, CooldownThenSensing) {
+    DetumbleController controller;
+    FakeIo io;
+
+    // Cooldown starts on the first run and must exceed 20ms
+    runFor(controller, io, 2);
+    EXPECT_EQ(controller.getState(), DetumbleController::COOLDOWN);
+    runFor(controller, io, 1);
+    EXPECT_EQ(controller.getState(), DetumbleController::SENSING_ANGULAR_VELOCITY);
+}
+
+TEST(DetumbleControllerTest, IdleReportsCompletion) {
+    DetumbleController controller;
+    FakeIo io;
+    io.rate_deg_sec = 1.0;
+
+    runFor(controller, io, 4);
+    EXPECT_EQ(controller.getState(), DetumbleController::SENSING_ANGULAR_VELOCITY);
+    EXPECT_EQ(controller.getStrategy(), StrategySelector::IDLE);
+    EXPECT_EQ(io.completed, 1);
+    EXPECT_EQ(io.started, 0);
+}
+
+TEST(DetumbleControllerTest, FailedRateReadStaysInSensing) {
+    DetumbleController controller;
+    FakeIo io;
+    io.rate_valid = false;
+
+    runFor(controller, io, 6);
+    EXPECT_EQ(controller.getState(), DetumbleController::SENSING_ANGULAR_VELOCITY);
+    EXPECT_EQ(io.started + io.completed, 0);
+}
+
+TEST(DetumbleControllerTest, BatchCycle) {
+    DetumbleController controller;
+    FakeIo io;
+
+    runFor(controller, io, 4);
+    EXPECT_EQ(controller.getState(), DetumbleController::SENSING_MAGNETIC_FIELD);
+    EXPECT_EQ(controller.getStrategy(), StrategySelector::BDOT);
+    EXPECT_EQ(io.started, 1);
+
+    // Fill the sample set
+    runFor(controller, io, BDOT_STENCIL_POINTS);
+    EXPECT_EQ(controller.getState(), DetumbleController::ACTUATING_BDOT);
+    EXPECT_EQ(io.field_reads, BDOT_STENCIL_POINTS);
+
+    // Torque for longer than 100ms, then stop and cool down
+    runFor(controller, io, 6);
+    EXPECT_EQ(controller.getState(), DetumbleController::ACTUATING_BDOT);
+    EXPECT_EQ(io.stops, 0);
+    runFor(controller, io, 1);
+    EXPECT_EQ(controller.getState(), DetumbleController::COOLDOWN);
+    EXPECT_EQ(io.dipole_starts, 7);
+    EXPECT_EQ(io.stops, 1);
+}
+
+TEST(DetumbleControllerTest, PushedFieldsFillTheSampleSet) {
+    DetumbleController controller;
+    FakeIo io;
+
+    runFor(controller, io, 4);
+    ASSERT_EQ(controller.getState(), DetumbleController::SENSING_MAGNETIC_FIELD);
+
+    for (std::size_t sample = 0; sample < BDOT_STENCIL_POINTS; sample++) {
+        controller.magneticFieldReady(io);
+    }
+    EXPECT_EQ(controller.getState(), DetumbleController::ACTUATING_BDOT);
+
+    // Pushed conversions are ignored outside SENSING_MAGNETIC_FIELD
+    controller.magneticFieldReady(io);
+    EXPECT_EQ(io.field_reads, BDOT_STENCIL_POINTS);
+}
+
+TEST(DetumbleControllerTest, HysteresisDrivesSelectedAxis) {
+    DetumbleController controller;
+    FakeIo io;
+    io.rate_deg_sec = 800.0;
+    io.settings_value.hysteresis_axis = DetumbleController::Y_AXIS;
+
+    runFor(controller, io, 4);
+    EXPECT_EQ(controller.getState(), DetumbleController::ACTUATING_HYSTERESIS);
+    runFor(controller, io, 1);
+    EXPECT_EQ(controller.getState(), DetumbleController::COOLDOWN);
+    DetumbleController::DriveLevels expected = {0, 0, 127, -127, 0};
+    EXPECT_EQ(io.levels, expected);
+}
+
+TEST(DetumbleControllerTest, ContinuousWaitsForFieldAfterGap) {
+    DetumbleController controller;
+    FakeIo io;
+    io.settings_value.continuous = true;
+
+    runFor(controller, io, 4);
+    ASSERT_EQ(controller.getState(), DetumbleController::ACTUATING_BDOT_CONTINUOUS);
+
+    // The gap opened on entry must pass before the first sample
+    io.field_available = false;
+    runFor(controller, io, 3);
+    EXPECT_EQ(io.field_reads, 0u);
+    io.field_available = true;
+    runFor(controller, io, 1);
+    EXPECT_EQ(io.field_reads, 1u);
+
+    // Coils stay off until the streaming window is full
+    EXPECT_EQ(io.dipole_starts, 0);
+}
+
+TEST(DetumbleControllerTest, ContinuousLeavesWhenDetumbled) {
+    DetumbleController controller;
+    FakeIo io;
+    io.settings_value.continuous = true;
+
+    runFor(controller, io, 4);
+    ASSERT_EQ(controller.getState(), DetumbleController::ACTUATING_BDOT_CONTINUOUS);
+
+    io.rate_deg_sec = 1.0;
+    runFor(controller, io, 2);
+    EXPECT_EQ(controller.getState(), DetumbleController::SENSING_ANGULAR_VELOCITY);
+    EXPECT_EQ(io.completed, 1);
+    EXPECT_GE(io.stops, 1);
+}
+
+TEST(DetumbleControllerTest, DisableStopsCoilsAndResets) {
+    DetumbleController controller;
+    FakeIo io;
+    io.settings_value.continuous = true;
+
+    runFor(controller, io, 4);
+    ASSERT_EQ(controller.getState(), DetumbleController::ACTUATING_BDOT_CONTINUOUS);
+
+    controller.disable(io);
+    EXPECT_EQ(controller.getState(), DetumbleController::COOLDOWN);
+    EXPECT_EQ(io.stops, 2);
+
+    // Already in COOLDOWN, nothing more to stop
+    controller.disable(io);
+    EXPECT_EQ(io.stops, 2);
+}
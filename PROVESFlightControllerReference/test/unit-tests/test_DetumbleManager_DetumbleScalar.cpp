@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#include "PROVESFlightControllerReference/Components/DetumbleManager/BDot.hpp"
+#include "PROVESFlightControllerReference/Components/DetumbleManager/DetumbleScalar.hpp"
+#include "PROVESFlightControllerReference/Components/DetumbleManager/MagnetorquerArray.hpp"
+#include "PROVESFlightControllerReference/Components/DetumbleManager/StrategySelector.hpp"
+
+using Components::BasicBDot;
+using Components::BasicMagnetorquerArray;
+using Components::BasicStrategySelector;
+using Components::BDOT_STENCIL_POINTS;
+using Components::FixedPointQ16;
+using Components::Magnetorquer;
+using Components::ScalarMath;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr long long SAMPLING_PERIOD_USECONDS = 20000;  // 50Hz rate group
+constexpr double Q16_LSB = 1.0 / 65536.0;
+
+//! Small deterministic generator so runs are repeatable
+class Random {
+  public:
+    double uniform(double low, double high) {
+        m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return low + (high - low) * static_cast<double>(m_state >> 11) / 9007199254740992.0;
+    }
+
+  private:
+    std::uint64_t m_state = 88172645463325252ULL;
+};
+
+//! Largest vector error of the Scalar B-Dot dipole against the double reference over random tumbles, in A·m²
+template <typename Scalar>
+double maxBDotError(typename BasicBDot<BDOT_STENCIL_POINTS, Scalar>::DerivativeMethod method,
+                    typename BasicBDot<BDOT_STENCIL_POINTS, Scalar>::SamplingMode mode) {
+    using Reference = BasicBDot<BDOT_STENCIL_POINTS, double>;
+    using Candidate = BasicBDot<BDOT_STENCIL_POINTS, Scalar>;
+    using Math = ScalarMath<Scalar>;
+
+    Random random;
+    double max_error = 0.0;
+    for (int window = 0; window < 2000; window++) {
+        // LEO field strengths, tumble rates up to the hysteresis threshold and a range of gains
+        double field = random.uniform(0.2, 0.6);
+        double rate_rad_s = random.uniform(-720.0, 720.0) * PI / 180.0;
+        double gain = random.uniform(0.5, 5.0);
+        double phase = random.uniform(0.0, 2.0 * PI);
+
+        Reference reference;
+        Candidate candidate;
+        reference.configure(gain, std::chrono::microseconds(SAMPLING_PERIOD_USECONDS));
+        candidate.configure(Math::fromDouble(gain), std::chrono::microseconds(SAMPLING_PERIOD_USECONDS));
+        reference.setSamplingMode(static_cast<typename Reference::SamplingMode>(mode));
+        candidate.setSamplingMode(mode);
+        reference.setDerivativeMethod(static_cast<typename Reference::DerivativeMethod>(method));
+        candidate.setDerivativeMethod(method);
+
+        // Jittered timestamps far from zero, as read from the RTC
+        long long start_useconds = 1700000000000000LL + static_cast<long long>(random.uniform(0.0, 1e9));
+        for (std::size_t i = 0; i < BDOT_STENCIL_POINTS + 2; i++) {
+            long long t_useconds = start_useconds + static_cast<long long>(i) * SAMPLING_PERIOD_USECONDS +
+                                   static_cast<long long>(random.uniform(-3000.0, 3000.0));
+            double angle = phase + rate_rad_s * static_cast<double>(i) * SAMPLING_PERIOD_USECONDS / 1e6;
+            std::array<double, 3> sample = {field * std::cos(angle), -field * std::sin(angle), 0.4 * field};
+
+            reference.addSample(sample, std::chrono::microseconds(t_useconds));
+            candidate.addSample({Math::fromDouble(sample[0]), Math::fromDouble(sample[1]), Math::fromDouble(sample[2])},
+                                std::chrono::microseconds(t_useconds));
+        }
+
+        std::array<double, 3> expected = reference.getMagneticMoment();
+        typename Candidate::Vector actual = candidate.getMagneticMoment();
+        double error = 0.0;
+        for (std::size_t axis = 0; axis < 3; axis++) {
+            double difference = Math::toDouble(actual[axis]) - expected[axis];
+            error += difference * difference;
+        }
+        max_error = std::fmax(max_error, std::sqrt(error));
+    }
+    return max_error;
+}
+
+//! Rectangular 0.1 m x 0.2 m coil with 100 turns at 0.5 A max -> 1.0 A*m^2 at full drive
+Magnetorquer rectangularCoil(Magnetorquer::DirectionSign sign) {
+    Magnetorquer coil;
+    coil.m_shape = Magnetorquer::CoilShape::RECTANGULAR;
+    coil.m_width = 0.1;
+    coil.m_length = 0.2;
+    coil.m_turns = 100.0;
+    coil.m_voltage = 5.0;
+    coil.m_resistance = 10.0;
+    coil.m_direction_sign = sign;
+    return coil;
+}
+
+template <typename Scalar>
+void configureArray(BasicMagnetorquerArray<Scalar>& array) {
+    using Array = BasicMagnetorquerArray<Scalar>;
+    array.configure(Array::X_PLUS, 0, rectangularCoil(Magnetorquer::POSITIVE));
+    array.configure(Array::X_MINUS, 0, rectangularCoil(Magnetorquer::NEGATIVE));
+    array.configure(Array::Y_PLUS, 1, rectangularCoil(Magnetorquer::POSITIVE));
+    array.configure(Array::Y_MINUS, 1, rectangularCoil(Magnetorquer::NEGATIVE));
+    array.configure(Array::Z_MINUS, 2, rectangularCoil(Magnetorquer::NEGATIVE));
+}
+
+//! Largest drive level difference of the Scalar coil array against the double reference, in counts
+template <typename Scalar>
+int maxDriveLevelError() {
+    using Math = ScalarMath<Scalar>;
+
+    BasicMagnetorquerArray<double> reference;
+    BasicMagnetorquerArray<Scalar> candidate;
+    configureArray(reference);
+    configureArray(candidate);
+
+    Random random;
+    int max_error = 0;
+    for (int i = 0; i < 10000; i++) {
+        // Up to three times full drive so the saturation scaling is exercised
+        std::array<double, 3> moment = {random.uniform(-3.0, 3.0), random.uniform(-3.0, 3.0),
+                                        random.uniform(-3.0, 3.0)};
+        auto expected = reference.magneticMomentToDriveLevels(moment);
+        auto actual = candidate.magneticMomentToDriveLevels(
+            {Math::fromDouble(moment[0]), Math::fromDouble(moment[1]), Math::fromDouble(moment[2])});
+        for (std::size_t coil = 0; coil < expected.size(); coil++) {
+            max_error = std::max(max_error, std::abs(static_cast<int>(actual[coil]) - expected[coil]));
+        }
+    }
+    return max_error;
+}
+
+//! Number of decisions where the Scalar strategy selector disagrees with the double reference
+template <typename Scalar>
+int strategyMismatches() {
+    using Math = ScalarMath<Scalar>;
+
+    BasicStrategySelector<double> reference;
+    BasicStrategySelector<Scalar> candidate;
+    reference.configure(720.0, 8.0, 5.0);
+    candidate.configure(Math::fromDouble(720.0), Math::fromDouble(8.0), Math::fromDouble(5.0));
+
+    Random random;
+    int mismatches = 0;
+    for (int i = 0; i < 10000; i++) {
+        // Keep clear of the thresholds by more than the fixed point resolution
+        double rate = random.uniform(0.0, 1000.0);
+        if (std::fabs(rate - 720.0) < 1e-3 || std::fabs(rate - 8.0) < 1e-3 || std::fabs(rate - 5.0) < 1e-3) {
+            continue;
+        }
+        int expected = reference.fromAngularVelocityMagnitude(rate);
+        int actual = candidate.fromAngularVelocityMagnitude(Math::fromDouble(rate));
+        if (expected != actual) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+// Fixed point arithmetic
+// ----------------------------------------------------------------------
+
+TEST(FixedPointTest, ArithmeticMatchesDoubleWithinOneLsb) {
+    Random random;
+    for (int i = 0; i < 10000; i++) {
+        double a = random.uniform(-100.0, 100.0);
+        double b = random.uniform(-100.0, 100.0);
+        FixedPointQ16 fa = FixedPointQ16::fromDouble(a);
+        FixedPointQ16 fb = FixedPointQ16::fromDouble(b);
+        double qa = fa.toDouble();
+        double qb = fb.toDouble();
+
+        EXPECT_NEAR((fa + fb).toDouble(), qa + qb, Q16_LSB);
+        EXPECT_NEAR((fa - fb).toDouble(), qa - qb, Q16_LSB);
+        EXPECT_NEAR((fa * fb).toDouble(), qa * qb, Q16_LSB);
+        if (std::fabs(qb) > 1.0) {
+            EXPECT_NEAR((fa / fb).toDouble(), qa / qb, Q16_LSB);
+        }
+    }
+}
+
+TEST(FixedPointTest, SaturatesInsteadOfWrapping) {
+    FixedPointQ16 large = FixedPointQ16::fromDouble(30000.0);
+
+    EXPECT_EQ((large + large).raw(), INT32_MAX);
+    EXPECT_EQ((-large - large).raw(), -INT32_MAX);
+    EXPECT_EQ((large * large).raw(), INT32_MAX);
+    EXPECT_EQ((large * -large).raw(), -INT32_MAX);
+    EXPECT_EQ(FixedPointQ16::fromDouble(1e9).raw(), INT32_MAX);
+    EXPECT_EQ(FixedPointQ16::fromDouble(-1e9).raw(), -INT32_MAX);
+}
+
+TEST(FixedPointTest, DivisionByZeroSaturatesTowardSign) {
+    EXPECT_EQ((FixedPointQ16(3) / FixedPointQ16(0)).raw(), INT32_MAX);
+    EXPECT_EQ((FixedPointQ16(-3) / FixedPointQ16(0)).raw(), -INT32_MAX);
+    EXPECT_EQ(ScalarMath<FixedPointQ16>::ratio(-5, 0).raw(), -INT32_MAX);
+}
+
+TEST(FixedPointTest, RatioHandlesLargeIntegerOperands) {
+    using Math = ScalarMath<FixedPointQ16>;
+
+    EXPECT_NEAR(Math::ratio(4 * 1000000LL, 80000).toDouble(), 50.0, Q16_LSB);
+    EXPECT_NEAR(Math::ratio(1000000000000000LL, 3000000000000LL).toDouble(), 1000.0 / 3.0, Q16_LSB);
+    EXPECT_NEAR(Math::ratio(-7, 2).toDouble(), -3.5, Q16_LSB);
+}
+
+TEST(FixedPointTest, NormMatchesDoubleWithoutOverflow) {
+    using Math = ScalarMath<FixedPointQ16>;
+
+    EXPECT_NEAR(Math::norm(3, 4, 12).toDouble(), 13.0, Q16_LSB);
+    // Squares of these components overflow Q15.16 but not the 64 bit sum
+    EXPECT_NEAR(Math::norm(20000, 0, 0).toDouble(), 20000.0, Q16_LSB);
+
+    Random random;
+    for (int i = 0; i < 10000; i++) {
+        double x = random.uniform(-10.0, 10.0);
+        double y = random.uniform(-10.0, 10.0);
+        double z = random.uniform(-10.0, 10.0);
+        double expected = std::sqrt(x * x + y * y + z * z);
+        double actual = Math::norm(Math::fromDouble(x), Math::fromDouble(y), Math::fromDouble(z)).toDouble();
+
+        EXPECT_NEAR(actual, expected, 2.0 * Q16_LSB);
+    }
+}
+
+TEST(FixedPointTest, RoundToIntRoundsHalfAwayFromZero) {
+    using Math = ScalarMath<FixedPointQ16>;
+
+    EXPECT_EQ(Math::roundToInt(FixedPointQ16::fromDouble(2.5)), 3);
+    EXPECT_EQ(Math::roundToInt(FixedPointQ16::fromDouble(-2.5)), -3);
+    EXPECT_EQ(Math::roundToInt(FixedPointQ16::fromDouble(2.49)), 2);
+    EXPECT_EQ(Math::roundToInt(FixedPointQ16::fromDouble(-126.6)), -127);
+}
+
+// ----------------------------------------------------------------------
+// Error bounds against the double reference
+// ----------------------------------------------------------------------
+
+TEST(DetumbleScalarTest, BDotErrorIsBounded) {
+    using FloatBDot = BasicBDot<BDOT_STENCIL_POINTS, float>;
+    using FixedBDot = BasicBDot<BDOT_STENCIL_POINTS, FixedPointQ16>;
+
+    // Dipoles reach tens of A·m² at the hysteresis threshold. Q15.16 is dominated by quantizing the field to
+    // 1.5e-5 G, which the stencil amplifies by Σ|w_i| / 𝚫t = 75 s⁻¹ and the gain by up to 5.
+    EXPECT_LT(maxBDotError<float>(FloatBDot::DerivativeMethod::CENTRAL_DIFFERENCE, FloatBDot::SamplingMode::BATCH),
+              1e-4);
+    EXPECT_LT(maxBDotError<float>(FloatBDot::DerivativeMethod::CENTRAL_DIFFERENCE,
+                                  FloatBDot::SamplingMode::STREAMING),
+              1e-4);
+    EXPECT_LT(maxBDotError<float>(FloatBDot::DerivativeMethod::LEAST_SQUARES, FloatBDot::SamplingMode::STREAMING),
+              1e-4);
+
+    EXPECT_LT(maxBDotError<FixedPointQ16>(FixedBDot::DerivativeMethod::CENTRAL_DIFFERENCE,
+                                          FixedBDot::SamplingMode::BATCH),
+              5e-3);
+    EXPECT_LT(maxBDotError<FixedPointQ16>(FixedBDot::DerivativeMethod::CENTRAL_DIFFERENCE,
+                                          FixedBDot::SamplingMode::STREAMING),
+              5e-3);
+    EXPECT_LT(maxBDotError<FixedPointQ16>(FixedBDot::DerivativeMethod::LEAST_SQUARES,
+                                          FixedBDot::SamplingMode::STREAMING),
+              5e-3);
+}
+
+TEST(DetumbleScalarTest, DriveLevelsWithinOneCount) {
+    EXPECT_LE(maxDriveLevelError<float>(), 1);
+    EXPECT_LE(maxDriveLevelError<FixedPointQ16>(), 1);
+}
+
+TEST(DetumbleScalarTest, StrategyDecisionsMatchAwayFromThresholds) {
+    EXPECT_EQ(strategyMismatches<float>(), 0);
+    EXPECT_EQ(strategyMismatches<FixedPointQ16>(), 0);
+}
+
+TEST(DetumbleScalarTest, ConstexprStencilWeightsMatchDouble) {
+    constexpr Components::CentralDifferenceStencil<5> reference;
+    constexpr Components::CentralDifferenceStencil<5, FixedPointQ16> fixed;
+    constexpr Components::CentralDifferenceStencil<5, float> single;
+
+    for (std::size_t i = 0; i < 5; i++) {
+        EXPECT_NEAR(fixed.weights[i].toDouble(), reference.weights[i], Q16_LSB / 2.0);
+        EXPECT_NEAR(single.weights[i], reference.weights[i], 1e-7);
+    }
+}
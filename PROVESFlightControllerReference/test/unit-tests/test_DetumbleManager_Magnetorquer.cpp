@@ -81,3 +81,15 @@ TEST_F(MagnetorquerTest, ZeroArea) {
     // computeTargetCurrent: if area == 0, return 0.0.
     EXPECT_EQ(m_torquer.magneticMomentToCurrent(1.0), 0);
 }
+
+TEST_F(MagnetorquerTest, DriveLevelPerMagneticMoment) {
+    // Max Dipole 1.0 A*m^2 -> 127 drive levels per A*m^2
+    EXPECT_NEAR(m_torquer.getDriveLevelPerMagneticMoment(), 127.0, 1e-9);
+
+    m_torquer.m_direction_sign = Magnetorquer::NEGATIVE;
+    EXPECT_NEAR(m_torquer.getDriveLevelPerMagneticMoment(), -127.0, 1e-9);
+
+    // A coil that cannot produce a moment has no gain
+    m_torquer.m_resistance = 0.0;
+    EXPECT_EQ(m_torquer.getDriveLevelPerMagneticMoment(), 0.0);
+}
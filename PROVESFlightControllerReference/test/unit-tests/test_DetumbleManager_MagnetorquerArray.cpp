@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+
+#include "PROVESFlightControllerReference/Components/DetumbleManager/MagnetorquerArray.hpp"
+
+using Components::Magnetorquer;
+using Components::MagnetorquerArray;
+
+constexpr double PI = 3.14159265358979323846;
+
+class MagnetorquerArrayTest : public ::testing::Test {
+  protected:
+    Magnetorquer m_x_plus;
+    Magnetorquer m_x_minus;
+    Magnetorquer m_y_plus;
+    Magnetorquer m_y_minus;
+    Magnetorquer m_z_minus;
+    MagnetorquerArray m_array;
+
+    //! Rectangular 0.1 m x 0.2 m coil with 100 turns at 0.5 A max -> 1.0 A*m^2 at full drive
+    static void rectangular(Magnetorquer& coil, Magnetorquer::DirectionSign sign) {
+        coil.m_shape = Magnetorquer::CoilShape::RECTANGULAR;
+        coil.m_width = 0.1;
+        coil.m_length = 0.2;
+        coil.m_turns = 100.0;
+        coil.m_voltage = 5.0;
+        coil.m_resistance = 10.0;
+        coil.m_direction_sign = sign;
+    }
+
+    void SetUp() override {
+        rectangular(m_x_plus, Magnetorquer::POSITIVE);
+        rectangular(m_x_minus, Magnetorquer::NEGATIVE);
+        rectangular(m_y_plus, Magnetorquer::POSITIVE);
+        rectangular(m_y_minus, Magnetorquer::NEGATIVE);
+
+        // Circular Z coil with half the resistance -> 1.0 A max -> 3.14159 A*m^2 at full drive
+        m_z_minus.m_shape = Magnetorquer::CoilShape::CIRCULAR;
+        m_z_minus.m_diameter = 0.2;
+        m_z_minus.m_turns = 100.0;
+        m_z_minus.m_voltage = 5.0;
+        m_z_minus.m_resistance = 5.0;
+        m_z_minus.m_direction_sign = Magnetorquer::NEGATIVE;
+
+        this->configure();
+    }
+
+    void configure() {
+        m_array.configure(MagnetorquerArray::X_PLUS, 0, m_x_plus);
+        m_array.configure(MagnetorquerArray::X_MINUS, 0, m_x_minus);
+        m_array.configure(MagnetorquerArray::Y_PLUS, 1, m_y_plus);
+        m_array.configure(MagnetorquerArray::Y_MINUS, 1, m_y_minus);
+        m_array.configure(MagnetorquerArray::Z_MINUS, 2, m_z_minus);
+    }
+};
+
+TEST_F(MagnetorquerArrayTest, MatchesPerCoilConversionBelowSaturation) {
+    const std::array<std::array<double, 3>, 4> moments = {{
+        {0.5, -0.25, 1.0},
+        {-0.9, 0.1, -2.5},
+        {0.0, 0.0, 0.0},
+        {0.013, -0.77, 0.31},
+    }};
+
+    for (const std::array<double, 3>& moment : moments) {
+        std::array<std::int8_t, MagnetorquerArray::COIL_COUNT> levels = m_array.magneticMomentToDriveLevels(moment);
+        EXPECT_EQ(levels[MagnetorquerArray::X_PLUS], m_x_plus.magneticMomentToCurrent(moment[0]));
+        EXPECT_EQ(levels[MagnetorquerArray::X_MINUS], m_x_minus.magneticMomentToCurrent(moment[0]));
+        EXPECT_EQ(levels[MagnetorquerArray::Y_PLUS], m_y_plus.magneticMomentToCurrent(moment[1]));
+        EXPECT_EQ(levels[MagnetorquerArray::Y_MINUS], m_y_minus.magneticMomentToCurrent(moment[1]));
+        EXPECT_EQ(levels[MagnetorquerArray::Z_MINUS], m_z_minus.magneticMomentToCurrent(moment[2]));
+    }
+}
+
+TEST_F(MagnetorquerArrayTest, SaturationPreservesDipoleDirection) {
+    // X needs 4x full drive, Y 60% of full drive
+    std::array<double, 3> moment = {4.0, 0.6, 0.0};
+    std::array<std::int8_t, MagnetorquerArray::COIL_COUNT> levels = m_array.magneticMomentToDriveLevels(moment);
+
+    // The most loaded coil sits at full drive and the others keep their ratio to it
+    EXPECT_EQ(levels[MagnetorquerArray::X_PLUS], 127);
+    EXPECT_EQ(levels[MagnetorquerArray::X_MINUS], -127);
+    EXPECT_EQ(levels[MagnetorquerArray::Y_PLUS], 19);
+    EXPECT_EQ(levels[MagnetorquerArray::Y_MINUS], -19);
+    EXPECT_EQ(levels[MagnetorquerArray::Z_MINUS], 0);
+
+    // Clamping each coil on its own drives Y at 76 and turns the dipole 22 degrees off the request
+    EXPECT_EQ(m_y_plus.magneticMomentToCurrent(moment[1]), 76);
+    double requested_angle = std::atan2(moment[1], moment[0]);
+    double array_angle = std::atan2(levels[MagnetorquerArray::Y_PLUS], levels[MagnetorquerArray::X_PLUS]);
+    EXPECT_NEAR(array_angle, requested_angle, 0.01);
+}
+
+TEST_F(MagnetorquerArrayTest, SaturationAccountsForCoilStrength) {
+    // The Z coil is stronger, so X saturates first even though Z asks for a larger moment
+    std::array<double, 3> moment = {-2.0, 0.0, 3.0};
+    std::array<std::int8_t, MagnetorquerArray::COIL_COUNT> levels = m_array.magneticMomentToDriveLevels(moment);
+
+    EXPECT_EQ(levels[MagnetorquerArray::X_PLUS], -127);
+    EXPECT_EQ(levels[MagnetorquerArray::X_MINUS], 127);
+
+    // Z drive = 127 * 3 / pi, scaled by half
+    EXPECT_EQ(levels[MagnetorquerArray::Z_MINUS], static_cast<std::int8_t>(std::round(-127.0 * 3.0 / PI / 2.0)));
+}
+
+TEST_F(MagnetorquerArrayTest, ReconfigureRebuildsGains) {
+    std::array<double, 3> moment = {0.6, 0.0, 0.0};
+    EXPECT_EQ(m_array.magneticMomentToDriveLevels(moment)[MagnetorquerArray::X_PLUS], 76);
+
+    // Doubling the resistance halves the current, so the same moment needs twice the drive
+    m_x_plus.m_resistance = 20.0;
+    this->configure();
+    EXPECT_EQ(m_array.magneticMomentToDriveLevels(moment)[MagnetorquerArray::X_PLUS], 127);
+
+    // The unchanged X- coil is scaled down with it and now supplies half the drive
+    EXPECT_NEAR(m_array.magneticMomentToDriveLevels(moment)[MagnetorquerArray::X_MINUS], -63.5, 0.5);
+}
+
+TEST_F(MagnetorquerArrayTest, UnusableCoilStaysOff) {
+    m_y_minus.m_turns = 0.0;
+    this->configure();
+
+    std::array<double, 3> moment = {0.0, 5.0, 0.0};
+    std::array<std::int8_t, MagnetorquerArray::COIL_COUNT> levels = m_array.magneticMomentToDriveLevels(moment);
+    EXPECT_EQ(levels[MagnetorquerArray::Y_PLUS], 127);
+    EXPECT_EQ(levels[MagnetorquerArray::Y_MINUS], 0);
+}
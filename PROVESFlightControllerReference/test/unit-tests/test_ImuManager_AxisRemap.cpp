@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "PROVESFlightControllerReference/Components/ImuManager/AxisRemap.hpp"
+
+using Components::AxisRemap;
+using SignedAxis = AxisRemap::SignedAxis;
+
+namespace {
+
+//! Same layout as Zephyr's sensor_value
+struct FixedValue {
+    std::int32_t val1;
+    std::int32_t val2;
+};
+
+std::array<double, 3> remap(const AxisRemap& remap, std::array<double, 3> v) {
+    remap.apply(v[0], v[1], v[2]);
+    return v;
+}
+
+}  // namespace
+
+TEST(AxisRemapTest, DefaultIsIdentity) {
+    AxisRemap identity;
+    EXPECT_EQ(remap(identity, {1.0, 2.0, 3.0}), (std::array<double, 3>{1.0, 2.0, 3.0}));
+    EXPECT_EQ(identity.determinant(), 1);
+}
+
+TEST(AxisRemapTest, QuarterTurnsMatchTheInPlaneOrientations) {
+    const std::array<double, 3> v = {1.0, 2.0, 3.0};
+
+    // ROTATED_90_DEG_CCW: x = -y, y = x
+    EXPECT_EQ(remap(AxisRemap::quarterTurnsZ(1), v), (std::array<double, 3>{-2.0, 1.0, 3.0}));
+    // ROTATED_180_DEG: x = -x, y = -y
+    EXPECT_EQ(remap(AxisRemap::quarterTurnsZ(2), v), (std::array<double, 3>{-1.0, -2.0, 3.0}));
+    // ROTATED_90_DEG_CW: x = y, y = -x
+    EXPECT_EQ(remap(AxisRemap::quarterTurnsZ(3), v), (std::array<double, 3>{2.0, -1.0, 3.0}));
+    EXPECT_EQ(remap(AxisRemap::quarterTurnsZ(-1), v), remap(AxisRemap::quarterTurnsZ(3), v));
+    EXPECT_EQ(remap(AxisRemap::quarterTurnsZ(4), v), v);
+}
+
+TEST(AxisRemapTest, SignedAxesBuildArbitraryMountings) {
+    // Board mounted on its side: body X from sensor -Z, body Y from sensor +X, body Z from sensor -Y
+    AxisRemap side;
+    ASSERT_TRUE(AxisRemap::fromSignedAxes({SignedAxis::NEG_Z, SignedAxis::POS_X, SignedAxis::NEG_Y}, side));
+    EXPECT_EQ(remap(side, {1.0, 2.0, 3.0}), (std::array<double, 3>{-3.0, 1.0, -2.0}));
+    EXPECT_EQ(side.element(0, 2), -1);
+    EXPECT_EQ(side.element(1, 0), 1);
+    EXPECT_EQ(side.element(2, 1), -1);
+    EXPECT_EQ(side.element(0, 0), 0);
+    EXPECT_EQ(side.determinant(), 1);
+
+    // Mirrored mounting
+    AxisRemap mirrored;
+    ASSERT_TRUE(AxisRemap::fromSignedAxes({SignedAxis::POS_Y, SignedAxis::POS_X, SignedAxis::POS_Z}, mirrored));
+    EXPECT_EQ(mirrored.determinant(), -1);
+}
+
+TEST(AxisRemapTest, RejectsRepeatedSensorAxes) {
+    AxisRemap remapping = AxisRemap::quarterTurnsZ(1);
+    EXPECT_FALSE(AxisRemap::fromSignedAxes({SignedAxis::POS_X, SignedAxis::NEG_X, SignedAxis::POS_Z}, remapping));
+
+    // Left unchanged
+    EXPECT_EQ(remap(remapping, {1.0, 2.0, 3.0}), (std::array<double, 3>{-2.0, 1.0, 3.0}));
+}
+
+TEST(AxisRemapTest, ComposeAppliesFirstThenSecond) {
+    AxisRemap mounting;
+    ASSERT_TRUE(AxisRemap::fromSignedAxes({SignedAxis::POS_Z, SignedAxis::POS_Y, SignedAxis::NEG_X}, mounting));
+    AxisRemap turn = AxisRemap::quarterTurnsZ(1);
+
+    const std::array<double, 3> v = {1.0, 2.0, 3.0};
+    EXPECT_EQ(remap(turn.compose(mounting), v), remap(turn, remap(mounting, v)));
+    EXPECT_EQ(turn.compose(mounting).determinant(), turn.determinant() * mounting.determinant());
+}
+
+TEST(AxisRemapTest, FixedPointValuesAreRemappedExactly) {
+    AxisRemap remapping;
+    ASSERT_TRUE(AxisRemap::fromSignedAxes({SignedAxis::NEG_Y, SignedAxis::POS_Z, SignedAxis::NEG_X}, remapping));
+
+    FixedValue x = {9, 806650};
+    FixedValue y = {-1, -234567};
+    FixedValue z = {0, 999999};
+    remapping.apply(x, y, z);
+
+    EXPECT_EQ(x.val1, 1);
+    EXPECT_EQ(x.val2, 234567);
+    EXPECT_EQ(y.val1, 0);
+    EXPECT_EQ(y.val2, 999999);
+    EXPECT_EQ(z.val1, -9);
+    EXPECT_EQ(z.val2, -806650);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/ImuManager/BurstCapture.hpp"
+
+using Components::BurstCapture;
+using Components::Lsm6dsoFifo;
+
+namespace {
+
+constexpr std::size_t RECORDS_PER_BUFFER = 4;
+constexpr std::size_t BUFFER_SIZE = RECORDS_PER_BUFFER * BurstCapture::RECORD_SIZE;
+
+// 1666 Hz is 24 timestamp ticks of 25 us apart
+constexpr double SAMPLING_FREQUENCY_HZ = 1e6 / (24 * Lsm6dsoFifo::TIMESTAMP_TICK_US);
+constexpr std::uint32_t PERIOD_TICKS = 24;
+
+Lsm6dsoFifo::Sample sample(std::uint32_t ticks, std::int16_t base) {
+    Lsm6dsoFifo::Sample s{};
+    s.timestamp_ticks = ticks;
+    s.acceleration_raw = {base, static_cast<std::int16_t>(-base), static_cast<std::int16_t>(base + 1)};
+    s.angular_velocity_raw = {static_cast<std::int16_t>(base * 2), -32768, 32767};
+    return s;
+}
+
+// Write everything pending into file, as the component does between drains
+void drain(BurstCapture& capture, std::vector<std::uint8_t>& file) {
+    const std::uint8_t* data;
+    std::size_t size;
+    while (capture.pendingWrite(data, size)) {
+        file.insert(file.end(), data, data + size);
+        capture.written(size);
+    }
+}
+
+}  // namespace
+
+TEST(BurstCaptureTest, HeaderRoundTrips) {
+    BurstCapture::Header header{};
+    header.sampling_frequency_hz = 1666.0f;
+    header.accel_scale = 0.000598f;
+    header.gyro_scale = 0.0001527f;
+    header.start_seconds = 1234567;
+    header.start_useconds = 890123;
+    header.start_ticks = 0xFFFFFF00;
+    header.axes = {5, 0, 3};
+    header.records = 42;
+    header.dropped = 7;
+
+    std::uint8_t bytes[BurstCapture::HEADER_SIZE];
+    BurstCapture::encodeHeader(header, bytes);
+    EXPECT_EQ(bytes[0], 'I');
+    EXPECT_EQ(bytes[1], 'M');
+    EXPECT_EQ(bytes[2], 'U');
+    EXPECT_EQ(bytes[3], 'B');
+
+    BurstCapture::Header decoded{};
+    ASSERT_TRUE(BurstCapture::decodeHeader(bytes, decoded));
+    EXPECT_EQ(decoded.sampling_frequency_hz, header.sampling_frequency_hz);
+    EXPECT_EQ(decoded.accel_scale, header.accel_scale);
+    EXPECT_EQ(decoded.gyro_scale, header.gyro_scale);
+    EXPECT_EQ(decoded.start_seconds, header.start_seconds);
+    EXPECT_EQ(decoded.start_useconds, header.start_useconds);
+    EXPECT_EQ(decoded.start_ticks, header.start_ticks);
+    EXPECT_EQ(decoded.axes, header.axes);
+    EXPECT_EQ(decoded.records, 42u);
+    EXPECT_EQ(decoded.dropped, 7u);
+
+    // The counts are patched in place when the capture ends
+    BurstCapture::encodeCounts(100, 3, bytes + BurstCapture::COUNTS_OFFSET);
+    ASSERT_TRUE(BurstCapture::decodeHeader(bytes, decoded));
+    EXPECT_EQ(decoded.records, 100u);
+    EXPECT_EQ(decoded.dropped, 3u);
+
+    bytes[4] = BurstCapture::VERSION + 1;
+    EXPECT_FALSE(BurstCapture::decodeHeader(bytes, decoded));
+}
+
+TEST(BurstCaptureTest, RecordRoundTripsRawCounts) {
+    Lsm6dsoFifo::Sample in = sample(0x12345678, -1234);
+    std::uint8_t bytes[BurstCapture::RECORD_SIZE];
+    BurstCapture::encodeRecord(in, bytes);
+
+    Lsm6dsoFifo::Sample out{};
+    BurstCapture::decodeRecord(bytes, out);
+    EXPECT_EQ(out.timestamp_ticks, in.timestamp_ticks);
+    EXPECT_EQ(out.acceleration_raw, in.acceleration_raw);
+    EXPECT_EQ(out.angular_velocity_raw, in.angular_velocity_raw);
+}
+
+TEST(BurstCaptureTest, FillsOneBufferWhileTheOtherIsWritten) {
+    std::uint8_t storage[BurstCapture::BUFFER_COUNT * BUFFER_SIZE];
+    BurstCapture capture(storage, BUFFER_SIZE);
+    capture.start(SAMPLING_FREQUENCY_HZ);
+
+    const std::uint8_t* data;
+    std::size_t size;
+    for (std::uint32_t i = 0; i < RECORDS_PER_BUFFER; i++) {
+        capture.append(sample(i * PERIOD_TICKS, static_cast<std::int16_t>(i)));
+    }
+    // The first buffer is only handed over once the next record needs room
+    EXPECT_FALSE(capture.pendingWrite(data, size));
+
+    capture.append(sample(RECORDS_PER_BUFFER * PERIOD_TICKS, RECORDS_PER_BUFFER));
+    ASSERT_TRUE(capture.pendingWrite(data, size));
+    EXPECT_EQ(size, BUFFER_SIZE);
+    EXPECT_EQ(data, storage);
+
+    // A partial write leaves the rest pending, and filling carries on meanwhile
+    capture.written(BurstCapture::RECORD_SIZE);
+    capture.append(sample((RECORDS_PER_BUFFER + 1) * PERIOD_TICKS, RECORDS_PER_BUFFER + 1));
+    ASSERT_TRUE(capture.pendingWrite(data, size));
+    EXPECT_EQ(size, BUFFER_SIZE - BurstCapture::RECORD_SIZE);
+    capture.written(size);
+    EXPECT_FALSE(capture.pendingWrite(data, size));
+
+    // Finishing hands over the partly filled buffer
+    capture.finish();
+    ASSERT_TRUE(capture.pendingWrite(data, size));
+    EXPECT_EQ(data, storage + BUFFER_SIZE);
+    EXPECT_EQ(size, 2 * BurstCapture::RECORD_SIZE);
+    capture.written(size);
+    EXPECT_FALSE(capture.pendingWrite(data, size));
+    EXPECT_EQ(capture.getRecords(), RECORDS_PER_BUFFER + 2);
+    EXPECT_EQ(capture.getDropped(), 0u);
+}
+
+TEST(BurstCaptureTest, DropsWhenBothBuffersAreFull) {
+    std::uint8_t storage[BurstCapture::BUFFER_COUNT * BUFFER_SIZE];
+    BurstCapture capture(storage, BUFFER_SIZE);
+    capture.start(SAMPLING_FREQUENCY_HZ);
+
+    const std::uint32_t total = 3 * RECORDS_PER_BUFFER;
+    for (std::uint32_t i = 0; i < total; i++) {
+        capture.append(sample(i * PERIOD_TICKS, static_cast<std::int16_t>(i)));
+    }
+    EXPECT_EQ(capture.getRecords(), 2 * RECORDS_PER_BUFFER);
+    EXPECT_EQ(capture.getDropped(), RECORDS_PER_BUFFER);
+
+    // Once written, records resume in order after the gap
+    std::vector<std::uint8_t> file;
+    drain(capture, file);
+    capture.append(sample(total * PERIOD_TICKS, static_cast<std::int16_t>(total)));
+    capture.finish();
+    drain(capture, file);
+
+    ASSERT_EQ(file.size(), (2 * RECORDS_PER_BUFFER + 1) * BurstCapture::RECORD_SIZE);
+    for (std::size_t i = 0; i < 2 * RECORDS_PER_BUFFER; i++) {
+        Lsm6dsoFifo::Sample out{};
+        BurstCapture::decodeRecord(file.data() + i * BurstCapture::RECORD_SIZE, out);
+        EXPECT_EQ(out.timestamp_ticks, i * PERIOD_TICKS);
+    }
+}
+
+TEST(BurstCaptureTest, CountsFifoOverrunsFromTimestampGaps) {
+    std::uint8_t storage[BurstCapture::BUFFER_COUNT * BUFFER_SIZE];
+    BurstCapture capture(storage, BUFFER_SIZE);
+    capture.start(SAMPLING_FREQUENCY_HZ);
+
+    // Three samples missing across a counter wrap, plus jitter that must not count
+    const std::uint32_t first = 0xFFFFFFFF - PERIOD_TICKS;
+    capture.append(sample(first, 0));
+    capture.append(sample(first + PERIOD_TICKS + 1, 1));
+    capture.append(sample(first + 5 * PERIOD_TICKS, 2));
+    EXPECT_EQ(capture.getRecords(), 3u);
+    EXPECT_EQ(capture.getDropped(), 3u);
+
+    // Restarting clears the counters
+    capture.start(SAMPLING_FREQUENCY_HZ);
+    EXPECT_EQ(capture.getRecords(), 0u);
+    EXPECT_EQ(capture.getDropped(), 0u);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "PROVESFlightControllerReference/Components/ImuManager/CachedSample.hpp"
+
+using Components::CachedSample;
+
+TEST(CachedSampleTest, EmptyCacheMisses) {
+    CachedSample<double> cache;
+    double value = -1.0;
+
+    EXPECT_FALSE(cache.get(0U, 10000U, value));
+    EXPECT_EQ(value, -1.0);
+    EXPECT_EQ(cache.getHits(), 0U);
+}
+
+TEST(CachedSampleTest, HitsWithinMaximumAge) {
+    CachedSample<double> cache;
+    double value = 0.0;
+
+    cache.store(1.5, 1000000U);
+
+    EXPECT_TRUE(cache.get(1000000U, 10000U, value));
+    EXPECT_EQ(value, 1.5);
+    EXPECT_TRUE(cache.get(1009999U, 10000U, value));
+    EXPECT_EQ(cache.getHits(), 2U);
+
+    // A reading exactly max age old is stale
+    EXPECT_FALSE(cache.get(1010000U, 10000U, value));
+    EXPECT_EQ(cache.getHits(), 2U);
+
+    // A fresh store restarts the age
+    cache.store(2.5, 1010000U);
+    EXPECT_TRUE(cache.get(1015000U, 10000U, value));
+    EXPECT_EQ(value, 2.5);
+}
+
+TEST(CachedSampleTest, ZeroMaximumAgeAlwaysMisses) {
+    CachedSample<double> cache;
+    double value = 0.0;
+
+    cache.store(1.0, 500U);
+    EXPECT_FALSE(cache.get(500U, 0U, value));
+    EXPECT_EQ(cache.value(), 1.0);
+}
+
+TEST(CachedSampleTest, UptimeMovingBackwardsMisses) {
+    CachedSample<double> cache;
+    double value = 0.0;
+
+    cache.store(1.0, 5000U);
+    EXPECT_FALSE(cache.get(4999U, 10000U, value));
+}
+
+TEST(CachedSampleTest, InvalidateForcesAFetch) {
+    CachedSample<double> cache;
+    double value = 0.0;
+
+    cache.store(1.0, 0U);
+    cache.invalidate();
+    EXPECT_FALSE(cache.get(1U, 10000U, value));
+
+    cache.store(3.0, 2U);
+    EXPECT_TRUE(cache.get(3U, 10000U, value));
+    EXPECT_EQ(value, 3.0);
+}
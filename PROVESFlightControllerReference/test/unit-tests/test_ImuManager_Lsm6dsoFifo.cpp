@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/ImuManager/Lsm6dsoFifo.hpp"
+
+using Components::Lsm6dsoFifo;
+
+namespace {
+
+constexpr double STANDARD_GRAVITY = 9.80665;
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+using Word = std::vector<std::uint8_t>;
+
+Word timestampWord(std::uint32_t ticks) {
+    return Word{static_cast<std::uint8_t>(static_cast<std::uint8_t>(Lsm6dsoFifo::Tag::TIMESTAMP) << 3),
+                static_cast<std::uint8_t>(ticks),
+                static_cast<std::uint8_t>(ticks >> 8),
+                static_cast<std::uint8_t>(ticks >> 16),
+                static_cast<std::uint8_t>(ticks >> 24),
+                0,
+                0};
+}
+
+Word dataWord(Lsm6dsoFifo::Tag tag, std::int16_t x, std::int16_t y, std::int16_t z) {
+    Word word{static_cast<std::uint8_t>(static_cast<std::uint8_t>(tag) << 3)};
+    for (std::int16_t value : {x, y, z}) {
+        std::uint16_t raw = static_cast<std::uint16_t>(value);
+        word.push_back(static_cast<std::uint8_t>(raw));
+        word.push_back(static_cast<std::uint8_t>(raw >> 8));
+    }
+    return word;
+}
+
+// Decode a burst and collect the completed samples
+std::vector<Lsm6dsoFifo::Sample> decode(Lsm6dsoFifo& fifo, const std::vector<Word>& words) {
+    std::vector<Lsm6dsoFifo::Sample> samples;
+    for (const Word& word : words) {
+        Lsm6dsoFifo::Sample sample{};
+        if (fifo.decodeWord(word.data(), sample)) {
+            samples.push_back(sample);
+        }
+    }
+    return samples;
+}
+
+}  // namespace
+
+TEST(Lsm6dsoFifoTest, BatchDataRateCodesMatchSamplingFrequencies) {
+    EXPECT_EQ(Lsm6dsoFifo::batchDataRateCode(0.0), 0);
+    EXPECT_EQ(Lsm6dsoFifo::batchDataRateCode(12.5), 1);
+    EXPECT_EQ(Lsm6dsoFifo::batchDataRateCode(26.0), 2);
+    EXPECT_EQ(Lsm6dsoFifo::batchDataRateCode(104.0), 4);
+    EXPECT_EQ(Lsm6dsoFifo::batchDataRateCode(416.0), 6);
+    EXPECT_EQ(Lsm6dsoFifo::batchDataRateCode(1666.0), 8);
+    EXPECT_EQ(Lsm6dsoFifo::batchDataRateCode(6666.0), 10);
+    EXPECT_EQ(Lsm6dsoFifo::batchDataRateCode(1.0), 1);
+    EXPECT_EQ(Lsm6dsoFifo::batchDataRateCode(20000.0), Lsm6dsoFifo::MAX_BATCH_DATA_RATE);
+}
+
+TEST(Lsm6dsoFifoTest, ControlRegisterValues) {
+    EXPECT_EQ(Lsm6dsoFifo::fifoCtrl3(1, 4), 0x41);
+    EXPECT_EQ(Lsm6dsoFifo::fifoCtrl4(true), 0x46);
+    EXPECT_EQ(Lsm6dsoFifo::fifoCtrl4(false), 0x00);
+}
+
+TEST(Lsm6dsoFifoTest, StatusRegisters) {
+    EXPECT_EQ(Lsm6dsoFifo::unreadWords(0x34, 0x00), 0x34u);
+    EXPECT_EQ(Lsm6dsoFifo::unreadWords(0x10, 0x42), 0x210u);
+    EXPECT_TRUE(Lsm6dsoFifo::overrun(0x42));
+    EXPECT_FALSE(Lsm6dsoFifo::overrun(0x83));
+}
+
+TEST(Lsm6dsoFifoTest, TimestampTicksAndWrap) {
+    const std::uint8_t bytes[] = {0x78, 0x56, 0x34, 0x12};
+    EXPECT_EQ(Lsm6dsoFifo::timestampTicks(bytes), 0x12345678u);
+
+    EXPECT_EQ(Lsm6dsoFifo::microsecondsBefore(1000u, 600u), 400 * 25);
+    EXPECT_EQ(Lsm6dsoFifo::microsecondsBefore(600u, 1000u), -400 * 25);
+
+    // The counter wrapped between the sample and the reference
+    EXPECT_EQ(Lsm6dsoFifo::microsecondsBefore(10u, 0xFFFFFFF0u), 26 * 25);
+}
+
+TEST(Lsm6dsoFifoTest, GroupsAreEmittedWhenTheNextTimestampArrives) {
+    Lsm6dsoFifo fifo;
+
+    std::vector<Lsm6dsoFifo::Sample> samples =
+        decode(fifo, {timestampWord(100), dataWord(Lsm6dsoFifo::Tag::GYROSCOPE, 1000, -1000, 0),
+                      dataWord(Lsm6dsoFifo::Tag::ACCELEROMETER, 0, 0, 16393), timestampWord(140),
+                      dataWord(Lsm6dsoFifo::Tag::GYROSCOPE, 2000, 0, 0)});
+
+    // Power on full scales are ±2 g and ±250 dps
+    ASSERT_EQ(samples.size(), 1u);
+    EXPECT_EQ(samples[0].timestamp_ticks, 100u);
+    EXPECT_NEAR(samples[0].angular_velocity[0], 1000 * 8.75e-3 * DEG_TO_RAD, 1e-12);
+    EXPECT_NEAR(samples[0].angular_velocity[1], -1000 * 8.75e-3 * DEG_TO_RAD, 1e-12);
+    EXPECT_NEAR(samples[0].acceleration[2], 16393 * 0.061e-3 * STANDARD_GRAVITY, 1e-12);
+
+    // The open group completes in the next burst and keeps the accelerometer value it was not batched with
+    samples = decode(fifo, {timestampWord(180)});
+    ASSERT_EQ(samples.size(), 1u);
+    EXPECT_EQ(samples[0].timestamp_ticks, 140u);
+    EXPECT_NEAR(samples[0].angular_velocity[0], 2000 * 8.75e-3 * DEG_TO_RAD, 1e-12);
+    EXPECT_NEAR(samples[0].acceleration[2], 16393 * 0.061e-3 * STANDARD_GRAVITY, 1e-12);
+}
+
+TEST(Lsm6dsoFifoTest, TimestampsWithoutDataDoNotEmitSamples) {
+    Lsm6dsoFifo fifo;
+
+    // Data before the first timestamp has no time and is only held
+    std::vector<Lsm6dsoFifo::Sample> samples =
+        decode(fifo, {dataWord(Lsm6dsoFifo::Tag::GYROSCOPE, 5, 5, 5), timestampWord(1), timestampWord(2)});
+    EXPECT_TRUE(samples.empty());
+}
+
+TEST(Lsm6dsoFifoTest, FullScaleSelectsSensitivity) {
+    Lsm6dsoFifo fifo;
+    fifo.setFullScale(0x0C, 0x0C);  // ±8 g, ±2000 dps
+
+    std::vector<Lsm6dsoFifo::Sample> samples =
+        decode(fifo, {timestampWord(0), dataWord(Lsm6dsoFifo::Tag::ACCELEROMETER, 100, 0, 0),
+                      dataWord(Lsm6dsoFifo::Tag::GYROSCOPE, 100, 0, 0), timestampWord(1)});
+    ASSERT_EQ(samples.size(), 1u);
+    EXPECT_NEAR(samples[0].acceleration[0], 100 * 0.244e-3 * STANDARD_GRAVITY, 1e-12);
+    EXPECT_NEAR(samples[0].angular_velocity[0], 100 * 70.0e-3 * DEG_TO_RAD, 1e-12);
+
+    fifo.setFullScale(0x04, 0x02);  // ±16 g, ±125 dps
+    samples = decode(fifo, {dataWord(Lsm6dsoFifo::Tag::ACCELEROMETER, 100, 0, 0),
+                            dataWord(Lsm6dsoFifo::Tag::GYROSCOPE, 100, 0, 0), timestampWord(2)});
+    ASSERT_EQ(samples.size(), 1u);
+    EXPECT_NEAR(samples[0].acceleration[0], 100 * 0.488e-3 * STANDARD_GRAVITY, 1e-12);
+    EXPECT_NEAR(samples[0].angular_velocity[0], 100 * 4.375e-3 * DEG_TO_RAD, 1e-12);
+}
+
+TEST(Lsm6dsoFifoTest, UnusedTagsAreCountedAndResetDropsTheOpenGroup) {
+    Lsm6dsoFifo fifo;
+
+    std::vector<Lsm6dsoFifo::Sample> samples =
+        decode(fifo, {timestampWord(10), dataWord(Lsm6dsoFifo::Tag::TEMPERATURE, 0, 0, 0),
+                      dataWord(Lsm6dsoFifo::Tag::CONFIG_CHANGE, 0, 0, 0),
+                      dataWord(Lsm6dsoFifo::Tag::GYROSCOPE, 1, 1, 1)});
+    EXPECT_TRUE(samples.empty());
+    EXPECT_EQ(fifo.getDiscardedWords(), 2u);
+
+    fifo.reset();
+    samples = decode(fifo, {timestampWord(20)});
+    EXPECT_TRUE(samples.empty());
+}
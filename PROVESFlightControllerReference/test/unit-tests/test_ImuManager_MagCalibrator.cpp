@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include "PROVESFlightControllerReference/Components/ImuManager/MagCalibrator.hpp"
+
+using Components::MagCalibrator;
+
+namespace {
+
+constexpr double FIELD_GAUSS = 0.45;
+
+struct Distortion {
+    std::array<double, 3> offset;  // Hard iron, gauss
+    std::array<double, 3> gain;    // Soft iron, per axis
+};
+
+double magnitude(double x, double y, double z) {
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+// Fold samples of a constant field seen from random attitudes through the distortion
+void feedSphere(MagCalibrator& calibrator,
+                const Distortion& distortion,
+                std::size_t samples,
+                double noise_gauss,
+                std::uint32_t seed) {
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::normal_distribution<double> noise(0.0, noise_gauss);
+    for (std::size_t i = 0; i < samples; i++) {
+        std::array<double, 3> direction = {normal(generator), normal(generator), normal(generator)};
+        double norm = magnitude(direction[0], direction[1], direction[2]);
+        std::array<double, 3> raw;
+        for (std::size_t axis = 0; axis < 3; axis++) {
+            raw[axis] = FIELD_GAUSS * direction[axis] / norm * distortion.gain[axis] + distortion.offset[axis] +
+                        noise(generator);
+        }
+        calibrator.add(raw[0], raw[1], raw[2]);
+    }
+}
+
+}  // namespace
+
+TEST(MagCalibratorTest, IdentityLeavesSamplesUnchanged) {
+    double x = 0.1, y = -0.2, z = 0.3;
+    MagCalibrator::apply(MagCalibrator::identity(), x, y, z);
+    EXPECT_DOUBLE_EQ(x, 0.1);
+    EXPECT_DOUBLE_EQ(y, -0.2);
+    EXPECT_DOUBLE_EQ(z, 0.3);
+}
+
+TEST(MagCalibratorTest, RecoversHardAndSoftIronFromAnExactEllipsoid) {
+    const Distortion distortion = {{0.12, -0.25, 0.04}, {1.2, 0.85, 1.05}};
+    MagCalibrator calibrator;
+    feedSphere(calibrator, distortion, 500, 0.0, 1);
+
+    MagCalibrator::Solution solution = MagCalibrator::identity();
+    ASSERT_TRUE(calibrator.solve(solution));
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        EXPECT_NEAR(solution.offset[axis], distortion.offset[axis], 1e-9);
+    }
+    // Scales undo the gains up to the common factor that maps the semi-axes onto their geometric mean
+    double mean_gain = std::cbrt(distortion.gain[0] * distortion.gain[1] * distortion.gain[2]);
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        EXPECT_NEAR(solution.scale[axis], mean_gain / distortion.gain[axis], 1e-9);
+    }
+    EXPECT_NEAR(solution.residual, 0.0, 1e-9);
+}
+
+TEST(MagCalibratorTest, CorrectedMagnitudeIsFlatWithNoise) {
+    const Distortion distortion = {{-0.08, 0.15, 0.3}, {0.9, 1.1, 1.25}};
+    MagCalibrator calibrator;
+    feedSphere(calibrator, distortion, 5000, 0.002, 2);
+
+    MagCalibrator::Solution solution = MagCalibrator::identity();
+    ASSERT_TRUE(calibrator.solve(solution));
+    for (std::size_t axis = 0; axis < 3; axis++) {
+        EXPECT_NEAR(solution.offset[axis], distortion.offset[axis], 2e-3);
+    }
+
+    // Spread of the magnitude over fresh samples, before and after correction
+    std::mt19937 generator(3);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    double raw_min = 1e9, raw_max = 0.0, corrected_min = 1e9, corrected_max = 0.0;
+    for (std::size_t i = 0; i < 1000; i++) {
+        std::array<double, 3> d = {normal(generator), normal(generator), normal(generator)};
+        double norm = magnitude(d[0], d[1], d[2]);
+        double x = FIELD_GAUSS * d[0] / norm * distortion.gain[0] + distortion.offset[0];
+        double y = FIELD_GAUSS * d[1] / norm * distortion.gain[1] + distortion.offset[1];
+        double z = FIELD_GAUSS * d[2] / norm * distortion.gain[2] + distortion.offset[2];
+        double raw = magnitude(x, y, z);
+        raw_min = std::fmin(raw_min, raw);
+        raw_max = std::fmax(raw_max, raw);
+        MagCalibrator::apply(solution, x, y, z);
+        double corrected = magnitude(x, y, z);
+        corrected_min = std::fmin(corrected_min, corrected);
+        corrected_max = std::fmax(corrected_max, corrected);
+    }
+    EXPECT_GT(raw_max - raw_min, 0.2);
+    EXPECT_LT(corrected_max - corrected_min, 0.01);
+}
+
+TEST(MagCalibratorTest, RefusesTooFewOrPlanarSamples) {
+    MagCalibrator calibrator;
+    MagCalibrator::Solution solution = MagCalibrator::identity();
+
+    feedSphere(calibrator, {{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}, MagCalibrator::MIN_SAMPLES - 1, 0.0, 4);
+    EXPECT_FALSE(calibrator.solve(solution));
+
+    // A spin about Z only sweeps the XY plane, which does not constrain the Z terms
+    calibrator.reset();
+    EXPECT_EQ(calibrator.getSamples(), 0u);
+    for (std::size_t i = 0; i < 360; i++) {
+        double angle = static_cast<double>(i) * 3.14159265358979323846 / 180.0;
+        calibrator.add(0.1 + FIELD_GAUSS * std::cos(angle), FIELD_GAUSS * std::sin(angle), 0.2);
+    }
+    EXPECT_FALSE(calibrator.solve(solution));
+    EXPECT_EQ(solution.scale, (std::array<double, 3>{1.0, 1.0, 1.0}));
+}
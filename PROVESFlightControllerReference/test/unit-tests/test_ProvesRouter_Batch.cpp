@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/ProvesRouter/Batch.hpp"
+
+using namespace Components::CommandBatch;
+
+namespace {
+
+// Defined from project/config/FpConstants.fpp and ProvesRouter.fpp by the test CMakeLists.txt
+constexpr size_t kMaxCommandSize = FW_COM_BUFFER_MAX_SIZE;
+constexpr size_t kMaxCommands = ROUTER_MAX_BATCH_COMMANDS;
+
+// A command packet: descriptor, opcode and argsSize argument bytes
+std::vector<uint8_t> makeCommand(uint32_t opCode, size_t argsSize = 0) {
+    std::vector<uint8_t> command = {0x00,
+                                    0x00,
+                                    static_cast<uint8_t>((opCode >> 24) & 0xFF),
+                                    static_cast<uint8_t>((opCode >> 16) & 0xFF),
+                                    static_cast<uint8_t>((opCode >> 8) & 0xFF),
+                                    static_cast<uint8_t>(opCode & 0xFF)};
+    for (size_t i = 0; i < argsSize; i++) {
+        command.push_back(static_cast<uint8_t>(i));
+    }
+    return command;
+}
+
+// A batch packet of the given command packets
+std::vector<uint8_t> makeBatch(const std::vector<std::vector<uint8_t>>& commands) {
+    std::vector<uint8_t> batch = {0x00, 0x80};
+    for (const auto& command : commands) {
+        batch.push_back(static_cast<uint8_t>(command.size() >> 8));
+        batch.push_back(static_cast<uint8_t>(command.size() & 0xFF));
+        batch.insert(batch.end(), command.begin(), command.end());
+    }
+    return batch;
+}
+
+// Command packets given as space-separated hex strings
+std::vector<std::vector<uint8_t>> parseCommands(const std::string& hexCommands) {
+    std::vector<std::vector<uint8_t>> commands;
+    std::istringstream stream(hexCommands);
+    std::string hex;
+    while (stream >> hex) {
+        std::vector<uint8_t> command;
+        for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+            command.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+        }
+        commands.push_back(command);
+    }
+    return commands;
+}
+
+Status validateBatch(const std::vector<uint8_t>& batch, size_t& count) {
+    return validate(batch.data(), batch.size(), kMaxCommandSize, kMaxCommands, count);
+}
+
+}  // namespace
+
+TEST(CommandBatchTest, CommandsAreReadInOrder) {
+    const std::vector<std::vector<uint8_t>> commands = {makeCommand(0x01000000), makeCommand(0x10065000, 3),
+                                                        makeCommand(0x2100B000, 12)};
+    const std::vector<uint8_t> batch = makeBatch(commands);
+
+    size_t count = 0;
+    ASSERT_EQ(validateBatch(batch, count), Status::Ok);
+    EXPECT_EQ(count, commands.size());
+
+    size_t offset = kHeaderSize;
+    Entry entry;
+    for (const auto& command : commands) {
+        ASSERT_TRUE(next(batch.data(), batch.size(), offset, entry));
+        EXPECT_EQ(std::vector<uint8_t>(entry.data, entry.data + entry.size), command);
+    }
+    EXPECT_FALSE(next(batch.data(), batch.size(), offset, entry));
+    EXPECT_EQ(offset, batch.size());
+}
+
+TEST(CommandBatchTest, GroundEncoderBatchRoundTrips) {
+    // Encoded from the same commands by Framing/src/command_batch.py at build time
+    const std::vector<std::vector<uint8_t>> commands = parseCommands(COMMAND_BATCH_COMMANDS);
+    std::ifstream file(COMMAND_BATCH_PACKET, std::ios::binary);
+    ASSERT_TRUE(file.good()) << COMMAND_BATCH_PACKET;
+    const std::vector<uint8_t> batch((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ASSERT_EQ(commands.back().size(), kMaxCommandSize);
+    EXPECT_EQ(batch, makeBatch(commands));
+
+    size_t count = 0;
+    ASSERT_EQ(validateBatch(batch, count), Status::Ok);
+    EXPECT_EQ(count, commands.size());
+
+    size_t offset = kHeaderSize;
+    Entry entry;
+    for (const auto& command : commands) {
+        ASSERT_TRUE(next(batch.data(), batch.size(), offset, entry));
+        EXPECT_EQ(std::vector<uint8_t>(entry.data, entry.data + entry.size), command);
+    }
+    EXPECT_FALSE(next(batch.data(), batch.size(), offset, entry));
+}
+
+TEST(CommandBatchTest, RejectsEmptyBatch) {
+    size_t count = 99;
+    EXPECT_EQ(validateBatch(makeBatch({}), count), Status::Empty);
+    EXPECT_EQ(count, 99u);
+    EXPECT_EQ(validate(nullptr, 10, kMaxCommandSize, kMaxCommands, count), Status::Empty);
+}
+
+TEST(CommandBatchTest, RejectsTruncatedBatch) {
+    const std::vector<uint8_t> first = makeCommand(0x01000000);
+    std::vector<uint8_t> batch = makeBatch({first, makeCommand(0x01000001, 4)});
+    const size_t firstEnd = kHeaderSize + kLengthSize + first.size();
+    size_t count = 0;
+
+    // Every cut short of the full batch is caught unless it falls exactly after the first command
+    for (size_t size = kHeaderSize + 1; size < batch.size(); size++) {
+        std::vector<uint8_t> cut(batch.begin(), batch.begin() + size);
+        const Status status = validateBatch(cut, count);
+        if (size == firstEnd) {
+            EXPECT_EQ(status, Status::Ok);
+            EXPECT_EQ(count, 1u);
+        } else {
+            EXPECT_EQ(status, Status::Truncated) << "size " << size;
+        }
+    }
+
+    // A stray byte after the last command is a truncated length prefix
+    batch.push_back(0x00);
+    EXPECT_EQ(validateBatch(batch, count), Status::Truncated);
+}
+
+TEST(CommandBatchTest, RejectsCommandWithoutOpcode) {
+    size_t count = 0;
+    EXPECT_EQ(validateBatch(makeBatch({makeCommand(0x01000000), {0x00, 0x00, 0x01}}), count),
+              Status::CommandTooShort);
+    EXPECT_EQ(validateBatch(makeBatch({{}}), count), Status::CommandTooShort);
+}
+
+TEST(CommandBatchTest, RejectsCommandLargerThanComBuffer) {
+    size_t count = 0;
+    EXPECT_EQ(validateBatch(makeBatch({makeCommand(0x01000000, kMaxCommandSize - kMinCommandSize)}), count),
+              Status::Ok);
+    EXPECT_EQ(validateBatch(makeBatch({makeCommand(0x01000000, kMaxCommandSize - kMinCommandSize + 1)}), count),
+              Status::CommandTooLong);
+}
+
+TEST(CommandBatchTest, RejectsTooManyCommands) {
+    std::vector<std::vector<uint8_t>> commands(kMaxCommands, makeCommand(0x01000000));
+    size_t count = 0;
+    EXPECT_EQ(validateBatch(makeBatch(commands), count), Status::Ok);
+    EXPECT_EQ(count, kMaxCommands);
+
+    commands.push_back(makeCommand(0x01000000));
+    EXPECT_EQ(validateBatch(makeBatch(commands), count), Status::TooManyCommands);
+}
+
+TEST(CommandBatchTest, ContextRoundTrips) {
+    uint32_t batch = 0;
+    uint32_t index = 0;
+    for (uint32_t b : {1u, 2u, 0x7FFFFFu}) {
+        for (uint32_t i = 0; i < kMaxCommands; i++) {
+            const uint32_t context = commandContext(b, i);
+            EXPECT_NE(context, 0u);
+            ASSERT_TRUE(decodeCommandContext(context, batch, index));
+            EXPECT_EQ(batch, b);
+            EXPECT_EQ(index, i);
+        }
+    }
+
+    // The batch number wraps without reaching the flag
+    ASSERT_TRUE(decodeCommandContext(commandContext(0x800001u, 3), batch, index));
+    EXPECT_EQ(batch, 1u);
+    EXPECT_EQ(index, 3u);
+}
+
+TEST(CommandBatchTest, SingleCommandContextIsNotBatched) {
+    uint32_t batch = 0;
+    uint32_t index = 0;
+    EXPECT_FALSE(decodeCommandContext(0u, batch, index));
+}
+
+TEST(CommandBatchTest, BatchCarriesMoreCommandsPerByte) {
+    // Frame overhead: TC primary header, security header, space packet header, MAC and FECF
+    const size_t frameOverhead = 5 + 6 + 6 + 16 + 2;
+    const size_t commandSize = makeCommand(0x01000000).size();
+
+    const std::vector<std::vector<uint8_t>> commands(kMaxCommands, makeCommand(0x01000000));
+
+    const size_t single = kMaxCommands * (frameOverhead + commandSize);
+    const size_t batched = frameOverhead + makeBatch(commands).size();
+    EXPECT_GE(static_cast<double>(single) / static_cast<double>(batched), 3.0);
+}
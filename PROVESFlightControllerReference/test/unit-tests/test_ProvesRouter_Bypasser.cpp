@@ -69,3 +69,20 @@ TEST(BypasserTest, AllowsWithExtraTrailingBytes) {
     auto buf = makePacket(0x01000000, /*totalSize=*/32);
     EXPECT_TRUE(bypassPacket(buf.data(), buf.size()));
 }
+
+TEST(BypasserTest, AdmitsAuthenticatedPackets) {
+    auto buf = makePacket(0xDEADBEEF);
+    EXPECT_EQ(admitPacket(buf.data(), buf.size(), true, false), Admission::Authenticated);
+    EXPECT_EQ(admitPacket(buf.data(), buf.size(), true, true), Admission::Authenticated);
+}
+
+TEST(BypasserTest, AdmitsAllowlistedSingleCommands) {
+    auto buf = makePacket(0x01000000);
+    EXPECT_EQ(admitPacket(buf.data(), buf.size(), false, false), Admission::Bypassed);
+}
+
+TEST(BypasserTest, NeverBypassesBatches) {
+    // A batch starting with an allowlisted opcode is still rejected without authentication
+    auto buf = makePacket(0x01000000);
+    EXPECT_EQ(admitPacket(buf.data(), buf.size(), false, true), Admission::Rejected);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/ProvesRouter/Handoff.hpp"
+
+using namespace Components::PacketHandoff;
+
+namespace {
+
+constexpr size_t kSlots = 4;
+
+struct Table {
+    Slot slots[kSlots];
+
+    Table() { reset(slots, kSlots); }
+
+    size_t claim(const uint8_t* data, size_t size) {
+        return Components::PacketHandoff::claim(slots, kSlots, data, size);
+    }
+
+    size_t release(const uint8_t* data, size_t& size) {
+        return Components::PacketHandoff::release(slots, kSlots, data, size);
+    }
+};
+
+}  // namespace
+
+TEST(HandoffTest, ReleaseReturnsClaimedSize) {
+    Table table;
+    uint8_t frame[64] = {};
+    size_t slot = table.claim(frame + 6, 40);
+    ASSERT_NE(slot, kNoSlot);
+
+    size_t size = 0;
+    EXPECT_EQ(table.release(frame + 6, size), slot);
+    EXPECT_EQ(size, 40u);
+
+    // A second return of the same buffer is not tracked
+    EXPECT_EQ(table.release(frame + 6, size), kNoSlot);
+}
+
+TEST(HandoffTest, UntrackedBufferIsNotReleased) {
+    Table table;
+    uint8_t frame[16] = {};
+    uint8_t copy[16] = {};
+    ASSERT_NE(table.claim(frame, sizeof(frame)), kNoSlot);
+
+    size_t size = 123;
+    EXPECT_EQ(table.release(copy, size), kNoSlot);
+    EXPECT_EQ(size, 123u);
+    EXPECT_EQ(table.release(nullptr, size), kNoSlot);
+}
+
+TEST(HandoffTest, NullBufferIsNotClaimed) {
+    Table table;
+    EXPECT_EQ(table.claim(nullptr, 10), kNoSlot);
+}
+
+TEST(HandoffTest, FullTableRefusesClaims) {
+    Table table;
+    uint8_t frames[kSlots + 1][8] = {};
+    for (size_t i = 0; i < kSlots; i++) {
+        EXPECT_NE(table.claim(frames[i], sizeof(frames[i])), kNoSlot);
+    }
+    EXPECT_EQ(table.claim(frames[kSlots], sizeof(frames[kSlots])), kNoSlot);
+
+    // Any return frees a slot for the next packet
+    size_t size = 0;
+    EXPECT_NE(table.release(frames[1], size), kNoSlot);
+    EXPECT_NE(table.claim(frames[kSlots], sizeof(frames[kSlots])), kNoSlot);
+}
+
+TEST(HandoffTest, OutOfOrderReturns) {
+    Table table;
+    uint8_t frames[kSlots][32] = {};
+    for (size_t i = 0; i < kSlots; i++) {
+        ASSERT_NE(table.claim(frames[i], i + 1), kNoSlot);
+    }
+
+    const size_t order[kSlots] = {2, 0, 3, 1};
+    for (size_t i : order) {
+        size_t size = 0;
+        EXPECT_NE(table.release(frames[i], size), kNoSlot);
+        EXPECT_EQ(size, i + 1);
+    }
+    for (const Slot& slot : table.slots) {
+        EXPECT_EQ(slot.data, nullptr);
+    }
+}
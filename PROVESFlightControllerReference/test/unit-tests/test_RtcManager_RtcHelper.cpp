@@ -39,3 +39,215 @@ TEST(RtcHelperTest, WrapAroundAtU32Max) {
     // Wrap from 4294967290 -> 5: forward delta is 11 microseconds
     EXPECT_EQ(helper.rescaleUseconds(0U, 5U), 11U);
 }
+
+TEST(RtcHelperTest, CachedEpochFirstResyncAnchorsAtSecondStart) {
+    RtcHelper helper;
+
+    EXPECT_FALSE(helper.isSynchronized());
+    EXPECT_TRUE(helper.resyncDue(0U, 60000000U));
+
+    // First reading anchors the epoch at the start of the observed second
+    EXPECT_EQ(helper.resync(1000U, 5000000U), 0);
+    EXPECT_TRUE(helper.isSynchronized());
+    EXPECT_EQ(helper.getResyncCount(), 1U);
+
+    std::uint32_t seconds = 0;
+    std::uint32_t useconds = 0;
+    helper.extrapolate(5000000U, seconds, useconds);
+    EXPECT_EQ(seconds, 1000U);
+    EXPECT_EQ(useconds, 0U);
+
+    // Uptime advances the epoch with microsecond resolution
+    helper.extrapolate(7250125U, seconds, useconds);
+    EXPECT_EQ(seconds, 1002U);
+    EXPECT_EQ(useconds, 250125U);
+}
+
+TEST(RtcHelperTest, CachedEpochResyncDue) {
+    RtcHelper helper;
+    helper.resync(1000U, 5000000U);
+
+    EXPECT_FALSE(helper.resyncDue(5000000U, 60000000U));
+    EXPECT_FALSE(helper.resyncDue(64999999U, 60000000U));
+    EXPECT_TRUE(helper.resyncDue(65000000U, 60000000U));
+
+    // A zero period re-reads the RTC on every request
+    EXPECT_TRUE(helper.resyncDue(5000000U, 0U));
+
+    // Invalidating forces a re-read regardless of age
+    helper.invalidate();
+    EXPECT_TRUE(helper.resyncDue(5000001U, 60000000U));
+}
+
+TEST(RtcHelperTest, CachedEpochResyncWithinWindowKeepsAnchor) {
+    RtcHelper helper;
+    helper.resync(1000U, 0U);
+
+    // Extrapolated 1060.5s, RTC reports 1060s: consistent, no drift and no jump
+    EXPECT_EQ(helper.resync(1060U, 60500000U), 0);
+    EXPECT_EQ(helper.getResyncCount(), 2U);
+
+    std::uint32_t seconds = 0;
+    std::uint32_t useconds = 0;
+    helper.extrapolate(60500000U, seconds, useconds);
+    EXPECT_EQ(seconds, 1060U);
+    EXPECT_EQ(useconds, 500000U);
+}
+
+TEST(RtcHelperTest, CachedEpochResyncStepsForwardWhenBehind) {
+    RtcHelper helper;
+    helper.resync(1000U, 0U);
+
+    // Extrapolated 1059.75s, RTC already reports 1060s: cache is 250ms behind
+    EXPECT_EQ(helper.resync(1060U, 59750000U), -250000);
+    EXPECT_EQ(helper.getLastDrift(), -250000);
+
+    std::uint32_t seconds = 0;
+    std::uint32_t useconds = 0;
+    helper.extrapolate(59750000U, seconds, useconds);
+    EXPECT_EQ(seconds, 1060U);
+    EXPECT_EQ(useconds, 0U);
+}
+
+TEST(RtcHelperTest, CachedEpochResyncStepsBackWhenAhead) {
+    RtcHelper helper;
+    helper.resync(1000U, 0U);
+
+    // Extrapolated 1061.5s, RTC still reports 1060s: cache is ahead of the latest consistent time
+    EXPECT_EQ(helper.resync(1060U, 61500000U), 500001);
+
+    std::uint32_t seconds = 0;
+    std::uint32_t useconds = 0;
+    helper.extrapolate(61500000U, seconds, useconds);
+    EXPECT_EQ(seconds, 1060U);
+    EXPECT_EQ(useconds, 999999U);
+}
+
+TEST(RtcHelperTest, CachedEpochInvalidateReanchors) {
+    RtcHelper helper;
+    helper.resync(1000U, 0U);
+    helper.invalidate();
+    EXPECT_FALSE(helper.isSynchronized());
+
+    // After a time set the new RTC value is adopted without reporting drift
+    EXPECT_EQ(helper.resync(5000U, 10000000U), 0);
+
+    std::uint32_t seconds = 0;
+    std::uint32_t useconds = 0;
+    helper.extrapolate(10000001U, seconds, useconds);
+    EXPECT_EQ(seconds, 5000U);
+    EXPECT_EQ(useconds, 1U);
+}
+
+namespace {
+
+//! Epoch seconds reported by an RTC running at the given rate relative to uptime
+std::uint32_t driftingRtcSeconds(std::uint64_t start_epoch_useconds, std::uint64_t uptime_useconds, double drift_ppm) {
+    double epoch =
+        static_cast<double>(start_epoch_useconds) + static_cast<double>(uptime_useconds) * (1.0 + drift_ppm * 1e-6);
+    return static_cast<std::uint32_t>(epoch / 1e6);
+}
+
+//! Deterministic sub-second jitter standing in for the arbitrary phase of time requests
+std::uint64_t resyncJitter(std::uint32_t& state) {
+    state = state * 1664525U + 1013904223U;
+    return static_cast<std::uint64_t>(state % 1000000U);
+}
+
+}  // namespace
+
+TEST(RtcHelperTest, DriftModelNotAppliedBeforeMinimumSpan) {
+    RtcHelper helper;
+    const std::uint64_t start = 1700000000ULL * 1000000ULL + 250000ULL;
+
+    // Resync every minute for less than the minimum regression span
+    for (std::uint64_t uptime = 0; uptime < RtcHelper::DRIFT_MIN_SPAN_USECONDS; uptime += 60000000ULL) {
+        helper.resync(driftingRtcSeconds(start, uptime, 100.0), uptime);
+    }
+
+    EXPECT_EQ(helper.getDriftPpb(), 0);
+}
+
+TEST(RtcHelperTest, DriftModelEstimatesRtcRate) {
+    const double drift_cases_ppm[] = {-80.0, -20.0, 0.0, 20.0, 80.0};
+
+    for (double drift_ppm : drift_cases_ppm) {
+        RtcHelper helper;
+        const std::uint64_t start = 1700000000ULL * 1000000ULL + 730000ULL;
+        std::uint32_t jitter_state = 1U;
+
+        // Half a day of resyncs at the default period
+        for (std::uint64_t tick = 0; tick <= 12ULL * 3600ULL * 1000000ULL; tick += 60000000ULL) {
+            std::uint64_t uptime = tick + resyncJitter(jitter_state);
+            helper.resync(driftingRtcSeconds(start, uptime, drift_ppm), uptime);
+        }
+
+        EXPECT_NEAR(static_cast<double>(helper.getDriftPpb()) / 1000.0, drift_ppm, 3.0) << "drift " << drift_ppm;
+    }
+}
+
+TEST(RtcHelperTest, DriftModelKeepsTimeMonotonic) {
+    RtcHelper helper;
+    const std::uint64_t start = 1700000000ULL * 1000000ULL + 999000ULL;
+    std::uint64_t last = 0;
+
+    // RTC runs slow, so resyncs repeatedly pull the cached epoch backwards until the model converges
+    for (std::uint64_t uptime = 0; uptime <= 36ULL * 3600ULL * 1000000ULL; uptime += 100000ULL) {
+        if (helper.resyncDue(uptime, 60000000ULL)) {
+            helper.resync(driftingRtcSeconds(start, uptime, -150.0), uptime);
+        }
+
+        std::uint32_t seconds = 0;
+        std::uint32_t useconds = 0;
+        helper.getTime(uptime, seconds, useconds);
+        std::uint64_t now = static_cast<std::uint64_t>(seconds) * 1000000ULL + useconds;
+        ASSERT_GE(now, last) << "at uptime " << uptime;
+        ASSERT_LT(useconds, 1000000U);
+        last = now;
+    }
+}
+
+TEST(RtcHelperTest, DriftModelReducesResyncCorrections) {
+    RtcHelper helper;
+    const std::uint64_t start = 1700000000ULL * 1000000ULL + 500000ULL;
+    std::uint32_t jitter_state = 7U;
+    std::int64_t late_corrections = 0;
+
+    // Uncompensated, a 150ppm RTC forces a 9ms correction at every one minute resync, about 13s over a day
+    for (std::uint64_t tick = 0; tick <= 48ULL * 3600ULL * 1000000ULL; tick += 60000000ULL) {
+        std::uint64_t uptime = tick + resyncJitter(jitter_state);
+        std::int64_t drift = helper.resync(driftingRtcSeconds(start, uptime, 150.0), uptime);
+        if (uptime > 24ULL * 3600ULL * 1000000ULL) {
+            late_corrections += (drift < 0) ? -drift : drift;
+        }
+    }
+
+    // Once converged the model should remove nearly all of it
+    EXPECT_LT(late_corrections, 200000);
+}
+
+TEST(RtcHelperTest, DriftModelSurvivesInvalidate) {
+    RtcHelper helper;
+    const std::uint64_t start = 1700000000ULL * 1000000ULL;
+    std::uint32_t jitter_state = 3U;
+
+    for (std::uint64_t tick = 0; tick <= 24ULL * 3600ULL * 1000000ULL; tick += 60000000ULL) {
+        std::uint64_t uptime = tick + resyncJitter(jitter_state);
+        helper.resync(driftingRtcSeconds(start, uptime, 40.0), uptime);
+    }
+    std::int64_t estimate = helper.getDriftPpb();
+    ASSERT_NE(estimate, 0);
+
+    // A time set restarts the regression but keeps applying the oscillator estimate
+    helper.invalidate();
+    EXPECT_EQ(helper.getDriftPpb(), estimate);
+
+    std::uint64_t uptime = 25ULL * 3600ULL * 1000000ULL;
+    helper.resync(1000U, uptime);
+
+    std::uint32_t seconds = 0;
+    std::uint32_t useconds = 0;
+    helper.getTime(uptime + 1000000ULL, seconds, useconds);
+    EXPECT_EQ(seconds, 1001U);
+    EXPECT_NEAR(static_cast<double>(useconds), static_cast<double>(estimate) / 1000.0, 1.0);
+}
@@ -0,0 +1,332 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/SBand/LinkAdaptation.hpp"
+
+using namespace Components::LinkAdaptation;
+
+namespace {
+
+constexpr size_t kDefaultRung = 4;  // SF_7, BW_406_25_KHZ
+constexpr uint8_t kCodingRate = 5;  // CR_4_5
+
+Config testConfig() {
+    Config config{};
+    config.targetMarginDb = 6.0f;
+    config.hysteresisDb = 2.0f;
+    config.window = 4;
+    config.announcements = 3;
+    config.confirmTicks = 10;
+    config.holdoffTicks = 50;
+    config.idleTicks = 1000;
+    return config;
+}
+
+void feed(State& state, const Config& config, float snrDb, size_t samples) {
+    for (size_t i = 0; i < samples; i++) {
+        addSnr(state, config, snrDb);
+    }
+}
+
+//! The acknowledgement the ground sends in the new modulation
+std::vector<uint8_t> acknowledgement(size_t rung) {
+    return {'S', 'B', 'M', 'A', static_cast<uint8_t>(rung)};
+}
+
+//! Send every announcement and return the countdown bytes the ground saw
+std::vector<uint8_t> announceAll(State& state) {
+    std::vector<uint8_t> countdowns;
+    bool switched = false;
+    while (!switched) {
+        uint8_t packet[kAnnouncementSize];
+        EXPECT_EQ(encodeAnnouncement(state, kCodingRate, packet, sizeof(packet)), kAnnouncementSize);
+        countdowns.push_back(packet[8]);
+        switched = announced(state);
+    }
+    return countdowns;
+}
+
+//! A 500 km pass, uplink and downlink stepped at the 10 Hz rate group
+//!
+//! SNR follows the slant range from 2300 km at the horizon to 500 km overhead, with +/-1 dB of noise. The satellite
+//! sends continuously and the ground sends one packet a second, plus an acknowledgement as soon as it has retuned. A
+//! frame gets through when the SNR meets the threshold of the modulation both ends are using.
+struct Pass {
+    static constexpr uint32_t kTicks = 6000;
+    static constexpr double kTickSeconds = 0.1;
+
+    bool adaptive;
+    float horizonSnrDb;  // SNR referred to 203.125 kHz at the horizon
+    Config config = testConfig();
+    State state{};
+    size_t groundRung = kDefaultRung;
+    bool groundAcknowledging = false;
+    uint32_t groundIdle = 0;
+    uint32_t seed = 12345;
+    double bits = 0;
+    uint32_t changes = 0;
+    uint32_t reverts = 0;
+    uint32_t outages = 0;
+
+    Pass(bool adaptive, float horizonSnrDb) : adaptive(adaptive), horizonSnrDb(horizonSnrDb) {
+        config.confirmTicks = 30;
+        config.idleTicks = 300;
+        reset(state, kDefaultRung);
+    }
+
+    //! SNR referred to 203.125 kHz at a tick
+    float referenceSnr(uint32_t step) {
+        const double t = (static_cast<double>(step) - kTicks / 2.0) * kTickSeconds;
+        const double range = std::sqrt(500.0 * 500.0 + (7.6 * t) * (7.6 * t));
+        seed = seed * 1103515245u + 12345u;
+        const double noise = static_cast<double>((seed >> 16) % 2001) / 1000.0 - 1.0;
+        return static_cast<float>(horizonSnrDb + 20.0 * std::log10(2300.0 / range) + noise);
+    }
+
+    static float bandwidthOffset(size_t rung) { return 3.01f * static_cast<float>(kLadder[rung].bandwidth); }
+
+    static bool heard(float reference, size_t rung) { return reference >= kLadder[rung].requiredSnrDb; }
+
+    void run() {
+        for (uint32_t step = 0; step < kTicks; step++) {
+            const float reference = referenceSnr(step);
+            const size_t rung = state.rung;
+            const bool linked = (groundRung == rung) && heard(reference, rung);
+
+            if (adaptive) {
+                if (linked && (groundAcknowledging || step % 10 == 0)) {
+                    addSnr(state, config, reference - bandwidthOffset(rung));
+                    if (groundAcknowledging) {
+                        groundAcknowledging = false;
+                        size_t acknowledgedRung = kNoRung;
+                        const std::vector<uint8_t> packet = acknowledgement(groundRung);
+                        EXPECT_TRUE(decodeAcknowledgement(packet.data(), packet.size(), acknowledgedRung));
+                        if (acknowledged(state, acknowledgedRung)) {
+                            changes++;
+                        }
+                    }
+                }
+                const Action action = tick(state, config);
+                if (action == Action::Announce) {
+                    uint8_t packet[kAnnouncementSize];
+                    encodeAnnouncement(state, kCodingRate, packet, sizeof(packet));
+                    if (linked && packet[8] == 0) {
+                        groundRung = packet[4];
+                        groundAcknowledging = true;
+                    }
+                    announced(state);
+                    continue;
+                }
+                if (action == Action::Revert) {
+                    reverts++;
+                }
+            }
+
+            // The ground follows the same idle rule as the satellite
+            groundIdle = linked ? 0 : groundIdle + 1;
+            if (groundIdle >= config.idleTicks) {
+                groundRung = kDefaultRung;
+                groundAcknowledging = false;
+            }
+            if (linked) {
+                bits += bitRate(kLadder[rung], kCodingRate) * kTickSeconds;
+            } else {
+                outages++;
+            }
+        }
+    }
+};
+
+}  // namespace
+
+TEST(LinkAdaptationTest, LadderIsOrderedFastestFirst) {
+    for (size_t i = 1; i < kRungs; i++) {
+        EXPECT_LT(bitRate(kLadder[i], kCodingRate), bitRate(kLadder[i - 1], kCodingRate)) << "rung " << i;
+        EXPECT_LT(kLadder[i].requiredSnrDb, kLadder[i - 1].requiredSnrDb) << "rung " << i;
+    }
+    EXPECT_EQ(bitRate(kLadder[0], kCodingRate), 203125u);
+    EXPECT_EQ(bitRate(kLadder[kDefaultRung], kCodingRate), 17773u);
+    EXPECT_EQ(bitRate(kLadder[kDefaultRung], 8), 11108u);
+
+    EXPECT_EQ(findRung(7, 1), kDefaultRung);
+    EXPECT_EQ(findRung(12, 0), kRungs - 1);
+    EXPECT_EQ(findRung(5, 0), kNoRung);
+}
+
+TEST(LinkAdaptationTest, ClimbsOneRungOnlyPastTheHysteresis) {
+    const Config config = testConfig();
+    State state{};
+    reset(state, kDefaultRung);
+
+    // Nothing happens until the window is full
+    feed(state, config, 10.0f, 3);
+    EXPECT_EQ(tick(state, config), Action::None);
+
+    // The next rung would have 7.5 dB, above the target but inside the hysteresis
+    reset(state, kDefaultRung);
+    feed(state, config, 3.0f, 4);
+    EXPECT_NEAR(margin(state, kDefaultRung - 1), 7.5f, 0.01f);
+    EXPECT_EQ(tick(state, config), Action::None);
+
+    // Even with room for several rungs, only the next one is proposed
+    feed(state, config, 20.0f, 4);
+    EXPECT_EQ(tick(state, config), Action::Announce);
+    EXPECT_EQ(state.pending, kDefaultRung - 1);
+}
+
+TEST(LinkAdaptationTest, FallsStraightToARungHoldingTheTarget) {
+    const Config config = testConfig();
+    State state{};
+    reset(state, kDefaultRung);
+
+    // -6 dB leaves 1.5 dB here, 4 dB on the next rung and 6.5 dB on the one after
+    feed(state, config, -6.0f, 4);
+    EXPECT_EQ(tick(state, config), Action::Announce);
+    EXPECT_EQ(state.pending, kDefaultRung + 2);
+
+    // The slowest rung is used when nothing holds the target
+    reset(state, kDefaultRung);
+    feed(state, config, -40.0f, 4);
+    EXPECT_EQ(tick(state, config), Action::Announce);
+    EXPECT_EQ(state.pending, kRungs - 1);
+}
+
+TEST(LinkAdaptationTest, AnnouncesBeforeSwitchingAndConfirmsOnAcknowledgement) {
+    const Config config = testConfig();
+    State state{};
+    reset(state, kDefaultRung);
+    feed(state, config, 4.0f, 4);
+    ASSERT_EQ(tick(state, config), Action::Announce);
+
+    // Announcing continues every tick until the last one is sent
+    uint8_t packet[kAnnouncementSize];
+    ASSERT_EQ(encodeAnnouncement(state, kCodingRate, packet, sizeof(packet)), kAnnouncementSize);
+    EXPECT_EQ(packet[0], 'S');
+    EXPECT_EQ(packet[3], 'C');
+    EXPECT_EQ(packet[4], kDefaultRung - 1);
+    EXPECT_EQ(packet[5], 7);
+    EXPECT_EQ(packet[6], 2);
+    EXPECT_EQ(packet[7], kCodingRate);
+    EXPECT_EQ(encodeAnnouncement(state, kCodingRate, packet, kAnnouncementSize - 1), 0u);
+
+    EXPECT_EQ(announceAll(state), (std::vector<uint8_t>{2, 1, 0}));
+    EXPECT_EQ(state.rung, kDefaultRung - 1);
+    EXPECT_EQ(state.phase, Phase::Confirming);
+    EXPECT_EQ(tick(state, config), Action::None);
+
+    // A packet in the new modulation measures the link but may have been sent before the ground retuned
+    addSnr(state, config, 1.0f);
+    EXPECT_EQ(state.phase, Phase::Confirming);
+    EXPECT_EQ(state.count, 1u);
+
+    // Only an acknowledgement of the announced rung confirms the change
+    EXPECT_FALSE(acknowledged(state, kDefaultRung));
+    EXPECT_EQ(state.phase, Phase::Confirming);
+    EXPECT_TRUE(acknowledged(state, kDefaultRung - 1));
+    EXPECT_EQ(state.phase, Phase::Steady);
+    EXPECT_FALSE(acknowledged(state, kDefaultRung - 1));
+}
+
+TEST(LinkAdaptationTest, DecodesAcknowledgements) {
+    size_t rung = kNoRung;
+    std::vector<uint8_t> packet = acknowledgement(7);
+    ASSERT_EQ(packet.size(), kAcknowledgementSize);
+    EXPECT_TRUE(decodeAcknowledgement(packet.data(), packet.size(), rung));
+    EXPECT_EQ(rung, 7u);
+
+    // Frames and announcements are not acknowledgements
+    rung = kNoRung;
+    EXPECT_FALSE(decodeAcknowledgement(packet.data(), packet.size() - 1, rung));
+    packet.push_back(0);
+    EXPECT_FALSE(decodeAcknowledgement(packet.data(), packet.size(), rung));
+    packet = acknowledgement(7);
+    packet[3] = 'C';
+    EXPECT_FALSE(decodeAcknowledgement(packet.data(), packet.size(), rung));
+    EXPECT_FALSE(decodeAcknowledgement(nullptr, kAcknowledgementSize, rung));
+    EXPECT_EQ(rung, kNoRung);
+}
+
+TEST(LinkAdaptationTest, RevertsWhenTheGroundDoesNotFollow) {
+    const Config config = testConfig();
+    State state{};
+    reset(state, kDefaultRung);
+    feed(state, config, 4.0f, 4);
+    ASSERT_EQ(tick(state, config), Action::Announce);
+    announceAll(state);
+
+    // Packets without an acknowledgement do not hold the change
+    for (uint32_t i = 1; i < config.confirmTicks; i++) {
+        addSnr(state, config, 4.0f);
+        ASSERT_EQ(tick(state, config), Action::None);
+    }
+    EXPECT_EQ(tick(state, config), Action::Revert);
+    EXPECT_EQ(state.rung, kDefaultRung);
+
+    // Climbing waits out the holdoff, falling does not
+    feed(state, config, 4.0f, 4);
+    for (uint32_t i = 1; i < config.holdoffTicks; i++) {
+        ASSERT_EQ(tick(state, config), Action::None) << "tick " << i;
+    }
+    EXPECT_EQ(tick(state, config), Action::Announce);
+
+    reset(state, kDefaultRung);
+    state.holdoff = config.holdoffTicks;
+    feed(state, config, -6.0f, 4);
+    EXPECT_EQ(tick(state, config), Action::Announce);
+}
+
+TEST(LinkAdaptationTest, ReturnsHomeWhenIdle) {
+    const Config config = testConfig();
+    State state{};
+    reset(state, kDefaultRung);
+    feed(state, config, 4.0f, 4);
+    ASSERT_EQ(tick(state, config), Action::Announce);
+    announceAll(state);
+    addSnr(state, config, 4.0f);
+    ASSERT_TRUE(acknowledged(state, state.rung));
+
+    for (uint32_t i = 1; i < config.idleTicks; i++) {
+        ASSERT_NE(tick(state, config), Action::Home);
+    }
+    EXPECT_EQ(tick(state, config), Action::Home);
+    EXPECT_EQ(state.rung, kDefaultRung);
+    EXPECT_EQ(tick(state, config), Action::None);
+
+    // An announcement that never got out is dropped too
+    reset(state, kDefaultRung);
+    feed(state, config, 4.0f, 4);
+    for (uint32_t i = 1; i < config.idleTicks; i++) {
+        ASSERT_EQ(tick(state, config), Action::Announce);
+    }
+    EXPECT_EQ(tick(state, config), Action::None);
+    EXPECT_EQ(state.phase, Phase::Steady);
+}
+
+TEST(LinkAdaptationTest, PassThroughputRisesSeveralTimes) {
+    // The default modulation has 8.5 dB of margin at the horizon and holds the link for the whole pass
+    Pass fixed(false, 4.0f);
+    fixed.run();
+    Pass adaptive(true, 4.0f);
+    adaptive.run();
+
+    EXPECT_EQ(fixed.outages, 0u);
+    EXPECT_GT(adaptive.bits, 3.0 * fixed.bits);
+    EXPECT_GT(adaptive.changes, 4u);
+    EXPECT_EQ(adaptive.reverts, 0u);
+    EXPECT_EQ(adaptive.groundRung, adaptive.state.rung);
+}
+
+TEST(LinkAdaptationTest, MarginalPassKeepsTheLink) {
+    // 4.5 dB of margin at the horizon, under the target, so the ends of the pass run slower than the default
+    Pass fixed(false, 0.0f);
+    fixed.run();
+    Pass adaptive(true, 0.0f);
+    adaptive.run();
+
+    EXPECT_EQ(adaptive.outages, 0u);
+    EXPECT_GT(adaptive.bits, 2.0 * fixed.bits);
+    EXPECT_EQ(adaptive.groundRung, adaptive.state.rung);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "PROVESFlightControllerReference/Components/SBand/ModulationCache.hpp"
+
+using namespace Components::ModulationCache;
+
+namespace {
+
+// SF_7, CR_4_5, BW_406_25_KHZ: the SBand parameter defaults
+constexpr Modulation kDefault = {7, 5, 1};
+
+//! Count the parameter writes to move the radio to wanted, as SBand::applyModulation does
+uint32_t writes(Cache& cache, const Modulation& wanted) {
+    uint8_t changed = changes(cache, wanted);
+    applied(cache, wanted);
+    uint32_t count = 0;
+    for (uint8_t bit = kSpreadingFactor; bit <= kBandwidth; bit <<= 1) {
+        count += ((changed & bit) != 0) ? 1 : 0;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(ModulationCacheTest, UnknownStateWritesEverything) {
+    Cache cache{};
+    EXPECT_EQ(changes(cache, kDefault), kAll);
+
+    applied(cache, kDefault);
+    EXPECT_EQ(changes(cache, kDefault), 0);
+
+    invalidate(cache);
+    EXPECT_EQ(changes(cache, kDefault), kAll);
+}
+
+TEST(ModulationCacheTest, ReportsEachChangedParameter) {
+    Cache cache{};
+    applied(cache, kDefault);
+
+    EXPECT_EQ(changes(cache, {8, 5, 1}), kSpreadingFactor);
+    EXPECT_EQ(changes(cache, {7, 6, 1}), kCodingRate);
+    EXPECT_EQ(changes(cache, {7, 5, 2}), kBandwidth);
+    EXPECT_EQ(changes(cache, {12, 8, 0}), kAll);
+}
+
+TEST(ModulationCacheTest, AlternatingTxAndRxWithSharedModulationWritesOnce) {
+    // Each frame used to write all three parameters for TX and again for RX
+    Cache cache{};
+    uint32_t total = 0;
+    for (int frame = 0; frame < 100; frame++) {
+        total += writes(cache, kDefault);  // enableTx
+        total += writes(cache, kDefault);  // enableRx
+    }
+    EXPECT_EQ(total, 3u);
+}
+
+TEST(ModulationCacheTest, SplitBandwidthWritesOnlyBandwidth) {
+    const Modulation tx = {7, 5, 2};
+    const Modulation rx = kDefault;
+    Cache cache{};
+    uint32_t total = writes(cache, rx);
+    for (int frame = 0; frame < 100; frame++) {
+        total += writes(cache, tx);
+        total += writes(cache, rx);
+    }
+    EXPECT_EQ(total, 3u + 200u);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/SBand/RxWatchdog.hpp"
+
+using namespace Components::RxWatchdog;
+
+namespace {
+
+constexpr uint32_t kTickMs = 100;  // 10 Hz rate group
+constexpr uint32_t kPeriod = 50;   // Default RX_WATCHDOG_PERIOD
+
+//! Stand-in for the SX1280 IRQ line and the SBand receive path, stepped in milliseconds
+//!
+//! A packet raises the line and, unless its edge is dropped, queues the RX handler at once. The handler reads the
+//! packet over SPI and the line falls. The rate group runs the watchdog while no handler is queued.
+struct Link {
+    bool interrupts;
+    State state{};
+    bool line = false;
+    bool queued = false;
+    uint32_t arrivalMs = 0;
+    uint32_t spiPolls = 0;
+    uint32_t missedEdges = 0;
+    std::vector<uint32_t> latenciesMs;
+
+    explicit Link(bool interruptsEnabled) : interrupts(interruptsEnabled) {}
+
+    void receive(uint32_t nowMs, bool dropEdge) {
+        line = true;
+        arrivalMs = nowMs;
+        if (interrupts && !dropEdge) {
+            queued = true;
+        }
+    }
+
+    void tick() {
+        if (queued) {
+            return;
+        }
+        Reason reason = check(state, interrupts, line, kPeriod);
+        if (reason == Reason::MissedEdge) {
+            missedEdges++;
+        }
+        if (reason != Reason::None) {
+            queued = true;
+        }
+    }
+
+    //! The RX handler runs on the component thread once queued
+    void service(uint32_t nowMs) {
+        if (!queued) {
+            return;
+        }
+        spiPolls++;
+        if (line) {
+            latenciesMs.push_back(nowMs - arrivalMs);
+            line = false;
+        }
+        queued = false;
+    }
+
+    //! Run for durationMs with a packet every intervalMs, dropping the edge of every dropEvery-th packet
+    void run(uint32_t durationMs, uint32_t intervalMs, uint32_t dropEvery) {
+        uint32_t packets = 0;
+        for (uint32_t now = 0; now < durationMs; now++) {
+            if (now % intervalMs == intervalMs - 1) {
+                packets++;
+                receive(now, dropEvery != 0 && packets % dropEvery == 0);
+            }
+            if (now % kTickMs == 0) {
+                tick();
+            }
+            service(now);
+        }
+    }
+};
+
+uint32_t maxOf(const std::vector<uint32_t>& values) {
+    uint32_t max = 0;
+    for (uint32_t value : values) {
+        max = (value > max) ? value : max;
+    }
+    return max;
+}
+
+}  // namespace
+
+TEST(RxWatchdogTest, PollsEveryTickWithoutInterrupts) {
+    State state{};
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(check(state, false, false, kPeriod), Reason::Polling);
+    }
+}
+
+TEST(RxWatchdogTest, PollsOncePerPeriod) {
+    State state{};
+    for (uint32_t i = 1; i < kPeriod; i++) {
+        EXPECT_EQ(check(state, true, false, kPeriod), Reason::None) << "tick " << i;
+    }
+    EXPECT_EQ(check(state, true, false, kPeriod), Reason::Period);
+    EXPECT_EQ(check(state, true, false, kPeriod), Reason::None);
+}
+
+TEST(RxWatchdogTest, ZeroPeriodNeverPolls) {
+    State state{};
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(check(state, true, false, 0), Reason::None);
+    }
+}
+
+TEST(RxWatchdogTest, AssertedLineIsAMissedEdge) {
+    State state{};
+    EXPECT_EQ(check(state, true, true, kPeriod), Reason::MissedEdge);
+    // Missed edges do not count towards the period
+    EXPECT_EQ(state.ticks, 0u);
+}
+
+TEST(RxWatchdogTest, InterruptsRemovePollingLatencyAndIdleSpi) {
+    // One packet every 1.337 s for a minute, so arrivals fall at every phase of the rate group
+    Link polled(false);
+    polled.run(60000, 1337, 0);
+    Link driven(true);
+    driven.run(60000, 1337, 0);
+
+    ASSERT_EQ(polled.latenciesMs.size(), driven.latenciesMs.size());
+    EXPECT_GT(maxOf(polled.latenciesMs), 90u);
+    EXPECT_EQ(maxOf(driven.latenciesMs), 0u);
+
+    // Polling reads the IRQ status over SPI ten times a second; the watchdog once per period
+    EXPECT_EQ(polled.spiPolls, 600u);
+    EXPECT_EQ(driven.spiPolls, driven.latenciesMs.size() + 60000 / (kPeriod * kTickMs));
+}
+
+TEST(RxWatchdogTest, MissedEdgesRecoverOnTheNextTick) {
+    Link driven(true);
+    driven.run(60000, 1337, 4);
+
+    EXPECT_EQ(driven.latenciesMs.size(), 44u);
+    EXPECT_EQ(driven.missedEdges, 11u);
+    EXPECT_LE(maxOf(driven.latenciesMs), kTickMs);
+}
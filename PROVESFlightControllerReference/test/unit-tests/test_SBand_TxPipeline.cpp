@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/SBand/TxPipeline.hpp"
+
+using namespace Components::TxPipeline;
+
+namespace {
+
+constexpr uint64_t kTickUs = 100000;  // 10 Hz rate group driving ComDelay
+constexpr uint64_t kRunUs = 60000000;
+
+// SBand defaults: SF_7, BW_406_25_KHZ, CR_4_5, 12 symbol preamble, CRC on, explicit header
+uint32_t defaultTimeOnAir(size_t payloadSize) {
+    return timeOnAirUs(7, 406250, 5, 12, payloadSize, true, true);
+}
+
+//! Stand-in for ComQueue behind ComDelay, the SX1280 and SBand, stepped from event to event
+//!
+//! ComQueue sends its next frame when a status reaches it, and ComDelay holds each status until the next rate group
+//! tick. The radio raises TX_DONE one time on air after a frame starts, except for every failEvery-th frame, which is
+//! failed at SBand's deadline of twice the time on air plus 100 ms.
+struct Link {
+    bool pipelined;
+    uint32_t timeOnAir;
+    uint32_t failEvery = 0;  // 0 for none
+
+    uint64_t now = 0;
+    uint32_t nextFrame = 0;     // Sequence number of ComQueue's next frame
+    bool statusPending = true;  // A ready status waits in ComDelay; the first send needs none
+    bool radioBusy = false;
+    uint64_t txDoneAt = 0;
+    uint32_t onAirFrame = 0;
+
+    State state{};
+    std::vector<uint32_t> sent;
+    std::vector<std::pair<uint32_t, bool>> statuses;  // Frame and outcome, in the order reported
+    uint64_t longestBlockUs = 0;
+
+    Link(bool pipelinedMode, size_t payloadSize)
+        : pipelined(pipelinedMode), timeOnAir(defaultTimeOnAir(payloadSize)) {}
+
+    bool fails(uint32_t frame) const { return (failEvery != 0) && ((frame % failEvery) == failEvery - 1); }
+
+    void status(uint32_t frame, bool sentOk) {
+        statuses.emplace_back(frame, sentOk);
+        statusPending = true;
+    }
+
+    void startRadio(uint32_t frame) {
+        radioBusy = true;
+        onAirFrame = frame;
+        txDoneAt = now + (fails(frame) ? 2 * timeOnAir + 100000 : timeOnAir);
+    }
+
+    //! dataIn, then deferredTxHandler
+    void frameIn(uint32_t frame) {
+        if (!pipelined) {
+            // transmit() holds the component thread for the whole time on air
+            now += timeOnAir;
+            longestBlockUs = (timeOnAir > longestBlockUs) ? timeOnAir : longestBlockUs;
+            if (!fails(frame)) {
+                sent.push_back(frame);
+            }
+            status(frame, !fails(frame));
+            return;
+        }
+        switch (accept(state)) {
+            case Accept::Start:
+                startRadio(frame);
+                break;
+            case Accept::Reject:
+                ADD_FAILURE() << "frame " << frame << " sent without a ready status";
+                break;
+        }
+    }
+
+    //! The IRQ handler seeing TX_DONE or the deadline
+    void txDone() {
+        radioBusy = false;
+        const bool sentOk = !fails(onAirFrame);
+        if (sentOk) {
+            sent.push_back(onAirFrame);
+        }
+        status(onAirFrame, sentOk);
+        complete(state);
+    }
+
+    void run() {
+        uint64_t nextTick = 0;
+        while (now < kRunUs) {
+            if (radioBusy && txDoneAt <= nextTick) {
+                now = txDoneAt;
+                if (now >= kRunUs) {
+                    break;
+                }
+                txDone();
+                continue;
+            }
+            // Ticks pass while transmit() blocks; ComDelay forwards the status on the first one after it
+            while (nextTick < now) {
+                nextTick += kTickUs;
+            }
+            now = nextTick;
+            if (now >= kRunUs) {
+                break;
+            }
+            nextTick += kTickUs;
+            if (statusPending) {
+                statusPending = false;
+                frameIn(nextFrame++);
+            }
+        }
+    }
+};
+
+}  // namespace
+
+TEST(TxPipelineTest, HoldsOneFrameOnAir) {
+    State state{};
+    EXPECT_EQ(accept(state), Accept::Start);
+    EXPECT_TRUE(state.onAir);
+    EXPECT_EQ(accept(state), Accept::Reject);
+
+    complete(state);
+    EXPECT_FALSE(state.onAir);
+
+    EXPECT_EQ(accept(state), Accept::Start);
+    abort(state);
+    EXPECT_EQ(accept(state), Accept::Start);
+}
+
+TEST(TxPipelineTest, TimeOnAirMatchesDatasheet) {
+    // Reference values from the SX1280 datasheet formula evaluated in floating point
+    EXPECT_EQ(timeOnAirUs(7, 406250, 5, 12, 255, true, true), 124219u);
+    EXPECT_EQ(timeOnAirUs(7, 406250, 5, 12, 20, true, true), 18668u);
+    EXPECT_EQ(timeOnAirUs(5, 1625000, 5, 12, 100, true, true), 4553u);
+    EXPECT_EQ(timeOnAirUs(12, 203125, 8, 12, 64, true, true), 2586151u);
+    EXPECT_EQ(timeOnAirUs(10, 812500, 6, 8, 0, true, true), 33083u);
+
+    // Implicit header and no CRC shorten the payload
+    EXPECT_LT(timeOnAirUs(7, 406250, 5, 12, 255, false, false), timeOnAirUs(7, 406250, 5, 12, 255, true, true));
+}
+
+TEST(TxPipelineTest, TransmitDoesNotHoldTheThread) {
+    // Full frames take 124 ms on air; either way the next frame waits for the 100 ms tick after the status
+    Link blocking(false, 255);
+    blocking.run();
+    Link pipelined(true, 255);
+    pipelined.run();
+
+    EXPECT_EQ(blocking.sent.size(), kRunUs / (2 * kTickUs));
+    EXPECT_EQ(pipelined.sent.size(), blocking.sent.size());
+
+    // The component thread is never held for the time on air
+    EXPECT_EQ(blocking.longestBlockUs, defaultTimeOnAir(255));
+    EXPECT_EQ(pipelined.longestBlockUs, 0u);
+}
+
+TEST(TxPipelineTest, StatusReportsTheOutcomeOfEachFrame) {
+    for (size_t payload : {20u, 100u, 255u}) {
+        Link pipelined(true, payload);
+        pipelined.failEvery = 4;
+        pipelined.run();
+        ASSERT_GT(pipelined.statuses.size(), 8u) << "payload " << payload;
+
+        // One status per frame, in order, sent once the frame has completed or timed out
+        for (size_t i = 0; i < pipelined.statuses.size(); i++) {
+            ASSERT_EQ(pipelined.statuses[i].first, i) << "payload " << payload;
+            EXPECT_EQ(pipelined.statuses[i].second, !pipelined.fails(static_cast<uint32_t>(i)))
+                << "payload " << payload << " frame " << i;
+        }
+        EXPECT_LE(pipelined.nextFrame - pipelined.statuses.size(), 1u) << "payload " << payload;
+    }
+}
@@ -105,3 +105,102 @@ TEST(PacketAuthenticatorTest, MinimumSizeBuffer) {
     EXPECT_EQ(res.status, PacketAuthenticator::AuthenticationStatus::VerifyError);
     EXPECT_EQ(res.psaStatus, PSA_ERROR_INVALID_SIGNATURE);
 }
+
+//! Import the test key as a precomputed key schedule, asserting success
+static HmacSha256::Midstate importTestMidstate() {
+    HmacSha256::Midstate midstate{};
+    auto res = importHmacMidstate(kTestKeyHex, midstate);
+    EXPECT_EQ(res.status, PacketAuthenticator::KeyImportStatus::Success);
+    EXPECT_EQ(res.psaStatus, PSA_SUCCESS);
+    return midstate;
+}
+
+TEST(PacketAuthenticatorMidstateTest, ImportInvalidHexKey) {
+    HmacSha256::Midstate midstate{};
+    auto res = importHmacMidstate("invalidkey", midstate);
+    EXPECT_EQ(res.status, PacketAuthenticator::KeyImportStatus::ParseKeyError);
+    EXPECT_EQ(res.psaStatus, PSA_ERROR_INVALID_ARGUMENT);
+}
+
+TEST(PacketAuthenticatorMidstateTest, NullBuffer) {
+    HmacSha256::Midstate midstate = importTestMidstate();
+    Mac mac{};
+    auto res = authenticatePacket(nullptr, 0, mac, midstate);
+    EXPECT_EQ(res.status, PacketAuthenticator::AuthenticationStatus::VerifyError);
+    EXPECT_EQ(res.psaStatus, PSA_ERROR_INVALID_ARGUMENT);
+}
+
+TEST(PacketAuthenticatorMidstateTest, AuthenticatedSuccess) {
+    HmacSha256::Midstate midstate = importTestMidstate();
+    auto res = authenticatePacket(kTestPacket.data(), kTestPacket.size(), macOf(kTestPacket), midstate);
+    EXPECT_EQ(res.status, PacketAuthenticator::AuthenticationStatus::Authenticated);
+    EXPECT_EQ(res.psaStatus, PSA_SUCCESS);
+}
+
+TEST(PacketAuthenticatorMidstateTest, VerifyFailure) {
+    HmacSha256::Midstate midstate = importTestMidstate();
+    Mac mac = macOf(kTestPacket);
+
+    // Corrupt the last byte of the MAC, which a short-circuiting compare would reach last
+    mac[mac.size() - 1] ^= 0x01;
+
+    auto res = authenticatePacket(kTestPacket.data(), kTestPacket.size(), mac, midstate);
+    EXPECT_EQ(res.status, PacketAuthenticator::AuthenticationStatus::VerifyError);
+    EXPECT_EQ(res.psaStatus, PSA_ERROR_INVALID_SIGNATURE);
+}
+
+TEST(PacketAuthenticatorMidstateTest, ShortBuffer) {
+    HmacSha256::Midstate midstate = importTestMidstate();
+    std::vector<uint8_t> packet = {1, 2, 3};  // Too short to contain a MAC
+    Mac mac{};
+
+    auto res = authenticatePacket(packet.data(), packet.size(), mac, midstate);
+    EXPECT_EQ(res.status, PacketAuthenticator::AuthenticationStatus::VerifyError);
+    EXPECT_EQ(res.psaStatus, PSA_ERROR_INVALID_ARGUMENT);
+}
+
+//! Import the test key into PSA for signing, which the verify-only key from importHmacKey does not permit
+static psa_key_id_t importTestSigningKey() {
+    const uint8_t keyBytes[] = {0x14, 0x40, 0x8c, 0x27, 0x11, 0x28, 0x1f, 0x4d,
+                                0x70, 0x45, 0x2c, 0xe3, 0x73, 0x0b, 0xb4, 0xfa};
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_HMAC);
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN_MESSAGE);
+    psa_set_key_algorithm(&attributes, PSA_ALG_HMAC(PSA_ALG_SHA_256));
+    psa_key_id_t keyId = 0;
+    EXPECT_EQ(psa_import_key(&attributes, keyBytes, sizeof(keyBytes), &keyId), PSA_SUCCESS);
+    return keyId;
+}
+
+TEST(PacketAuthenticatorMidstateTest, MatchesPsaReference) {
+    uint32_t keyId = importTestKey();
+    psa_key_id_t signingKeyId = importTestSigningKey();
+    HmacSha256::Midstate midstate = importTestMidstate();
+
+    // Sign frames across the SHA-256 block and padding boundaries with PSA, then verify them with both backends
+    for (size_t dataSize = 0; dataSize <= 300; dataSize++) {
+        std::vector<uint8_t> packet(dataSize + Ccsds355_0_B_2::kTCSecurityTrailer);
+        for (size_t i = 0; i < dataSize; i++) {
+            packet[i] = static_cast<uint8_t>(i * 7 + dataSize);
+        }
+        uint8_t fullMac[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+        size_t macSize = 0;
+        ASSERT_EQ(psa_mac_compute(signingKeyId, PSA_ALG_HMAC(PSA_ALG_SHA_256), packet.data(), dataSize, fullMac,
+                                  sizeof(fullMac), &macSize),
+                  PSA_SUCCESS);
+        std::copy(fullMac, fullMac + Ccsds355_0_B_2::kTCSecurityTrailer, packet.begin() + static_cast<long>(dataSize));
+
+        auto reference = authenticatePacket(packet.data(), packet.size(), macOf(packet), keyId);
+        auto res = authenticatePacket(packet.data(), packet.size(), macOf(packet), midstate);
+        EXPECT_EQ(res.status, reference.status) << "size " << dataSize;
+        EXPECT_EQ(res.psaStatus, reference.psaStatus) << "size " << dataSize;
+
+        packet[dataSize / 2] ^= 0x80;
+        reference = authenticatePacket(packet.data(), packet.size(), macOf(packet), keyId);
+        res = authenticatePacket(packet.data(), packet.size(), macOf(packet), midstate);
+        EXPECT_EQ(res.status, reference.status) << "corrupted size " << dataSize;
+        EXPECT_EQ(res.psaStatus, reference.psaStatus) << "corrupted size " << dataSize;
+    }
+
+    psa_destroy_key(signingKeyId);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/HmacSha256.hpp"
+
+using namespace Components;
+
+namespace {
+
+std::vector<uint8_t> fromHex(const std::string& hex) {
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        bytes.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+std::string toHex(const HmacSha256::Digest& digest) {
+    static const char kDigits[] = "0123456789abcdef";
+    std::string hex;
+    for (uint8_t byte : digest) {
+        hex.push_back(kDigits[byte >> 4]);
+        hex.push_back(kDigits[byte & 0x0F]);
+    }
+    return hex;
+}
+
+std::string hmac(const std::vector<uint8_t>& key, const std::vector<uint8_t>& data) {
+    HmacSha256::Midstate midstate;
+    HmacSha256::precompute(key.data(), key.size(), midstate);
+    HmacSha256::Digest digest;
+    HmacSha256::compute(midstate, data.data(), data.size(), digest);
+    return toHex(digest);
+}
+
+std::vector<uint8_t> bytes(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+//! The flight key from test_TcSecurityDeframer_Authenticator.cpp
+const std::vector<uint8_t> kTestKey = fromHex("14408c2711281f4d70452ce3730bb4fa");
+
+//! Data of i & 0xFF for i in [0, size)
+std::vector<uint8_t> counting(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    return data;
+}
+
+}  // namespace
+
+// RFC 4231 Section 4 test vectors
+TEST(HmacSha256Test, Rfc4231Case1) {
+    EXPECT_EQ(hmac(std::vector<uint8_t>(20, 0x0b), bytes("Hi There")),
+              "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7");
+}
+
+TEST(HmacSha256Test, Rfc4231Case2) {
+    EXPECT_EQ(hmac(bytes("Jefe"), bytes("what do ya want for nothing?")),
+              "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+}
+
+TEST(HmacSha256Test, Rfc4231Case3) {
+    EXPECT_EQ(hmac(std::vector<uint8_t>(20, 0xaa), std::vector<uint8_t>(50, 0xdd)),
+              "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe");
+}
+
+TEST(HmacSha256Test, Rfc4231Case4) {
+    EXPECT_EQ(hmac(fromHex("0102030405060708090a0b0c0d0e0f10111213141516171819"), std::vector<uint8_t>(50, 0xcd)),
+              "82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b");
+}
+
+TEST(HmacSha256Test, Rfc4231Case6KeyLargerThanBlock) {
+    EXPECT_EQ(hmac(std::vector<uint8_t>(131, 0xaa), bytes("Test Using Larger Than Block-Size Key - Hash Key First")),
+              "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+}
+
+TEST(HmacSha256Test, Rfc4231Case7KeyAndDataLargerThanBlock) {
+    EXPECT_EQ(hmac(std::vector<uint8_t>(131, 0xaa),
+                   bytes("This is a test using a larger than block-size key and a larger than block-size data. The key "
+                         "needs to be hashed before being used by the HMAC algorithm.")),
+              "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2");
+}
+
+TEST(HmacSha256Test, PaddingBoundaries) {
+    // Sizes either side of the one- and two-block padding limits, computed with Python's hmac module
+    const struct {
+        size_t size;
+        const char* mac;
+    } kVectors[] = {
+        {0, "24d486445d3a82a89897df4daa782de481a01b9af87adb7103beda27fa5e3051"},
+        {1, "713b0681e51eb9582c35fe067bc4b828fa3cfd5593c4ada8c3ba3751fd23bd7e"},
+        {55, "18f17bcef64effa3cd5bbdaa9160920609be157c20e2ac72b00a789a288c704f"},
+        {56, "f1da1387e8fa7f69a8b899a52a72b40ce5f399f0f194eeb3490db779b1f41bde"},
+        {63, "208270ee2462cf0c3a88e9eaae79a7a11df824cbe7122d7744795b629cd87f60"},
+        {64, "22f4f97cf718f2fd1b5db1a70db1a833899dea692ca2f1f7a6ac3d3fd5c8d878"},
+        {65, "ed635a7e21680a7314b48cbe966172f77c7343312e0a3cf40b57999426ff1412"},
+        {119, "35513ccf40bd3c4c17e246c0be142d11504c764fc1a566f0111cf1dcbc870956"},
+        {120, "f79e8f81d6f1f40ad775adf3c3ad9c7e33a265d59bbbd1de301c16155ffa8b34"},
+        {128, "2c757c1a5ccd11935525c90cbe7a29b90994fc334debb6d72152e6aa213fd273"},
+        {200, "f6f35c76e3a08eda885c6c393e4b0732685c4bae29e0a39786397fa809176cd5"},
+    };
+    for (const auto& vector : kVectors) {
+        EXPECT_EQ(hmac(kTestKey, counting(vector.size)), vector.mac) << "size " << vector.size;
+    }
+}
+
+TEST(HmacSha256Test, VerifyTruncatedMac) {
+    HmacSha256::Midstate midstate;
+    HmacSha256::precompute(kTestKey.data(), kTestKey.size(), midstate);
+    // The data and truncated MAC of the test packet in test_TcSecurityDeframer_Authenticator.cpp
+    const std::vector<uint8_t> data = fromHex("0102030405060708090a0b0c0d0e0f10");
+    const std::vector<uint8_t> mac = fromHex("549246aff2ea867cebbc385d73f8949c");
+
+    EXPECT_TRUE(HmacSha256::verify(midstate, data.data(), data.size(), mac.data(), mac.size()));
+
+    // Every byte of the truncated MAC is checked
+    for (size_t i = 0; i < mac.size(); i++) {
+        std::vector<uint8_t> corrupted = mac;
+        corrupted[i] ^= 0x01;
+        EXPECT_FALSE(HmacSha256::verify(midstate, data.data(), data.size(), corrupted.data(), corrupted.size()))
+            << "byte " << i;
+    }
+
+    // A MAC longer than the digest can never match
+    std::vector<uint8_t> tooLong(HmacSha256::kDigestSize + 1, 0);
+    EXPECT_FALSE(HmacSha256::verify(midstate, data.data(), data.size(), tooLong.data(), tooLong.size()));
+}
+
+TEST(HmacSha256Test, ClearErasesMidstate) {
+    HmacSha256::Midstate midstate;
+    HmacSha256::precompute(kTestKey.data(), kTestKey.size(), midstate);
+    HmacSha256::clear(midstate);
+    for (size_t i = 0; i < midstate.inner.size(); i++) {
+        EXPECT_EQ(midstate.inner[i], 0u);
+        EXPECT_EQ(midstate.outer[i], 0u);
+    }
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Reservation.hpp"
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Validator.hpp"
+
+using namespace Components;
+using Header = Ccsds355_0_B_2::TCSecurityHeader;
+
+namespace {
+
+// Mirrors the TcSecurityDeframer accept path: the file is written before the frame is accepted
+struct Deframer {
+    uint32_t file;         // value in the sequence number file, survives power loss
+    uint32_t sequence;     // live counter, lost on power loss
+    uint32_t mark;         // mark the component believes is persisted
+    uint32_t reservation;  // SEQ_NUM_RESERVATION
+    uint32_t window;       // SEQ_NUM_WINDOW
+    uint32_t writes;       // file writes issued
+
+    Deframer(uint32_t persisted, uint32_t reservationSize, uint32_t windowSize)
+        : file(persisted), reservation(reservationSize), window(windowSize), writes(0) {
+        boot();
+    }
+
+    void boot() {
+        sequence = file;
+        mark = file;
+    }
+
+    // Returns true when the frame is accepted; powerLoss cuts power before the file write lands
+    bool receive(uint32_t packetSequence, bool powerLoss = false) {
+        if (validatePacket(Header{0u, packetSequence}, sequence, window) != PacketValidator::Status::Valid) {
+            return false;
+        }
+        if (!sequenceNumberReserved(packetSequence, mark, reservation)) {
+            if (powerLoss) {
+                boot();
+                return false;
+            }
+            file = reserveSequenceNumber(packetSequence, reservation);
+            mark = file;
+            writes++;
+        }
+        sequence = packetSequence;
+        return true;
+    }
+};
+
+}  // namespace
+
+TEST(SequenceReservationTest, ZeroReservationWritesEveryPacket) {
+    Deframer d(10u, 0u, 50u);
+    for (uint32_t seq = 11u; seq <= 20u; seq++) {
+        EXPECT_TRUE(d.receive(seq));
+        EXPECT_EQ(d.file, seq);
+    }
+    EXPECT_EQ(d.writes, 10u);
+}
+
+TEST(SequenceReservationTest, ReservationAmortizesWrites) {
+    Deframer d(0u, 100u, 50000u);
+    for (uint32_t seq = 1u; seq <= 1000u; seq++) {
+        EXPECT_TRUE(d.receive(seq));
+    }
+    // Written at 1, 102, 203, ... 910, each reserving the next 100 sequence numbers
+    EXPECT_EQ(d.writes, 10u);
+    EXPECT_EQ(d.file, 1010u);
+}
+
+TEST(SequenceReservationTest, MarkIsCoveredUpToReservation) {
+    EXPECT_TRUE(sequenceNumberReserved(100u, 100u, 10u));
+    EXPECT_TRUE(sequenceNumberReserved(90u, 100u, 10u));
+    EXPECT_FALSE(sequenceNumberReserved(101u, 100u, 10u));
+    // A mark left behind by a failed write is never taken as covering the counter
+    EXPECT_FALSE(sequenceNumberReserved(150u, 100u, 10u));
+}
+
+TEST(SequenceReservationTest, ReservationWrapsAround) {
+    EXPECT_EQ(reserveSequenceNumber(0xFFFFFFF0u, 0x20u), 0x10u);
+    EXPECT_TRUE(sequenceNumberReserved(0xFFFFFFF8u, 0x10u, 0x20u));
+    EXPECT_FALSE(sequenceNumberReserved(0x11u, 0x10u, 0x20u));
+}
+
+TEST(SequenceReservationTest, ReservationIsClamped) {
+    EXPECT_EQ(reserveSequenceNumber(5u, 0xFFFFFFFFu), 5u + SequenceReservation::kMaxReservation);
+    EXPECT_FALSE(sequenceNumberReserved(7u, 5u, 0xFFFFFFFFu));
+}
+
+TEST(SequenceReservationTest, NoReplayAcrossPowerLoss) {
+    // Cut power after every frame, and during every file write, near the U32 wrap
+    const uint32_t reservation = 7u;
+    const uint32_t window = 50u;
+    for (uint32_t cut = 1u; cut <= 40u; cut++) {
+        for (int duringWrite = 0; duringWrite < 2; duringWrite++) {
+            Deframer d(0xFFFFFFE0u, reservation, window);
+            std::vector<uint32_t> accepted;
+            uint32_t seq = 0xFFFFFFE0u;
+            for (uint32_t i = 1u; i <= cut; i++) {
+                seq++;
+                bool loss = (duringWrite != 0) && (i == cut);
+                if (d.receive(seq, loss)) {
+                    accepted.push_back(seq);
+                }
+            }
+            // Reset between frames too when the last frame needed no write
+            d.boot();
+
+            // Every frame accepted before the reset is rejected after it
+            for (uint32_t replay : accepted) {
+                Deframer probe = d;
+                EXPECT_FALSE(probe.receive(replay)) << "cut " << cut << " replayed " << replay;
+            }
+
+            // The resumed counter is never more than a reservation ahead of the last accepted frame
+            const uint32_t last = accepted.empty() ? 0xFFFFFFE0u : accepted.back();
+            EXPECT_LE(d.sequence - last, reservation);
+
+            // The ground resynchronizes by jumping past the resumed counter
+            EXPECT_TRUE(d.receive(d.sequence + 1u));
+        }
+    }
+}
@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
 #include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Validator.hpp"
 
 using namespace Components;
@@ -62,3 +67,172 @@ TEST(PacketValidatorTest, SequenceNumberAtWindowBoundary) {
     auto res = validatePacket(h, 10u, 5u);
     EXPECT_EQ(res, PacketValidator::Status::Valid);
 }
+
+// ----------------------------------------------------------------------
+// Sliding replay window
+// ----------------------------------------------------------------------
+
+namespace {
+
+using Window = PacketValidator::ReplayWindow;
+
+//! Validate then, when valid, accept, as TcSecurityDeframer does for an authenticated frame
+bool receive(Window& window, uint32_t seq, uint32_t forward) {
+    if (validatePacket(Header{0u, seq}, window, forward) != PacketValidator::Status::Valid) {
+        return false;
+    }
+    acceptSequenceNumber(window, seq);
+    return true;
+}
+
+//! Reference model: every accepted sequence number, and the highest by serial order
+struct Model {
+    std::set<uint32_t> accepted;
+    uint32_t highest;
+    uint32_t forward;
+
+    bool receive(uint32_t seq) {
+        const uint32_t ahead = seq - highest;
+        const uint32_t behind = highest - seq;
+        bool valid = false;
+        if (ahead != 0 && ahead <= forward) {
+            valid = true;
+        } else if (behind < PacketValidator::kReplayWindowSize) {
+            valid = accepted.count(seq) == 0;
+        }
+        if (valid) {
+            accepted.insert(seq);
+            if (ahead != 0 && ahead <= forward) {
+                highest = seq;
+            }
+        }
+        return valid;
+    }
+};
+
+}  // namespace
+
+TEST(ReplayWindowTest, ResumedWindowRejectsEverythingBehind) {
+    Window window = PacketValidator::replayWindowFrom(1000u);
+    for (uint32_t behind = 0; behind < 200u; behind++) {
+        EXPECT_EQ(validatePacket(Header{0u, 1000u - behind}, window, 50u),
+                  PacketValidator::Status::SequenceNumberInvalid)
+            << "behind " << behind;
+    }
+    EXPECT_EQ(validatePacket(Header{0u, 1001u}, window, 50u), PacketValidator::Status::Valid);
+    EXPECT_EQ(validatePacket(Header{0u, 1050u}, window, 50u), PacketValidator::Status::Valid);
+    EXPECT_EQ(validatePacket(Header{0u, 1051u}, window, 50u), PacketValidator::Status::SequenceNumberInvalid);
+}
+
+TEST(ReplayWindowTest, SpiCheckedFirst) {
+    Window window = PacketValidator::replayWindowFrom(10u);
+    EXPECT_EQ(validatePacket(Header{1u, 11u}, window, 5u), PacketValidator::Status::SpiInvalid);
+}
+
+TEST(ReplayWindowTest, ReorderedBurstAcceptedOnce) {
+    Window window = PacketValidator::replayWindowFrom(100u);
+
+    // A pipelined burst 101..110 arrives newest first
+    for (uint32_t seq = 110u; seq > 100u; seq--) {
+        EXPECT_TRUE(receive(window, seq, 50u)) << "seq " << seq;
+    }
+    EXPECT_EQ(window.highest, 110u);
+
+    // Every frame of the burst, and everything before it, is now a replay
+    for (uint32_t seq = 90u; seq <= 110u; seq++) {
+        EXPECT_FALSE(receive(window, seq, 50u)) << "seq " << seq;
+    }
+}
+
+TEST(ReplayWindowTest, AcceptReportsNewHighest) {
+    Window window = PacketValidator::replayWindowFrom(100u);
+    EXPECT_TRUE(acceptSequenceNumber(window, 103u));
+    EXPECT_FALSE(acceptSequenceNumber(window, 102u));
+    EXPECT_FALSE(acceptSequenceNumber(window, 101u));
+    EXPECT_TRUE(acceptSequenceNumber(window, 104u));
+    EXPECT_EQ(window.highest, 104u);
+}
+
+TEST(ReplayWindowTest, GapFallsOutOfWindow) {
+    Window window = PacketValidator::replayWindowFrom(100u);
+    EXPECT_TRUE(receive(window, 102u, 500u));
+
+    // 101 is still tracked until the highest moves 64 past it
+    EXPECT_TRUE(receive(window, 101u + PacketValidator::kReplayWindowSize - 1u, 500u));
+    Window probe = window;
+    EXPECT_TRUE(receive(probe, 101u, 500u));
+
+    EXPECT_TRUE(receive(window, 101u + PacketValidator::kReplayWindowSize, 500u));
+    EXPECT_FALSE(receive(window, 101u, 500u));
+}
+
+TEST(ReplayWindowTest, LargeJumpClearsBitmap) {
+    Window window = PacketValidator::replayWindowFrom(0u);
+    EXPECT_TRUE(receive(window, 1000u, 5000u));
+    EXPECT_EQ(window.bitmap, 1u);
+    EXPECT_TRUE(receive(window, 999u, 5000u));
+    EXPECT_FALSE(receive(window, 1000u - PacketValidator::kReplayWindowSize, 5000u));
+}
+
+TEST(ReplayWindowTest, ReorderAcrossWraparound) {
+    Window window = PacketValidator::replayWindowFrom(0xFFFFFFFDu);
+    EXPECT_TRUE(receive(window, 2u, 50u));
+    EXPECT_TRUE(receive(window, 0xFFFFFFFFu, 50u));
+    EXPECT_TRUE(receive(window, 0u, 50u));
+    EXPECT_TRUE(receive(window, 0xFFFFFFFEu, 50u));
+    EXPECT_TRUE(receive(window, 1u, 50u));
+    for (uint32_t seq : {0xFFFFFFFDu, 0xFFFFFFFEu, 0xFFFFFFFFu, 0u, 1u, 2u}) {
+        EXPECT_FALSE(receive(window, seq, 50u)) << "seq " << seq;
+    }
+    EXPECT_EQ(window.highest, 2u);
+}
+
+TEST(ReplayWindowTest, ExhaustivePairsMatchModel) {
+    // Every first frame, then every second frame, from 80 behind to 80 ahead of the resumed highest
+    const uint32_t start = 0xFFFFFFD0u;  // straddles the U32 wrap
+    for (int32_t first = -80; first <= 80; first++) {
+        for (int32_t second = -80; second <= 80; second++) {
+            Window window = PacketValidator::replayWindowFrom(start);
+            Model model{{}, start, 70u};
+            for (int64_t behind = 0; behind < 200; behind++) {
+                model.accepted.insert(start - static_cast<uint32_t>(behind));
+            }
+            for (int32_t offset : {first, second}) {
+                const uint32_t seq = start + static_cast<uint32_t>(offset);
+                ASSERT_EQ(receive(window, seq, 70u), model.receive(seq)) << "first " << first << " second " << second;
+            }
+            ASSERT_EQ(window.highest, model.highest);
+        }
+    }
+}
+
+TEST(ReplayWindowTest, RandomStreamsMatchModel) {
+    // Jittered, duplicated and replayed streams against the reference model
+    std::mt19937 random(426u);
+    for (uint32_t stream = 0; stream < 200u; stream++) {
+        const uint32_t start = static_cast<uint32_t>(random());
+        const uint32_t forward = 1u + random() % 100u;
+        Window window = PacketValidator::replayWindowFrom(start);
+        Model model{{}, start, forward};
+        for (int64_t behind = 0; behind < 2 * PacketValidator::kReplayWindowSize; behind++) {
+            model.accepted.insert(start - static_cast<uint32_t>(behind));
+        }
+        uint32_t next = start;
+        std::vector<uint32_t> sent;
+        for (uint32_t step = 0; step < 2000u; step++) {
+            uint32_t seq;
+            const uint32_t kind = random() % 10u;
+            if (kind < 6u) {
+                next += 1u + random() % 3u;
+                seq = next - random() % 8u;  // pipelined frames reordered in flight
+            } else if (kind < 9u && !sent.empty()) {
+                seq = sent[random() % sent.size()];  // replay of something already sent
+            } else {
+                seq = next + random() % (2u * forward + 2u) - forward;  // anywhere around the window
+            }
+            sent.push_back(seq);
+            ASSERT_EQ(receive(window, seq, forward), model.receive(seq)) << "stream " << stream << " step " << step;
+            ASSERT_EQ(window.highest, model.highest);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "PROVESFlightControllerReference/Components/TcSecurityDeframer/Verifier.hpp"
+
+using namespace Components;
+
+namespace {
+
+constexpr uint32_t kWindow = 50000;     //!< SEQ_NUM_WINDOW default
+constexpr uint32_t kReservation = 100;   //!< SEQ_NUM_RESERVATION default
+
+//! Sign a frame: SPI and sequence number, 8 data bytes, then the truncated HMAC
+std::vector<uint8_t> signedFrame(const HmacSha256::Midstate& midstate, uint16_t spi, uint32_t sequenceNumber) {
+    std::vector<uint8_t> frame = {static_cast<uint8_t>(spi >> 8),
+                                  static_cast<uint8_t>(spi),
+                                  static_cast<uint8_t>(sequenceNumber >> 24),
+                                  static_cast<uint8_t>(sequenceNumber >> 16),
+                                  static_cast<uint8_t>(sequenceNumber >> 8),
+                                  static_cast<uint8_t>(sequenceNumber)};
+    for (uint8_t i = 0; i < 8; i++) {
+        frame.push_back(i);
+    }
+    HmacSha256::Digest digest;
+    HmacSha256::compute(midstate, frame.data(), frame.size(), digest);
+    frame.insert(frame.end(), digest.begin(), digest.begin() + Ccsds355_0_B_2::kTCSecurityTrailer);
+    return frame;
+}
+
+class VerifierTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        const uint8_t key[16] = {0x14, 0x40, 0x8c, 0x27, 0x11, 0x28, 0x1f, 0x4d,
+                                 0x70, 0x45, 0x2c, 0xe3, 0x73, 0x0b, 0xb4, 0xfa};
+        HmacSha256::precompute(key, sizeof(key), midstate);
+        window = PacketValidator::replayWindowFrom(0);
+    }
+
+    FrameVerifier::Result verify(const std::vector<uint8_t>& frame, uint32_t mark = 0) {
+        const Ccsds355_0_B_2::TcTransferFrame::Parser::Result parsed =
+            Ccsds355_0_B_2::parse(frame.data(), frame.size());
+        EXPECT_EQ(parsed.status, Ccsds355_0_B_2::TcTransferFrame::Parser::Status::Ok);
+        return verifyFrame(frame.data(), frame.size(), parsed, window, kWindow, mark, kReservation, midstate);
+    }
+
+    HmacSha256::Midstate midstate;
+    PacketValidator::ReplayWindow window;
+};
+
+}  // namespace
+
+TEST_F(VerifierTest, AcceptsAndReservesPastTheMark) {
+    FrameVerifier::Result result = verify(signedFrame(midstate, 0, 1));
+    EXPECT_EQ(result.status, FrameVerifier::Status::Accepted);
+    EXPECT_FALSE(result.reordered);
+    EXPECT_TRUE(result.reserve);
+    EXPECT_EQ(result.mark, 1u + kReservation);
+    EXPECT_EQ(window.highest, 1u);
+
+    // Within the reservation no write is needed
+    result = verify(signedFrame(midstate, 0, 2), 1 + kReservation);
+    EXPECT_EQ(result.status, FrameVerifier::Status::Accepted);
+    EXPECT_FALSE(result.reserve);
+    EXPECT_EQ(result.mark, 1u + kReservation);
+}
+
+TEST_F(VerifierTest, ReorderedFrameOnlyMarksTheWindow) {
+    verify(signedFrame(midstate, 0, 5));
+    const FrameVerifier::Result result = verify(signedFrame(midstate, 0, 3), 5 + kReservation);
+    EXPECT_EQ(result.status, FrameVerifier::Status::Accepted);
+    EXPECT_TRUE(result.reordered);
+    EXPECT_FALSE(result.reserve);
+    EXPECT_EQ(window.highest, 5u);
+}
+
+TEST_F(VerifierTest, RejectsReplay) {
+    const std::vector<uint8_t> frame = signedFrame(midstate, 0, 7);
+    verify(frame);
+    const FrameVerifier::Result result = verify(frame, 7 + kReservation);
+    EXPECT_EQ(result.status, FrameVerifier::Status::SequenceNumberInvalid);
+    EXPECT_FALSE(result.reserve);
+}
+
+TEST_F(VerifierTest, RejectsInvalidSpi) {
+    const FrameVerifier::Result result = verify(signedFrame(midstate, 1, 1));
+    EXPECT_EQ(result.status, FrameVerifier::Status::SpiInvalid);
+    EXPECT_EQ(window.highest, 0u);
+}
+
+TEST_F(VerifierTest, ForgedFrameLeavesTheWindowUntouched) {
+    std::vector<uint8_t> frame = signedFrame(midstate, 0, 1);
+    frame.back() ^= 0x01;
+    const FrameVerifier::Result result = verify(frame);
+    EXPECT_EQ(result.status, FrameVerifier::Status::AuthenticationFailed);
+    EXPECT_EQ(result.authentication.status, PacketAuthenticator::AuthenticationStatus::VerifyError);
+    EXPECT_FALSE(result.reserve);
+    EXPECT_EQ(window.highest, 0u);
+
+    // The genuine frame with the same sequence number is still accepted
+    frame.back() ^= 0x01;
+    EXPECT_EQ(verify(frame).status, FrameVerifier::Status::Accepted);
+}